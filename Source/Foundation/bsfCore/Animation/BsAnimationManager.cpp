@@ -10,6 +10,7 @@
 #include "Animation/BsMorphShapes.h"
 #include "Mesh/BsMeshData.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Debug/BsProfilerTimeline.h"
 
 namespace bs
 {
@@ -37,6 +38,8 @@ namespace bs
 
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
+		BS_TIMELINE_SAMPLE("Animation update");
+
 		// Wait for any workers to complete
 		{
 			Lock lock(mMutex);
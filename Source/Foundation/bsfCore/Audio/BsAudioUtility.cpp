@@ -252,4 +252,36 @@ namespace bs
 	{
 		return (input[2] << 24) | (input[1] << 16) | (input[0] << 8);
 	}
+
+	float AudioUtility::calculateAudibility(float volume, float distance, float minDistance, float attenuation)
+	{
+		float refDistance = std::max(minDistance, 0.0001f);
+		distance = std::max(distance, refDistance);
+
+		return volume * refDistance / (refDistance + attenuation * (distance - refDistance));
+	}
+
+	UINT32 AudioUtility::assignVoices(Vector<AudioVoiceCandidate>& candidates, UINT32 maxVoices)
+	{
+		UINT32 numVoices = std::min(maxVoices, (UINT32)candidates.size());
+		if (numVoices == (UINT32)candidates.size())
+			return numVoices;
+
+		// Favor sources that already have a voice, so sources of similar audibility don't keep swapping
+		auto getWeight = [](const AudioVoiceCandidate& candidate)
+		{
+			return candidate.hasVoice ? candidate.audibility * 1.25f : candidate.audibility;
+		};
+
+		std::nth_element(candidates.begin(), candidates.begin() + numVoices, candidates.end(),
+			[&getWeight](const AudioVoiceCandidate& a, const AudioVoiceCandidate& b)
+		{
+			if (a.priority != b.priority)
+				return a.priority > b.priority;
+
+			return getWeight(a) > getWeight(b);
+		});
+
+		return numVoices;
+	}
 }
\ No newline at end of file
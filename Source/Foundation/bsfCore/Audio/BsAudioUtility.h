@@ -10,6 +10,15 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Audio source competing for one of a limited number of voices. */
+	struct AudioVoiceCandidate
+	{
+		UINT32 id = 0; /**< Identifier of the source, provided by the caller. */
+		INT32 priority = 0; /**< Sources with higher priority are assigned voices before sources with lower priority. */
+		float audibility = 0.0f; /**< How loud the source is heard, in range [0, 1]. */
+		bool hasVoice = false; /**< True if the source currently has a voice assigned. */
+	};
+
 	/** Provides various utility functionality relating to audio. */
 	class BS_CORE_EXPORT AudioUtility
 	{
@@ -60,6 +69,31 @@ namespace bs
 		 * @return				32-bit signed integer.
 		 */
 		static INT32 convert24To32Bits(const UINT8* input);
+
+		/**
+		 * Estimates how loud a 3D audio source is heard by a listener, using the inverse distance clamped model (the
+		 * default OpenAL distance model).
+		 *
+		 * @param[in]	volume		Volume of the source, in range [0, 1].
+		 * @param[in]	distance	Distance between the source and the listener.
+		 * @param[in]	minDistance	Distance at which the source starts attenuating.
+		 * @param[in]	attenuation	Determines how quickly the volume drops off with distance past @p minDistance.
+		 * @return					Volume at which the source is heard, in range [0, 1].
+		 */
+		static float calculateAudibility(float volume, float distance, float minDistance, float attenuation);
+
+		/**
+		 * Determines which audio sources get assigned a voice, when only a limited number of sources can play at once.
+		 * Sources with higher priority are picked first, followed by sources with higher audibility. Sources that already
+		 * have a voice are favored over slightly more audible ones, so sources of similar audibility don't keep swapping
+		 * voices.
+		 *
+		 * @param[in, out]	candidates	Sources competing for a voice. Reordered so the sources that get assigned a voice
+		 *								come first, in no particular order.
+		 * @param[in]		maxVoices	Maximum number of sources that can have a voice.
+		 * @return						Number of sources, from the start of @p candidates, that get assigned a voice.
+		 */
+		static UINT32 assignVoices(Vector<AudioVoiceCandidate>& candidates, UINT32 maxVoices);
 	};
 
 	/** @} */
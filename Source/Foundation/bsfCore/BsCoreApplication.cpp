@@ -37,9 +37,12 @@
 #include "Managers/BsQueryManager.h"
 #include "Threading/BsThreadPool.h"
 #include "Threading/BsTaskScheduler.h"
+#include "FileSystem/BsAsyncFileIO.h"
 #include "Profiling/BsRenderStats.h"
+#include "Debug/BsProfilerTimeline.h"
 #include "Utility/BsMessageHandler.h"
 #include "Managers/BsResourceListenerManager.h"
+#include "Image/BsTextureStreamer.h"
 #include "Managers/BsRenderStateManager.h"
 #include "Material/BsShaderManager.h"
 #include "Physics/BsPhysicsManager.h"
@@ -53,6 +56,13 @@ namespace bs
 {
 	constexpr UINT32 CoreApplication::MAX_FIXED_UPDATES_PER_FRAME;
 
+	/** Returns the name identifier of the timeline sample covering a single frame on the core thread. */
+	static UINT32 getCoreFrameSampleId()
+	{
+		static const UINT32 nameId = ProfilerTimeline::registerName("Core frame");
+		return nameId;
+	}
+
 	CoreApplication::CoreApplication(START_UP_DESC desc)
 		: mPrimaryWindow(nullptr), mStartUpDesc(desc), mRendererPlugin(nullptr), mIsFrameRenderingFinished(true)
 		, mSimThreadId(BS_THREAD_CURRENT_ID), mRunMainLoop(false)
@@ -77,6 +87,7 @@ namespace bs
 
 		ct::ParamBlockManager::shutDown();
 		StringTableManager::shutDown();
+		TextureStreamer::shutDown();
 		Resources::shutDown();
 		GameObjectManager::shutDown();
 
@@ -112,6 +123,7 @@ namespace bs
 
 		CoreThread::shutDown();
 		RenderStats::shutDown();
+		AsyncFileIO::shutDown();
 		TaskScheduler::shutDown();
 		ThreadPool::shutDown();
 		ProfilingManager::shutDown();
@@ -138,6 +150,7 @@ namespace bs
 		ProfilingManager::startUp();
 		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
 		TaskScheduler::startUp();
+		AsyncFileIO::startUp();
 		TaskScheduler::instance().removeWorker();
 		RenderStats::startUp();
 		CoreThread::startUp();
@@ -148,6 +161,7 @@ namespace bs
 		CoreObjectManager::startUp();
 		GameObjectManager::startUp();
 		Resources::startUp();
+		TextureStreamer::startUp();
 		ResourceListenerManager::startUp();
 		GpuProgramManager::startUp();
 		RenderStateManager::startUp();
@@ -181,6 +195,7 @@ namespace bs
 	void CoreApplication::runMainLoop()
 	{
 		mRunMainLoop = true;
+		ProfilerTimeline::setThreadName("Sim");
 
 		while(mRunMainLoop)
 		{
@@ -213,6 +228,7 @@ namespace bs
 			}
 
 			gProfilerCPU().beginThread("Sim");
+			BS_TIMELINE_SAMPLE("Sim frame");
 
 			Platform::_update();
 			DeferredCallManager::instance()._update();
@@ -278,6 +294,9 @@ namespace bs
 			// animation we sent on the previous frame, and we want the scene information to match to what is displayed.
 			const EvaluatedAnimationData* animData = AnimationManager::instance().update();
 
+			// Update texture mip residency based on what was rendered last frame
+			TextureStreamer::instance()._update();
+
 			// Send out resource events in case any were loaded/destroyed/modified
 			ResourceListenerManager::instance().update();
 
@@ -315,6 +334,7 @@ namespace bs
 			gCoreThread().queueCommand(std::bind(&CoreApplication::frameRenderingFinishedCallback, this), CTQF_InternalQueue);
 
 			gCoreThread().queueCommand(std::bind(&ct::QueryManager::_update, ct::QueryManager::instancePtr()), CTQF_InternalQueue);
+			gCoreThread().queueCommand(std::bind(&ct::HardwareBufferManager::_endFrame, ct::HardwareBufferManager::instancePtr()), CTQF_InternalQueue);
 			gCoreThread().queueCommand(std::bind(&CoreApplication::endCoreProfiling, this), CTQF_InternalQueue);
 
 			gProfilerCPU().endThread();
@@ -360,6 +380,15 @@ namespace bs
 		mFrameStep = (UINT64)1000000 / limit;
 	}
 
+	float CoreApplication::getFixedUpdateFraction() const
+	{
+		UINT64 currentTime = gTime().getTimePrecise();
+		if (currentTime <= mLastFixedUpdateTime)
+			return 0.0f;
+
+		return std::min((currentTime - mLastFixedUpdateTime) / (float)mFixedStep, 1.0f);
+	}
+
 	void CoreApplication::frameRenderingFinishedCallback()
 	{
 		Lock lock(mFrameRenderingFinishedMutex);
@@ -376,10 +405,15 @@ namespace bs
 	void CoreApplication::beginCoreProfiling()
 	{
 		gProfilerCPU().beginThread("Core");
+
+		ProfilerTimeline::setThreadName("Core");
+		ProfilerTimeline::beginSample(getCoreFrameSampleId());
 	}
 
 	void CoreApplication::endCoreProfiling()
 	{
+		ProfilerTimeline::endSample(getCoreFrameSampleId());
+
 		ProfilerGPU::instance()._update();
 
 		gProfilerCPU().endThread();
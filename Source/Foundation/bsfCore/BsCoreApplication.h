@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "RenderAPI/BsRenderWindow.h"
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
 #include "Utility/BsEvent.h"
 
 namespace bs
@@ -23,6 +24,13 @@ namespace bs
 		String input; /**< Name of the input plugin to use. */
 		bool scripting = false; /**< True to load the scripting system. */
 
+		/** 
+		 * Folder in which to store compiled GPU program bytecode, so programs don't need to be recompiled on next
+		 * start-up. Defaults to a folder in the user's temporary folder. Set to an empty path to disable the cache. Used by
+		 * render backends that support bytecode caching, and by the OpenGL backend for storing linked program binaries.
+		 */
+		Path bytecodeCache = ct::GpuProgramBytecodeCache::getDefaultFolder();
+
 		RENDER_WINDOW_DESC primaryWindowDesc; /**< Describes the window to create during start-up. */
 
 		Vector<String> importers; /**< A list of importer plugins to load. */
@@ -60,12 +68,21 @@ namespace bs
 			 */
 			float getFixedUpdateStep() const { return mFixedStep / 1000000.0f; }
 
+			/**
+			 * Returns the amount of time that has passed since the last fixed update, as a fraction of the fixed update
+			 * step, in range [0, 1]. Can be used for interpolating between the results of the last two fixed updates.
+			 */
+			float getFixedUpdateFraction() const;
+
 			/**
 			 * Issues a request for the application to close. Application may choose to ignore the request depending on the
 			 * circumstances and the implementation.
 			 */
 			virtual void quitRequested();
 
+			/**	Returns the parameters the application was started with. */
+			const START_UP_DESC& getStartUpDesc() const { return mStartUpDesc; }
+
 			/**	Returns the main window that was created on application start-up. */
 			SPtr<RenderWindow> getPrimaryWindow() const { return mPrimaryWindow; }
 
@@ -355,7 +355,10 @@ namespace bs
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class ResourceArchive;
 	class Texture;
+	class TextureStreamer;
+	struct TextureStreamingData;
 	class Mesh;
 	class MeshBase;
 	class TransientMesh;
@@ -432,6 +435,7 @@ namespace bs
 		class Technique;
 		class Material;
 		class GpuProgram;
+		class GpuProgramBytecodeCache;
 		class Light;
 		class ComputePipelineState;
 		class GraphicsPipelineState;
@@ -143,6 +143,7 @@ set(BS_CORE_INC_RENDERAPI
 	"bsfCore/RenderAPI/BsIndexBuffer.h"
 	"bsfCore/RenderAPI/BsHardwareBuffer.h"
 	"bsfCore/RenderAPI/BsGpuProgram.h"
+	"bsfCore/RenderAPI/BsGpuProgramBytecodeCache.h"
 	"bsfCore/RenderAPI/BsGpuParams.h"
 	"bsfCore/RenderAPI/BsGpuParamDesc.h"
 	"bsfCore/RenderAPI/BsGpuParamBlockBuffer.h"
@@ -200,11 +201,13 @@ set(BS_CORE_INC_MATERIAL
 	"bsfCore/Material/BsGpuParamsSet.h"
 	"bsfCore/Material/BsShaderInclude.h"
 	"bsfCore/Material/BsShaderVariation.h"
+	"bsfCore/Material/BsShaderPrecompiler.h"
 )
 
 set(BS_CORE_INC_RESOURCES
 	"bsfCore/Resources/BsResources.h"
 	"bsfCore/Resources/BsResourceManifest.h"
+	"bsfCore/Resources/BsResourceArchive.h"
 	"bsfCore/Resources/BsResourceHandle.h"
 	"bsfCore/Resources/BsResource.h"
 	"bsfCore/Resources/BsGpuResourceData.h"
@@ -224,6 +227,7 @@ set(BS_CORE_INC_MESH
 
 set(BS_CORE_INC_IMAGE
 	"bsfCore/Image/BsTexture.h"
+	"bsfCore/Image/BsTextureStreamer.h"
 	"bsfCore/Image/BsPixelData.h"
 	"bsfCore/Image/BsPixelUtil.h"
 	"bsfCore/Image/BsPixelVolume.h"
@@ -398,6 +402,7 @@ set(BS_CORE_SRC_RESOURCES
 	"bsfCore/Resources/BsResource.cpp"
 	"bsfCore/Resources/BsResourceHandle.cpp"
 	"bsfCore/Resources/BsResourceManifest.cpp"
+	"bsfCore/Resources/BsResourceArchive.cpp"
 	"bsfCore/Resources/BsResources.cpp"
 	"bsfCore/Resources/BsResourceMetaData.cpp"
 	"bsfCore/Resources/BsSavedResourceData.cpp"
@@ -416,6 +421,7 @@ set(BS_CORE_SRC_MESH
 set(BS_CORE_SRC_IMAGE
 	"bsfCore/Image/BsPixelData.cpp"
 	"bsfCore/Image/BsTexture.cpp"
+	"bsfCore/Image/BsTextureStreamer.cpp"
 	"bsfCore/Image/BsPixelUtil.cpp"
 )
 
@@ -431,6 +437,7 @@ set(BS_CORE_SRC_MATERIAL
 	"bsfCore/Material/BsGpuParamsSet.cpp"
 	"bsfCore/Material/BsShaderInclude.cpp"
 	"bsfCore/Material/BsShaderVariation.cpp"
+	"bsfCore/Material/BsShaderPrecompiler.cpp"
 )
 
 set(BS_CORE_SRC_INPUT
@@ -458,6 +465,7 @@ set(BS_CORE_SRC_RENDERAPI
 	"bsfCore/RenderAPI/BsGpuParamBlockBuffer.cpp"
 	"bsfCore/RenderAPI/BsGpuParams.cpp"
 	"bsfCore/RenderAPI/BsGpuProgram.cpp"
+	"bsfCore/RenderAPI/BsGpuProgramBytecodeCache.cpp"
 	"bsfCore/RenderAPI/BsIndexBuffer.cpp"
 	"bsfCore/RenderAPI/BsOcclusionQuery.cpp"
 	"bsfCore/RenderAPI/BsRasterizerState.cpp"
@@ -9,6 +9,7 @@
 #include "Threading/BsAsyncOp.h"
 #include "Resources/BsResources.h"
 #include "Image/BsPixelUtil.h"
+#include "Image/BsTextureStreamer.h"
 
 namespace bs 
 {
@@ -105,7 +106,8 @@ namespace bs
 	{
 		const TextureProperties& props = getProperties();
 
-		SPtr<ct::CoreObject> coreObj = ct::TextureManager::instance().createTextureInternal(props.mDesc, mInitData);
+		SPtr<ct::CoreObject> coreObj = ct::TextureManager::instance().createTextureInternal(
+			getResidentDesc(mResidentMip), mInitData);
 
 		if ((mProperties.getUsage() & TU_CPUCACHED) == 0)
 			mInitData = nullptr;
@@ -113,11 +115,101 @@ namespace bs
 		return coreObj;
 	}
 
+	void Texture::destroy()
+	{
+		if (mStreamingId != 0 && TextureStreamer::isStarted())
+			TextureStreamer::instance()._unregisterTexture(this);
+
+		Resource::destroy();
+	}
+
+	void Texture::setSourceFile(const Path& path, UINT64 offset)
+	{
+		// Only relevant if the streamed mip levels were left in the file during deserialization
+		if (mStreamingData == nullptr || mStreamingData->hasSource())
+			return;
+
+		mStreamingData->path = path;
+		mStreamingData->offset += offset;
+
+		if (TextureStreamer::isStarted())
+			TextureStreamer::instance()._registerTexture(this);
+	}
+
+	TEXTURE_DESC Texture::getResidentDesc(UINT32 mipLevel) const
+	{
+		TEXTURE_DESC desc = mProperties.mDesc;
+		if (mipLevel == 0)
+			return desc;
+
+		PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, mipLevel, desc.width, desc.height, desc.depth);
+		desc.numMips -= mipLevel;
+
+		return desc;
+	}
+
+	void Texture::_setResidentMip(UINT32 mipLevel, const Vector<SPtr<PixelData>>& mipData)
+	{
+		if (mStreamingData == nullptr || mipLevel == mResidentMip || mipLevel > mStreamingData->numStreamedMips)
+			return;
+
+		UINT32 numFaces = mProperties.getNumFaces();
+		UINT32 oldMipLevel = mResidentMip;
+		if (mipLevel < oldMipLevel && mipData.size() != (oldMipLevel - mipLevel) * numFaces)
+		{
+			LOGERR("Mip level data provided for texture " + getName() + " doesn't match the number of new mip levels.");
+			return;
+		}
+
+		SPtr<ct::Texture> oldCore = getCore();
+		SPtr<ct::Texture> newCore = ct::TextureManager::instance().createTextureInternal(getResidentDesc(mipLevel));
+
+		mCoreSpecific = newCore;
+		mResidentMip = mipLevel;
+
+		UINT32 numMips = mProperties.getNumMipmaps() + 1;
+		auto updateCore = [oldCore, newCore, oldMipLevel, mipLevel, numMips, numFaces, mipData]()
+		{
+			newCore->initialize();
+
+			// Mip levels resident in both versions are copied on the GPU, new ones are uploaded
+			for (UINT32 mip = std::max(oldMipLevel, mipLevel); mip < numMips; mip++)
+			{
+				for (UINT32 face = 0; face < numFaces; face++)
+				{
+					TEXTURE_COPY_DESC copyDesc;
+					copyDesc.srcFace = face;
+					copyDesc.srcMip = mip - oldMipLevel;
+					copyDesc.dstFace = face;
+					copyDesc.dstMip = mip - mipLevel;
+
+					oldCore->copy(newCore, copyDesc);
+				}
+			}
+
+			for (UINT32 i = 0; i < (UINT32)mipData.size(); i++)
+				newCore->writeData(*mipData[i], i / numFaces, i % numFaces);
+		};
+
+		gCoreThread().queueCommand(updateCore);
+	}
+
 	AsyncOp Texture::writeData(const SPtr<PixelData>& data, UINT32 face, UINT32 mipLevel, bool discardEntireBuffer)
 	{
+		if (mipLevel < mResidentMip)
+		{
+			LOGERR("Cannot write to mip level " + toString(mipLevel) + " of texture " + getName() + " as it is not "
+				"resident. Streamed textures cannot be written to.");
+
+			AsyncOp op;
+			op._completeOperation();
+			return op;
+		}
+
 		UINT32 subresourceIdx = mProperties.mapToSubresourceIdx(face, mipLevel);
 		updateCPUBuffers(subresourceIdx, *data);
 
+		mipLevel -= mResidentMip;
 		data->_lock();
 
 		std::function<void(const SPtr<ct::Texture>&, UINT32, UINT32, const SPtr<PixelData>&, bool, AsyncOp&)> func =
@@ -136,6 +228,19 @@ namespace bs
 
 	AsyncOp Texture::readData(const SPtr<PixelData>& data, UINT32 face, UINT32 mipLevel)
 	{
+		if (mipLevel < mResidentMip)
+		{
+			// Not resident on the GPU, read from the streaming source instead
+			SPtr<PixelData> mipData = mStreamingData->readMip(face, mipLevel);
+			if (mipData != nullptr)
+				PixelUtil::bulkPixelConversion(*mipData, *data);
+
+			AsyncOp op;
+			op._completeOperation();
+			return op;
+		}
+
+		mipLevel -= mResidentMip;
 		data->_lock();
 
 		std::function<void(const SPtr<ct::Texture>&, UINT32, UINT32, const SPtr<PixelData>&, AsyncOp&)> func =
@@ -589,6 +694,12 @@ namespace bs
 		return TextureManager::instance().createTexture(desc, deviceMask);
 	}
 
+	SPtr<Texture> Texture::createAliased(const TEXTURE_DESC& desc, const SPtr<Texture>& memorySource,
+		GpuDeviceFlags deviceMask)
+	{
+		return TextureManager::instance().createAliasedTexture(desc, memorySource, deviceMask);
+	}
+
 	SPtr<Texture> Texture::create(const SPtr<PixelData>& pixelData, int usage, bool hwGammaCorrection, 
 		GpuDeviceFlags deviceMask)
 	{
@@ -77,6 +77,18 @@ namespace bs
 
 		/** Number of texture slices to create if creating a texture array. Ignored for 3D textures. */
 		UINT32 numArraySlices = 1;
+
+		/**
+		 * If true, the most detailed mip levels of the texture are stored separately when the texture is saved. When such
+		 * a texture is loaded only its low detail mip levels are uploaded to the GPU, while higher detail mip levels are
+		 * streamed in by the TextureStreamer once they are needed for rendering.
+		 *
+		 * The streamed mip levels are read from the resource file on demand, so they occupy neither GPU nor system memory
+		 * until needed. Such textures are saved uncompressed for this purpose. If the resource file is compressed
+		 * regardless (e.g. as part of a compressed archive) the data of the streamed mip levels is instead kept in system
+		 * memory for the lifetime of the texture. If the TextureStreamer isn't started, all mip levels are loaded.
+		 */
+		bool streaming = false;
 	};
 
 	/** Structure used for specifying information about a texture copy operation. */
@@ -165,6 +177,9 @@ namespace bs
 		/** Returns the number of array slices of the texture (if the texture is an array texture). */
 		UINT32 getNumArraySlices() const { return mDesc.numArraySlices; }
 
+		/** Checks should the most detailed mip levels of the texture be streamed in on demand. */
+		bool isStreaming() const { return mDesc.streaming; }
+
 		/**
 		 * Allocates a buffer that exactly matches the format of the texture described by these properties, for the provided
 		 * face and mip level. This is a helper function, primarily meant for creating buffers when reading from, or writing
@@ -295,10 +310,31 @@ namespace bs
 		static SPtr<Texture> _createPtr(const SPtr<PixelData>& pixelData, int usage = TU_DEFAULT, 
 			bool hwGammaCorrection = false);
 
+		/**
+		 * Returns the most detailed mip level currently resident on the GPU. Always zero unless the texture is streamed.
+		 * The core texture contains only the resident mip levels, meaning its mip level 0 maps to this mip level.
+		 */
+		UINT32 _getResidentMip() const { return mResidentMip; }
+
+		/** Returns the source of the streamed mip levels, or null if the texture is not streamed. */
+		const SPtr<TextureStreamingData>& _getStreamingData() const { return mStreamingData; }
+
+		/**
+		 * Changes the most detailed mip level resident on the GPU. The core texture is re-created with the new set of mip
+		 * levels. Caller is responsible for notifying anything referencing the core texture of the change.
+		 *
+		 * @param[in]	mipLevel	New most detailed resident mip level.
+		 * @param[in]	mipData		Data of the mip levels that become resident, if @p mipLevel is more detailed than the
+		 *							current resident mip level. Provided in mip-major order, for all faces of each mip
+		 *							level between @p mipLevel and the currently resident mip level.
+		 */
+		void _setResidentMip(UINT32 mipLevel, const Vector<SPtr<PixelData>>& mipData);
+
 		/** @} */
 
 	protected:
 		friend class TextureManager;
+		friend class TextureStreamer;
 
 		Texture(const TEXTURE_DESC& desc);
 		Texture(const TEXTURE_DESC& desc, const SPtr<PixelData>& pixelData);
@@ -306,9 +342,21 @@ namespace bs
 		/** @copydoc Resource::initialize */
 		void initialize() override;
 
+		/** @copydoc CoreObject::destroy */
+		void destroy() override;
+
 		/** @copydoc CoreObject::createCore */
 		SPtr<ct::CoreObject> createCore() const override;
 
+		/** @copydoc Resource::isCompressible */
+		bool isCompressible() const override { return !mProperties.isStreaming(); } // Streamed mips are read from the file
+
+		/** @copydoc Resource::setSourceFile */
+		void setSourceFile(const Path& path, UINT64 offset) override;
+
+		/** Returns a description of the core texture containing only the mip levels starting with @p mipLevel. */
+		TEXTURE_DESC getResidentDesc(UINT32 mipLevel) const;
+
 		/** Calculates the size of the texture, in bytes. */
 		UINT32 calculateSize() const;
 
@@ -327,6 +375,10 @@ namespace bs
 		TextureProperties mProperties;
 		mutable SPtr<PixelData> mInitData;
 
+		SPtr<TextureStreamingData> mStreamingData;
+		UINT32 mResidentMip = 0;
+		UINT32 mStreamingId = 0;
+
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
 		/************************************************************************/
@@ -456,6 +508,22 @@ namespace bs
 		static SPtr<Texture> create(const SPtr<PixelData>& pixelData, int usage = TU_DEFAULT, 
 			bool hwGammaCorrection = false, GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
+		/**
+		 * Creates a new texture that shares GPU memory with an existing texture, allowing textures that are never used at
+		 * the same time to occupy the same memory. Contents of the two textures are undefined whenever the other texture
+		 * was written to, and the caller is responsible for overwriting the entire texture before reading from it.
+		 *
+		 * If the render API doesn't support memory aliasing (see RSC_TEXTURE_MEMORY_ALIASING), or if the memory of
+		 * @p memorySource is not large enough or compatible with the new texture, the texture is created with its own
+		 * memory instead.
+		 *
+		 * @param[in]	desc			Description of the texture to create.
+		 * @param[in]	memorySource	Texture whose memory to reuse. Its memory is kept alive while the new texture is.
+		 * @param[in]	deviceMask		Mask that determines on which GPU devices should the object be created on.
+		 */
+		static SPtr<Texture> createAliased(const TEXTURE_DESC& desc, const SPtr<Texture>& memorySource,
+			GpuDeviceFlags deviceMask = GDF_DEFAULT);
+
 		/************************************************************************/
 		/* 								TEXTURE VIEW                      		*/
 		/************************************************************************/
@@ -0,0 +1,473 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Image/BsTextureStreamer.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "FileSystem/BsDataStream.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsAsyncFileIO.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Resources/BsResources.h"
+#include "Reflection/BsRTTIType.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	constexpr UINT32 TextureStreamer::MIN_RESIDENT_SIZE;
+	constexpr UINT64 TextureStreamer::DEFAULT_MEMORY_BUDGET;
+	constexpr UINT32 TextureStreamer::MAX_PENDING_LOADS;
+	constexpr UINT32 TextureStreamer::EVICTION_DELAY;
+
+	UINT64 TextureStreamingData::getMipOffset(UINT32 mipLevel) const
+	{
+		UINT32 numFaces = TextureProperties(desc).getNumFaces();
+
+		UINT64 mipOffset = 0;
+		for (UINT32 i = 0; i < mipLevel; i++)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, i, width, height, depth);
+
+			mipOffset += numFaces * (UINT64)PixelUtil::getMemorySize(width, height, depth, storedFormat);
+		}
+
+		return mipOffset;
+	}
+
+	SPtr<PixelData> TextureStreamingData::readMip(UINT32 face, UINT32 mipLevel)
+	{
+		UINT32 width, height, depth;
+		PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, mipLevel, width, height, depth);
+
+		SPtr<PixelData> data = PixelData::create(width, height, depth, storedFormat);
+		UINT64 mipOffset = getMipOffset(mipLevel) + face * (UINT64)data->getSize();
+
+		if (!read(mipOffset, data->getData(), data->getSize()))
+			return nullptr;
+
+		if (storedFormat != desc.format)
+		{
+			SPtr<PixelData> convertedData = PixelData::create(width, height, depth, desc.format);
+			PixelUtil::bulkPixelConversion(*data, *convertedData);
+
+			data = convertedData;
+		}
+
+		return data;
+	}
+
+	Vector<SPtr<PixelData>> TextureStreamingData::readMips(UINT32 firstMip, UINT32 lastMip)
+	{
+		UINT64 start = getMipOffset(firstMip);
+		UINT64 size = getMipOffset(lastMip) - start;
+
+		UINT8* data = (UINT8*)bs_alloc((size_t)size);
+
+		Vector<SPtr<PixelData>> output;
+		if (read(start, data, size))
+			output = decodeMips(data, firstMip, lastMip);
+
+		bs_free(data);
+		return output;
+	}
+
+	Vector<SPtr<PixelData>> TextureStreamingData::decodeMips(const UINT8* data, UINT32 firstMip, UINT32 lastMip) const
+	{
+		UINT32 numFaces = TextureProperties(desc).getNumFaces();
+
+		Vector<SPtr<PixelData>> output;
+		for (UINT32 mip = firstMip; mip < lastMip; mip++)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, mip, width, height, depth);
+
+			for (UINT32 face = 0; face < numFaces; face++)
+			{
+				SPtr<PixelData> pixelData = PixelData::create(width, height, depth, storedFormat);
+				memcpy(pixelData->getData(), data, pixelData->getSize());
+				data += pixelData->getSize();
+
+				if (storedFormat != desc.format)
+				{
+					SPtr<PixelData> convertedData = PixelData::create(width, height, depth, desc.format);
+					PixelUtil::bulkPixelConversion(*pixelData, *convertedData);
+
+					pixelData = convertedData;
+				}
+
+				output.push_back(pixelData);
+			}
+		}
+
+		return output;
+	}
+
+	bool TextureStreamingData::read(UINT64 start, UINT8* output, UINT64 size)
+	{
+		if (!path.isEmpty())
+		{
+			Lock fileLock = FileScheduler::getLock(path);
+
+			SPtr<DataStream> file = FileSystem::openFile(path, true);
+			if (file == nullptr)
+				return false;
+
+			file->seek((size_t)(offset + start));
+			return file->read(output, (size_t)size) == size;
+		}
+
+		if (stream == nullptr)
+			return false;
+
+		Lock lock(mMutex);
+
+		stream->seek((size_t)(offset + start));
+		return stream->read(output, (size_t)size) == size;
+	}
+
+	TextureStreamer::TextureStreamer()
+	{
+		mResourceLoadedConn = gResources().onResourceLoaded.connect(
+			std::bind(&TextureStreamer::onResourceLoaded, this, std::placeholders::_1));
+	}
+
+	TextureStreamer::~TextureStreamer()
+	{
+		mResourceLoadedConn.disconnect();
+
+		// Reads and loads reference the streamer, make sure they finish
+		Vector<SPtr<Task>> pendingLoads;
+		{
+			Lock lock(mCompletedMutex);
+			mPendingReadsSignal.wait(lock, [this]() { return mNumPendingReads == 0; });
+
+			pendingLoads = mPendingLoads;
+		}
+
+		for (auto& task : pendingLoads)
+			task->wait();
+	}
+
+	UINT32 TextureStreamer::getNumStreamableMips(const TextureProperties& props)
+	{
+		if (!props.isStreaming() || props.getNumSamples() > 1)
+			return 0;
+
+		// Textures written to at runtime must keep all their data resident
+		const INT32 nonStreamableUsage = TU_DYNAMIC | TU_RENDERTARGET | TU_DEPTHSTENCIL | TU_LOADSTORE | TU_CPUCACHED;
+		if ((props.getUsage() & nonStreamableUsage) != 0)
+			return 0;
+
+		UINT32 numMips = props.getNumMipmaps();
+		UINT32 numStreamedMips = 0;
+		while (numStreamedMips < numMips)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), props.getDepth(), numStreamedMips,
+				width, height, depth);
+
+			if (std::max(width, std::max(height, depth)) <= MIN_RESIDENT_SIZE)
+				break;
+
+			numStreamedMips++;
+		}
+
+		return numStreamedMips;
+	}
+
+	void TextureStreamer::_notifyTextureUsage(const UnorderedMap<const ct::Texture*, float>& screenSizes)
+	{
+		Lock lock(mUsageMutex);
+
+		for (auto& entry : screenSizes)
+		{
+			float& screenSize = mUsage[entry.first];
+			screenSize = std::max(screenSize, entry.second);
+		}
+	}
+
+	void TextureStreamer::_registerTexture(Texture* texture)
+	{
+		Lock lock(mMutex);
+
+		UINT32 id = mNextId++;
+		texture->mStreamingId = id;
+
+		StreamedTexture& entry = mTextures[id];
+		entry.texture = texture;
+		entry.requiredMip = texture->_getResidentMip();
+
+		mNumTextures.store((UINT32)mTextures.size(), std::memory_order_relaxed);
+	}
+
+	void TextureStreamer::_unregisterTexture(Texture* texture)
+	{
+		Lock lock(mMutex);
+
+		mTextures.erase(texture->mStreamingId);
+		texture->mStreamingId = 0;
+
+		mNumTextures.store((UINT32)mTextures.size(), std::memory_order_relaxed);
+	}
+
+	void TextureStreamer::onResourceLoaded(const HResource& resource)
+	{
+		if (resource->getRTTI()->getRTTIId() != TID_Texture)
+			return;
+
+		Texture* texture = static_cast<Texture*>(resource.get());
+		if (texture->mStreamingId == 0)
+			return;
+
+		Lock lock(mMutex);
+
+		auto iterFind = mTextures.find(texture->mStreamingId);
+		if (iterFind != mTextures.end())
+			iterFind->second.uuid = resource.getUUID();
+	}
+
+	void TextureStreamer::setResidentMip(StreamedTexture& entry, UINT32 mipLevel, const Vector<SPtr<PixelData>>& mipData)
+	{
+		entry.texture->_setResidentMip(mipLevel, mipData);
+
+		// Make sure materials referencing the texture start using the new core texture
+		if (!entry.uuid.empty())
+			gResources().onResourceModified(gResources()._getResourceHandle(entry.uuid));
+	}
+
+	void TextureStreamer::_update()
+	{
+		mFrameIdx++;
+
+		UnorderedMap<const ct::Texture*, float> usage;
+		{
+			Lock lock(mUsageMutex);
+			std::swap(usage, mUsage);
+		}
+
+		Vector<CompletedLoad> completedLoads;
+		{
+			Lock lock(mCompletedMutex);
+			std::swap(completedLoads, mCompletedLoads);
+
+			for (auto iter = mPendingLoads.begin(); iter != mPendingLoads.end();)
+			{
+				if ((*iter)->isComplete())
+					iter = mPendingLoads.erase(iter);
+				else
+					++iter;
+			}
+		}
+
+		Lock lock(mMutex);
+
+		// Apply mip levels read since last frame, unless the texture was destroyed or its residency changed since
+		for (auto& load : completedLoads)
+		{
+			auto iterFind = mTextures.find(load.id);
+			if (iterFind == mTextures.end())
+				continue;
+
+			StreamedTexture& entry = iterFind->second;
+			entry.loadPending = false;
+
+			if (entry.texture->_getResidentMip() != load.previousMip)
+				continue;
+
+			bool valid = !load.mipData.empty();
+			for (auto& mipData : load.mipData)
+				valid &= mipData != nullptr;
+
+			if (valid)
+				setResidentMip(entry, load.mip, load.mipData);
+			else
+				LOGERR("Failed reading streamed mip levels of texture: " + entry.texture->getName());
+		}
+
+		// Determine the mip level each texture requires, based on its size on screen
+		UINT64 requiredMemory = 0;
+		for (auto& pair : mTextures)
+		{
+			StreamedTexture& entry = pair.second;
+			const TextureProperties& props = entry.texture->getProperties();
+			UINT32 numStreamedMips = entry.texture->_getStreamingData()->numStreamedMips;
+
+			auto iterFind = usage.find(entry.texture->getCore().get());
+			if (iterFind != usage.end())
+			{
+				entry.screenSize = iterFind->second;
+				entry.lastUsedFrame = mFrameIdx;
+			}
+			else if ((mFrameIdx - entry.lastUsedFrame) > EVICTION_DELAY)
+				entry.screenSize = 0.0f;
+
+			UINT32 maxSize = std::max(props.getWidth(), std::max(props.getHeight(), props.getDepth()));
+			if (entry.screenSize > 0.0f)
+			{
+				float texelsPerPixel = maxSize / entry.screenSize;
+				UINT32 mip = texelsPerPixel > 1.0f ? (UINT32)Math::floorToInt(Math::log2(texelsPerPixel)) : 0;
+
+				entry.requiredMip = std::min(mip, numStreamedMips);
+			}
+			else
+				entry.requiredMip = numStreamedMips;
+
+			requiredMemory += getMemorySize(props, entry.requiredMip);
+		}
+
+		// Over budget, lower the detail of textures with the most texels per screen pixel first
+		if (requiredMemory > mMemoryBudget)
+		{
+			auto getPriority = [](StreamedTexture& entry)
+			{
+				const TextureProperties& props = entry.texture->getProperties();
+				UINT32 maxSize = std::max(props.getWidth(), std::max(props.getHeight(), props.getDepth()));
+
+				return (maxSize >> entry.requiredMip) / entry.screenSize;
+			};
+
+			using QueueEntry = std::pair<float, StreamedTexture*>;
+			std::priority_queue<QueueEntry, Vector<QueueEntry>> queue;
+
+			for (auto& pair : mTextures)
+			{
+				StreamedTexture& entry = pair.second;
+				if (entry.requiredMip < entry.texture->_getStreamingData()->numStreamedMips)
+					queue.push(std::make_pair(getPriority(entry), &entry));
+			}
+
+			while (requiredMemory > mMemoryBudget && !queue.empty())
+			{
+				StreamedTexture& entry = *queue.top().second;
+				queue.pop();
+
+				const TextureProperties& props = entry.texture->getProperties();
+				requiredMemory -= getMemorySize(props, entry.requiredMip);
+				entry.requiredMip++;
+				requiredMemory += getMemorySize(props, entry.requiredMip);
+
+				if (entry.requiredMip < entry.texture->_getStreamingData()->numStreamedMips)
+					queue.push(std::make_pair(getPriority(entry), &entry));
+			}
+		}
+
+		// Evict mip levels that are no longer needed, and start loading the ones that are
+		UINT32 numPendingLoads;
+		{
+			Lock completedLock(mCompletedMutex);
+			numPendingLoads = (UINT32)mPendingLoads.size() + mNumPendingReads;
+		}
+
+		mResidentMemory = 0;
+		for (auto& pair : mTextures)
+		{
+			StreamedTexture& entry = pair.second;
+			if (!entry.loadPending)
+			{
+				UINT32 residentMip = entry.texture->_getResidentMip();
+				if (entry.requiredMip > residentMip)
+					setResidentMip(entry, entry.requiredMip, {});
+				else if (entry.requiredMip < residentMip && numPendingLoads < MAX_PENDING_LOADS)
+				{
+					startLoad(pair.first, entry);
+					numPendingLoads++;
+				}
+			}
+
+			mResidentMemory += getMemorySize(entry.texture->getProperties(), entry.texture->_getResidentMip());
+		}
+	}
+
+	UINT64 TextureStreamer::getMemorySize(const TextureProperties& props, UINT32 firstMip)
+	{
+		UINT64 size = 0;
+		for (UINT32 i = firstMip; i <= props.getNumMipmaps(); i++)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), props.getDepth(), i, width, height, depth);
+
+			size += PixelUtil::getMemorySize(width, height, depth, props.getFormat());
+		}
+
+		return size * props.getNumFaces();
+	}
+
+	void TextureStreamer::startLoad(UINT32 id, StreamedTexture& entry)
+	{
+		entry.loadPending = true;
+
+		SPtr<TextureStreamingData> streamingData = entry.texture->_getStreamingData();
+		UINT32 previousMip = entry.texture->_getResidentMip();
+		UINT32 mip = entry.requiredMip;
+
+		auto queueLoad = [this](const SPtr<Task>& task)
+		{
+			{
+				Lock lock(mCompletedMutex);
+				mPendingLoads.push_back(task);
+			}
+
+			TaskScheduler::instance().addTask(task);
+		};
+
+		auto completeLoad = [this, id, previousMip, mip](Vector<SPtr<PixelData>> mipData)
+		{
+			CompletedLoad load;
+			load.id = id;
+			load.previousMip = previousMip;
+			load.mip = mip;
+			load.mipData = std::move(mipData);
+
+			Lock lock(mCompletedMutex);
+			mCompletedLoads.push_back(std::move(load));
+		};
+
+		// Read the data without occupying a worker while waiting on the disk, if possible
+		if (AsyncFileIO::isStarted() && !streamingData->path.isEmpty())
+		{
+			UINT64 start = streamingData->getMipOffset(mip);
+
+			ASYNC_READ_DESC readDesc;
+			readDesc.path = streamingData->path;
+			readDesc.offset = streamingData->offset + start;
+			readDesc.size = streamingData->getMipOffset(previousMip) - start;
+			readDesc.callback = [this, streamingData, previousMip, mip, queueLoad, completeLoad]
+				(const SPtr<MemoryDataStream>& data)
+			{
+				// Splitting and converting the data is done on a worker, as the I/O thread shouldn't perform heavy work
+				auto decodeMips = [streamingData, previousMip, mip, completeLoad, data]()
+				{
+					if (data != nullptr)
+						completeLoad(streamingData->decodeMips(data->getPtr(), mip, previousMip));
+					else
+						completeLoad({});
+				};
+
+				queueLoad(Task::create("Texture streaming", decodeMips, TaskPriority::Low));
+
+				{
+					Lock lock(mCompletedMutex);
+					mNumPendingReads--;
+				}
+
+				mPendingReadsSignal.notify_all();
+			};
+
+			{
+				Lock lock(mCompletedMutex);
+				mNumPendingReads++;
+			}
+
+			AsyncFileIO::instance().read(readDesc);
+		}
+		else
+		{
+			auto readMips = [streamingData, previousMip, mip, completeLoad]()
+			{
+				completeLoad(streamingData->readMips(mip, previousMip));
+			};
+
+			queueLoad(Task::create("Texture streaming", readMips, TaskPriority::Low));
+		}
+	}
+}
@@ -0,0 +1,216 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Image/BsTexture.h"
+#include "Utility/BsEvent.h"
+#include "Utility/BsUUID.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Source of the high detail mip levels of a streamed texture. Mip levels are stored consecutively in mip-major order
+	 * (all faces of mip 0, followed by all faces of mip 1, etc.).
+	 *
+	 * The data is normally read on demand from the file the texture was loaded from. It is only kept in memory if the
+	 * file cannot be read directly, e.g. because its contents are compressed.
+	 *
+	 * @note	Thread safe.
+	 */
+	struct BS_CORE_EXPORT TextureStreamingData
+	{
+		/** File containing the mip level data. Empty if the data is held by @p stream instead. */
+		Path path;
+
+		/** In-memory copy of the mip level data, used if the data cannot be read from @p path. */
+		SPtr<DataStream> stream;
+
+		/** Offset in the file or stream at which the data of the first mip level starts. */
+		UINT64 offset = 0;
+
+		/** Number of mip levels (starting at the most detailed one) stored in the stream. */
+		UINT32 numStreamedMips = 0;
+
+		/** Format the pixels are stored in. Can differ from the texture format if the format isn't natively supported. */
+		PixelFormat storedFormat = PF_UNKNOWN;
+
+		/** Description of the texture with all mip levels resident. */
+		TEXTURE_DESC desc;
+
+		/** Returns true if the mip level data has a source it can be read from. */
+		bool hasSource() const { return !path.isEmpty() || stream != nullptr; }
+
+		/** Returns the offset of the data of the specified mip level, relative to @p offset. */
+		UINT64 getMipOffset(UINT32 mipLevel) const;
+
+		/** Reads the contents of the specified face and mip level, converted to the format of the texture. */
+		SPtr<PixelData> readMip(UINT32 face, UINT32 mipLevel);
+
+		/**
+		 * Reads the contents of all faces of mip levels in range [@p firstMip, @p lastMip), converted to the format of
+		 * the texture. Returns the data in mip-major order, or an empty array if the read failed.
+		 */
+		Vector<SPtr<PixelData>> readMips(UINT32 firstMip, UINT32 lastMip);
+
+		/**
+		 * Splits raw data of all faces of mip levels in range [@p firstMip, @p lastMip), as stored starting at
+		 * getMipOffset(@p firstMip), into separate pixel data objects converted to the format of the texture.
+		 */
+		Vector<SPtr<PixelData>> decodeMips(const UINT8* data, UINT32 firstMip, UINT32 lastMip) const;
+
+	private:
+		/** Reads @p size bytes starting at @p start (relative to @p offset) into @p output. */
+		bool read(UINT64 start, UINT8* output, UINT64 size);
+
+		Mutex mMutex;
+	};
+
+	/**
+	 * Keeps only the mip levels of streamed textures that are required for rendering resident on the GPU.
+	 *
+	 * Streamed textures are loaded with only their low detail mip levels. The renderer reports the size at which each
+	 * texture is displayed on screen, from which the streamer determines the mip level each texture requires. It then
+	 * evicts mip levels that are no longer needed and reads the needed ones in the background (using AsyncFileIO, if
+	 * started), while keeping the total GPU memory used by streamed textures within a memory budget. When the budget
+	 * would be exceeded, textures with the most texels per screen pixel are reduced in detail first.
+	 *
+	 * @note	Sim thread unless noted otherwise.
+	 */
+	class BS_CORE_EXPORT TextureStreamer : public Module<TextureStreamer>
+	{
+		/** Information about a texture registered with the streamer. */
+		struct StreamedTexture
+		{
+			Texture* texture = nullptr;
+			UUID uuid;
+			float screenSize = 0.0f;
+			UINT64 lastUsedFrame = 0;
+			UINT32 requiredMip = 0;
+			bool loadPending = false;
+		};
+
+		/** Mip levels read in the background, waiting to be applied on the sim thread. */
+		struct CompletedLoad
+		{
+			UINT32 id = 0;
+			UINT32 previousMip = 0;
+			UINT32 mip = 0;
+			Vector<SPtr<PixelData>> mipData;
+		};
+
+	public:
+		/**
+		 * Size of the largest mip level that always remains resident, in pixels. Only larger mip levels are streamed.
+		 */
+		static constexpr UINT32 MIN_RESIDENT_SIZE = 64;
+
+		/** Default memory budget for streamed textures, in bytes. */
+		static constexpr UINT64 DEFAULT_MEMORY_BUDGET = 512 * 1024 * 1024;
+
+		/** Maximum number of textures that can be read in the background at once. */
+		static constexpr UINT32 MAX_PENDING_LOADS = 4;
+
+		/** Number of frames a texture must remain unseen before its streamed mip levels are evicted. */
+		static constexpr UINT32 EVICTION_DELAY = 60;
+
+		TextureStreamer();
+		~TextureStreamer();
+
+		/**
+		 * Sets the maximum amount of GPU memory streamed textures are allowed to use, in bytes. Mip levels that always
+		 * remain resident count towards the budget as well.
+		 */
+		void setMemoryBudget(UINT64 budget) { mMemoryBudget = budget; }
+
+		/** @copydoc setMemoryBudget */
+		UINT64 getMemoryBudget() const { return mMemoryBudget; }
+
+		/** Returns the amount of GPU memory currently used by streamed textures, in bytes. */
+		UINT64 getResidentMemory() const { return mResidentMemory; }
+
+		/**
+		 * Returns the number of textures registered with the streamer.
+		 *
+		 * @note	Thread safe.
+		 */
+		UINT32 getNumTextures() const { return mNumTextures.load(std::memory_order_relaxed); }
+
+		/**
+		 * Returns the number of mip levels that would be streamed for a texture with the provided properties, or zero if
+		 * the texture cannot be streamed.
+		 */
+		static UINT32 getNumStreamableMips(const TextureProperties& props);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Reports the size at which textures were displayed on screen this frame. Sizes are provided in pixels, for the
+		 * largest dimension of the most detailed mip level. Textures that aren't streamed are ignored.
+		 *
+		 * @note	Thread safe.
+		 */
+		void _notifyTextureUsage(const UnorderedMap<const ct::Texture*, float>& screenSizes);
+
+		/**
+		 * Registers a texture with streaming data so its residency can be managed.
+		 *
+		 * @note	Thread safe.
+		 */
+		void _registerTexture(Texture* texture);
+
+		/**
+		 * Unregisters a texture previously registered with _registerTexture().
+		 *
+		 * @note	Thread safe.
+		 */
+		void _unregisterTexture(Texture* texture);
+
+		/** Updates residency of all registered textures. Should be called once per frame. */
+		void _update();
+
+		/** @} */
+
+	private:
+		/** Returns the amount of GPU memory used by a texture when mip levels starting with @p firstMip are resident. */
+		static UINT64 getMemorySize(const TextureProperties& props, UINT32 firstMip);
+
+		/** Changes the resident mip level of a texture and notifies any listeners of the texture. */
+		void setResidentMip(StreamedTexture& entry, UINT32 mipLevel, const Vector<SPtr<PixelData>>& mipData);
+
+		/** Triggered when a resource finishes loading. Used for retrieving UUIDs of registered textures. */
+		void onResourceLoaded(const HResource& resource);
+
+		/** Starts reading the mip levels the texture requires in the background. */
+		void startLoad(UINT32 id, StreamedTexture& entry);
+
+		UnorderedMap<UINT32, StreamedTexture> mTextures;
+		std::atomic<UINT32> mNumTextures{0};
+		UINT32 mNextId = 1;
+		Mutex mMutex;
+
+		UnorderedMap<const ct::Texture*, float> mUsage;
+		Mutex mUsageMutex;
+
+		Vector<CompletedLoad> mCompletedLoads;
+		Vector<SPtr<Task>> mPendingLoads;
+		UINT32 mNumPendingReads = 0;
+		Mutex mCompletedMutex;
+		Signal mPendingReadsSignal;
+
+		UINT64 mMemoryBudget = DEFAULT_MEMORY_BUDGET;
+		UINT64 mResidentMemory = 0;
+		UINT64 mFrameIdx = 0;
+
+		HEvent mResourceLoadedConn;
+	};
+
+	/** @} */
+}
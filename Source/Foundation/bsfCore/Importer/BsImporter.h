@@ -6,6 +6,7 @@
 #include "Utility/BsModule.h"
 #include "Importer/BsSpecificImporter.h"
 #include "Threading/BsAsyncOp.h"
+#include "Utility/BsEvent.h"
 
 namespace bs
 {
@@ -109,6 +110,14 @@ namespace bs
 			return std::static_pointer_cast<T>(createImportOptions(inputFilePath));
 		}
 
+		/**
+		 * Triggered periodically during import of a file, reporting the path of the file and the portion of the import 
+		 * that has completed, in [0, 1] range. Only reported by importers that perform lengthy processing.
+		 *
+		 * @note	It is undefined from which thread this will get called from.
+		 */
+		Event<void(const Path&, float)> onImportProgress;
+
 		/**
 		 * Checks if we can import a file with the specified extension.
 		 *
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Importer/BsImportOptions.h"
 #include "Animation/BsAnimationClip.h"
+#include "Renderer/BsRendererMeshData.h"
 
 namespace bs
 {
@@ -121,6 +122,15 @@ namespace bs
 		/**	Retrieves a value that controls what type (if any) of collision mesh should be imported. */
 		CollisionMeshType getCollisionMeshType() const { return mCollisionMeshType; }
 
+		/**	
+		 * Sets which vertex attributes of the imported mesh should be stored in compressed form. Compressed attributes
+		 * use less memory and bandwidth during rendering, at the cost of precision.
+		 */
+		void setVertexCompression(VertexCompression compression) { mVertexCompression = compression; }
+
+		/**	Retrieves which vertex attributes of the imported mesh should be stored in compressed form. */
+		VertexCompression getVertexCompression() const { return mVertexCompression; }
+
 		/** 
 		 * Registers animation split infos that determine how will the source animation clip be split. If no splits
 		 * are present the data will be imported as one clip, but if splits are present the data will be split according
@@ -179,6 +189,7 @@ namespace bs
 		bool mImportRootMotion;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
+		VertexCompression mVertexCompression;
 		Vector<AnimationSplitInfo> mAnimationSplits;
 		Vector<ImportedAnimationEvents> mAnimationEvents;
 
@@ -81,6 +81,15 @@ namespace bs
 		 */
 		CubemapSourceType getCubemapSourceType() const { return mCubemapSourceType; }
 
+		/**
+		 * Determines should the most detailed mip levels of the texture be streamed in on demand, rather than being
+		 * loaded together with the texture. Only relevant when mipmaps are generated and CPU caching is disabled.
+		 */
+		void setStreaming(bool streaming) { mStreaming = streaming; }
+
+		/** Checks should the most detailed mip levels of the texture be streamed in on demand. */
+		bool getStreaming() const { return mStreaming; }
+
 		/** Creates a new import options object that allows you to customize how are textures imported. */
 		static SPtr<TextureImportOptions> create();
 
@@ -100,6 +109,7 @@ namespace bs
 		bool mSRGB;
 		bool mCubemap;
 		CubemapSourceType mCubemapSourceType;
+		bool mStreaming;
 	};
 
 	/** @} */
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Managers/BsGpuProgramManager.h"
 #include "RenderAPI/BsRenderAPI.h"
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
 
 namespace bs
 {
@@ -145,8 +146,43 @@ namespace bs
 
 	SPtr<GpuProgramBytecode> GpuProgramManager::compileBytecode(const GPU_PROGRAM_DESC& desc)
 	{
-		GpuProgramFactory* factory = getFactory(desc.language);
-		return factory->compileBytecode(desc);
+		return compileBytecode(desc, getBytecodeCache());
+	}
+
+	SPtr<GpuProgramBytecode> GpuProgramManager::compileBytecode(const GPU_PROGRAM_DESC& desc,
+		const SPtr<GpuProgramBytecodeCache>& cache)
+	{
+		GpuProgramFactory* factory;
+		{
+			Lock lock(mMutex);
+			factory = getFactory(desc.language);
+		}
+
+		// Null factory doesn't produce any bytecode worth caching
+		if(cache == nullptr || factory == mNullFactory)
+			return factory->compileBytecode(desc);
+
+		String key = GpuProgramBytecodeCache::getKey(desc, factory->getCompilerVersion());
+		SPtr<GpuProgramBytecode> bytecode = cache->load(key);
+		if(bytecode != nullptr)
+			return bytecode;
+
+		bytecode = factory->compileBytecode(desc);
+		cache->save(key, bytecode);
+
+		return bytecode;
+	}
+
+	void GpuProgramManager::setBytecodeCache(const SPtr<GpuProgramBytecodeCache>& cache)
+	{
+		Lock lock(mMutex);
+		mBytecodeCache = cache;
+	}
+
+	SPtr<GpuProgramBytecodeCache> GpuProgramManager::getBytecodeCache() const
+	{
+		Lock lock(mMutex);
+		return mBytecodeCache;
 	}
 	}
 }
@@ -49,6 +49,12 @@ namespace bs
 
 		/** @copydoc GpuProgram::compileBytecode */
 		virtual SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) = 0;
+
+		/** 
+		 * Returns a string identifying the version of the compiler used by compileBytecode(). Bytecode produced by 
+		 * different compiler versions is never shared through the bytecode cache.
+		 */
+		virtual String getCompilerVersion() const { return ""; }
 	};
 
 	/**
@@ -81,9 +87,32 @@ namespace bs
 		/** @copydoc GpuProgram::create */
 		SPtr<GpuProgram> create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
-		/** @copydoc GpuProgram::compileBytecode */
+		/** 
+		 * @copydoc GpuProgram::compileBytecode 
+		 *
+		 * If a bytecode cache is registered the bytecode will be looked up in the cache first, and any newly compiled
+		 * bytecode will be stored in it. Thread safe.
+		 */
 		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc);
 
+		/** 
+		 * @copydoc GpuProgram::compileBytecode 
+		 *
+		 * Same as compileBytecode(const GPU_PROGRAM_DESC&), except that the bytecode is looked up in and stored in
+		 * @p cache instead of the registered cache. No caching is performed if @p cache is null. Thread safe.
+		 */
+		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc,
+			const SPtr<GpuProgramBytecodeCache>& cache);
+
+		/** 
+		 * Registers a cache that will be used for storing and retrieving compiled GPU program bytecode. Set to null to
+		 * disable caching. Thread safe.
+		 */
+		void setBytecodeCache(const SPtr<GpuProgramBytecodeCache>& cache);
+
+		/** Returns the currently registered bytecode cache, if any. Thread safe. */
+		SPtr<GpuProgramBytecodeCache> getBytecodeCache() const;
+
 	protected:
 		friend class bs::GpuProgram;
 
@@ -98,10 +127,11 @@ namespace bs
 		GpuProgramFactory* getFactory(const String& language);
 
 	protected:
-		Mutex mMutex;
+		mutable Mutex mMutex;
 
 		UnorderedMap<String, GpuProgramFactory*> mFactories;
 		GpuProgramFactory* mNullFactory; /**< Factory for dealing with GPU programs that can't be created. */
+		SPtr<GpuProgramBytecodeCache> mBytecodeCache;
 	};
 	}
 	/** @} */
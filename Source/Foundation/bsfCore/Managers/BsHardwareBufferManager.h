@@ -130,6 +130,12 @@ namespace bs
 		/** @copydoc GpuParams::create(const SPtr<GpuPipelineParamInfo>&, GpuDeviceFlags) */
 		SPtr<GpuParams> createGpuParams(const SPtr<GpuPipelineParamInfo>& paramInfo,
 											GpuDeviceFlags deviceMask = GDF_DEFAULT);
+
+		/**
+		 * Called once per frame, after all rendering commands for the frame have been submitted. Allows implementations
+		 * to recycle memory used by per-frame (transient) buffers.
+		 */
+		virtual void _endFrame() { }
 	protected:
 		friend class bs::IndexBuffer;
 		friend class IndexBuffer;
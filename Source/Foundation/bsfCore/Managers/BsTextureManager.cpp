@@ -147,6 +147,15 @@ namespace bs
 		return newTex;
 	}
 
+	SPtr<Texture> TextureManager::createAliasedTexture(const TEXTURE_DESC& desc, const SPtr<Texture>& memorySource,
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<Texture> newTex = createAliasedTextureInternal(desc, memorySource, deviceMask);
+		newTex->initialize();
+
+		return newTex;
+	}
+
 	SPtr<RenderTexture> TextureManager::createRenderTexture(const RENDER_TEXTURE_DESC& desc, 
 																	UINT32 deviceIdx)
 	{
@@ -103,6 +103,10 @@ namespace bs
 		 */
 		SPtr<Texture> createTexture(const TEXTURE_DESC& desc, GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
+		/** @copydoc Texture::createAliased */
+		SPtr<Texture> createAliasedTexture(const TEXTURE_DESC& desc, const SPtr<Texture>& memorySource,
+			GpuDeviceFlags deviceMask = GDF_DEFAULT);
+
 		/**
 		 * @copydoc bs::TextureManager::createRenderTexture(const RENDER_TEXTURE_DESC&) 
 		 * @param[in]	deviceIdx		Index of the GPU device to create the object on.
@@ -121,6 +125,16 @@ namespace bs
 		virtual SPtr<Texture> createTextureInternal(const TEXTURE_DESC& desc, 
 			const SPtr<PixelData>& initialData = nullptr, GpuDeviceFlags deviceMask = GDF_DEFAULT) = 0;
 
+		/**
+		 * Creates an empty and uninitialized texture that shares memory with @p memorySource. Render systems that support
+		 * memory aliasing should override this, by default a texture with its own memory is created.
+		 */
+		virtual SPtr<Texture> createAliasedTextureInternal(const TEXTURE_DESC& desc, const SPtr<Texture>& memorySource,
+			GpuDeviceFlags deviceMask = GDF_DEFAULT)
+		{
+			return createTextureInternal(desc, nullptr, deviceMask);
+		}
+
 		/** @copydoc createRenderTexture */
 		virtual SPtr<RenderTexture> createRenderTextureInternal(const RENDER_TEXTURE_DESC& desc, 
 			UINT32 deviceIdx = 0) = 0;
@@ -0,0 +1,124 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Material/BsShaderPrecompiler.h"
+#include "Material/BsShader.h"
+#include "Material/BsTechnique.h"
+#include "Material/BsPass.h"
+#include "Managers/BsGpuProgramManager.h"
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
+#include "Resources/BsResources.h"
+#include "Reflection/BsRTTIType.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	SHADER_PRECOMPILE_RESULT ShaderPrecompiler::precompile(const Vector<HShader>& shaders, 
+		const SPtr<ct::GpuProgramBytecodeCache>& cache)
+	{
+		SHADER_PRECOMPILE_RESULT output;
+
+		ct::GpuProgramManager& gpm = ct::GpuProgramManager::instance();
+
+		// Find all unique programs. Different variations often end up with the same source for some program types.
+		UnorderedMap<String, GPU_PROGRAM_DESC> programs;
+		for (auto& shader : shaders)
+		{
+			if (!shader.isLoaded())
+				continue;
+
+			for (auto& technique : shader->getCompatibleTechniques())
+			{
+				UINT32 numPasses = technique->getNumPasses();
+				for (UINT32 i = 0; i < numPasses; i++)
+				{
+					SPtr<Pass> pass = technique->getPass(i);
+
+					for (UINT32 j = 0; j < GPT_COUNT; j++)
+					{
+						const GPU_PROGRAM_DESC& desc = pass->getProgramDesc((GpuProgramType)j);
+						if (desc.source.empty() || !gpm.isLanguageSupported(desc.language))
+							continue;
+
+						// Key is only used for finding duplicates, so the compiler version can be ignored
+						String key = ct::GpuProgramBytecodeCache::getKey(desc, "");
+						if (programs.find(key) != programs.end())
+							continue;
+
+						GPU_PROGRAM_DESC programDesc = desc;
+						programDesc.bytecode = nullptr;
+
+						programs[key] = programDesc;
+					}
+				}
+			}
+		}
+
+		output.numPrograms = (UINT32)programs.size();
+
+		Timer timer;
+
+		// Each program is stored in the cache as soon as it is compiled
+		std::atomic<UINT32> numFailed{0};
+		Vector<SPtr<Task>> tasks;
+		tasks.reserve(programs.size());
+
+		for (auto& entry : programs)
+		{
+			const GPU_PROGRAM_DESC& desc = entry.second;
+			auto compileWorker = [&gpm, &desc, &cache, &numFailed]()
+			{
+				SPtr<GpuProgramBytecode> bytecode = gpm.compileBytecode(desc, cache);
+				if (bytecode == nullptr || bytecode->instructions.data == nullptr)
+				{
+					numFailed++;
+
+					if (bytecode != nullptr)
+						LOGERR("Failed to precompile GPU program: " + bytecode->messages);
+				}
+			};
+
+			SPtr<Task> task = Task::create("ShaderPrecompile", compileWorker);
+			TaskScheduler::instance().addTask(task);
+
+			tasks.push_back(task);
+		}
+
+		for (auto& task : tasks)
+			task->wait();
+
+		output.numFailed = numFailed;
+		output.time = timer.getMicroseconds();
+
+		return output;
+	}
+
+	SHADER_PRECOMPILE_RESULT ShaderPrecompiler::precompile(const Vector<Path>& shaderPaths, 
+		const SPtr<ct::GpuProgramBytecodeCache>& cache)
+	{
+		Vector<HShader> shaders;
+		for (auto& path : shaderPaths)
+		{
+			HResource resource = gResources().load(path, ResourceLoadFlag::KeepSourceData);
+			if (!resource.isLoaded())
+			{
+				LOGWRN("Unable to load shader for precompilation: " + path.toString());
+				continue;
+			}
+
+			// Paths might come from scanning an asset folder, so other resource types are skipped
+			if (resource->getRTTI()->getRTTIId() == TID_Shader)
+				shaders.push_back(static_resource_cast<Shader>(resource));
+			else
+				gResources().release(resource);
+		}
+
+		SHADER_PRECOMPILE_RESULT output = precompile(shaders, cache);
+
+		for (auto& shader : shaders)
+			gResources().release(shader);
+
+		return output;
+	}
+}
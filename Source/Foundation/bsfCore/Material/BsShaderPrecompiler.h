@@ -0,0 +1,52 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Material-Internal
+	 *  @{
+	 */
+
+	/** Contains information about the results of a ShaderPrecompiler run. */
+	struct SHADER_PRECOMPILE_RESULT
+	{
+		UINT32 numPrograms = 0; /**< Total number of unique GPU programs found in the provided shaders. */
+		UINT32 numFailed = 0; /**< Number of GPU programs that failed to compile. */
+		UINT64 time = 0; /**< Total time it took to compile all programs, in microseconds. */
+	};
+
+	/**
+	 * Compiles bytecode for all GPU programs in a set of shaders, including all of their variations, so it can be stored
+	 * in the bytecode cache. This is intended to be ran from a batch tool before shipping, so shaders never need to be
+	 * compiled at load time.
+	 *
+	 * Only programs in languages supported by the active render backend are compiled. Programs are compiled in parallel
+	 * using the TaskScheduler.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_CORE_EXPORT ShaderPrecompiler
+	{
+	public:
+		/**
+		 * Compiles all programs in the provided shaders and stores their bytecode in @p cache. Programs whose bytecode
+		 * already exists in the cache are skipped. Blocks until all programs are compiled.
+		 */
+		static SHADER_PRECOMPILE_RESULT precompile(const Vector<HShader>& shaders, 
+			const SPtr<ct::GpuProgramBytecodeCache>& cache);
+
+		/**
+		 * Loads the shader assets at the provided paths and compiles all of their programs. Paths referring to other
+		 * types of resources are ignored.
+		 *
+		 * @see	precompile(const Vector<HShader>&, const SPtr<ct::GpuProgramBytecodeCache>&)
+		 */
+		static SHADER_PRECOMPILE_RESULT precompile(const Vector<Path>& shaderPaths, 
+			const SPtr<ct::GpuProgramBytecodeCache>& cache);
+	};
+
+	/** @} */
+}
@@ -87,6 +87,7 @@ namespace bs
 	{
 		SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(mProperties.mNumVertices, mProperties.mNumIndices,
 			mVertexDesc, mIndexType);
+		meshData->setQuantizationBounds(mProperties.mQuantizationBounds);
 
 		return meshData;
 	}
@@ -105,6 +106,7 @@ namespace bs
 	void Mesh::updateBounds(const MeshData& meshData)
 	{
 		mProperties.mBounds = meshData.calculateBounds();
+		mProperties.mQuantizationBounds = meshData.getQuantizationBounds();
 		markCoreDirty();
 	}
 
@@ -163,6 +165,7 @@ namespace bs
 		UINT8* src = pixelData.getData();
 
 		memcpy(dest, src, pixelData.getSize());
+		mCPUData->setQuantizationBounds(pixelData.getQuantizationBounds());
 	}
 
 	void Mesh::readCachedData(MeshData& dest)
@@ -189,6 +192,7 @@ namespace bs
 		UINT8* destPtr = dest.getData();
 
 		memcpy(destPtr, srcPtr, dest.getSize());
+		dest.setQuantizationBounds(mCPUData->getQuantizationBounds());
 	}
 
 	void Mesh::createCPUBuffer()
@@ -576,6 +580,7 @@ namespace bs
 	void Mesh::updateBounds(const MeshData& meshData)
 	{
 		mProperties.mBounds = meshData.calculateBounds();
+		mProperties.mQuantizationBounds = meshData.getQuantizationBounds();
 
 		// TODO - Sync this to sim-thread possibly?
 	}
@@ -53,10 +53,11 @@ namespace bs
 
 	CoreSyncData MeshBase::syncToCore(FrameAlloc* allocator)
 	{
-		UINT32 size = sizeof(Bounds);
+		UINT32 size = sizeof(Bounds) + sizeof(AABox);
 		UINT8* buffer = allocator->alloc(size);
 
-		memcpy(buffer, &mProperties.mBounds, size);
+		memcpy(buffer, &mProperties.mBounds, sizeof(Bounds));
+		memcpy(buffer + sizeof(Bounds), &mProperties.mQuantizationBounds, sizeof(AABox));
 		return CoreSyncData(buffer, size);
 	}
 
@@ -87,7 +88,8 @@ namespace bs
 
 	void MeshBase::syncToCore(const CoreSyncData& data)
 	{
-		mProperties.mBounds = data.getData<Bounds>();
+		memcpy(&mProperties.mBounds, data.getBuffer(), sizeof(Bounds));
+		memcpy(&mProperties.mQuantizationBounds, data.getBuffer() + sizeof(Bounds), sizeof(AABox));
 	}
 	}
 }
\ No newline at end of file
@@ -57,6 +57,12 @@ namespace bs
 		/**	Returns bounds of the geometry contained in the vertex buffers for all sub-meshes. */
 		const Bounds& getBounds() const { return mBounds; }
 
+		/** 
+		 * Returns the bounds quantized vertex positions are relative to. Only relevant if the mesh stores its positions in
+		 * quantized form. See MeshData::setQuantizationBounds().
+		 */
+		const AABox& getQuantizationBounds() const { return mQuantizationBounds; }
+
 	protected:
 		friend class MeshBase;
 		friend class ct::MeshBase;
@@ -70,6 +76,7 @@ namespace bs
 		UINT32 mNumVertices;
 		UINT32 mNumIndices;
 		Bounds mBounds;
+		AABox mQuantizationBounds;
 	};
 
 	/** @} */
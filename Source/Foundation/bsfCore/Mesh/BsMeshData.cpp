@@ -359,22 +359,39 @@ namespace bs
 		{
 			const VertexElement& curElement = vertexDesc->getElement(i);
 
-			if (curElement.getSemantic() != VES_POSITION || (curElement.getType() != VET_FLOAT3 && curElement.getType() != VET_FLOAT4))
+			if (curElement.getSemantic() != VES_POSITION)
+				continue;
+
+			VertexElementType type = curElement.getType();
+			if (type != VET_FLOAT3 && type != VET_FLOAT4 && type != VET_USHORT4_NORM)
 				continue;
 
 			UINT8* data = getElementData(curElement.getSemantic(), curElement.getSemanticIdx(), curElement.getStreamIdx());
 			UINT32 stride = vertexDesc->getVertexStride(curElement.getStreamIdx());
 
+			auto readPosition = [this, type, data, stride](UINT32 idx)
+			{
+				if (type == VET_USHORT4_NORM)
+				{
+					UINT16* quantized = (UINT16*)(data + stride * idx);
+					Vector3 normalized(quantized[0] / 65535.0f, quantized[1] / 65535.0f, quantized[2] / 65535.0f);
+
+					return mQuantizationBounds.getMin() + normalized * mQuantizationBounds.getSize();
+				}
+
+				return *(Vector3*)(data + stride * idx);
+			};
+
 			if (getNumVertices() > 0)
 			{
-				Vector3 curPosition = *(Vector3*)data;
+				Vector3 curPosition = readPosition(0);
 				Vector3 accum = curPosition;
 				Vector3 min = curPosition;
 				Vector3 max = curPosition;
 
 				for (UINT32 i = 1; i < getNumVertices(); i++)
 				{
-					curPosition = *(Vector3*)(data + stride * i);
+					curPosition = readPosition(i);
 					accum += curPosition;
 					min = Vector3::min(min, curPosition);
 					max = Vector3::max(max, curPosition);
@@ -385,7 +402,7 @@ namespace bs
 
 				for (UINT32 i = 0; i < getNumVertices(); i++)
 				{
-					curPosition = *(Vector3*)(data + stride * i);
+					curPosition = readPosition(i);
 					float dist = center.squaredDistance(curPosition);
 
 					if (dist > radiusSqrd)
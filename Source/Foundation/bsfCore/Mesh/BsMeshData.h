@@ -211,6 +211,15 @@ namespace bs
 		/**	Return the size (in bytes) of the entire buffer. */
 		UINT32 getSize() const { return getInternalBufferSize(); }
 
+		/**
+		 * Sets the bounds quantized vertex positions are relative to. Only relevant if positions are stored as
+		 * VET_USHORT4_NORM, in which case each position is stored normalized to the [0, 1] range within the bounds.
+		 */
+		void setQuantizationBounds(const AABox& bounds) { mQuantizationBounds = bounds; }
+
+		/** @copydoc setQuantizationBounds */
+		const AABox& getQuantizationBounds() const { return mQuantizationBounds; }
+
 		/**	Calculates the bounds of all vertices stored in the internal buffer. */
 		Bounds calculateBounds() const;
 
@@ -225,6 +234,8 @@ namespace bs
 		 *								the newly created MeshData.
 		 * @return						Combined mesh data containing all vertices and indexes references by the provided 
 		 *								sub-meshes.
+		 *
+		 * @note	Quantized positions are not supported, as each of the elements has its own quantization bounds.
 		 */
 		static SPtr<MeshData> combine(const Vector<SPtr<MeshData>>& elements, const Vector<Vector<SubMesh>>& allSubMeshes,
 			Vector<SubMesh>& subMeshes);
@@ -288,6 +299,7 @@ namespace bs
 		UINT32 mNumVertices;
 		UINT32 mNumIndices;
 		IndexType mIndexType;
+		AABox mQuantizationBounds;
 
 		SPtr<VertexDataDesc> mVertexData;
 
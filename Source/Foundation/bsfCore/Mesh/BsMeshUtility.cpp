@@ -5,6 +5,7 @@
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
 #include "Math/BsPlane.h"
+#include "Math/BsAABox.h"
 
 namespace bs
 {
@@ -938,4 +939,51 @@ namespace bs
 			ptr += stride;
 		}
 	}
-}
\ No newline at end of file
+
+	void MeshUtility::quantizePositions(Vector3* source, UINT8* destination, UINT32 count, UINT32 inStride, 
+		UINT32 outStride, const AABox& bounds)
+	{
+		Vector3 min = bounds.getMin();
+		Vector3 size = bounds.getSize();
+
+		// Avoid division by zero for flat meshes
+		Vector3 invSize;
+		invSize.x = size.x > 0.0f ? 1.0f / size.x : 0.0f;
+		invSize.y = size.y > 0.0f ? 1.0f / size.y : 0.0f;
+		invSize.z = size.z > 0.0f ? 1.0f / size.z : 0.0f;
+
+		UINT8* srcPtr = (UINT8*)source;
+		UINT8* dstPtr = destination;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			Vector3 normalized = (*(Vector3*)srcPtr - min) * invSize;
+			UINT16* quantized = (UINT16*)dstPtr;
+
+			quantized[0] = (UINT16)Math::clamp(Math::roundToInt(normalized.x * 65535.0f), 0, 65535);
+			quantized[1] = (UINT16)Math::clamp(Math::roundToInt(normalized.y * 65535.0f), 0, 65535);
+			quantized[2] = (UINT16)Math::clamp(Math::roundToInt(normalized.z * 65535.0f), 0, 65535);
+			quantized[3] = 65535;
+
+			srcPtr += inStride;
+			dstPtr += outStride;
+		}
+	}
+
+	void MeshUtility::dequantizePositions(UINT8* source, Vector3* destination, UINT32 count, UINT32 stride, 
+		const AABox& bounds)
+	{
+		Vector3 min = bounds.getMin();
+		Vector3 size = bounds.getSize();
+
+		UINT8* ptr = source;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			UINT16* quantized = (UINT16*)ptr;
+			Vector3 normalized(quantized[0] / 65535.0f, quantized[1] / 65535.0f, quantized[2] / 65535.0f);
+
+			destination[i] = min + normalized * size;
+
+			ptr += stride;
+		}
+	}
+}
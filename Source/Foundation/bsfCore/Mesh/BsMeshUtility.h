@@ -177,6 +177,31 @@ namespace bs
 		 * @param[in]	stride			Distance between two entries in the @p source buffer, in bytes.
 		 */
 		static void unpackNormals(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride);
+
+		/** 
+		 * Encodes positions from 32-bit float format into 4D 16-bit normalized format, relative to the provided bounds.
+		 *
+		 * @param[in]	source			Buffer containing data to encode. Must have @p count entries.
+		 * @param[out]	destination		Buffer to output the data to. Must have @p count entries, each 64-bits.
+		 * @param[in]	count			Number of entries in the @p source and @p destination arrays.
+		 * @param[in]	inStride		Distance between two entries in the @p source buffer, in bytes.
+		 * @param[in]	outStride		Distance between two entries in the @p destination buffer, in bytes.
+		 * @param[in]	bounds			Bounds encompassing all the positions.
+		 */
+		static void quantizePositions(Vector3* source, UINT8* destination, UINT32 count, UINT32 inStride, 
+			UINT32 outStride, const AABox& bounds);
+
+		/** 
+		 * Decodes positions from 4D 16-bit normalized format into a 32-bit float format.
+		 *
+		 * @param[in]	source			Buffer containing data to decode. Must have @p count entries, each 64-bits.
+		 * @param[out]	destination		Buffer to output the data to. Must have @p count entries.
+		 * @param[in]	count			Number of entries in the @p source and @p destination arrays.
+		 * @param[in]	stride			Distance between two entries in the @p source buffer, in bytes.
+		 * @param[in]	bounds			Bounds the positions were quantized relative to.
+		 */
+		static void dequantizePositions(UINT8* source, Vector3* destination, UINT32 count, UINT32 stride, 
+			const AABox& bounds);
 	};
 
 	/** @} */
@@ -4,6 +4,11 @@
 #include "Physics/BsRigidbody.h"
 #include "Math/BsRay.h"
 #include "Components/BsCCollider.h"
+#include "Math/BsAABox.h"
+#include "Math/BsSphere.h"
+#include "Math/BsCapsule.h"
+#include "Math/BsLineSegment3.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -45,6 +50,136 @@ namespace bs
 		return rayCastAll(ray.getOrigin(), ray.getDirection(), layer, max);
 	}
 
+	void Physics::queryBatch(const PhysicsBatchQuery* queries, UINT32 numQueries, 
+		Vector<PhysicsBatchQueryHit>& hits) const
+	{
+		// Number of queries performed by a single task. Individual queries are cheap, so they need to be grouped in order
+		// for the task overhead not to dominate.
+		static constexpr UINT32 QUERIES_PER_TASK = 64;
+
+		hits.clear();
+
+		for (UINT32 i = 0; i < numQueries; i++)
+		{
+			if (queries[i].shape == PhysicsQueryShape::Ray && queries[i].type == PhysicsQueryType::Overlap)
+			{
+				LOGERR("Invalid physics batch query at index " + toString(i) + ". Ray queries cannot be used for "
+					"overlap checks. The query will be ignored.");
+			}
+		}
+
+		const auto executeRange = [this, queries](UINT32 start, UINT32 end, Vector<PhysicsBatchQueryHit>& output)
+		{
+			PhysicsBatchQueryHit entry;
+			for (UINT32 i = start; i < end; i++)
+			{
+				if (executeBatchQuery(queries[i], entry.hit))
+				{
+					entry.queryIdx = i;
+					output.push_back(entry);
+
+					entry.hit = PhysicsQueryHit();
+				}
+			}
+		};
+
+		UINT32 numTasks = Math::divideAndRoundUp(numQueries, QUERIES_PER_TASK);
+		if (numTasks <= 1)
+		{
+			executeRange(0, numQueries, hits);
+			return;
+		}
+
+		// Each task outputs to its own buffer, so the results can be merged without synchronization and in order
+		Vector<Vector<PhysicsBatchQueryHit>> taskHits(numTasks);
+		Vector<SPtr<Task>> tasks;
+		tasks.reserve(numTasks - 1);
+
+		for (UINT32 i = 1; i < numTasks; i++)
+		{
+			UINT32 start = i * QUERIES_PER_TASK;
+			UINT32 end = std::min(start + QUERIES_PER_TASK, numQueries);
+
+			Vector<PhysicsBatchQueryHit>& output = taskHits[i];
+			auto queryWorker = [&executeRange, &output, start, end]()
+			{
+				executeRange(start, end, output);
+			};
+
+			SPtr<Task> task = Task::create("PhysicsQuery", queryWorker);
+			TaskScheduler::instance().addTask(task);
+
+			tasks.push_back(task);
+		}
+
+		// Perform the first group of queries on the calling thread while the tasks are running
+		executeRange(0, QUERIES_PER_TASK, taskHits[0]);
+
+		for (auto& task : tasks)
+			task->wait();
+
+		UINT32 numHits = 0;
+		for (auto& entry : taskHits)
+			numHits += (UINT32)entry.size();
+
+		hits.reserve(numHits);
+		for (auto& entry : taskHits)
+			hits.insert(hits.end(), entry.begin(), entry.end());
+	}
+
+	bool Physics::executeBatchQuery(const PhysicsBatchQuery& query, PhysicsQueryHit& hit) const
+	{
+		const Vector3& pos = query.position;
+		const Vector3& extents = query.extents;
+
+		switch (query.shape)
+		{
+		case PhysicsQueryShape::Ray:
+			if (query.type == PhysicsQueryType::Closest)
+				return rayCast(pos, query.unitDir, hit, query.layer, query.max);
+			else if (query.type == PhysicsQueryType::Any)
+				return rayCastAny(pos, query.unitDir, query.layer, query.max);
+
+			return false; // Overlap queries with rays are rejected by queryBatch()
+		case PhysicsQueryShape::Box:
+		{
+			AABox box(pos - extents, pos + extents);
+
+			if (query.type == PhysicsQueryType::Closest)
+				return boxCast(box, query.rotation, query.unitDir, hit, query.layer, query.max);
+			else if (query.type == PhysicsQueryType::Any)
+				return boxCastAny(box, query.rotation, query.unitDir, query.layer, query.max);
+
+			return boxOverlapAny(box, query.rotation, query.layer);
+		}
+		case PhysicsQueryShape::Sphere:
+		{
+			Sphere sphere(pos, extents.x);
+
+			if (query.type == PhysicsQueryType::Closest)
+				return sphereCast(sphere, query.unitDir, hit, query.layer, query.max);
+			else if (query.type == PhysicsQueryType::Any)
+				return sphereCastAny(sphere, query.unitDir, query.layer, query.max);
+
+			return sphereOverlapAny(sphere, query.layer);
+		}
+		case PhysicsQueryShape::Capsule:
+		{
+			Vector3 halfHeight(0.0f, extents.y, 0.0f);
+			Capsule capsule(LineSegment3(pos - halfHeight, pos + halfHeight), extents.x);
+
+			if (query.type == PhysicsQueryType::Closest)
+				return capsuleCast(capsule, query.rotation, query.unitDir, hit, query.layer, query.max);
+			else if (query.type == PhysicsQueryType::Any)
+				return capsuleCastAny(capsule, query.rotation, query.unitDir, query.layer, query.max);
+
+			return capsuleOverlapAny(capsule, query.rotation, query.layer);
+		}
+		}
+
+		return false;
+	}
+
 	bool Physics::rayCastAny(const Ray& ray, UINT64 layer, float max) const
 	{
 		return rayCastAny(ray.getOrigin(), ray.getDirection(), layer, max);
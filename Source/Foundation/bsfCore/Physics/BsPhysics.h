@@ -46,7 +46,15 @@ namespace bs
 		 * Enables continous collision detection. This will prevent fast-moving objects from tunneling through each other.
 		 * You must also enable CCD for individual Rigidbodies. This option can have a significant performance impact.
 		 */
-		CCD_Enable = 1<<3
+		CCD_Enable = 1<<3,
+		/**
+		 * Runs the simulation step asynchronously. The step is started at the end of a fixed update and its results are
+		 * retrieved at the start of the next one, allowing the simulation to run in parallel with the rest of the frame.
+		 * Rigidbody transforms are interpolated between fixed updates so movement remains smooth. This introduces a
+		 * one step delay between changes made to physics objects and their results becoming visible. Scene queries
+		 * are performed against the results of the last finished step.
+		 */
+		AsyncSimulation = 1<<4
 	};
 
 	/** @copydoc CharacterCollisionFlag */
@@ -427,6 +435,27 @@ namespace bs
 		virtual bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const = 0;
 
+		/**
+		 * Performs a batch of queries, executing them in parallel using the task scheduler. This is more efficient than
+		 * performing many individual queries when a large number of queries needs to be performed at once (e.g. line of
+		 * sight checks for many agents).
+		 *
+		 * @param[in]	queries		Array of queries to perform.
+		 * @param[in]	numQueries	Number of entries in the @p queries array.
+		 * @param[out]	hits		Receives an entry for every query that found a hit, in the same order as the queries.
+		 *							Queries that found no hit are not present in the output.
+		 *
+		 * @note	Thread safe, as long as no physics objects are being modified or simulated concurrently.
+		 */
+		virtual void queryBatch(const PhysicsBatchQuery* queries, UINT32 numQueries, 
+			Vector<PhysicsBatchQueryHit>& hits) const;
+
+		/** @copydoc queryBatch(const PhysicsBatchQuery*, UINT32, Vector<PhysicsBatchQueryHit>&) const */
+		void queryBatch(const Vector<PhysicsBatchQuery>& queries, Vector<PhysicsBatchQueryHit>& hits) const
+		{
+			queryBatch(queries.data(), (UINT32)queries.size(), hits);
+		}
+
 		/******************************************************************************************************************/
 		/************************************************* OPTIONS ********************************************************/
 		/******************************************************************************************************************/
@@ -596,6 +625,12 @@ namespace bs
 	protected:
 		friend class Rigidbody;
 
+		/**
+		 * Performs a single query from a query batch. Returns true if the query found a hit, in which case @p hit is
+		 * populated for PhysicsQueryType::Closest queries.
+		 */
+		bool executeBatchQuery(const PhysicsBatchQuery& query, PhysicsQueryHit& hit) const;
+
 		mutable Mutex mMutex;
 		bool mCollisionMap[CollisionMapSize][CollisionMapSize];
 
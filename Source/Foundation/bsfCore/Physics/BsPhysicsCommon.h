@@ -5,6 +5,8 @@
 #include "BsCorePrerequisites.h"
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
+#include "Math/BsQuaternion.h"
+#include <cfloat>
 
 namespace bs
 {
@@ -87,5 +89,51 @@ namespace bs
 		Collider* colliderRaw = nullptr; /**< Collider that was hit. */
 	};
 
+	/** Type of a query performed as a part of a query batch. */
+	enum class PhysicsQueryType
+	{
+		/** Sweeps the shape along a direction and reports the closest hit. */
+		Closest,
+		/** Sweeps the shape along a direction and reports if anything was hit, without providing hit information. */
+		Any,
+		/** Reports if the shape overlaps any physics object, without providing hit information. */
+		Overlap
+	};
+
+	/** Shape used by a query performed as a part of a query batch. */
+	enum class PhysicsQueryShape
+	{
+		Ray, /**< Infinitely thin ray. Cannot be used for overlap queries, which are ignored with an error. */
+		Box, /**< Oriented box. */
+		Sphere, /**< Sphere. */
+		Capsule /**< Capsule aligned with the Y axis before rotation is applied. */
+	};
+
+	/** Description of a single query in a query batch. */
+	struct PhysicsBatchQuery
+	{
+		PhysicsQueryType type = PhysicsQueryType::Closest; /**< Type of the query to perform. */
+		PhysicsQueryShape shape = PhysicsQueryShape::Ray; /**< Shape to perform the query with. */
+		Vector3 position = Vector3::ZERO; /**< Origin of the ray, or the center of the shape. */
+		Quaternion rotation = Quaternion::IDENTITY; /**< Orientation of the shape. Only relevant for boxes and capsules. */
+
+		/** 
+		 * Half-size of the box. For spheres and capsules the x component is the radius, and for capsules the y component
+		 * is the half-height of the capsule's line segment.
+		 */
+		Vector3 extents = Vector3::ZERO;
+
+		Vector3 unitDir = Vector3::UNIT_Z; /**< Unit direction along which to cast the shape. Ignored for overlaps. */
+		float max = FLT_MAX; /**< Maximum distance at which to perform the query. Ignored for overlaps. */
+		UINT64 layer = BS_ALL_LAYERS; /**< Layers to consider for the query. */
+	};
+
+	/** Information about a query in a query batch that has found a hit. */
+	struct PhysicsBatchQueryHit
+	{
+		UINT32 queryIdx = 0; /**< Index of the query in the batch. */
+		PhysicsQueryHit hit; /**< Information about the hit. Only populated for PhysicsQueryType::Closest queries. */
+	};
+
 	/** @} */
 }
\ No newline at end of file
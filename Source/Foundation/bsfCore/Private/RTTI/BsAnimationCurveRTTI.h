@@ -17,6 +17,10 @@ namespace bs
 	{
 		enum { id = TID_KeyFrame }; enum { hasDynamicSize = 0 };
 
+		/** Keyframes are written member by member, which matches their memory layout unless the struct is padded. */
+		enum { isMemcpySerializable = RTTIMemcpySerializable<T>::value && 
+			sizeof(TKeyframe<T>) == (sizeof(T) * 3 + sizeof(float)) };
+
 		/** @copydoc RTTIPlainType::toMemory */
 		static void toMemory(const TKeyframe<T>& data, char* memory)
 		{
@@ -32,6 +32,9 @@ namespace bs
 		UINT32& getNumIndices(MeshData* obj) { return obj->mNumIndices; }
 		void setNumIndices(MeshData* obj, UINT32& value) { obj->mNumIndices = value; }
 
+		AABox& getQuantizationBounds(MeshData* obj) { return obj->mQuantizationBounds; }
+		void setQuantizationBounds(MeshData* obj, AABox& value) { obj->mQuantizationBounds = value; }
+
 		SPtr<DataStream> getData(MeshData* obj, UINT32& size)
 		{
 			size = obj->getInternalBufferSize();
@@ -55,6 +58,8 @@ namespace bs
 			addPlainField("mNumIndices", 3, &MeshDataRTTI::getNumIndices, &MeshDataRTTI::setNumIndices);
 
 			addDataBlockField("data", 4, &MeshDataRTTI::getData, &MeshDataRTTI::setData, 0);
+			addPlainField("mQuantizationBounds", 5, &MeshDataRTTI::getQuantizationBounds, 
+				&MeshDataRTTI::setQuantizationBounds);
 		}
 
 		SPtr<IReflectable> newRTTIObject() override
@@ -54,7 +54,7 @@ namespace bs
 		SkeletonRTTI()
 		{
 			addPlainArrayField("bindPoses", 0, &SkeletonRTTI::getBindPose, &SkeletonRTTI::getNumBones,
-				&SkeletonRTTI::setBindPose, &SkeletonRTTI::setNumBindPoses);
+				&SkeletonRTTI::setBindPose, &SkeletonRTTI::setNumBindPoses, RTTI_Flag_ContiguousArray);
 			addPlainArrayField("boneInfo", 1, &SkeletonRTTI::getBoneInfo, &SkeletonRTTI::getNumBones,
 				&SkeletonRTTI::setBoneInfo, &SkeletonRTTI::setNumBoneInfos);
 			addReflectableArrayField("boneTransforms", 3, &SkeletonRTTI::getBoneTransform, &SkeletonRTTI::getNumBones,
@@ -10,6 +10,8 @@
 #include "RenderAPI/BsRenderAPI.h"
 #include "Managers/BsTextureManager.h"
 #include "Image/BsPixelData.h"
+#include "Image/BsTextureStreamer.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -20,6 +22,22 @@ namespace bs
 
 	class BS_CORE_EXPORT TextureRTTI : public RTTIType<Texture, Resource, TextureRTTI>
 	{
+		/**
+		 * Temporary data used during (de)serialization. Mip levels below @p numStreamedMips are stored in a single data
+		 * block, while the remaining mip levels are stored as separate pixel data objects.
+		 */
+		struct SerializationData
+		{
+			UINT32 numStreamedMips = 0;
+			Vector<SPtr<PixelData>> pixelData;
+
+			bool hasStreamedMipData = false;
+			bool streamFromSource = false;
+			Path streamedMipPath;
+			SPtr<DataStream> streamedMipData;
+			UINT64 streamedMipOffset = 0;
+		};
+
 	private:
 		BS_BEGIN_RTTI_MEMBERS
 			BS_RTTI_MEMBER_PLAIN(mSize, 0)
@@ -31,6 +49,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN_NAMED(numSamples, mProperties.mDesc.numSamples, 7)
 			BS_RTTI_MEMBER_PLAIN_NAMED(type, mProperties.mDesc.type, 9)
 			BS_RTTI_MEMBER_PLAIN_NAMED(format, mProperties.mDesc.format, 10)
+			BS_RTTI_MEMBER_PLAIN_NAMED(streaming, mProperties.mDesc.streaming, 13)
 		BS_END_RTTI_MEMBERS
 
 		INT32& getUsage(Texture* obj) { return obj->mProperties.mDesc.usage; }
@@ -50,10 +69,23 @@ namespace bs
 #define BS_ADD_PLAINFIELD(name, id, parentType) \
 	addPlainField(#name, id##, &##parentType##::get##name, &##parentType##::Set##name);
 
+		UINT32& getNumStreamedMips(Texture* obj)
+		{
+			return any_cast<SerializationData*>(obj->mRTTIData)->numStreamedMips;
+		}
+
+		void setNumStreamedMips(Texture* obj, UINT32& val)
+		{
+			any_cast<SerializationData*>(obj->mRTTIData)->numStreamedMips = val;
+		}
+
 		SPtr<PixelData> getPixelData(Texture* obj, UINT32 idx)
 		{
-			UINT32 face = (size_t)Math::floor(idx / (float)(obj->mProperties.getNumMipmaps() + 1));
-			UINT32 mipmap = idx % (obj->mProperties.getNumMipmaps() + 1);
+			UINT32 numStreamedMips = any_cast<SerializationData*>(obj->mRTTIData)->numStreamedMips;
+			UINT32 numTailMips = obj->mProperties.getNumMipmaps() + 1 - numStreamedMips;
+
+			UINT32 face = idx / numTailMips;
+			UINT32 mipmap = numStreamedMips + idx % numTailMips;
 
 			SPtr<PixelData> pixelData = obj->mProperties.allocBuffer(face, mipmap);
 
@@ -65,21 +97,84 @@ namespace bs
 
 		void setPixelData(Texture* obj, UINT32 idx, SPtr<PixelData> data)
 		{
-			Vector<SPtr<PixelData>>* pixelData = any_cast<Vector<SPtr<PixelData>>*>(obj->mRTTIData);
-
-			(*pixelData)[idx] = data;
+			any_cast<SerializationData*>(obj->mRTTIData)->pixelData[idx] = data;
 		}
 
 		UINT32 getPixelDataArraySize(Texture* obj)
 		{
-			return obj->mProperties.getNumFaces() * (obj->mProperties.getNumMipmaps() + 1);
+			UINT32 numStreamedMips = any_cast<SerializationData*>(obj->mRTTIData)->numStreamedMips;
+
+			return obj->mProperties.getNumFaces() * (obj->mProperties.getNumMipmaps() + 1 - numStreamedMips);
 		}
 
 		void setPixelDataArraySize(Texture* obj, UINT32 size)
 		{
-			Vector<SPtr<PixelData>>* pixelData = any_cast<Vector<SPtr<PixelData>>*>(obj->mRTTIData);
+			any_cast<SerializationData*>(obj->mRTTIData)->pixelData.resize(size);
+		}
+
+		SPtr<DataStream> getStreamedMipData(Texture* obj, UINT32& size)
+		{
+			UINT32 numStreamedMips = any_cast<SerializationData*>(obj->mRTTIData)->numStreamedMips;
+			UINT32 numFaces = obj->mProperties.getNumFaces();
+
+			Vector<SPtr<PixelData>> mipData;
+			size = 0;
+			for (UINT32 mip = 0; mip < numStreamedMips; mip++)
+			{
+				for (UINT32 face = 0; face < numFaces; face++)
+				{
+					SPtr<PixelData> pixelData = obj->mProperties.allocBuffer(face, mip);
+					obj->readData(pixelData, face, mip);
+
+					mipData.push_back(pixelData);
+					size += pixelData->getSize();
+				}
+			}
+
+			gCoreThread().submitAll(true);
+
+			SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(size);
+			for (auto& entry : mipData)
+				stream->write(entry->getData(), entry->getSize());
 
-			pixelData->resize(size);
+			stream->seek(0);
+			return stream;
+		}
+
+		void setStreamedMipData(Texture* obj, const SPtr<DataStream>& val, UINT32 size)
+		{
+			SerializationData* data = any_cast<SerializationData*>(obj->mRTTIData);
+
+			data->hasStreamedMipData = true;
+
+			// Mip levels are read from the file on demand when streaming. Without a streamer all of them are made
+			// resident on load, and the data is only needed until then.
+			if (val->isFile())
+			{
+				if (TextureStreamer::isStarted())
+					data->streamedMipPath = std::static_pointer_cast<FileDataStream>(val)->getPath();
+				else
+					data->streamedMipData = val->clone();
+
+				data->streamedMipOffset = val->tell();
+			}
+			else if (data->streamFromSource && TextureStreamer::isStarted())
+			{
+				// The file is provided once decoding finishes, see Texture::setSourceFile()
+				data->streamedMipOffset = val->tell();
+			}
+			else
+			{
+				// Copy the block so the rest of the serialized data can be released
+				size_t offset = val->tell();
+
+				SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(size);
+				val->read(stream->getPtr(), size);
+				val->seek(offset);
+
+				data->streamedMipData = stream;
+				data->streamedMipOffset = 0;
+			}
 		}
 
 	public:
@@ -89,13 +184,40 @@ namespace bs
 
 			addReflectablePtrArrayField("mPixelData", 12, &TextureRTTI::getPixelData, &TextureRTTI::getPixelDataArraySize, 
 				&TextureRTTI::setPixelData, &TextureRTTI::setPixelDataArraySize, RTTI_Flag_SkipInReferenceSearch);
+
+			addPlainField("mNumStreamedMips", 14, &TextureRTTI::getNumStreamedMips, &TextureRTTI::setNumStreamedMips);
+			addDataBlockField("mStreamedMipData", 15, &TextureRTTI::getStreamedMipData, &TextureRTTI::setStreamedMipData, 0);
+		}
+
+		void onSerializationStarted(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
+		{
+			Texture* texture = static_cast<Texture*>(obj);
+
+			SerializationData* data = bs_new<SerializationData>();
+			if (texture->mStreamingData != nullptr)
+				data->numStreamedMips = texture->mStreamingData->numStreamedMips;
+			else
+				data->numStreamedMips = TextureStreamer::getNumStreamableMips(texture->mProperties);
+
+			texture->mRTTIData = data;
+		}
+
+		void onSerializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
+		{
+			Texture* texture = static_cast<Texture*>(obj);
+
+			bs_delete(any_cast<SerializationData*>(texture->mRTTIData));
+			texture->mRTTIData = nullptr;
 		}
 
 		void onDeserializationStarted(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
 		{
 			Texture* texture = static_cast<Texture*>(obj);
 
-			texture->mRTTIData = bs_new<Vector<SPtr<PixelData>>>();
+			SerializationData* data = bs_new<SerializationData>();
+			data->streamFromSource = params.find("streamFromSource") != params.end();
+
+			texture->mRTTIData = data;
 		}
 
 		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
@@ -113,7 +235,8 @@ namespace bs
 			PixelFormat validFormat = TextureManager::instance().getNativeFormat(
 				texProps.getTextureType(), texProps.getFormat(), texProps.getUsage(), texProps.isHardwareGammaEnabled());
 
-			Vector<SPtr<PixelData>>* pixelData = any_cast<Vector<SPtr<PixelData>>*>(texture->mRTTIData);
+			SerializationData* data = any_cast<SerializationData*>(texture->mRTTIData);
+			Vector<SPtr<PixelData>>* pixelData = &data->pixelData;
 			if (originalFormat != validFormat)
 			{
 				texProps.mDesc.format = validFormat;
@@ -128,19 +251,58 @@ namespace bs
 				}
 			}
 
+			// Only the mip levels stored as pixel data are made resident, the rest are streamed in when needed
+			UINT32 numStreamedMips = 0;
+			if (data->hasStreamedMipData)
+				numStreamedMips = std::min(data->numStreamedMips, texProps.getNumMipmaps());
+
+			Vector<SPtr<PixelData>> streamedPixelData;
+			if (numStreamedMips > 0)
+			{
+				SPtr<TextureStreamingData> streamingData = bs_shared_ptr_new<TextureStreamingData>();
+				streamingData->path = data->streamedMipPath;
+				streamingData->stream = data->streamedMipData;
+				streamingData->offset = data->streamedMipOffset;
+				streamingData->numStreamedMips = numStreamedMips;
+				streamingData->storedFormat = originalFormat;
+				streamingData->desc = texProps.mDesc;
+
+				if (TextureStreamer::isStarted())
+				{
+					texture->mStreamingData = streamingData;
+					texture->mResidentMip = numStreamedMips;
+				}
+				else
+				{
+					// Nothing would ever stream the mip levels in, so load all of them
+					streamedPixelData = streamingData->readMips(0, numStreamedMips);
+					if (streamedPixelData.empty())
+						LOGERR("Failed reading streamed mip levels of texture: " + texture->getName());
+				}
+			}
+
 			// A bit clumsy initializing with already set values, but I feel its better than complicating things and storing the values
 			// in mRTTIData.
 			texture->initialize();
 
-			for(size_t i = 0; i < pixelData->size(); i++)
+			UINT32 numFaces = texProps.getNumFaces();
+			for (UINT32 i = 0; i < (UINT32)streamedPixelData.size(); i++)
+				texture->writeData(streamedPixelData[i], i % numFaces, i / numFaces, false);
+
+			UINT32 numTailMips = texProps.getNumMipmaps() + 1 - numStreamedMips;
+			for(UINT32 i = 0; i < (UINT32)pixelData->size(); i++)
 			{
-				UINT32 face = (size_t)Math::floor(i / (float)(texProps.getNumMipmaps() + 1));
-				UINT32 mipmap = i % (texProps.getNumMipmaps() + 1);
+				UINT32 face = i / numTailMips;
+				UINT32 mipmap = numStreamedMips + i % numTailMips;
 
 				texture->writeData(pixelData->at(i), face, mipmap, false);
 			}
 
-			bs_delete(pixelData);
+			// Textures whose data is left in the file are registered once the file is known
+			if (texture->mStreamingData != nullptr && texture->mStreamingData->hasSource())
+				TextureStreamer::instance()._registerTexture(texture);
+
+			bs_delete(data);
 			texture->mRTTIData = nullptr;	
 		}
 
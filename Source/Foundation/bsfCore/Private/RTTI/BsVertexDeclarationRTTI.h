@@ -59,7 +59,7 @@ namespace bs
 		VertexDeclarationRTTI()
 		{
 			addPlainArrayField("mElementList", 0, &VertexDeclarationRTTI::getElement, &VertexDeclarationRTTI::getElementArraySize, 
-				&VertexDeclarationRTTI::setElement, &VertexDeclarationRTTI::setElementArraySize);
+				&VertexDeclarationRTTI::setElement, &VertexDeclarationRTTI::setElementArraySize, RTTI_Flag_ContiguousArray);
 		}
 
 		SPtr<IReflectable> newRTTIObject() override
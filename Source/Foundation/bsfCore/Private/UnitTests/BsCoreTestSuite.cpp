@@ -0,0 +1,80 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/UnitTests/BsCoreTestSuite.h"
+#include "Audio/BsAudioUtility.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	CoreTestSuite::CoreTestSuite()
+	{
+		BS_ADD_TEST(CoreTestSuite::testAudioVoiceBudget);
+	}
+
+	void CoreTestSuite::testAudioVoiceBudget()
+	{
+		// Attenuation follows the inverse distance clamped model
+		BS_TEST_ASSERT(Math::approxEquals(AudioUtility::calculateAudibility(0.8f, 0.5f, 1.0f, 1.0f), 0.8f));
+		BS_TEST_ASSERT(Math::approxEquals(AudioUtility::calculateAudibility(0.8f, 2.0f, 1.0f, 1.0f), 0.4f));
+		BS_TEST_ASSERT(AudioUtility::calculateAudibility(1.0f, 10.0f, 1.0f, 1.0f) >
+			AudioUtility::calculateAudibility(1.0f, 20.0f, 1.0f, 1.0f));
+
+		auto makeCandidate = [](UINT32 id, INT32 priority, float audibility, bool hasVoice)
+		{
+			AudioVoiceCandidate candidate;
+			candidate.id = id;
+			candidate.priority = priority;
+			candidate.audibility = audibility;
+			candidate.hasVoice = hasVoice;
+
+			return candidate;
+		};
+
+		auto assignVoices = [](Vector<AudioVoiceCandidate>& candidates, UINT32 maxVoices)
+		{
+			UnorderedSet<UINT32> voiced;
+
+			UINT32 numVoices = AudioUtility::assignVoices(candidates, maxVoices);
+			for (UINT32 i = 0; i < numVoices; i++)
+				voiced.insert(candidates[i].id);
+
+			// Sources that got a voice keep it in the next update, all others become virtual
+			for (auto& candidate : candidates)
+				candidate.hasVoice = voiced.find(candidate.id) != voiced.end();
+
+			return voiced;
+		};
+
+		Vector<AudioVoiceCandidate> candidates =
+		{
+			makeCandidate(0, 0, 0.9f, false),
+			makeCandidate(1, 1, 0.1f, false), // Quiet, but high priority
+			makeCandidate(2, 0, 0.5f, true),
+			makeCandidate(3, 0, 0.55f, false), // Slightly louder than 2, but without a voice
+			makeCandidate(4, 0, 0.05f, true)
+		};
+
+		UnorderedSet<UINT32> voiced = assignVoices(candidates, 3);
+		BS_TEST_ASSERT(voiced.size() == 3);
+		BS_TEST_ASSERT(voiced.count(0) == 1 && voiced.count(1) == 1 && voiced.count(2) == 1);
+
+		// A virtual source that becomes clearly louder takes over the voice of a quieter one
+		for (auto& candidate : candidates)
+		{
+			if (candidate.id == 3)
+				candidate.audibility = 0.8f;
+		}
+
+		voiced = assignVoices(candidates, 3);
+		BS_TEST_ASSERT(voiced.size() == 3);
+		BS_TEST_ASSERT(voiced.count(0) == 1 && voiced.count(1) == 1 && voiced.count(3) == 1);
+
+		// Everything plays if there are enough voices
+		voiced = assignVoices(candidates, 8);
+		BS_TEST_ASSERT(voiced.size() == candidates.size());
+
+		// No voices at all virtualizes every source
+		voiced = assignVoices(candidates, 0);
+		BS_TEST_ASSERT(voiced.empty());
+	}
+}
\ No newline at end of file
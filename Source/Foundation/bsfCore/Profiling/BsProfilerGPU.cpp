@@ -5,6 +5,7 @@
 #include "RenderAPI/BsTimerQuery.h"
 #include "RenderAPI/BsOcclusionQuery.h"
 #include "Error/BsException.h"
+#include "Debug/BsProfilerTimeline.h"
 
 namespace bs
 {
@@ -53,10 +54,15 @@ namespace bs
 		if (!mIsFrameActive)
 			BS_EXCEPT(InvalidStateException, "Cannot begin a sample because no frame is active.");
 
+		// Suspend the parent's occlusion query, as queries of the same type cannot nest
+		INT32 parentIdx = mActiveSampleIndexes.empty() ? -1 : (INT32)mActiveSampleIndexes.top();
+		getActiveSample(parentIdx).occlusionQueries.back()->end();
+
 		mActiveFrame.samples.push_back(ActiveSample());
 		ActiveSample& sample = mActiveFrame.samples.back();
 
 		sample.sampleName = name;
+		sample.parentIdx = parentIdx;
 		beginSampleInternal(sample);
 
 		mActiveSampleIndexes.push((UINT32)mActiveFrame.samples.size() - 1);
@@ -79,6 +85,9 @@ namespace bs
 
 		endSampleInternal(sample);
 		mActiveSampleIndexes.pop();
+
+		// Resume the parent's occlusion query
+		beginOcclusionQuery(getActiveSample(sample.parentIdx));
 	}
 
 	UINT32 ProfilerGPU::getNumAvailableReports()
@@ -144,6 +153,16 @@ namespace bs
 			resolveSample(sample, newSample);
 		}
 
+		// Occlusion queries only cover the parts of a sample outside of its children, so accumulate the drawn sample
+		// counts upwards. Children always follow their parents, so a single reverse pass is enough.
+		for (INT32 i = (INT32)frame.samples.size() - 1; i >= 0; i--)
+		{
+			INT32 parentIdx = frame.samples[i].parentIdx;
+			GPUProfileSample& parent = parentIdx == -1 ? report.frameSample : report.samples[parentIdx];
+
+			parent.numDrawnSamples += report.samples[i].numDrawnSamples;
+		}
+
 		return report;
 	}
 
@@ -151,7 +170,11 @@ namespace bs
 	{
 		reportSample.name = String(sample.sampleName.c_str());
 		reportSample.timeMs = sample.activeTimeQuery->getTimeMs();
-		reportSample.numDrawnSamples = sample.activeOcclusionQuery->getNumSamples();
+		reportSample.cpuTimeMs = std::chrono::duration<float, std::milli>(sample.cpuEndTime - sample.cpuStartTime).count();
+
+		reportSample.numDrawnSamples = 0;
+		for (auto& query : sample.occlusionQueries)
+			reportSample.numDrawnSamples += query->getNumSamples();
 
 		reportSample.numDrawCalls = (UINT32)(sample.endStats.numDrawCalls - sample.startStats.numDrawCalls);
 		reportSample.numRenderTargetChanges = (UINT32)(sample.endStats.numRenderTargetChanges - sample.startStats.numRenderTargetChanges);
@@ -173,25 +196,58 @@ namespace bs
 		reportSample.numObjectsCreated = (UINT32)(sample.endStats.numObjectsCreated - sample.startStats.numObjectsCreated);
 		reportSample.numObjectsDestroyed = (UINT32)(sample.endStats.numObjectsDestroyed - sample.startStats.numObjectsDestroyed);
 
+		if (ProfilerTimeline::isEnabled())
+		{
+			// Cache the identifiers locally, to avoid the global name lookup for every sample
+			auto iterFind = mTimelineNameIds.find(reportSample.name);
+			if (iterFind == mTimelineNameIds.end())
+			{
+				UINT32 nameId = ProfilerTimeline::registerName(reportSample.name);
+				iterFind = mTimelineNameIds.insert(std::make_pair(reportSample.name, nameId)).first;
+			}
+
+			ProfilerTimeline::addGPUSample(iterFind->second, sample.timelineTimestamp, reportSample.timeMs);
+		}
+
 		mFreeTimerQueries.push(sample.activeTimeQuery);
-		mFreeOcclusionQueries.push(sample.activeOcclusionQuery);
+
+		for (auto& query : sample.occlusionQueries)
+			mFreeOcclusionQueries.push(query);
 	}
 
 	void ProfilerGPU::beginSampleInternal(ActiveSample& sample)
 	{
 		sample.startStats = RenderStats::instance().getData();
+		sample.timelineTimestamp = ProfilerTimeline::getTimestamp();
+		sample.cpuStartTime = std::chrono::high_resolution_clock::now();
 		sample.activeTimeQuery = getTimerQuery();
 		sample.activeTimeQuery->begin();
 
-		sample.activeOcclusionQuery = getOcclusionQuery();
-		sample.activeOcclusionQuery->begin();
+		beginOcclusionQuery(sample);
 	}
 
 	void ProfilerGPU::endSampleInternal(ActiveSample& sample)
 	{
 		sample.endStats = RenderStats::instance().getData();
-		sample.activeOcclusionQuery->end();
+		sample.occlusionQueries.back()->end();
 		sample.activeTimeQuery->end();
+		sample.cpuEndTime = std::chrono::high_resolution_clock::now();
+	}
+
+	void ProfilerGPU::beginOcclusionQuery(ActiveSample& sample)
+	{
+		SPtr<ct::OcclusionQuery> query = getOcclusionQuery();
+		query->begin();
+
+		sample.occlusionQueries.push_back(query);
+	}
+
+	ProfilerGPU::ActiveSample& ProfilerGPU::getActiveSample(INT32 idx)
+	{
+		if (idx == -1)
+			return mActiveFrame.frameSample;
+
+		return mActiveFrame.samples[idx];
 	}
 
 	SPtr<ct::TimerQuery> ProfilerGPU::getTimerQuery() const
@@ -17,6 +17,7 @@ namespace bs
 	{
 		String name; /**< Name of the sample for easier identification. */
 		float timeMs; /**< Time in milliseconds it took to execute the sampled block. */
+		float cpuTimeMs; /**< Time in milliseconds the CPU spent issuing the commands of the sampled block. */
 
 		UINT32 numDrawCalls; /**< Number of draw calls that happened. */
 		UINT32 numRenderTargetChanges; /**< How many times was render target changed. */
@@ -61,7 +62,11 @@ namespace bs
 			RenderStatsData startStats;
 			RenderStatsData endStats;
 			SPtr<ct::TimerQuery> activeTimeQuery;
-			SPtr<ct::OcclusionQuery> activeOcclusionQuery;
+			Vector<SPtr<ct::OcclusionQuery>> occlusionQueries; /**< Queries for parts of the sample outside of children. */
+			INT32 parentIdx = -1; /**< Index of the parent sample in the frame, or -1 if parented to the frame sample. */
+			UINT64 timelineTimestamp = 0;
+			std::chrono::high_resolution_clock::time_point cpuStartTime;
+			std::chrono::high_resolution_clock::time_point cpuEndTime;
 		};
 
 		struct ActiveFrame
@@ -107,6 +112,9 @@ namespace bs
 		 */
 		void endSample(const ProfilerString& name);
 
+		/** Checks if a frame is currently being sampled, meaning beginSample() and endSample() may be called. */
+		bool isFrameActive() const { return mIsFrameActive; }
+
 		/**
 		 * Returns number of profiling reports that are ready but haven't been retrieved yet.
 		 *
@@ -146,6 +154,15 @@ namespace bs
 		/**	Assigns end values for the provided sample. */
 		void endSampleInternal(ActiveSample& sample);
 
+		/**
+		 * Starts a new occlusion query for the provided sample. Only one occlusion query may be active at a time, so
+		 * a sample's query is ended while its child samples run, and a new one is started once they finish.
+		 */
+		void beginOcclusionQuery(ActiveSample& sample);
+
+		/** Returns the sample at the provided index in the active frame, or the frame sample if the index is -1. */
+		ActiveSample& getActiveSample(INT32 idx);
+
 		/**	Creates a new timer query or returns an existing free query. */
 		SPtr<ct::TimerQuery> getTimerQuery() const;
 
@@ -176,6 +193,8 @@ namespace bs
 		mutable Stack<SPtr<ct::TimerQuery>> mFreeTimerQueries;
 		mutable Stack<SPtr<ct::OcclusionQuery>> mFreeOcclusionQueries;
 
+		UnorderedMap<String, UINT32> mTimelineNameIds;
+
 		Mutex mMutex;
 	};
 
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilingManager.h"
 #include "Math/BsMath.h"
+#include "Debug/BsProfilerTimeline.h"
 
 namespace bs
 {
@@ -26,6 +27,8 @@ namespace bs
 
 	void ProfilingManager::_update()
 	{
+		ProfilerTimeline::_update();
+
 #if BS_PROFILING_ENABLED
 		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
 
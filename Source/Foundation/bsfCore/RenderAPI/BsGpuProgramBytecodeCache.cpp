@@ -0,0 +1,255 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Debug/BsDebug.h"
+#include "Utility/BsUUID.h"
+
+namespace bs { namespace ct
+{
+	/** Header written at the start of each cache entry. */
+	struct GpuProgramBytecodeCacheHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		UINT32 size;
+	};
+
+	static const UINT32 BYTECODE_CACHE_MAGIC = 0x42435342; // "BSCB"
+	static const UINT32 BYTECODE_CACHE_VERSION = 1;
+
+	constexpr UINT32 GpuProgramBytecodeCache::MAX_CACHED_ENTRIES;
+	constexpr UINT64 GpuProgramBytecodeCache::DEFAULT_MAX_DISK_SIZE;
+
+	GpuProgramBytecodeCache::GpuProgramBytecodeCache(const Path& cacheFolder, UINT64 maxDiskSize)
+		:mFolder(cacheFolder), mMaxDiskSize(maxDiskSize)
+	{
+		if (!FileSystem::exists(mFolder))
+			FileSystem::createDir(mFolder);
+
+		UINT64 diskSize = 0;
+		FileSystem::iterate(mFolder, [&diskSize](const Path& path)
+		{
+			if (path.getExtension() == ".bin")
+				diskSize += FileSystem::getFileSize(path);
+
+			return true;
+		}, nullptr, false);
+
+		mDiskSize = diskSize;
+		if (mMaxDiskSize > 0 && mDiskSize > mMaxDiskSize)
+			trimDiskSize();
+	}
+
+	GpuProgramBytecodeCache::~GpuProgramBytecodeCache()
+	{
+		LOGDBG("GPU program bytecode cache: " + toString(mNumHits.load()) + " hits, " + toString(mNumMisses.load()) +
+			" misses.");
+	}
+
+	String GpuProgramBytecodeCache::getKey(const GPU_PROGRAM_DESC& desc, const String& compilerVersion)
+	{
+		String header = desc.language + "|" + compilerVersion + "|" + desc.entryPoint + "|" + 
+			toString((UINT32)desc.type) + "|" + toString(desc.requiresAdjacency) + "|";
+
+		return md5(header + desc.source);
+	}
+
+	SPtr<GpuProgramBytecode> GpuProgramBytecodeCache::load(const String& key)
+	{
+		{
+			Lock lock(mMutex);
+
+			auto iterFind = mEntries.find(key);
+			if (iterFind != mEntries.end())
+			{
+				mUsage.splice(mUsage.begin(), mUsage, iterFind->second.usageIter);
+
+				mNumHits++;
+				return iterFind->second.bytecode;
+			}
+		}
+
+		Path entryPath = getEntryPath(key);
+		if (!FileSystem::isFile(entryPath))
+		{
+			mNumMisses++;
+			return nullptr;
+		}
+
+		SPtr<DataStream> stream = FileSystem::openFile(entryPath);
+		if (stream == nullptr)
+		{
+			mNumMisses++;
+			return nullptr;
+		}
+
+		GpuProgramBytecodeCacheHeader header;
+		bool valid = stream->read(&header, sizeof(header)) == sizeof(header);
+		valid &= header.magic == BYTECODE_CACHE_MAGIC && header.version == BYTECODE_CACHE_VERSION;
+		valid &= (sizeof(header) + header.size) == stream->size();
+
+		SPtr<GpuProgramBytecode> bytecode;
+		if (valid)
+		{
+			UINT8* data = (UINT8*)bs_alloc(header.size);
+			stream->read(data, header.size);
+
+			MemorySerializer serializer;
+			bytecode = std::static_pointer_cast<GpuProgramBytecode>(serializer.decode(data, header.size));
+
+			bs_free(data);
+		}
+
+		UINT64 fileSize = stream->size();
+		stream->close();
+
+		if (bytecode == nullptr)
+		{
+			LOGWRN("Removing invalid GPU program bytecode cache entry: " + entryPath.toString());
+
+			Lock lock(mDiskMutex);
+			mDiskSize -= std::min(mDiskSize.load(), fileSize);
+			FileSystem::remove(entryPath);
+
+			mNumMisses++;
+			return nullptr;
+		}
+
+		{
+			Lock lock(mMutex);
+			addCachedEntry(key, bytecode);
+		}
+
+		mNumHits++;
+		return bytecode;
+	}
+
+	void GpuProgramBytecodeCache::save(const String& key, const SPtr<GpuProgramBytecode>& bytecode)
+	{
+		if (bytecode == nullptr || bytecode->instructions.data == nullptr)
+			return;
+
+		{
+			Lock lock(mMutex);
+			addCachedEntry(key, bytecode);
+		}
+
+		UINT32 size = 0;
+		MemorySerializer serializer;
+		UINT8* data = serializer.encode(bytecode.get(), size);
+
+		GpuProgramBytecodeCacheHeader header;
+		header.magic = BYTECODE_CACHE_MAGIC;
+		header.version = BYTECODE_CACHE_VERSION;
+		header.size = size;
+
+		// Write to a uniquely named temporary file first, so other threads or processes never see a partially written 
+		// entry
+		Path entryPath = getEntryPath(key);
+		Path tempPath = entryPath;
+		tempPath.setExtension(".tmp" + UUIDGenerator::generateRandom().toString());
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(tempPath);
+		if (stream != nullptr)
+		{
+			stream->write(&header, sizeof(header));
+			stream->write(data, size);
+			stream->close();
+
+			Lock lock(mDiskMutex);
+
+			if (FileSystem::isFile(entryPath))
+				mDiskSize -= std::min(mDiskSize.load(), FileSystem::getFileSize(entryPath));
+
+			FileSystem::move(tempPath, entryPath);
+			mDiskSize += sizeof(header) + size;
+		}
+
+		bs_free(data);
+
+		if (mMaxDiskSize > 0 && mDiskSize > mMaxDiskSize)
+			trimDiskSize();
+	}
+
+	void GpuProgramBytecodeCache::trimDiskSize()
+	{
+		struct DiskEntry
+		{
+			Path path;
+			std::time_t lastModified;
+			UINT64 size;
+		};
+
+		Lock lock(mDiskMutex);
+
+		// Another thread might have trimmed the cache already
+		if (mDiskSize <= mMaxDiskSize)
+			return;
+
+		Vector<DiskEntry> entries;
+		UINT64 diskSize = 0;
+		FileSystem::iterate(mFolder, [&entries, &diskSize](const Path& path)
+		{
+			if (path.getExtension() == ".bin")
+			{
+				DiskEntry entry = { path, FileSystem::getLastModifiedTime(path), FileSystem::getFileSize(path) };
+				entries.push_back(entry);
+
+				diskSize += entry.size;
+			}
+
+			return true;
+		}, nullptr, false);
+
+		std::sort(entries.begin(), entries.end(), [](const DiskEntry& a, const DiskEntry& b)
+		{
+			return a.lastModified < b.lastModified;
+		});
+
+		// Trim below the limit, so the folder doesn't need to be scanned on every save
+		UINT64 targetSize = mMaxDiskSize / 4 * 3;
+		for (auto& entry : entries)
+		{
+			if (diskSize <= targetSize)
+				break;
+
+			FileSystem::remove(entry.path);
+			diskSize -= entry.size;
+		}
+
+		mDiskSize = diskSize;
+	}
+
+	void GpuProgramBytecodeCache::addCachedEntry(const String& key, const SPtr<GpuProgramBytecode>& bytecode)
+	{
+		auto iterFind = mEntries.find(key);
+		if (iterFind != mEntries.end())
+		{
+			iterFind->second.bytecode = bytecode;
+			mUsage.splice(mUsage.begin(), mUsage, iterFind->second.usageIter);
+			return;
+		}
+
+		mUsage.push_front(key);
+		mEntries[key] = { bytecode, mUsage.begin() };
+
+		if (mEntries.size() > MAX_CACHED_ENTRIES)
+		{
+			mEntries.erase(mUsage.back());
+			mUsage.pop_back();
+		}
+	}
+
+	Path GpuProgramBytecodeCache::getDefaultFolder()
+	{
+		return FileSystem::getTempDirectoryPath() + "bsf/BytecodeCache/";
+	}
+
+	Path GpuProgramBytecodeCache::getEntryPath(const String& key) const
+	{
+		return mFolder + (key + ".bin");
+	}
+}}
@@ -0,0 +1,110 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "RenderAPI/BsGpuProgram.h"
+#include "FileSystem/BsPath.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderAPI-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Persistent, content-addressed cache of GPU program bytecode. Once registered with the GpuProgramManager all calls to
+	 * GpuProgram::compileBytecode will first attempt to find the bytecode in the cache, and store any newly compiled
+	 * bytecode in it.
+	 *
+	 * Entries are keyed by a hash of the program source (after all defines have been applied), entry point, program
+	 * type, language and compiler version. Since every render backend registers its own program language, this also
+	 * makes the key unique per-backend. Most recently used entries are also kept in memory, up to a limited number.
+	 *
+	 * The size of the cache on disk is limited. When the limit is exceeded the least recently written entries are
+	 * removed, until the cache is reduced to three quarters of the limit.
+	 *
+	 * The cache can be filled ahead of time by using ShaderPrecompiler, so that shaders never need to be compiled at
+	 * load time.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT GpuProgramBytecodeCache
+	{
+	public:
+		/** Default limit on the size of the cache on disk, in bytes. */
+		static constexpr UINT64 DEFAULT_MAX_DISK_SIZE = 256 * 1024 * 1024;
+
+		/**
+		 * Creates a new cache that stores its entries in the provided folder.
+		 *
+		 * @param[in]	cacheFolder		Folder to store the entries in. Created if it doesn't exist.
+		 * @param[in]	maxDiskSize		Maximum size of all entries in the folder, in bytes. Zero for no limit.
+		 */
+		GpuProgramBytecodeCache(const Path& cacheFolder, UINT64 maxDiskSize = DEFAULT_MAX_DISK_SIZE);
+		~GpuProgramBytecodeCache();
+
+		/** 
+		 * Generates a key that uniquely identifies the bytecode compiled from the provided program description, by a 
+		 * compiler with the provided version (as reported by GpuProgramFactory::getCompilerVersion()).
+		 */
+		static String getKey(const GPU_PROGRAM_DESC& desc, const String& compilerVersion);
+
+		/** Attempts to find bytecode stored under the provided key. Returns null if the entry doesn't exist. */
+		SPtr<GpuProgramBytecode> load(const String& key);
+
+		/** Stores the provided bytecode under the provided key. Bytecode that failed to compile is not stored. */
+		void save(const String& key, const SPtr<GpuProgramBytecode>& bytecode);
+
+		/** Returns the folder in which the cache entries are stored. */
+		const Path& getFolder() const { return mFolder; }
+
+		/** Returns the size of all entries stored on disk, in bytes. */
+		UINT64 getDiskSize() const { return mDiskSize; }
+
+		/** Returns the number of entries that were found in the cache. */
+		UINT32 getNumHits() const { return mNumHits; }
+
+		/** Returns the number of entries that were requested but not found in the cache. */
+		UINT32 getNumMisses() const { return mNumMisses; }
+
+		/** Returns the default folder in which the cache entries are stored. */
+		static Path getDefaultFolder();
+
+	private:
+		/** Maximum number of entries kept in memory. Older entries are only kept on disk. */
+		static constexpr UINT32 MAX_CACHED_ENTRIES = 256;
+
+		/** Entry kept in memory. */
+		struct CachedEntry
+		{
+			SPtr<GpuProgramBytecode> bytecode;
+			List<String>::iterator usageIter;
+		};
+
+		/** Returns the path of the file that stores the entry with the provided key. */
+		Path getEntryPath(const String& key) const;
+
+		/** 
+		 * Keeps the provided entry in memory, evicting the least recently used one if over the limit. Caller must hold
+		 * the mutex.
+		 */
+		void addCachedEntry(const String& key, const SPtr<GpuProgramBytecode>& bytecode);
+
+		/** Removes the least recently written entries from disk until the disk size is below the limit. */
+		void trimDiskSize();
+
+		Path mFolder;
+		UINT64 mMaxDiskSize;
+		std::atomic<UINT64> mDiskSize{0};
+		Mutex mDiskMutex;
+
+		Mutex mMutex;
+		UnorderedMap<String, CachedEntry> mEntries;
+		List<String> mUsage; /**< Keys of entries kept in memory, most recently used first. */
+		std::atomic<UINT32> mNumHits{0};
+		std::atomic<UINT32> mNumMisses{0};
+	};
+
+	/** @} */
+}}
@@ -42,7 +42,10 @@ namespace bs
 		case VET_USHORT2:
 			return sizeof(UINT16) * 2;
 		case VET_USHORT4:
+		case VET_USHORT4_NORM:
 			return sizeof(UINT16) * 4;
+		case VET_HALF2:
+			return sizeof(UINT16) * 2;
 		case VET_SHORT1:
 			return sizeof(INT16);
 		case VET_SHORT2:
@@ -89,6 +92,7 @@ namespace bs
 		case VET_UINT1:
 			return 1;
 		case VET_FLOAT2:
+		case VET_HALF2:
 		case VET_SHORT2:
 		case VET_USHORT2:
 		case VET_INT2:
@@ -105,6 +109,7 @@ namespace bs
 		case VET_UINT4:
 		case VET_UBYTE4:
 		case VET_UBYTE4_NORM:
+		case VET_USHORT4_NORM:
 			return 4;
 		default:
 			break;
@@ -53,6 +53,8 @@ namespace bs
 		VET_UINT2 = 22,  /**< 2D 32-bit signed integer value */
 		VET_UINT3 = 23,  /**< 3D 32-bit signed integer value */
 		VET_UBYTE4_NORM = 24, /**< 4D 8-bit unsigned integer interpreted as a normalized value in [0, 1] range. */
+		VET_HALF2 = 25, /**< 2D 16-bit floating point value */
+		VET_USHORT4_NORM = 26, /**< 4D 16-bit unsigned integer interpreted as a normalized value in [0, 1] range. */
 		VET_COUNT, // Keep at end before VET_UNKNOWN
 		VET_UNKNOWN = 0xffff
 	};
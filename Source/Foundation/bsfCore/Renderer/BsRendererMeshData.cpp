@@ -10,6 +10,7 @@
 #include "Renderer/BsRendererManager.h"
 #include "Renderer/BsRenderer.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Utility/BsBitwise.h"
 
 namespace bs
 {
@@ -28,24 +29,58 @@ namespace bs
 
 	void RendererMeshData::getPositions(Vector3* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_POSITION))
+		const VertexElement* positionElem = mMeshData->getVertexDesc()->getElement(VES_POSITION);
+		if (positionElem == nullptr)
 			return;
 
 		UINT32 numElements = mMeshData->getNumVertices();
 		assert(numElements * sizeof(Vector3) == size);
 
-		mMeshData->getVertexData(VES_POSITION, (UINT8*)buffer, size);
+		if (positionElem->getType() == VET_USHORT4_NORM)
+		{
+			UINT8* positionSrc = mMeshData->getElementData(VES_POSITION);
+			UINT32 stride = mMeshData->getVertexDesc()->getVertexStride(0);
+
+			MeshUtility::dequantizePositions(positionSrc, buffer, numElements, stride, 
+				mMeshData->getQuantizationBounds());
+		}
+		else
+			mMeshData->getVertexData(VES_POSITION, (UINT8*)buffer, size);
 	}
 
 	void RendererMeshData::setPositions(Vector3* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_POSITION))
+		const VertexElement* positionElem = mMeshData->getVertexDesc()->getElement(VES_POSITION);
+		if (positionElem == nullptr)
 			return;
 
 		UINT32 numElements = mMeshData->getNumVertices();
 		assert(numElements * sizeof(Vector3) == size);
 
-		mMeshData->setVertexData(VES_POSITION, (UINT8*)buffer, size);
+		if (positionElem->getType() == VET_USHORT4_NORM)
+		{
+			AABox bounds(Vector3::ZERO, Vector3::ZERO);
+			if (numElements > 0)
+			{
+				Vector3 min = buffer[0];
+				Vector3 max = buffer[0];
+				for (UINT32 i = 1; i < numElements; i++)
+				{
+					min = Vector3::min(min, buffer[i]);
+					max = Vector3::max(max, buffer[i]);
+				}
+
+				bounds = AABox(min, max);
+			}
+
+			UINT8* positionDst = mMeshData->getElementData(VES_POSITION);
+			UINT32 stride = mMeshData->getVertexDesc()->getVertexStride(0);
+
+			mMeshData->setQuantizationBounds(bounds);
+			MeshUtility::quantizePositions(buffer, positionDst, numElements, sizeof(Vector3), stride, bounds);
+		}
+		else
+			mMeshData->setVertexData(VES_POSITION, (UINT8*)buffer, size);
 	}
 
 	void RendererMeshData::getNormals(Vector3* buffer, UINT32 size)
@@ -159,46 +194,75 @@ namespace bs
 
 	void RendererMeshData::getUV0(Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 0))
-			return;
-
-		UINT32 numElements = mMeshData->getNumVertices();
-		assert(numElements * sizeof(Vector2) == size);
-
-		mMeshData->getVertexData(VES_TEXCOORD, (UINT8*)buffer, size, 0);
+		getUV(0, buffer, size);
 	}
 
 	void RendererMeshData::setUV0(Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 0))
-			return;
+		setUV(0, buffer, size);
+	}
 
-		UINT32 numElements = mMeshData->getNumVertices();
-		assert(numElements * sizeof(Vector2) == size);
+	void RendererMeshData::getUV1(Vector2* buffer, UINT32 size)
+	{
+		getUV(1, buffer, size);
+	}
 
-		mMeshData->setVertexData(VES_TEXCOORD, (UINT8*)buffer, size, 0);
+	void RendererMeshData::setUV1(Vector2* buffer, UINT32 size)
+	{
+		setUV(1, buffer, size);
 	}
 
-	void RendererMeshData::getUV1(Vector2* buffer, UINT32 size)
+	void RendererMeshData::getUV(UINT32 channel, Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 1))
+		const VertexElement* uvElem = mMeshData->getVertexDesc()->getElement(VES_TEXCOORD, channel);
+		if (uvElem == nullptr)
 			return;
 
 		UINT32 numElements = mMeshData->getNumVertices();
 		assert(numElements * sizeof(Vector2) == size);
 
-		mMeshData->getVertexData(VES_TEXCOORD, (UINT8*)buffer, size, 1);
+		if (uvElem->getType() == VET_HALF2)
+		{
+			UINT8* uvSrc = mMeshData->getElementData(VES_TEXCOORD, channel);
+			UINT32 stride = mMeshData->getVertexDesc()->getVertexStride(0);
+
+			for (UINT32 i = 0; i < numElements; i++)
+			{
+				UINT16* half = (UINT16*)uvSrc;
+				buffer[i] = Vector2(Bitwise::halfToFloat(half[0]), Bitwise::halfToFloat(half[1]));
+
+				uvSrc += stride;
+			}
+		}
+		else
+			mMeshData->getVertexData(VES_TEXCOORD, (UINT8*)buffer, size, channel);
 	}
 
-	void RendererMeshData::setUV1(Vector2* buffer, UINT32 size)
+	void RendererMeshData::setUV(UINT32 channel, Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 1))
+		const VertexElement* uvElem = mMeshData->getVertexDesc()->getElement(VES_TEXCOORD, channel);
+		if (uvElem == nullptr)
 			return;
 
 		UINT32 numElements = mMeshData->getNumVertices();
 		assert(numElements * sizeof(Vector2) == size);
 
-		mMeshData->setVertexData(VES_TEXCOORD, (UINT8*)buffer, size, 1);
+		if (uvElem->getType() == VET_HALF2)
+		{
+			UINT8* uvDst = mMeshData->getElementData(VES_TEXCOORD, channel);
+			UINT32 stride = mMeshData->getVertexDesc()->getVertexStride(0);
+
+			for (UINT32 i = 0; i < numElements; i++)
+			{
+				UINT16* half = (UINT16*)uvDst;
+				half[0] = Bitwise::floatToHalf(buffer[i].x);
+				half[1] = Bitwise::floatToHalf(buffer[i].y);
+
+				uvDst += stride;
+			}
+		}
+		else
+			mMeshData->setVertexData(VES_TEXCOORD, (UINT8*)buffer, size, channel);
 	}
 
 	void RendererMeshData::getBoneWeights(BoneWeight* buffer, UINT32 size)
@@ -216,22 +280,36 @@ namespace bs
 		UINT8* indexPtr = mMeshData->getElementData(VES_BLEND_INDICES);
 
 		UINT32 stride = vertexDesc->getVertexStride(0);
+		bool packedWeights = vertexDesc->getElement(VES_BLEND_WEIGHTS)->getType() == VET_UBYTE4_NORM;
 
 		BoneWeight* weightDst = buffer;
 		for (UINT32 i = 0; i < numElements; i++)
 		{
 			UINT8* indices = indexPtr;
-			float* weights = (float*)weightPtr;
 
 			weightDst->index0 = indices[0];
 			weightDst->index1 = indices[1];
 			weightDst->index2 = indices[2];
 			weightDst->index3 = indices[3];
 
-			weightDst->weight0 = weights[0];
-			weightDst->weight1 = weights[1];
-			weightDst->weight2 = weights[2];
-			weightDst->weight3 = weights[3];
+			if (packedWeights)
+			{
+				UINT8* weights = weightPtr;
+
+				weightDst->weight0 = weights[0] / 255.0f;
+				weightDst->weight1 = weights[1] / 255.0f;
+				weightDst->weight2 = weights[2] / 255.0f;
+				weightDst->weight3 = weights[3] / 255.0f;
+			}
+			else
+			{
+				float* weights = (float*)weightPtr;
+
+				weightDst->weight0 = weights[0];
+				weightDst->weight1 = weights[1];
+				weightDst->weight2 = weights[2];
+				weightDst->weight3 = weights[3];
+			}
 
 			weightDst++;
 			indexPtr += stride;
@@ -254,22 +332,48 @@ namespace bs
 		UINT8* indexPtr = mMeshData->getElementData(VES_BLEND_INDICES);
 
 		UINT32 stride = vertexDesc->getVertexStride(0);
+		bool packedWeights = vertexDesc->getElement(VES_BLEND_WEIGHTS)->getType() == VET_UBYTE4_NORM;
 
 		BoneWeight* weightSrc = buffer;
 		for (UINT32 i = 0; i < numElements; i++)
 		{
 			UINT8* indices = indexPtr;
-			float* weights = (float*)weightPtr;
 
 			indices[0] = weightSrc->index0;
 			indices[1] = weightSrc->index1;
 			indices[2] = weightSrc->index2;
 			indices[3] = weightSrc->index3;
 
-			weights[0] = weightSrc->weight0;
-			weights[1] = weightSrc->weight1;
-			weights[2] = weightSrc->weight2;
-			weights[3] = weightSrc->weight3;
+			if (packedWeights)
+			{
+				float srcWeights[4] = { weightSrc->weight0, weightSrc->weight1, weightSrc->weight2, weightSrc->weight3 };
+				UINT8* weights = weightPtr;
+
+				// Quantize while making sure the weights still sum up to one, by assigning the rounding error to the
+				// largest weight
+				INT32 sum = 0;
+				UINT32 largestIdx = 0;
+				for (UINT32 j = 0; j < 4; j++)
+				{
+					weights[j] = (UINT8)Math::clamp(Math::roundToInt(srcWeights[j] * 255.0f), 0, 255);
+					sum += weights[j];
+
+					if (srcWeights[j] > srcWeights[largestIdx])
+						largestIdx = j;
+				}
+
+				if (sum > 0)
+					weights[largestIdx] = (UINT8)Math::clamp(weights[largestIdx] + 255 - sum, 0, 255);
+			}
+			else
+			{
+				float* weights = (float*)weightPtr;
+
+				weights[0] = weightSrc->weight0;
+				weights[1] = weightSrc->weight1;
+				weights[2] = weightSrc->weight2;
+				weights[3] = weightSrc->weight3;
+			}
 
 			weightSrc++;
 			indexPtr += stride;
@@ -339,7 +443,7 @@ namespace bs
 		return RendererManager::instance().getActive()->_createMeshData(meshData);
 	}
 
-	SPtr<VertexDataDesc> RendererMeshData::vertexLayoutVertexDesc(VertexLayout type)
+	SPtr<VertexDataDesc> RendererMeshData::vertexLayoutVertexDesc(VertexLayout type, VertexCompression compression)
 	{
 		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
 
@@ -348,8 +452,12 @@ namespace bs
 		if (intType == 0)
 			type = VertexLayout::Position;
 
+		VertexElementType positionType = compression.isSet(VertexCompressionFlag::Position) ? VET_USHORT4_NORM : VET_FLOAT3;
+		VertexElementType uvType = compression.isSet(VertexCompressionFlag::UV) ? VET_HALF2 : VET_FLOAT2;
+		VertexElementType weightType = compression.isSet(VertexCompressionFlag::BoneWeights) ? VET_UBYTE4_NORM : VET_FLOAT4;
+
 		if ((intType & (INT32)VertexLayout::Position) != 0)
-			vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+			vertexDesc->addVertElem(positionType, VES_POSITION);
 
 		if ((intType & (INT32)VertexLayout::Normal) != 0)
 			vertexDesc->addVertElem(VET_UBYTE4_NORM, VES_NORMAL);
@@ -358,10 +466,10 @@ namespace bs
 			vertexDesc->addVertElem(VET_UBYTE4_NORM, VES_TANGENT);
 
 		if ((intType & (INT32)VertexLayout::UV0) != 0)
-			vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD, 0);
+			vertexDesc->addVertElem(uvType, VES_TEXCOORD, 0);
 
 		if ((intType & (INT32)VertexLayout::UV1) != 0)
-			vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD, 1);
+			vertexDesc->addVertElem(uvType, VES_TEXCOORD, 1);
 
 		if ((intType & (INT32)VertexLayout::Color) != 0)
 			vertexDesc->addVertElem(VET_COLOR, VES_COLOR);
@@ -369,7 +477,7 @@ namespace bs
 		if ((intType & (INT32)VertexLayout::BoneWeights) != 0)
 		{
 			vertexDesc->addVertElem(VET_UBYTE4, VES_BLEND_INDICES);
-			vertexDesc->addVertElem(VET_FLOAT4, VES_BLEND_WEIGHTS);
+			vertexDesc->addVertElem(weightType, VES_BLEND_WEIGHTS);
 		}
 
 		return vertexDesc;
@@ -531,4 +639,178 @@ namespace bs
 
 		return output;
 	}
-}
\ No newline at end of file
+
+	SPtr<MeshData> RendererMeshData::compress(const SPtr<MeshData>& meshData, VertexCompression compression)
+	{
+		SPtr<VertexDataDesc> vertexDesc = meshData->getVertexDesc();
+
+		UINT32 numVertices = meshData->getNumVertices();
+		UINT32 numIndices = meshData->getNumIndices();
+
+		INT32 type = 0;
+		if (vertexDesc->hasElement(VES_POSITION))
+			type |= (INT32)VertexLayout::Position;
+
+		// Normals, tangents and colors are always stored in 32-bit packed form. Packed input is copied as is, full
+		// precision input is packed, and anything else is dropped.
+		const VertexElement* normalElem = vertexDesc->getElement(VES_NORMAL);
+		bool packNormals = false;
+		if (normalElem != nullptr)
+		{
+			if (normalElem->getType() == VET_FLOAT3)
+			{
+				packNormals = true;
+				type |= (INT32)VertexLayout::Normal;
+			}
+			else if (normalElem->getType() == VET_UBYTE4_NORM)
+				type |= (INT32)VertexLayout::Normal;
+			else
+				LOGWRN("Unsupported vertex normal format when compressing mesh data. Normals will be dropped.");
+		}
+
+		const VertexElement* tanElem = vertexDesc->getElement(VES_TANGENT);
+		bool packTangents = false;
+		if (tanElem != nullptr)
+		{
+			if (tanElem->getType() == VET_FLOAT4)
+			{
+				packTangents = true;
+				type |= (INT32)VertexLayout::Tangent;
+			}
+			else if (tanElem->getType() == VET_UBYTE4_NORM)
+				type |= (INT32)VertexLayout::Tangent;
+			else
+				LOGWRN("Unsupported vertex tangent format when compressing mesh data. Tangents will be dropped.");
+		}
+
+		if (vertexDesc->hasElement(VES_TEXCOORD, 0))
+			type |= (INT32)VertexLayout::UV0;
+
+		if (vertexDesc->hasElement(VES_TEXCOORD, 1))
+			type |= (INT32)VertexLayout::UV1;
+
+		const VertexElement* colorElem = vertexDesc->getElement(VES_COLOR);
+		bool packColors = false;
+		if (colorElem != nullptr)
+		{
+			if (colorElem->getType() == VET_FLOAT4)
+			{
+				packColors = true;
+				type |= (INT32)VertexLayout::Color;
+			}
+			else if (colorElem->getType() == VET_COLOR || colorElem->getType() == VET_UBYTE4_NORM)
+				type |= (INT32)VertexLayout::Color;
+			else
+				LOGWRN("Unsupported vertex color format when compressing mesh data. Colors will be dropped.");
+		}
+
+		if (vertexDesc->hasElement(VES_BLEND_INDICES) && vertexDesc->hasElement(VES_BLEND_WEIGHTS))
+			type |= (INT32)VertexLayout::BoneWeights;
+
+		SPtr<VertexDataDesc> outputVertexDesc = vertexLayoutVertexDesc((VertexLayout)type, compression);
+		SPtr<MeshData> output = bs_shared_ptr_new<MeshData>(numVertices, numIndices, outputVertexDesc, 
+			meshData->getIndexType());
+
+		RendererMeshData input(meshData);
+		RendererMeshData compressed(output);
+
+		// Large enough for any of the vertex attributes
+		UINT32 bufferSize = numVertices * sizeof(BoneWeight);
+		UINT8* buffer = (UINT8*)bs_alloc(bufferSize);
+
+		if ((type & (INT32)VertexLayout::Position) != 0)
+		{
+			UINT32 size = numVertices * sizeof(Vector3);
+
+			input.getPositions((Vector3*)buffer, size);
+			compressed.setPositions((Vector3*)buffer, size);
+		}
+
+		if ((type & (INT32)VertexLayout::Normal) != 0)
+		{
+			if (packNormals)
+			{
+				UINT32 size = numVertices * sizeof(Vector3);
+
+				meshData->getVertexData(VES_NORMAL, buffer, size);
+				compressed.setNormals((Vector3*)buffer, size);
+			}
+			else
+			{
+				meshData->getVertexData(VES_NORMAL, buffer, numVertices * sizeof(UINT32));
+				output->setVertexData(VES_NORMAL, buffer, numVertices * sizeof(UINT32));
+			}
+		}
+
+		if ((type & (INT32)VertexLayout::Tangent) != 0)
+		{
+			if (packTangents)
+			{
+				UINT32 size = numVertices * sizeof(Vector4);
+
+				meshData->getVertexData(VES_TANGENT, buffer, size);
+				compressed.setTangents((Vector4*)buffer, size);
+			}
+			else
+			{
+				meshData->getVertexData(VES_TANGENT, buffer, numVertices * sizeof(UINT32));
+				output->setVertexData(VES_TANGENT, buffer, numVertices * sizeof(UINT32));
+			}
+		}
+
+		if ((type & (INT32)VertexLayout::Color) != 0)
+		{
+			if (packColors)
+			{
+				UINT32 size = numVertices * sizeof(Color);
+
+				meshData->getVertexData(VES_COLOR, buffer, size);
+				compressed.setColors((Color*)buffer, size);
+			}
+			else
+			{
+				meshData->getVertexData(VES_COLOR, buffer, numVertices * sizeof(UINT32));
+				output->setVertexData(VES_COLOR, buffer, numVertices * sizeof(UINT32));
+			}
+		}
+
+		if ((type & (INT32)VertexLayout::UV0) != 0)
+		{
+			UINT32 size = numVertices * sizeof(Vector2);
+
+			input.getUV0((Vector2*)buffer, size);
+			compressed.setUV0((Vector2*)buffer, size);
+		}
+
+		if ((type & (INT32)VertexLayout::UV1) != 0)
+		{
+			UINT32 size = numVertices * sizeof(Vector2);
+
+			input.getUV1((Vector2*)buffer, size);
+			compressed.setUV1((Vector2*)buffer, size);
+		}
+
+		if ((type & (INT32)VertexLayout::BoneWeights) != 0)
+		{
+			UINT32 size = numVertices * sizeof(BoneWeight);
+
+			input.getBoneWeights((BoneWeight*)buffer, size);
+			compressed.setBoneWeights((BoneWeight*)buffer, size);
+		}
+
+		bs_free(buffer);
+
+		if(meshData->getIndexType() == IT_32BIT)
+		{
+			UINT32* dst = output->getIndices32();
+			memcpy(dst, meshData->getIndices32(), numIndices * sizeof(UINT32));
+		}
+		else
+		{
+			UINT16* dst = output->getIndices16();
+			memcpy(dst, meshData->getIndices16(), numIndices * sizeof(UINT16));
+		}
+
+		return output;
+	}
+}
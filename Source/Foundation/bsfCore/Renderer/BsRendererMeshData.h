@@ -38,6 +38,25 @@ namespace bs
 		PNTU = Position | Normal | Tangent | UV0,
 	};
 
+	/** 
+	 * Vertex attributes that may be stored in a compressed format, reducing the memory and bandwidth required for 
+	 * rendering at the cost of precision. Normals and tangents are always stored compressed.
+	 */
+	enum class VertexCompressionFlag
+	{
+		None = 0,
+		/** Positions are quantized to 16 bits per component, relative to the bounds of the mesh. */
+		Position = 1 << 0,
+		/** Texture coordinates are stored as 16-bit floating point values. */
+		UV = 1 << 1,
+		/** Bone weights are quantized to 8 bits each. */
+		BoneWeights = 1 << 2,
+		All = Position | UV | BoneWeights
+	};
+
+	typedef Flags<VertexCompressionFlag> VertexCompression;
+	BS_FLAGS_OPERATORS(VertexCompressionFlag)
+
 	/** Contains mesh vertex and index data used for initializing, updating and reading mesh data from Mesh. */
 	class BS_CORE_EXPORT BS_SCRIPT_EXPORT(m:Rendering,n:MeshData) RendererMeshData
 	{
@@ -212,18 +231,37 @@ namespace bs
 		/**	Creates a new mesh data structure using an existing mesh data buffer. */
 		static SPtr<RendererMeshData> create(const SPtr<MeshData>& meshData);
 
-		/**	Creates a vertex descriptor from a vertex layout enum. */
-		static SPtr<VertexDataDesc> vertexLayoutVertexDesc(VertexLayout type);
+		/**	
+		 * Creates a vertex descriptor from a vertex layout enum, optionally storing some of the vertex attributes in 
+		 * compressed form.
+		 */
+		static SPtr<VertexDataDesc> vertexLayoutVertexDesc(VertexLayout type, 
+			VertexCompression compression = VertexCompressionFlag::None);
 
 		/** Converts a generic mesh data into mesh data format expected by the renderer. */
 		static SPtr<MeshData> convert(const SPtr<MeshData>& meshData);
 
+		/** 
+		 * Creates a copy of mesh data with the specified vertex attributes stored in compressed form. Input must be in the
+		 * format expected by the renderer (e.g. as created by RendererMeshData), except that normals, tangents and colors
+		 * may also be provided in full precision, in which case they are packed. Normals, tangents or colors in any
+		 * other format are dropped. Compressed positions are quantized relative to the bounds of the mesh, and are
+		 * decoded by the standard vertex input shader code.
+		 */
+		static SPtr<MeshData> compress(const SPtr<MeshData>& meshData, VertexCompression compression);
+
 	private:
 		friend class ct::Renderer;
 
 		RendererMeshData(UINT32 numVertices, UINT32 numIndices, VertexLayout layout, IndexType indexType = IT_32BIT);
 		RendererMeshData(const SPtr<MeshData>& meshData);
 
+		/** Reads the coordinates of the specified UV channel. See getUV0(). */
+		void getUV(UINT32 channel, Vector2* buffer, UINT32 size);
+
+		/** Writes the coordinates of the specified UV channel. See setUV0(). */
+		void setUV(UINT32 channel, Vector2* buffer, UINT32 size);
+
 		SPtr<MeshData> mMeshData;
 	};
 
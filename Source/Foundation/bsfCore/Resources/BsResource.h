@@ -49,6 +49,17 @@ namespace bs
 		 */
 		virtual bool isCompressible() const { return true; }
 
+		/**
+		 * Called after the resource was decoded from a stream containing an exact copy of the file the resource was
+		 * loaded from, i.e. when the file wasn't compressed. Allows the resource to read parts of its data from the file
+		 * on demand, instead of keeping them in memory. Only called if "streamFromSource" deserialization parameter was
+		 * provided.
+		 *
+		 * @param[in]	path	Path to the file the resource was loaded from.
+		 * @param[in]	offset	Offset in the file at which the stream the resource was decoded from starts.
+		 */
+		virtual void setSourceFile(const Path& path, UINT64 offset) { }
+
 		UINT32 mSize;
 		SPtr<ResourceMetaData> mMetaData;
 
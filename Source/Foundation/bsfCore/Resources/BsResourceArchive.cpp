@@ -0,0 +1,346 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Resources/BsResourceArchive.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsCompression.h"
+#include "Utility/BsBitwise.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	static_assert(sizeof(UUID) == 16, "UUID is written to the archive directly and must be 16 bytes.");
+
+	constexpr UINT32 ResourceArchive::ENTRY_ALIGNMENT;
+	constexpr UINT32 ResourceArchive::ENTRY_FLAG_COMPRESSED;
+
+	SPtr<ResourceArchive> ResourceArchive::open(const Path& path)
+	{
+		if (!FileSystem::isFile(path))
+		{
+			LOGWRN("Cannot open resource archive. Specified file: " + path.toString() + " doesn't exist.");
+			return nullptr;
+		}
+
+		SPtr<DataStream> file = FileSystem::openFile(path, true);
+		if (file == nullptr)
+			return nullptr;
+
+		Header header;
+		if (file->read(&header, sizeof(header)) != sizeof(header) || header.magic != MAGIC || header.version != VERSION ||
+			!Bitwise::isPow2(header.numIndexSlots))
+		{
+			LOGERR("Cannot open resource archive. File: " + path.toString() + " is not a valid resource archive.");
+			return nullptr;
+		}
+
+		SPtr<ResourceArchive> archive = bs_shared_ptr_new<ResourceArchive>(ConstructPrivately());
+		archive->mPath = path;
+		archive->mNumEntries = header.numEntries;
+		archive->mFile = file;
+
+		// Read the index
+		UINT64 fileSize = file->size();
+		UINT64 indexSize = header.numIndexSlots * (UINT64)sizeof(IndexEntry);
+		if (header.indexOffset > fileSize || indexSize > fileSize - header.indexOffset)
+		{
+			LOGERR("Cannot open resource archive. Index of file: " + path.toString() + " is corrupt.");
+			return nullptr;
+		}
+
+		archive->mIndex.resize(header.numIndexSlots);
+
+		file->seek((size_t)header.indexOffset);
+		if (file->read(archive->mIndex.data(), (size_t)indexSize) != indexSize)
+		{
+			LOGERR("Cannot open resource archive. Index of file: " + path.toString() + " is corrupt.");
+			return nullptr;
+		}
+
+		// Make sure all the entries are within the file, so reads never need to check
+		for (auto& entry : archive->mIndex)
+		{
+			if (entry.uuid.empty())
+				continue;
+
+			if (entry.offset > fileSize || entry.size > fileSize - entry.offset)
+			{
+				LOGERR("Cannot open resource archive. Entry " + entry.uuid.toString() + " of file: " + path.toString() +
+					" is out of bounds.");
+				return nullptr;
+			}
+		}
+
+		// Read the reference paths
+		file->seek((size_t)header.pathsOffset);
+
+		UINT64 pathsEnd = header.pathsOffset + header.pathsSize;
+		while (file->tell() < pathsEnd)
+		{
+			UUID uuid;
+			UINT32 length = 0;
+			if (file->read(&uuid, sizeof(uuid)) != sizeof(uuid) ||
+				file->read(&length, sizeof(length)) != sizeof(length) ||
+				length > pathsEnd - file->tell())
+			{
+				LOGERR("Cannot open resource archive. Path table of file: " + path.toString() + " is corrupt.");
+				return nullptr;
+			}
+
+			String pathStr(length, '\0');
+			if (length > 0 && file->read(&pathStr[0], length) != length)
+			{
+				LOGERR("Cannot open resource archive. Path table of file: " + path.toString() + " is corrupt.");
+				return nullptr;
+			}
+
+			archive->mPaths[Path(pathStr)] = uuid;
+		}
+
+		return archive;
+	}
+
+	bool ResourceArchive::pack(const Path& outputPath, const Vector<RESOURCE_ARCHIVE_ENTRY_DESC>& entries,
+		const Vector<UUID>& loadOrder, bool compress)
+	{
+		// Resources from the recorded load order go first, followed by any others
+		Vector<const RESOURCE_ARCHIVE_ENTRY_DESC*> orderedEntries;
+		orderedEntries.reserve(entries.size());
+
+		{
+			UnorderedMap<UUID, const RESOURCE_ARCHIVE_ENTRY_DESC*> entryLookup;
+			for (auto& entry : entries)
+				entryLookup[entry.uuid] = &entry;
+
+			for (auto& uuid : loadOrder)
+			{
+				auto iterFind = entryLookup.find(uuid);
+				if (iterFind == entryLookup.end() || iterFind->second == nullptr)
+					continue;
+
+				orderedEntries.push_back(iterFind->second);
+				iterFind->second = nullptr; // Ignore duplicates
+			}
+
+			for (auto& entry : entries)
+			{
+				auto iterFind = entryLookup.find(entry.uuid);
+				if (iterFind->second == &entry)
+				{
+					orderedEntries.push_back(&entry);
+					iterFind->second = nullptr;
+				}
+			}
+		}
+
+		Path parentDir = outputPath.getDirectory();
+		if (!FileSystem::exists(parentDir))
+			FileSystem::createDir(parentDir);
+
+		SPtr<DataStream> file = FileSystem::createAndOpenFile(outputPath);
+		if (file == nullptr)
+		{
+			LOGERR("Cannot create resource archive at path: " + outputPath.toString());
+			return false;
+		}
+
+		// Header gets written last, once offsets are known
+		Header header;
+		memset(&header, 0, sizeof(header));
+		file->write(&header, sizeof(header));
+
+		UINT32 numEntries = (UINT32)orderedEntries.size();
+		UINT32 numIndexSlots = Bitwise::nextPow2(std::max(numEntries * 2, 1U));
+
+		Vector<IndexEntry> index(numIndexSlots);
+		memset(index.data(), 0, numIndexSlots * sizeof(IndexEntry));
+
+		UINT8 padding[ENTRY_ALIGNMENT];
+		memset(padding, 0, sizeof(padding));
+
+		Vector<const RESOURCE_ARCHIVE_ENTRY_DESC*> packedEntries;
+		packedEntries.reserve(orderedEntries.size());
+
+		bool packedAll = true;
+		UINT64 offset = sizeof(header);
+		for (auto& entry : orderedEntries)
+		{
+			SPtr<DataStream> entryStream = FileSystem::openFile(entry->filePath, true);
+			if (entryStream == nullptr)
+			{
+				LOGERR("Cannot pack resource into archive. Unable to open: " + entry->filePath.toString());
+				packedAll = false;
+				continue;
+			}
+
+			SPtr<DataStream> data = bs_shared_ptr_new<MemoryDataStream>(entryStream);
+			UINT64 uncompressedSize = data->size();
+			UINT32 flags = 0;
+
+			if (compress && uncompressedSize > 0)
+			{
+				SPtr<DataStream> compressedData = Compression::compress(data);
+				if (compressedData->size() < uncompressedSize)
+				{
+					data = compressedData;
+					flags |= ENTRY_FLAG_COMPRESSED;
+				}
+			}
+
+			UINT64 alignedOffset = Math::divideAndRoundUp(offset, (UINT64)ENTRY_ALIGNMENT) * ENTRY_ALIGNMENT;
+			file->write(padding, (size_t)(alignedOffset - offset));
+
+			data->seek(0);
+			MemoryDataStream* memoryData = static_cast<MemoryDataStream*>(data.get());
+			file->write(memoryData->getPtr(), data->size());
+
+			// Insert into the index using linear probing
+			UINT32 slot = hashUUID(entry->uuid) & (numIndexSlots - 1);
+			while (!index[slot].uuid.empty())
+				slot = (slot + 1) & (numIndexSlots - 1);
+
+			IndexEntry& indexEntry = index[slot];
+			indexEntry.uuid = entry->uuid;
+			indexEntry.offset = alignedOffset;
+			indexEntry.size = data->size();
+			indexEntry.uncompressedSize = uncompressedSize;
+			indexEntry.flags = flags;
+
+			offset = alignedOffset + data->size();
+			packedEntries.push_back(entry);
+		}
+
+		// Write the index and the reference paths
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.numEntries = (UINT32)packedEntries.size();
+		header.numIndexSlots = numIndexSlots;
+		header.indexOffset = offset;
+
+		file->write(index.data(), numIndexSlots * sizeof(IndexEntry));
+		offset += numIndexSlots * sizeof(IndexEntry);
+
+		header.pathsOffset = offset;
+		for (auto& entry : packedEntries)
+		{
+			if (entry->referencePath.isEmpty())
+				continue;
+
+			String pathStr = entry->referencePath.toString();
+			UINT32 length = (UINT32)pathStr.size();
+
+			file->write(&entry->uuid, sizeof(entry->uuid));
+			file->write(&length, sizeof(length));
+			file->write(pathStr.data(), length);
+
+			offset += sizeof(entry->uuid) + sizeof(length) + length;
+		}
+
+		header.pathsSize = offset - header.pathsOffset;
+
+		file->seek(0);
+		file->write(&header, sizeof(header));
+		file->close();
+
+		if (!packedAll)
+		{
+			LOGERR("Resource archive at path: " + outputPath.toString() + " is missing " +
+				toString((UINT32)(orderedEntries.size() - packedEntries.size())) + " resource(s) that couldn't be packed.");
+		}
+
+		return packedAll;
+	}
+
+	bool ResourceArchive::findUUID(const Path& path, UUID& uuid) const
+	{
+		auto iterFind = mPaths.find(path);
+		if (iterFind == mPaths.end())
+			return false;
+
+		uuid = iterFind->second;
+		return true;
+	}
+
+	SPtr<DataStream> ResourceArchive::read(const UUID& uuid) const
+	{
+		const IndexEntry* entry = findEntry(uuid);
+		if (entry == nullptr)
+			return nullptr;
+
+		size_t size = (size_t)entry->size;
+		UINT8* data = (UINT8*)bs_alloc(size);
+
+		size_t readSize;
+		{
+			Lock lock(mMutex);
+
+			mFile->seek((size_t)entry->offset);
+			readSize = mFile->read(data, size);
+		}
+
+		if (readSize != size)
+		{
+			LOGERR("Failed to read resource " + uuid.toString() + " from archive: " + mPath.toString() + ". Expected " +
+				toString((UINT64)size) + " bytes but only " + toString((UINT64)readSize) + " were read.");
+
+			bs_free(data);
+			return nullptr;
+		}
+
+		SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data, size);
+		if ((entry->flags & ENTRY_FLAG_COMPRESSED) != 0)
+			stream = Compression::decompress(stream);
+
+		return stream;
+	}
+
+	bool ResourceArchive::getEntryLocation(const UUID& uuid, UINT64& offset, UINT64& size, bool& compressed) const
+	{
+		const IndexEntry* entry = findEntry(uuid);
+		if (entry == nullptr)
+			return false;
+
+		offset = entry->offset;
+		size = entry->size;
+		compressed = (entry->flags & ENTRY_FLAG_COMPRESSED) != 0;
+
+		return true;
+	}
+
+	const ResourceArchive::IndexEntry* ResourceArchive::findEntry(const UUID& uuid) const
+	{
+		if (mIndex.empty() || uuid.empty())
+			return nullptr;
+
+		// Index of a valid archive always has empty slots, but a corrupt one might not, so probing is bounded
+		UINT32 numSlots = (UINT32)mIndex.size();
+		UINT32 mask = numSlots - 1;
+		UINT32 slot = hashUUID(uuid) & mask;
+		for (UINT32 i = 0; i < numSlots && !mIndex[slot].uuid.empty(); i++)
+		{
+			if (mIndex[slot].uuid == uuid)
+				return &mIndex[slot];
+
+			slot = (slot + 1) & mask;
+		}
+
+		return nullptr;
+	}
+
+	UINT32 ResourceArchive::hashUUID(const UUID& uuid)
+	{
+		UINT32 data[4];
+		memcpy(data, &uuid, sizeof(data));
+
+		// FNV-1a over the four words, followed by a final mix so the low bits depend on the entire UUID
+		UINT32 hash = 2166136261U;
+		for (UINT32 i = 0; i < 4; i++)
+			hash = (hash ^ data[i]) * 16777619U;
+
+		hash ^= hash >> 16;
+		hash *= 0x85EBCA6BU;
+		hash ^= hash >> 13;
+
+		return hash;
+	}
+}
@@ -0,0 +1,142 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsUUID.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/** Information about a single resource to be packed into a ResourceArchive. */
+	struct RESOURCE_ARCHIVE_ENTRY_DESC
+	{
+		/** UUID of the resource. */
+		UUID uuid;
+
+		/** Location of the resource file, as saved by Resources::save(). */
+		Path filePath;
+
+		/**
+		 * Optional path the resource is referenced by when loading, e.g. through GameResourceManager. Allows the resource
+		 * to be found by path using ResourceArchive::findUUID().
+		 */
+		Path referencePath;
+	};
+
+	/**
+	 * Archive that stores many resources in a single file. Resources in an archive can be loaded without any file system
+	 * lookups, by registering the archive with Resources::registerArchive().
+	 *
+	 * The archive contains resource data followed by an index. The index is a hash table mapping resource UUIDs to the
+	 * location of their data, and is read into memory when the archive is opened. Each entry starts at a multiple of
+	 * ENTRY_ALIGNMENT so entries can be memory mapped, and may be individually compressed.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT ResourceArchive
+	{
+		struct ConstructPrivately {};
+
+		struct IndexEntry
+		{
+			UUID uuid;
+			UINT64 offset;
+			UINT64 size;
+			UINT64 uncompressedSize;
+			UINT32 flags;
+			UINT32 padding;
+		};
+
+		struct Header
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 numEntries;
+			UINT32 numIndexSlots;
+			UINT64 indexOffset;
+			UINT64 pathsOffset;
+			UINT64 pathsSize;
+		};
+
+	public:
+		explicit ResourceArchive(const ConstructPrivately& dummy) { }
+
+		/** Alignment of every entry in the archive, in bytes. */
+		static constexpr UINT32 ENTRY_ALIGNMENT = 4096;
+
+		/** Flag set on compressed entries. */
+		static constexpr UINT32 ENTRY_FLAG_COMPRESSED = 1 << 0;
+
+		/**
+		 * Opens an existing archive for reading. The file remains open for as long as the archive exists. Returns null if
+		 * the file doesn't exist or isn't a valid archive.
+		 */
+		static SPtr<ResourceArchive> open(const Path& path);
+
+		/**
+		 * Packs the provided resources into a new archive.
+		 *
+		 * @param[in]	outputPath	Path to write the archive to. Any existing file is overwritten.
+		 * @param[in]	entries		Resources to pack.
+		 * @param[in]	loadOrder	Order in which resources are expected to be loaded, normally recorded during a
+		 *							play-through using Resources::startLoadOrderRecording(). Resources in this list are
+		 *							written first and in this order, so loading them mostly reads the archive
+		 *							sequentially. Remaining resources follow in the order they were provided.
+		 * @param[in]	compress	If true, entries are compressed whenever that reduces their size.
+		 * @return					True if all the resources were packed. False if the archive couldn't be written, or
+		 *							if some resources couldn't be read, in which case the archive is written without
+		 *							them.
+		 */
+		static bool pack(const Path& outputPath, const Vector<RESOURCE_ARCHIVE_ENTRY_DESC>& entries,
+			const Vector<UUID>& loadOrder = {}, bool compress = true);
+
+		/** Checks if the archive contains a resource with the provided UUID. */
+		bool contains(const UUID& uuid) const { return findEntry(uuid) != nullptr; }
+
+		/** Finds the UUID of the resource packed with the provided reference path. Returns false if not found. */
+		bool findUUID(const Path& path, UUID& uuid) const;
+
+		/**
+		 * Reads the data of the resource with the provided UUID, in the same format as the resource file it was packed
+		 * from. Returns null if the archive doesn't contain the resource.
+		 */
+		SPtr<DataStream> read(const UUID& uuid) const;
+
+		/**
+		 * Returns the location of the data of the resource with the provided UUID within the archive file, allowing the
+		 * data to be read directly (e.g. asynchronously). If @p compressed is true the data must be decompressed using
+		 * Compression::decompress() before use. Returns false if the archive doesn't contain the resource.
+		 */
+		bool getEntryLocation(const UUID& uuid, UINT64& offset, UINT64& size, bool& compressed) const;
+
+		/** Returns the number of resources in the archive. */
+		UINT32 getNumEntries() const { return mNumEntries; }
+
+		/** Returns the path of the archive file. */
+		const Path& getPath() const { return mPath; }
+
+	private:
+		/** Returns the index entry for the provided UUID, or null if the archive doesn't contain it. */
+		const IndexEntry* findEntry(const UUID& uuid) const;
+
+		/** Hashes the UUID for the purposes of index lookup. Consistent across platforms. */
+		static UINT32 hashUUID(const UUID& uuid);
+
+		static constexpr UINT32 MAGIC = 0x4B505342; // "BSPK"
+		static constexpr UINT32 VERSION = 1;
+
+		Path mPath;
+		UINT32 mNumEntries = 0;
+		Vector<IndexEntry> mIndex;
+		UnorderedMap<Path, UUID> mPaths;
+
+		SPtr<DataStream> mFile;
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}
@@ -3,6 +3,7 @@
 #include "Resources/BsResources.h"
 #include "Resources/BsResource.h"
 #include "Resources/BsResourceManifest.h"
+#include "Resources/BsResourceArchive.h"
 #include "Error/BsException.h"
 #include "Serialization/BsFileSerializer.h"
 #include "FileSystem/BsFileSystem.h"
@@ -16,6 +17,7 @@
 #include "Utility/BsCompression.h"
 #include "FileSystem/BsDataStream.h"
 #include "Serialization/BsBinarySerializer.h"
+#include "FileSystem/BsAsyncFileIO.h"
 
 namespace bs
 {
@@ -153,27 +155,44 @@ namespace bs
 				}
 			}
 
-			// If we have nowhere to load from, warn and complete load if a file path was provided, otherwise pass through
-			// as we might just want to complete a previously queued load 
-			if (filePath.isEmpty())
+			// Resources contained in a registered archive are read from it, and don't require a file path
+			SPtr<ResourceArchive> archive = findArchive(uuid);
+			if (archive == nullptr)
 			{
-				if (!alreadyLoading)
+				// If we have nowhere to load from, warn and complete load if a file path was provided, otherwise pass
+				// through as we might just want to complete a previously queued load 
+				if (filePath.isEmpty())
 				{
-					LOGWRN_VERBOSE("Cannot load resource. Resource with UUID '" + UUID + "' doesn't exist.");
+					if (!alreadyLoading)
+					{
+						LOGWRN_VERBOSE("Cannot load resource. Resource with UUID '" + UUID + "' doesn't exist.");
+						loadFailed = true;
+					}
+				}
+				else if (!FileSystem::isFile(filePath))
+				{
+					LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
 					loadFailed = true;
 				}
 			}
-			else if (!FileSystem::isFile(filePath))
-			{
-				LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
-				loadFailed = true;
-			}
 
 			if(!loadFailed)
 			{
 				// Load dependency data if a file path is provided
 				SPtr<SavedResourceData> savedResourceData;
-				if (!filePath.isEmpty())
+				if (archive != nullptr)
+				{
+					SPtr<DataStream> stream = archive->read(uuid);
+					if (stream != nullptr && !stream->eof())
+					{
+						UINT32 objectSize = 0;
+						stream->read(&objectSize, sizeof(objectSize));
+
+						BinarySerializer bs;
+						savedResourceData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize));
+					}
+				}
+				else if (!filePath.isEmpty())
 				{
 					FileDecoder fs(filePath);
 					savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
@@ -273,7 +292,7 @@ namespace bs
 					}
 				}
 
-				initiateLoad = !alreadyLoading && !filePath.isEmpty();
+				initiateLoad = !alreadyLoading && (archive != nullptr || !filePath.isEmpty());
 
 				if(savedResourceData != nullptr)
 					synchronous = synchronous & savedResourceData->allowAsyncLoading();
@@ -300,15 +319,20 @@ namespace bs
 			{
 				loadCallback(filePath, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
 			}
-			else // Asynchronous, read the file on a worker thread
+			else // Asynchronous, read the file without blocking and process it on worker threads
 			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
-
 				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
+				if (AsyncFileIO::isStarted())
+					queueAsyncLoad(outputResource, filePath, keepSourceData);
+				else
+				{
+					String fileName = !filePath.isEmpty() ? filePath.getFilename() : uuid.toString();
+					String taskName = "Resource load: " + fileName;
+
+					SPtr<Task> task = Task::create(taskName, 
+						std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
+					TaskScheduler::instance().addTask(task);
+				}
 			}
 		}
 		else
@@ -345,14 +369,43 @@ namespace bs
 		return outputResource;
 	}
 
-	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
+	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const UUID& uuid, const Path& filePath, bool loadWithSaveData)
 	{
-		Lock fileLock = FileScheduler::getLock(filePath);
-
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
+		// Loose files might be getting written to by another thread, so they stay locked until decoded
+		Lock fileLock;
+		SPtr<DataStream> stream = openResourceStream(uuid, filePath, fileLock);
 		if (stream == nullptr)
 			return nullptr;
 
+		recordLoad(uuid);
+
+		// Find the file the stream was read from, unless the data was compressed
+		Path sourceFile = filePath;
+		UINT64 sourceOffset = 0;
+
+		SPtr<ResourceArchive> archive = findArchive(uuid);
+		if (archive != nullptr)
+		{
+			UINT64 size;
+			bool compressed;
+			archive->getEntryLocation(uuid, sourceOffset, size, compressed);
+
+			sourceFile = compressed ? Path::BLANK : archive->getPath();
+		}
+
+		SPtr<DataStream> fileStream = stream;
+
+		UINT32 objectSize = 0;
+		stream = readResourceData(stream, objectSize, loadWithSaveData);
+
+		if (stream != fileStream)
+			sourceFile = Path::BLANK;
+
+		return decodeResource(stream, objectSize, uuid, filePath, loadWithSaveData, sourceFile, sourceOffset);
+	}
+
+	SPtr<DataStream> Resources::readResourceData(SPtr<DataStream> stream, UINT32& objectSize, bool loadWithSaveData)
+	{
 		if (stream->size() > std::numeric_limits<UINT32>::max())
 		{
 			BS_EXCEPT(InternalErrorException,
@@ -368,33 +421,47 @@ namespace bs
 		{
 			if (!stream->eof())
 			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
+				UINT32 metaDataSize = 0;
+				stream->read(&metaDataSize, sizeof(metaDataSize));
 
 				BinarySerializer bs;
-				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
+				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, metaDataSize, params));
 			}
 		}
 
+		if (metaData == nullptr || stream->eof())
+			return nullptr;
+
+		// Prepare resource data
+		stream->read(&objectSize, sizeof(objectSize));
+
+		if (metaData->getCompressionMethod() != 0)
+			stream = Compression::decompress(stream);
+
+		return stream;
+	}
+
+	SPtr<Resource> Resources::decodeResource(const SPtr<DataStream>& stream, UINT32 objectSize, const UUID& uuid,
+		const Path& filePath, bool loadWithSaveData, const Path& sourceFile, UINT64 sourceOffset)
+	{
+		UnorderedMap<String, UINT64> params;
+		if(loadWithSaveData)
+			params["keepSourceData"] = 1;
+
+		if(!sourceFile.isEmpty())
+			params["streamFromSource"] = 1;
+
 		// Read resource data
 		SPtr<IReflectable> loadedData;
+		if(stream != nullptr)
 		{
-			if(metaData && !stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
-
-				if (metaData->getCompressionMethod() != 0)
-					stream = Compression::decompress(stream);
-
-				BinarySerializer bs;
-				loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
-			}
+			BinarySerializer bs;
+			loadedData = bs.decode(stream, objectSize, params);
 		}
 
 		if (loadedData == nullptr)
 		{
-			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
+			LOGERR("Unable to load resource with UUID \"" + uuid.toString() + "\" at path \"" + filePath.toString() + "\"");
 		}
 		else
 		{
@@ -403,9 +470,82 @@ namespace bs
 		}
 
 		SPtr<Resource> resource = std::static_pointer_cast<Resource>(loadedData);
+		if (resource != nullptr && !sourceFile.isEmpty())
+			resource->setSourceFile(sourceFile, sourceOffset);
+
 		return resource;
 	}
 
+	void Resources::queueAsyncLoad(const HResource& resource, const Path& filePath, bool loadWithSaveData)
+	{
+		const UUID& uuid = resource.getUUID();
+		recordLoad(uuid);
+
+		ASYNC_READ_DESC readDesc;
+		bool compressed = false;
+
+		SPtr<ResourceArchive> archive = findArchive(uuid);
+		if (archive != nullptr)
+		{
+			readDesc.path = archive->getPath();
+			archive->getEntryLocation(uuid, readDesc.offset, readDesc.size, compressed);
+		}
+		else
+			readDesc.path = filePath;
+
+		String name = !filePath.isEmpty() ? filePath.getFilename() : uuid.toString();
+
+		// Once read, decompress and decode in separate tasks so workers never wait on the disk, and so decoding of one
+		// resource can overlap with decompression of another
+		Path sourceFile = readDesc.path;
+		UINT64 sourceOffset = readDesc.offset;
+
+		readDesc.callback = [this, resource, filePath, name, compressed, loadWithSaveData, sourceFile, sourceOffset]
+			(const SPtr<MemoryDataStream>& data)
+		{
+			SPtr<Task> decompressTask = Task::create("Resource decompress: " + name, 
+				[this, resource, filePath, name, compressed, loadWithSaveData, sourceFile, sourceOffset, data]()
+			{
+				UINT32 objectSize = 0;
+				SPtr<DataStream> stream = data;
+
+				if (stream != nullptr)
+				{
+					if (compressed)
+						stream = Compression::decompress(stream);
+
+					stream = readResourceData(stream, objectSize, loadWithSaveData);
+				}
+
+				// Parts of the resource can only be read from the file later if the data wasn't compressed
+				Path decodeSourceFile = stream == data ? sourceFile : Path::BLANK;
+
+				SPtr<Task> decodeTask = Task::create("Resource decode: " + name, 
+					[this, resource, filePath, loadWithSaveData, stream, objectSize, decodeSourceFile, sourceOffset]()
+				{
+					SPtr<Resource> rawResource = decodeResource(stream, objectSize, resource.getUUID(), filePath,
+						loadWithSaveData, decodeSourceFile, sourceOffset);
+
+					HResource handle = resource;
+					finishLoad(handle, rawResource);
+				});
+
+				TaskScheduler::instance().addTask(decodeTask);
+			});
+
+			TaskScheduler::instance().addTask(decompressTask);
+		};
+
+		AsyncFileIO::instance().read(readDesc);
+	}
+
+	void Resources::recordLoad(const UUID& uuid)
+	{
+		Lock lock(mLoadOrderMutex);
+		if (mRecordLoadOrder)
+			mLoadOrder.push_back(uuid);
+	}
+
 	void Resources::release(ResourceHandleBase& resource)
 	{
 		const UUID& uuid = resource.getUUID();
@@ -620,42 +760,45 @@ namespace bs
 		else
 			savePath = filePath;
 		
-		Lock fileLock = FileScheduler::getLock(filePath);
-
-		std::ofstream stream;
-		stream.open(savePath.toPlatformString().c_str(), std::ios::out | std::ios::binary);
-		if (stream.fail())
-			LOGWRN("Failed to save file: \"" + filePath.toString() + "\". Error: " + strerror(errno) + ".");
-	
-		// Write meta-data
+		// Encode before locking the file, as encoding can read from files (e.g. streamed texture data)
+		UINT32 numMetaDataBytes = 0;
+		UINT8* metaDataBytes;
 		{
 			MemorySerializer ms;
-			UINT32 numBytes = 0;
-			UINT8* bytes = ms.encode(resourceData.get(), numBytes);
-			
-			stream.write((char*)&numBytes, sizeof(numBytes));
-			stream.write((char*)bytes, numBytes);
-			
-			bs_free(bytes);
+			metaDataBytes = ms.encode(resourceData.get(), numMetaDataBytes);
 		}
 
-		// Write object data
+		UINT32 numObjectBytes = 0;
+		SPtr<MemoryDataStream> objStream;
 		{
 			MemorySerializer ms;
-			UINT32 numBytes = 0;
-			UINT8* bytes = ms.encode(resource.get(), numBytes);
+			UINT8* bytes = ms.encode(resource.get(), numObjectBytes);
 
-			SPtr<MemoryDataStream> objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, numBytes);
+			objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, numObjectBytes);
 			if (compressionMethod != 0)
 			{
 				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
 				objStream = Compression::compress(srcStream);
 			}
-
-			stream.write((char*)&numBytes, sizeof(numBytes));
-			stream.write((char*)objStream->getPtr(), objStream->size());
 		}
 
+		Lock fileLock = FileScheduler::getLock(filePath);
+
+		std::ofstream stream;
+		stream.open(savePath.toPlatformString().c_str(), std::ios::out | std::ios::binary);
+		if (stream.fail())
+			LOGWRN("Failed to save file: \"" + filePath.toString() + "\". Error: " + strerror(errno) + ".");
+	
+		// Write meta-data
+		stream.write((char*)&numMetaDataBytes, sizeof(numMetaDataBytes));
+		stream.write((char*)metaDataBytes, numMetaDataBytes);
+
+		bs_free(metaDataBytes);
+
+		// Write object data
+		stream.write((char*)&numObjectBytes, sizeof(numObjectBytes));
+		stream.write((char*)objStream->getPtr(), objStream->size());
+
 		stream.close();
 		stream.clear();
 
@@ -888,8 +1031,12 @@ namespace bs
 
 	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
 	{
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
+		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(resource.getUUID(), filePath, loadWithSaveData);
+		finishLoad(resource, rawResource);
+	}
 
+	void Resources::finishLoad(HResource& resource, const SPtr<Resource>& rawResource)
+	{
 		{
 			Lock lock(mInProgressResourcesMutex);
 
@@ -902,6 +1049,70 @@ namespace bs
 		loadComplete(resource);
 	}
 
+	void Resources::registerArchive(const SPtr<ResourceArchive>& archive)
+	{
+		Lock lock(mArchivesMutex);
+
+		auto findIter = std::find(mArchives.begin(), mArchives.end(), archive);
+		if(findIter == mArchives.end())
+			mArchives.push_back(archive);
+	}
+
+	void Resources::unregisterArchive(const SPtr<ResourceArchive>& archive)
+	{
+		Lock lock(mArchivesMutex);
+
+		auto findIter = std::find(mArchives.begin(), mArchives.end(), archive);
+		if (findIter != mArchives.end())
+			mArchives.erase(findIter);
+	}
+
+	SPtr<ResourceArchive> Resources::findArchive(const UUID& uuid) const
+	{
+		Lock lock(mArchivesMutex);
+
+		for (auto iter = mArchives.rbegin(); iter != mArchives.rend(); ++iter)
+		{
+			if ((*iter)->contains(uuid))
+				return *iter;
+		}
+
+		return nullptr;
+	}
+
+	SPtr<DataStream> Resources::openResourceStream(const UUID& uuid, const Path& filePath, Lock& fileLock) const
+	{
+		SPtr<ResourceArchive> archive = findArchive(uuid);
+		if (archive != nullptr)
+			return archive->read(uuid);
+
+		if (filePath.isEmpty())
+			return nullptr;
+
+		fileLock = FileScheduler::getLock(filePath);
+		return FileSystem::openFile(filePath, true);
+	}
+
+	void Resources::startLoadOrderRecording()
+	{
+		Lock lock(mLoadOrderMutex);
+
+		mLoadOrder.clear();
+		mRecordLoadOrder = true;
+	}
+
+	Vector<UUID> Resources::stopLoadOrderRecording()
+	{
+		Lock lock(mLoadOrderMutex);
+
+		mRecordLoadOrder = false;
+
+		Vector<UUID> output;
+		std::swap(output, mLoadOrder);
+
+		return output;
+	}
+
 	BS_CORE_EXPORT Resources& gResources()
 	{
 		return Resources::instance();
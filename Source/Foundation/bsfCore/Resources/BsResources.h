@@ -251,6 +251,24 @@ namespace bs
 		 */
 		SPtr<ResourceManifest> getResourceManifest(const String& name) const;
 
+		/**
+		 * Registers a resource archive. Any resources contained in the archive will be read from it when loaded by UUID,
+		 * instead of from their individual files. Archives registered later take priority.
+		 */
+		void registerArchive(const SPtr<ResourceArchive>& archive);
+
+		/**	Unregisters a resource archive previously registered with registerArchive(). */
+		void unregisterArchive(const SPtr<ResourceArchive>& archive);
+
+		/**
+		 * Starts recording the order in which resources are read. Recorded order can be provided to
+		 * ResourceArchive::pack() so that resources are laid out in the archive in the order they will be loaded.
+		 */
+		void startLoadOrderRecording();
+
+		/** Stops recording started with startLoadOrderRecording() and returns UUIDs of all resources read in between. */
+		Vector<UUID> stopLoadOrderRecording();
+
 		/** Attempts to retrieve file path from the provided UUID. Returns true if successful, false otherwise. */
 		bool getFilePathFromUUID(const UUID& uuid, Path& filePath) const;
 
@@ -314,7 +332,43 @@ namespace bs
 		HResource loadInternal(const UUID& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags);
 
 		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
-		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
+		SPtr<Resource> loadFromDiskAndDeserialize(const UUID& uuid, const Path& filePath, bool loadWithSaveData);
+
+		/**
+		 * Reads the resource meta-data from the provided stream, and decompresses the resource data if required. Returns
+		 * a stream positioned at the start of the resource object of @p objectSize bytes, or null if the data is invalid.
+		 */
+		SPtr<DataStream> readResourceData(SPtr<DataStream> stream, UINT32& objectSize, bool loadWithSaveData);
+
+		/**
+		 * Deserializes the resource object from a stream returned by readResourceData(). If the stream is an exact copy
+		 * of a file, @p sourceFile and @p sourceOffset should be set to the file and the offset in the file at which the
+		 * stream starts, allowing the resource to read parts of its data from the file on demand.
+		 */
+		SPtr<Resource> decodeResource(const SPtr<DataStream>& stream, UINT32 objectSize, const UUID& uuid,
+			const Path& filePath, bool loadWithSaveData, const Path& sourceFile = Path::BLANK, UINT64 sourceOffset = 0);
+
+		/**
+		 * Starts an asynchronous load of the provided resource. The load is split into stages: the data is read using
+		 * AsyncFileIO without occupying any worker threads, after which it is decompressed and decoded in separate tasks.
+		 */
+		void queueAsyncLoad(const HResource& resource, const Path& filePath, bool loadWithSaveData);
+
+		/** Records the read of the provided resource if load order recording is active. */
+		void recordLoad(const UUID& uuid);
+
+		/**
+		 * Returns the archive containing the resource with the provided UUID, or null if the resource isn't contained in
+		 * any registered archive.
+		 */
+		SPtr<ResourceArchive> findArchive(const UUID& uuid) const;
+
+		/**
+		 * Opens a stream containing the data of the resource with the provided UUID. The data is read from a registered
+		 * archive if possible, or from the provided file path otherwise. When reading from a file, @p fileLock is set to
+		 * the file's FileScheduler lock, which must be held for as long as the stream is being read.
+		 */
+		SPtr<DataStream> openResourceStream(const UUID& uuid, const Path& filePath, Lock& fileLock) const;
 
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource);
@@ -322,6 +376,9 @@ namespace bs
 		/**	Callback triggered when the task manager is ready to process the loading task. */
 		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
 
+		/** Assigns the loaded resource data to its handle and finalizes the load, once the data has been read. */
+		void finishLoad(HResource& resource, const SPtr<Resource>& rawResource);
+
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
 
@@ -329,6 +386,13 @@ namespace bs
 		Vector<SPtr<ResourceManifest>> mResourceManifests;
 		SPtr<ResourceManifest> mDefaultResourceManifest;
 
+		Vector<SPtr<ResourceArchive>> mArchives;
+		mutable Mutex mArchivesMutex;
+
+		Vector<UUID> mLoadOrder;
+		bool mRecordLoadOrder = false;
+		Mutex mLoadOrderMutex;
+
 		Mutex mInProgressResourcesMutex;
 		Mutex mLoadedResourceMutex;
 		RecursiveMutex mDestroyMutex;
@@ -298,6 +298,41 @@ namespace bs
 		notifyTransformChanged(TCF_Transform);
 	}
 
+	void SceneObject::_setWorldTransforms(SceneObject* const* objects, const Vector3* positions,
+		const Quaternion* rotations, UINT32 count)
+	{
+		// Write all the transforms first, only marking the cached transforms as dirty
+		for (UINT32 i = 0; i < count; i++)
+		{
+			SceneObject* so = objects[i];
+			if (so->mMobility != ObjectMobility::Movable)
+				continue;
+
+			if (so->mParent != nullptr)
+			{
+				const Transform& parentTfrm = so->mParent->getTransform();
+
+				so->mLocalTfrm.setWorldPosition(positions[i], parentTfrm);
+				so->mLocalTfrm.setWorldRotation(rotations[i], parentTfrm);
+			}
+			else
+			{
+				so->mLocalTfrm.setPosition(positions[i]);
+				so->mLocalTfrm.setRotation(rotations[i]);
+			}
+
+			so->markTransformDirty(TCF_Transform);
+		}
+
+		// Then notify the components, once per object rather than once per changed property
+		for (UINT32 i = 0; i < count; i++)
+		{
+			SceneObject* so = objects[i];
+			if (so->mMobility == ObjectMobility::Movable)
+				so->notifyComponentsTransformChanged(TCF_Transform);
+		}
+	}
+
 	const Transform& SceneObject::getTransform() const
 	{ 
 		if (!isCachedWorldTfrmUpToDate())
@@ -425,16 +460,35 @@ namespace bs
 
 	void SceneObject::notifyTransformChanged(TransformChangedFlags flags) const
 	{
-		// If object is immovable, don't send transform changed events nor mark the transform dirty
-		TransformChangedFlags componentFlags = flags;
-		if (mMobility != ObjectMobility::Movable)
-			componentFlags = (TransformChangedFlags)(componentFlags & ~TCF_Transform);
-		else
+		markTransformDirty(flags);
+		notifyComponentsTransformChanged(flags);
+	}
+
+	void SceneObject::markTransformDirty(TransformChangedFlags flags) const
+	{
+		// If object is immovable, don't mark the transform dirty
+		if (mMobility == ObjectMobility::Movable)
 		{
 			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 			mDirtyHash++;
 		}
 
+		// Mobility flag is only relevant for this scene object
+		flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
+		if (flags != 0)
+		{
+			for (auto& entry : mChildren)
+				entry->markTransformDirty(flags);
+		}
+	}
+
+	void SceneObject::notifyComponentsTransformChanged(TransformChangedFlags flags) const
+	{
+		// If object is immovable, don't send transform changed events
+		TransformChangedFlags componentFlags = flags;
+		if (mMobility != ObjectMobility::Movable)
+			componentFlags = (TransformChangedFlags)(componentFlags & ~TCF_Transform);
+
 		// Only send component flags if we haven't removed them all
 		if (componentFlags != 0)
 		{
@@ -454,7 +508,7 @@ namespace bs
 		if (flags != 0)
 		{
 			for (auto& entry : mChildren)
-				entry->notifyTransformChanged(flags);
+				entry->notifyComponentsTransformChanged(flags);
 		}
 	}
 
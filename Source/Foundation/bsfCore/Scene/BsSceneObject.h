@@ -145,6 +145,20 @@ namespace bs
 		/** Recursively disables the provided set of flags on this object and all children. */
 		void _unsetFlags(UINT32 flags);
 
+		/**
+		 * Sets the world position and rotation of multiple scene objects at once. This is more efficient than calling
+		 * setWorldPosition() and setWorldRotation() on each object. All transforms are written in a single pass, and
+		 * change notifications to components are deferred until all the transforms have been written, after which a
+		 * single notification is sent per object.
+		 *
+		 * @param[in]	objects		Objects whose transforms to update.
+		 * @param[in]	positions	New world positions, one per object.
+		 * @param[in]	rotations	New world rotations, one per object.
+		 * @param[in]	count		Number of entries in the provided arrays.
+		 */
+		static void _setWorldTransforms(SceneObject* const* objects, const Vector3* positions,
+			const Quaternion* rotations, UINT32 count);
+
 		/** @} */
 
 	private:
@@ -320,6 +334,21 @@ namespace bs
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
+		/** 
+		 * Marks the cached transforms of this object and its children as dirty, without notifying any components. 
+		 * 
+		 * @param	flags		Specifies in what way was the transform changed.
+		 */
+		void markTransformDirty(TransformChangedFlags flags) const;
+
+		/** 
+		 * Notifies components of this object and its children that a transform has been changed, without marking the 
+		 * transforms dirty.
+		 * 
+		 * @param	flags		Specifies in what way was the transform changed.
+		 */
+		void notifyComponentsTransformChanged(TransformChangedFlags flags) const;
+
 		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
 		void updateLocalTfrm() const;
 
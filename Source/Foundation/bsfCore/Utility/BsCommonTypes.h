@@ -297,7 +297,14 @@ namespace bs
 	enum GpuParamBlockUsage
 	{
 		GPBU_STATIC, /**< Buffer will be rarely, if ever, updated. */
-		GPBU_DYNAMIC /**< Buffer will be updated often (for example every frame). */
+		GPBU_DYNAMIC, /**< Buffer will be updated often (for example every frame). */
+		/** 
+		 * Buffer contents are only valid for the frame they were written in. Contents are sub-allocated from a large 
+		 * per-frame buffer shared by all transient buffers and bound using an offset, on render backends that support
+		 * it. Otherwise equivalent to GPBU_DYNAMIC.
+		 */
+		GPBU_TRANSIENT
+
 	};
 
 	/** Type of a parameter in a GPU program. */
@@ -22,6 +22,10 @@
 #include "Platform/BsPlatform.h"
 #include "Resources/BsEngineShaderIncludeHandler.h"
 #include "Resources/BsResources.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
+#include "Managers/BsGpuProgramManager.h"
+#include "Utility/BsPaths.h"
 #include "BsEngineConfig.h"
 
 namespace bs
@@ -53,6 +57,15 @@ namespace bs
 		PlainTextImporter* importer = bs_new<PlainTextImporter>();
 		Importer::instance()._registerAssetImporter(importer);
 
+		// Use precompiled shader bytecode where available, so shaders don't need to be compiled at load time
+		const RenderAPIInfo& apiInfo = ct::RenderAPI::instance().getAPIInfo();
+		if (!mStartUpDesc.bytecodeCache.isEmpty() && apiInfo.isFlagSet(RenderAPIFeatureFlag::ByteCodeCaching))
+		{
+			SPtr<ct::GpuProgramBytecodeCache> bytecodeCache = 
+				bs_shared_ptr_new<ct::GpuProgramBytecodeCache>(mStartUpDesc.bytecodeCache);
+			ct::GpuProgramManager::instance().setBytecodeCache(bytecodeCache);
+		}
+
 		VirtualInput::startUp();
 		BuiltinResources::startUp();
 		RendererMaterialManager::startUp();
@@ -254,7 +254,7 @@ namespace bs
 			rows.resize(curIdx);
 		}
 
-		void addData(const String& name, float timeMs)
+		void addData(const GPUProfileSample& sample)
 		{
 			if (curIdx >= rows.size())
 			{
@@ -265,19 +265,115 @@ namespace bs
 				newRow.disabled = false;
 				newRow.name = HEString(u8"{1}");
 				newRow.time = HEString(u8"{0}");
+				newRow.cpuTime = HEString(u8"{0}");
+				newRow.drawCalls = HEString(u8"{0}");
+				newRow.stateChanges = HEString(u8"{0}");
+				newRow.paramBinds = HEString(u8"{0}");
+				newRow.bufferBinds = HEString(u8"{0}");
 
 				newRow.layout = layout.insertNewElement<GUILayoutX>(layout.getNumChildren());
 
-				newRow.guiName = newRow.layout->addNewElement<GUILabel>(newRow.name, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiName = newRow.layout->addNewElement<GUILabel>(newRow.name, GUIOptions(GUIOption::fixedWidth(150)));
 				newRow.guiTime = newRow.layout->addNewElement<GUILabel>(newRow.time, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiCPUTime = newRow.layout->addNewElement<GUILabel>(newRow.cpuTime, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiDrawCalls = newRow.layout->addNewElement<GUILabel>(newRow.drawCalls, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiStateChanges = newRow.layout->addNewElement<GUILabel>(newRow.stateChanges, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiParamBinds = newRow.layout->addNewElement<GUILabel>(newRow.paramBinds, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiBufferBinds = newRow.layout->addNewElement<GUILabel>(newRow.bufferBinds, GUIOptions(GUIOption::fixedWidth(100)));
 			}
 
 			ProfilerOverlayInternal::GPUSampleRow& row = rows[curIdx];
-			row.name.setParameter(0, name);
-			row.time.setParameter(0, toString(timeMs));
+			row.name.setParameter(0, sample.name);
+			row.time.setParameter(0, toString(sample.timeMs));
+			row.cpuTime.setParameter(0, toString(sample.cpuTimeMs));
+			row.drawCalls.setParameter(0, toString(sample.numDrawCalls));
+			row.stateChanges.setParameter(0, toString(sample.numPipelineStateChanges));
+			row.paramBinds.setParameter(0, toString(sample.numGpuParamBinds));
+			row.bufferBinds.setParameter(0, toString(sample.numVertexBufferBinds + sample.numIndexBufferBinds));
 
 			row.guiName->setContent(row.name);
 			row.guiTime->setContent(row.time);
+			row.guiCPUTime->setContent(row.cpuTime);
+			row.guiDrawCalls->setContent(row.drawCalls);
+			row.guiStateChanges->setContent(row.stateChanges);
+			row.guiParamBinds->setContent(row.paramBinds);
+			row.guiBufferBinds->setContent(row.bufferBinds);
+
+			if (row.disabled)
+			{
+				row.layout->setVisible(true);
+				row.disabled = false;
+			}
+
+			curIdx++;
+		}
+	};
+
+	class MemoryRowFiller
+	{
+	public:
+		UINT32 curIdx;
+		GUILayout& layout;
+		GUIWidget& widget;
+		Vector<ProfilerOverlayInternal::MemoryRow>& rows;
+
+		MemoryRowFiller(Vector<ProfilerOverlayInternal::MemoryRow>& _rows, GUILayout& _layout, GUIWidget& _widget)
+			:curIdx(0), layout(_layout), widget(_widget), rows(_rows)
+		{ }
+
+		~MemoryRowFiller()
+		{
+			UINT32 excessEntries = (UINT32)rows.size() - curIdx;
+			for (UINT32 i = 0; i < excessEntries; i++)
+			{
+				ProfilerOverlayInternal::MemoryRow& row = rows[curIdx + i];
+
+				if (!row.disabled)
+				{
+					row.layout->setVisible(false);
+					row.disabled = true;
+				}
+			}
+
+			rows.resize(curIdx);
+		}
+
+		void addData(const MemoryCategoryStats& stats)
+		{
+			if (curIdx >= rows.size())
+			{
+				rows.push_back(ProfilerOverlayInternal::MemoryRow());
+
+				ProfilerOverlayInternal::MemoryRow& newRow = rows.back();
+
+				newRow.disabled = false;
+				newRow.name = HEString(u8"{0}");
+				newRow.liveBytes = HEString(u8"{0}");
+				newRow.peakBytes = HEString(u8"{0}");
+				newRow.numAllocs = HEString(u8"{0}");
+				newRow.numFrees = HEString(u8"{0}");
+
+				newRow.layout = layout.insertNewElement<GUILayoutX>(layout.getNumChildren());
+
+				newRow.guiName = newRow.layout->addNewElement<GUILabel>(newRow.name, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiLiveBytes = newRow.layout->addNewElement<GUILabel>(newRow.liveBytes, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiPeakBytes = newRow.layout->addNewElement<GUILabel>(newRow.peakBytes, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiNumAllocs = newRow.layout->addNewElement<GUILabel>(newRow.numAllocs, GUIOptions(GUIOption::fixedWidth(100)));
+				newRow.guiNumFrees = newRow.layout->addNewElement<GUILabel>(newRow.numFrees, GUIOptions(GUIOption::fixedWidth(100)));
+			}
+
+			ProfilerOverlayInternal::MemoryRow& row = rows[curIdx];
+			row.name.setParameter(0, stats.name);
+			row.liveBytes.setParameter(0, toMegabytes(stats.liveBytes));
+			row.peakBytes.setParameter(0, toMegabytes(stats.peakBytes));
+			row.numAllocs.setParameter(0, toString(stats.numAllocs));
+			row.numFrees.setParameter(0, toString(stats.numFrees));
+
+			row.guiName->setContent(row.name);
+			row.guiLiveBytes->setContent(row.liveBytes);
+			row.guiPeakBytes->setContent(row.peakBytes);
+			row.guiNumAllocs->setContent(row.numAllocs);
+			row.guiNumFrees->setContent(row.numFrees);
 
 			if (row.disabled)
 			{
@@ -287,6 +383,13 @@ namespace bs
 
 			curIdx++;
 		}
+
+	private:
+		/** Converts a number of bytes into a string displaying the amount in megabytes. */
+		static String toMegabytes(INT64 bytes)
+		{
+			return toString(bytes / (1024.0 * 1024.0), 2, 0, ' ', std::ios::fixed) + " MB";
+		}
 	};
 
 	const UINT32 ProfilerOverlayInternal::MAX_DEPTH = 4;
@@ -451,8 +554,18 @@ namespace bs
 
 		HString gpuSamplesNameStr(u8"__ProfOvGPUSampName", u8"Name");
 		HString gpuSamplesTimeStr(u8"__ProfOvGPUSampTime", u8"Time");
-		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesNameStr, GUIOptions(GUIOption::fixedWidth(100))));
+		HString gpuSamplesCPUTimeStr(u8"__ProfOvGPUSampCPUTime", u8"CPU time");
+		HString gpuSamplesDrawCallsStr(u8"__ProfOvGPUSampDrawCalls", u8"Draw calls");
+		HString gpuSamplesStateChangesStr(u8"__ProfOvGPUSampPSChanges", u8"State changes");
+		HString gpuSamplesParamBindsStr(u8"__ProfOvGPUSampParamBinds", u8"Param. binds");
+		HString gpuSamplesBufferBindsStr(u8"__ProfOvGPUSampBufferBinds", u8"VB/IB binds");
+		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesNameStr, GUIOptions(GUIOption::fixedWidth(150))));
 		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesTimeStr, GUIOptions(GUIOption::fixedWidth(100))));
+		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesCPUTimeStr, GUIOptions(GUIOption::fixedWidth(100))));
+		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesDrawCallsStr, GUIOptions(GUIOption::fixedWidth(100))));
+		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesStateChangesStr, GUIOptions(GUIOption::fixedWidth(100))));
+		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesParamBindsStr, GUIOptions(GUIOption::fixedWidth(100))));
+		gpuSampleTitleRow->addElement(GUILabel::create(gpuSamplesBufferBindsStr, GUIOptions(GUIOption::fixedWidth(100))));
 
 		mGPUFrameNumStr = HEString(u8"__ProfOvFrame", u8"Frame #{0}");
 		mGPUTimeStr = HEString(u8"__ProfOvTime", u8"Time: {0}ms");
@@ -513,18 +626,38 @@ namespace bs
 		mGPULayoutFrameContentsRight->addElement(mGPUIndexBufferBindsLbl);
 		mGPULayoutFrameContentsRight->addNewElement<GUIFlexibleSpace>();
 
+		// Set up memory areas
+		mMemoryLayout = mWidget->getPanel()->addNewElement<GUILayoutY>();
+
+		GUILayout* memoryTitle = mMemoryLayout->addNewElement<GUILayoutY>();
+		mMemoryLayoutContents = mMemoryLayout->addNewElement<GUILayoutY>();
+		mMemoryLayout->addNewElement<GUIFlexibleSpace>();
+
+		HString memoryStr(u8"__ProfOvMemory", u8"Memory");
+		memoryTitle->addElement(GUILabel::create(memoryStr));
+		memoryTitle->addNewElement<GUIFixedSpace>(20);
+
+		GUILayout* memoryTitleRow = memoryTitle->addNewElement<GUILayoutX>();
+
+		HString memoryCategoryStr(u8"__ProfOvMemCategory", u8"Category");
+		HString memoryLiveStr(u8"__ProfOvMemLive", u8"Allocated");
+		HString memoryPeakStr(u8"__ProfOvMemPeak", u8"Peak");
+		HString memoryAllocsStr(u8"__ProfOvMemAllocs", u8"# allocs");
+		HString memoryFreesStr(u8"__ProfOvMemFrees", u8"# frees");
+		memoryTitleRow->addElement(GUILabel::create(memoryCategoryStr, GUIOptions(GUIOption::fixedWidth(100))));
+		memoryTitleRow->addElement(GUILabel::create(memoryLiveStr, GUIOptions(GUIOption::fixedWidth(100))));
+		memoryTitleRow->addElement(GUILabel::create(memoryPeakStr, GUIOptions(GUIOption::fixedWidth(100))));
+		memoryTitleRow->addElement(GUILabel::create(memoryAllocsStr, GUIOptions(GUIOption::fixedWidth(100))));
+		memoryTitleRow->addElement(GUILabel::create(memoryFreesStr, GUIOptions(GUIOption::fixedWidth(100))));
+
 		updateCPUSampleAreaSizes();
 		updateGPUSampleAreaSizes();
+		updateMemoryAreaSizes();
 
 		if (!mIsShown)
 			hide();
 		else
-		{
-			if (mType == ProfilerOverlayType::CPUSamples)
-				show(ProfilerOverlayType::CPUSamples);
-			else
-				show(ProfilerOverlayType::GPUSamples);
-		}
+			show(mType);
 	}
 
 	void ProfilerOverlayInternal::show(ProfilerOverlayType type)
@@ -537,8 +670,9 @@ namespace bs
 			mPreciseLayoutContents->setVisible(true);
 			mGPULayoutFrameContents->setVisible(false);
 			mGPULayoutSamples->setVisible(false);
+			mMemoryLayout->setVisible(false);
 		}
-		else
+		else if (type == ProfilerOverlayType::GPUSamples)
 		{
 			mGPULayoutFrameContents->setVisible(true);
 			mGPULayoutSamples->setVisible(true);
@@ -546,6 +680,17 @@ namespace bs
 			mPreciseLayoutLabels->setVisible(false);
 			mBasicLayoutContents->setVisible(false);
 			mPreciseLayoutContents->setVisible(false);
+			mMemoryLayout->setVisible(false);
+		}
+		else
+		{
+			mMemoryLayout->setVisible(true);
+			mBasicLayoutLabels->setVisible(false);
+			mPreciseLayoutLabels->setVisible(false);
+			mBasicLayoutContents->setVisible(false);
+			mPreciseLayoutContents->setVisible(false);
+			mGPULayoutFrameContents->setVisible(false);
+			mGPULayoutSamples->setVisible(false);
 		}
 
 		mType = type;
@@ -560,6 +705,7 @@ namespace bs
 		mPreciseLayoutContents->setVisible(false);
 		mGPULayoutFrameContents->setVisible(false);
 		mGPULayoutSamples->setVisible(false);
+		mMemoryLayout->setVisible(false);
 		mIsShown = false;
 	}
 
@@ -577,12 +723,16 @@ namespace bs
 		{
 			updateGPUSampleContents(ProfilerGPU::instance().getNextReport());
 		}
+
+		if (mIsShown && mType == ProfilerOverlayType::Memory)
+			updateMemoryContents();
 	}
 
 	void ProfilerOverlayInternal::targetResized()
 	{
 		updateCPUSampleAreaSizes();
 		updateGPUSampleAreaSizes();
+		updateMemoryAreaSizes();
 	}
 
 	void ProfilerOverlayInternal::updateCPUSampleAreaSizes()
@@ -633,6 +783,18 @@ namespace bs
 		mGPULayoutSamples->setHeight(samplesHeight);
 	}
 
+	void ProfilerOverlayInternal::updateMemoryAreaSizes()
+	{
+		static const INT32 PADDING = 10;
+
+		UINT32 width = (UINT32)std::max(0, (INT32)mTarget->getPixelArea().width - PADDING * 2);
+		UINT32 height = (UINT32)std::max(0, (INT32)mTarget->getPixelArea().height - PADDING * 2);
+
+		mMemoryLayout->setPosition(PADDING, PADDING);
+		mMemoryLayout->setWidth(width);
+		mMemoryLayout->setHeight(height);
+	}
+
 	void ProfilerOverlayInternal::updateCPUSampleContents(const ProfilerReport& simReport, const ProfilerReport& coreReport)
 	{
 		static const UINT32 NUM_ROOT_ENTRIES = 2;
@@ -767,7 +929,24 @@ namespace bs
 		GPUSampleRowFiller sampleRowFiller(mGPUSampleRows, *mGPULayoutSampleContents, *mWidget->_getInternal());
 		for (auto& sample : gpuReport.samples)
 		{
-			sampleRowFiller.addData(sample.name, sample.timeMs);
+			sampleRowFiller.addData(sample);
+		}
+	}
+
+	void ProfilerOverlayInternal::updateMemoryContents()
+	{
+		MemoryRowFiller memoryRowFiller(mMemoryRows, *mMemoryLayoutContents, *mWidget->_getInternal());
+
+		UINT32 numCategories = MemoryCounter::getNumCategories();
+		for (UINT32 i = 0; i < numCategories; i++)
+		{
+			MemoryCategoryStats stats = MemoryCounter::getCategoryStats(i);
+
+			// Skip categories that were never used
+			if (stats.numAllocs == 0)
+				continue;
+
+			memoryRowFiller.addData(stats);
 		}
 	}
 }
\ No newline at end of file
@@ -20,7 +20,8 @@ namespace bs
 	enum class ProfilerOverlayType
 	{
 		CPUSamples,
-		GPUSamples
+		GPUSamples,
+		Memory
 	};
 
 	/**
@@ -132,9 +133,39 @@ namespace bs
 
 			GUILabel* guiName;
 			GUILabel* guiTime;
+			GUILabel* guiCPUTime;
+			GUILabel* guiDrawCalls;
+			GUILabel* guiStateChanges;
+			GUILabel* guiParamBinds;
+			GUILabel* guiBufferBinds;
 
 			HString name;
 			HString time;
+			HString cpuTime;
+			HString drawCalls;
+			HString stateChanges;
+			HString paramBinds;
+			HString bufferBinds;
+
+			bool disabled;
+		};
+
+		/**	Holds data about GUI elements in a single row of memory category statistics. */
+		struct MemoryRow
+		{
+			GUILayout* layout;
+
+			GUILabel* guiName;
+			GUILabel* guiLiveBytes;
+			GUILabel* guiPeakBytes;
+			GUILabel* guiNumAllocs;
+			GUILabel* guiNumFrees;
+
+			HString name;
+			HString liveBytes;
+			HString peakBytes;
+			HString numAllocs;
+			HString numFrees;
 
 			bool disabled;
 		};
@@ -165,6 +196,9 @@ namespace bs
 		/** Updates sizes of GUI areas used for displaying GPU sample data. To be called after viewport change or resize. */
 		void updateGPUSampleAreaSizes();
 
+		/** Updates sizes of GUI areas used for displaying memory data. To be called after viewport change or resize. */
+		void updateMemoryAreaSizes();
+
 		/**
 		 * Updates CPU GUI elements from the data in the provided profiler reports. To be called whenever a new report is 
 		 * received.
@@ -177,6 +211,9 @@ namespace bs
 		 */
 		void updateGPUSampleContents(const GPUProfilerReport& gpuReport);
 
+		/** Updates memory GUI elements from the current per-category memory statistics reported by MemoryCounter. */
+		void updateMemoryContents();
+
 		static const UINT32 MAX_DEPTH;
 
 		ProfilerOverlayType mType;
@@ -216,6 +253,9 @@ namespace bs
 		GUILayout* mGPULayoutSamples = nullptr;
 		GUILayout* mGPULayoutSampleContents = nullptr;
 
+		GUILayout* mMemoryLayout = nullptr;
+		GUILayout* mMemoryLayoutContents = nullptr;
+
 		GUILabel* mGPUFrameNumLbl;
 		GUILabel* mGPUTimeLbl;
 		GUILabel* mGPUDrawCallsLbl;
@@ -257,6 +297,7 @@ namespace bs
 		Vector<BasicRow> mBasicRows;
 		Vector<PreciseRow> mPreciseRows;
 		Vector<GPUSampleRow> mGPUSampleRows;
+		Vector<MemoryRow> mMemoryRows;
 
 		HEvent mTargetResizedConn;
 		bool mIsShown;
@@ -0,0 +1,91 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsApplication.h"
+#include "BsEngineConfig.h"
+#include "Material/BsShaderPrecompiler.h"
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "FileSystem/BsFileSystem.h"
+#include <cstdio>
+
+using namespace bs;
+
+/**
+ * Offline tool that compiles all GPU programs of a set of shader assets into a bytecode cache, using the render API
+ * the framework was built with. The resulting cache folder can be shipped and provided through
+ * START_UP_DESC::bytecodeCache, so shaders don't need to be compiled at load time.
+ *
+ * Usage: bsfShaderPrecompiler <cache folder> <shader asset or folder> [<shader asset or folder> ...]
+ *
+ * Folders are searched recursively for assets. Assets that aren't shaders are ignored.
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: bsfShaderPrecompiler <cache folder> <shader asset or folder> [<shader asset or folder> ...]\n");
+		return 1;
+	}
+
+	Path cacheFolder = String(argv[1]);
+	cacheFolder.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+
+	Vector<Path> shaderPaths;
+	for (int i = 2; i < argc; i++)
+	{
+		Path path = String(argv[i]);
+		path.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+
+		if (FileSystem::isDirectory(path))
+		{
+			FileSystem::iterate(path, [&shaderPaths](const Path& filePath)
+			{
+				if (filePath.getExtension() == ".asset")
+					shaderPaths.push_back(filePath);
+
+				return true;
+			});
+		}
+		else
+			shaderPaths.push_back(path);
+	}
+
+	START_UP_DESC desc;
+	desc.renderAPI = BS_RENDER_API_MODULE;
+	desc.renderer = BS_RENDERER_MODULE;
+	desc.audio = BS_AUDIO_MODULE;
+	desc.physics = BS_PHYSICS_MODULE;
+	desc.importers.push_back("bsfSL");
+
+	desc.primaryWindowDesc.videoMode = VideoMode(64, 64);
+	desc.primaryWindowDesc.title = "Shader precompiler";
+	desc.primaryWindowDesc.hidden = true;
+
+	// Programs are only stored in the output cache
+	desc.bytecodeCache = Path::BLANK;
+
+	Application::startUp(desc);
+
+	int exitCode = 0;
+	const RenderAPIInfo& apiInfo = ct::RenderAPI::instance().getAPIInfo();
+	if (apiInfo.isFlagSet(RenderAPIFeatureFlag::ByteCodeCaching))
+	{
+		// Everything is kept, the cache only grows when shaders change
+		SPtr<ct::GpuProgramBytecodeCache> cache = bs_shared_ptr_new<ct::GpuProgramBytecodeCache>(cacheFolder, 0);
+		SHADER_PRECOMPILE_RESULT result = ShaderPrecompiler::precompile(shaderPaths, cache);
+
+		printf("Compiled %u GPU programs in %.2f seconds, %u failed.\n", result.numPrograms,
+			result.time / 1000000.0, result.numFailed);
+
+		if (result.numFailed > 0)
+			exitCode = 1;
+	}
+	else
+	{
+		printf("Render API \"%s\" doesn't support bytecode caching.\n", BS_RENDER_API_MODULE);
+		exitCode = 1;
+	}
+
+	Application::shutDown();
+	return exitCode;
+}
@@ -3,6 +3,7 @@
 #include "Resources/BsGameResourceManager.h"
 #include "Private/RTTI/BsResourceMappingRTTI.h"
 #include "Resources/BsResources.h"
+#include "Resources/BsResourceArchive.h"
 #include "FileSystem/BsFileSystem.h"
 
 namespace bs
@@ -45,6 +46,32 @@ namespace bs
 		mMapping = mapping->getMap();
 	}
 
+	ArchiveResourceLoader::ArchiveResourceLoader(const SPtr<ResourceArchive>& archive)
+		:mArchive(archive)
+	{
+		if (mArchive != nullptr)
+			gResources().registerArchive(mArchive);
+	}
+
+	ArchiveResourceLoader::~ArchiveResourceLoader()
+	{
+		if (mArchive != nullptr && Resources::isStarted())
+			gResources().unregisterArchive(mArchive);
+	}
+
+	HResource ArchiveResourceLoader::load(const Path& path, bool keepLoaded) const
+	{
+		UUID uuid;
+		if (mArchive == nullptr || !mArchive->findUUID(path, uuid))
+			return StandaloneResourceLoader::load(path, keepLoaded);
+
+		ResourceLoadFlags loadFlags = ResourceLoadFlag::LoadDependencies;
+		if (keepLoaded)
+			loadFlags |= ResourceLoadFlag::KeepInternalRef;
+
+		return gResources().loadFromUUID(uuid, false, loadFlags);
+	}
+
 	GameResourceManager::GameResourceManager()
 		:mLoader(bs_shared_ptr_new<StandaloneResourceLoader>())
 	{
@@ -65,6 +65,25 @@ namespace bs
 		UnorderedMap<Path, Path> mMapping;
 	};
 
+	/**
+	 * Handles loading of game resources packed into a ResourceArchive. Paths are looked up using the reference paths
+	 * stored in the archive. Resources not found in the archive are loaded from individual files, same as with
+	 * StandaloneResourceLoader.
+	 */
+	class BS_EXPORT ArchiveResourceLoader : public StandaloneResourceLoader
+	{
+	public:
+		/** Creates a new loader and registers the provided archive with the Resources manager. */
+		ArchiveResourceLoader(const SPtr<ResourceArchive>& archive);
+		~ArchiveResourceLoader();
+
+		/** @copydoc IGameResourceLoader::load */
+		HResource load(const Path& path, bool keepLoaded) const override;
+
+	private:
+		SPtr<ResourceArchive> mArchive;
+	};
+
 	/**
 	 * Keeps track of resources that can be dynamically loaded during runtime. These resources will be packed with the game
 	 * build so that they're available on demand.
@@ -0,0 +1,566 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsPoolAlloc.h"
+#include "Threading/BsSpinLock.h"
+#include <climits>
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	namespace impl
+	{
+		/** Returns a sequential index unique to the calling thread, used for spreading threads across per-thread slots. */
+		inline UINT32 getConcurrentPoolThreadIdx()
+		{
+			static std::atomic<UINT32> sNextThreadIdx { 0 };
+			static thread_local UINT32 sThreadIdx = sNextThreadIdx.fetch_add(1, std::memory_order_relaxed);
+
+			return sThreadIdx;
+		}
+	}
+
+	/**
+	 * A thread safe variant of PoolAlloc. Allocates elements of the same size, and allows allocations and deallocations
+	 * to be performed from any thread, including freeing an element on a different thread than the one it was allocated on.
+	 *
+	 * Each thread allocates from, and frees to, its own magazine of free elements. Only when a thread's magazines are
+	 * exhausted (or full) are they exchanged with a global depot, meaning most operations only touch memory local to the
+	 * calling thread. The depot refills magazines from blocks of ElemsPerBlock elements, and once it holds more free
+	 * elements than it needs, returns them to their blocks. Blocks whose elements have all been freed are returned to the
+	 * system, keeping one free block around to avoid thrashing.
+	 *
+	 * @tparam	ElemSize		Size of a single element in the pool. This will be the exact allocation size. 4 byte minimum.
+	 * @tparam	ElemsPerBlock	Number of elements in a single block. The pool grows by one block whenever it runs out of
+	 *							free elements.
+	 * @tparam	Alignment		Memory alignment of each allocated element. Note that alignments that are larger than
+	 *							element size, or aren't a multiplier of element size will introduce additionally padding
+	 *							for each element, and therefore require more internal memory.
+	 * @tparam	MagazineSize	Number of free elements a single magazine can hold. Larger values mean the depot needs to
+	 *							be accessed less often, but more free elements can be held by threads, unavailable to others.
+	 */
+	template <int ElemSize, int ElemsPerBlock = 512, int Alignment = 4, int MagazineSize = 32>
+	class ConcurrentPoolAlloc
+	{
+	private:
+		/** Number of slots threads are distributed over. Threads sharing a slot share its magazines. */
+		static constexpr UINT32 NUM_THREAD_SLOTS = 16;
+
+		/**
+		 * Maximum number of full magazines held by the depot. Any further full magazines get their elements returned to
+		 * the blocks.
+		 */
+		static constexpr UINT32 MAX_DEPOT_MAGAZINES = std::max(2, ElemsPerBlock / MagazineSize);
+
+		/** A fixed-size stack of free elements. */
+		struct Magazine
+		{
+			UINT32 count = 0;
+			Magazine* next = nullptr;
+			void* elems[MagazineSize];
+		};
+
+		/** Magazines assigned to a group of threads. Padded to a cache line to avoid false sharing between slots. */
+		struct ThreadSlot
+		{
+			Magazine* loaded = nullptr;
+			Magazine* previous = nullptr;
+			SpinLock lock;
+
+			UINT8 padding[64 - 2 * sizeof(Magazine*) - sizeof(SpinLock)];
+		};
+
+		/** A single block able to hold ElemsPerBlock elements. */
+		struct MemBlock
+		{
+			MemBlock(UINT8* blockData)
+				:blockData(blockData)
+			{
+				UINT32 offset = 0;
+				for(UINT32 i = 0; i < ElemsPerBlock; i++)
+				{
+					UINT32* entryPtr = (UINT32*)&blockData[offset];
+
+					offset += ActualElemSize;
+					*entryPtr = offset;
+				}
+			}
+
+			/** Returns the first free address. Caller needs to ensure the block has free elements before calling. */
+			UINT8* alloc()
+			{
+				UINT8* freeEntry = &blockData[freePtr];
+				freePtr = *(UINT32*)freeEntry;
+				--freeElems;
+
+				return freeEntry;
+			}
+
+			/** Deallocates the provided pointer. */
+			void dealloc(void* data)
+			{
+				UINT32* entryPtr = (UINT32*)data;
+				*entryPtr = freePtr;
+				++freeElems;
+
+				freePtr = (UINT32)(((UINT8*)data) - blockData);
+			}
+
+			UINT8* blockData;
+			UINT32 freePtr = 0;
+			UINT32 freeElems = ElemsPerBlock;
+
+			/** Links in the list of blocks with free elements. Only valid if freeElems is non-zero. */
+			MemBlock* prev = nullptr;
+			MemBlock* next = nullptr;
+		};
+
+	public:
+		ConcurrentPoolAlloc()
+		{
+			static_assert(ElemSize >= 4, "Pool allocator minimum allowed element size is 4 bytes.");
+			static_assert(ElemsPerBlock > 0, "Number of elements per block must be at least 1.");
+			static_assert(MagazineSize > 0, "Number of elements per magazine must be at least 1.");
+			static_assert(ElemsPerBlock * ActualElemSize <= UINT_MAX, "Pool allocator block size too large.");
+			static_assert(sizeof(ThreadSlot) == 64, "Unexpected thread slot size.");
+		}
+
+		~ConcurrentPoolAlloc()
+		{
+			for(auto& slot : mSlots)
+			{
+				releaseMagazine(slot.loaded);
+				releaseMagazine(slot.previous);
+			}
+
+			releaseMagazineList(mFullMagazines);
+			releaseMagazineList(mEmptyMagazines);
+
+			for(auto& entry : mBlocks)
+			{
+				assert(entry.second->freeElems == ElemsPerBlock && "Not all elements were deallocated from a block.");
+				deallocBlock(entry.second);
+			}
+		}
+
+		/** Allocates enough memory for a single element in the pool. */
+		UINT8* alloc()
+		{
+			ThreadSlot& slot = getThreadSlot();
+			ScopedSpinLock lock(slot.lock);
+
+			if(slot.loaded == nullptr || slot.loaded->count == 0)
+			{
+				if(slot.previous != nullptr && slot.previous->count > 0)
+					std::swap(slot.loaded, slot.previous);
+				else
+				{
+					Lock depotLock(mDepotMutex);
+
+					Magazine* full = popFullMagazine();
+					if(slot.loaded != nullptr)
+						pushEmptyMagazine(slot.loaded);
+
+					slot.loaded = full;
+				}
+			}
+
+			return (UINT8*)slot.loaded->elems[--slot.loaded->count];
+		}
+
+		/** Deallocates an element from the pool. The element may have been allocated on any thread. */
+		void free(void* data)
+		{
+			if(data == nullptr)
+				return;
+
+			ThreadSlot& slot = getThreadSlot();
+			ScopedSpinLock lock(slot.lock);
+
+			if(slot.loaded == nullptr || slot.loaded->count == MagazineSize)
+			{
+				if(slot.previous != nullptr && slot.previous->count < MagazineSize)
+					std::swap(slot.loaded, slot.previous);
+				else
+				{
+					Lock depotLock(mDepotMutex);
+
+					Magazine* empty = popEmptyMagazine();
+					if(slot.loaded != nullptr)
+					{
+						if(slot.previous == nullptr)
+							slot.previous = slot.loaded;
+						else
+							pushFullMagazine(slot.loaded);
+					}
+
+					slot.loaded = empty;
+				}
+			}
+
+			slot.loaded->elems[slot.loaded->count++] = data;
+		}
+
+		/** Allocates and constructs a single pool element. */
+		template<class T, class... Args>
+		T* construct(Args &&...args)
+		{
+			T* data = (T*)alloc();
+			new ((void*)data) T(std::forward<Args>(args)...);
+
+			return data;
+		}
+
+		/** Destructs and deallocates a single pool element. */
+		template<class T>
+		void destruct(T* data)
+		{
+			data->~T();
+			free(data);
+		}
+
+		/**
+		 * Returns all free elements held by threads and the depot back to their blocks, and releases all blocks that no
+		 * longer have any allocated elements. Useful after a burst of allocations, such as a level unload.
+		 */
+		void trim()
+		{
+			for(auto& slot : mSlots)
+			{
+				ScopedSpinLock lock(slot.lock);
+				Lock depotLock(mDepotMutex);
+
+				for(Magazine* magazine : { slot.loaded, slot.previous })
+				{
+					if(magazine == nullptr)
+						continue;
+
+					drainMagazine(magazine);
+					pushEmptyMagazine(magazine);
+				}
+
+				slot.loaded = nullptr;
+				slot.previous = nullptr;
+			}
+
+			Lock depotLock(mDepotMutex);
+			while(mFullMagazines != nullptr)
+			{
+				Magazine* magazine = popFullMagazine();
+
+				drainMagazine(magazine);
+				pushEmptyMagazine(magazine);
+			}
+
+			releaseMagazineList(mEmptyMagazines);
+			mEmptyMagazines = nullptr;
+
+			for(auto iter = mBlocks.begin(); iter != mBlocks.end();)
+			{
+				MemBlock* block = iter->second;
+				if(block->freeElems == ElemsPerBlock)
+				{
+					unlinkBlock(block);
+					deallocBlock(block);
+
+					iter = mBlocks.erase(iter);
+				}
+				else
+					++iter;
+			}
+
+			mNumFreeBlocks = 0;
+		}
+
+		/** Returns the number of blocks currently allocated by the pool. */
+		UINT32 getNumBlocks() const
+		{
+			Lock depotLock(mDepotMutex);
+			return (UINT32)mBlocks.size();
+		}
+
+	private:
+		/** Returns the slot assigned to the calling thread. */
+		ThreadSlot& getThreadSlot()
+		{
+			return mSlots[impl::getConcurrentPoolThreadIdx() % NUM_THREAD_SLOTS];
+		}
+
+		/** Returns a full magazine from the depot, filling a new one from the blocks if none exist. Depot lock required. */
+		Magazine* popFullMagazine()
+		{
+			Magazine* magazine = mFullMagazines;
+			if(magazine != nullptr)
+			{
+				mFullMagazines = magazine->next;
+				mNumFullMagazines--;
+
+				return magazine;
+			}
+
+			magazine = popEmptyMagazine();
+			while(magazine->count < MagazineSize)
+			{
+				if(mPartialBlocks == nullptr)
+					allocBlock();
+
+				MemBlock* block = mPartialBlocks;
+				if(block->freeElems == ElemsPerBlock)
+					mNumFreeBlocks--;
+
+				// Take as many elements from the block as fit
+				while(block->freeElems > 0 && magazine->count < MagazineSize)
+					magazine->elems[magazine->count++] = block->alloc();
+
+				if(block->freeElems == 0)
+					unlinkBlock(block);
+			}
+
+			return magazine;
+		}
+
+		/** Stores a full magazine in the depot, or returns its elements to the blocks if the depot has enough of them. */
+		void pushFullMagazine(Magazine* magazine)
+		{
+			if(mNumFullMagazines >= MAX_DEPOT_MAGAZINES)
+			{
+				drainMagazine(magazine);
+				pushEmptyMagazine(magazine);
+
+				return;
+			}
+
+			magazine->next = mFullMagazines;
+			mFullMagazines = magazine;
+			mNumFullMagazines++;
+		}
+
+		/** Returns an empty magazine from the depot, allocating a new one if none exist. Depot lock required. */
+		Magazine* popEmptyMagazine()
+		{
+			Magazine* magazine = mEmptyMagazines;
+			if(magazine != nullptr)
+			{
+				mEmptyMagazines = magazine->next;
+				return magazine;
+			}
+
+			return bs_new<Magazine, PoolBlockAlloc>();
+		}
+
+		/** Stores an empty magazine in the depot. Depot lock required. */
+		void pushEmptyMagazine(Magazine* magazine)
+		{
+			magazine->next = mEmptyMagazines;
+			mEmptyMagazines = magazine;
+		}
+
+		/** Returns all elements in the magazine to their blocks, releasing blocks left without allocated elements. */
+		void drainMagazine(Magazine* magazine)
+		{
+			for(UINT32 i = 0; i < magazine->count; i++)
+			{
+				UINT8* data = (UINT8*)magazine->elems[i];
+
+				auto iterFind = mBlocks.upper_bound(data);
+				assert(iterFind != mBlocks.begin());
+
+				MemBlock* block = (--iterFind)->second;
+				assert(data < block->blockData + ActualElemSize * ElemsPerBlock);
+
+				if(block->freeElems == 0)
+					linkBlock(block);
+
+				block->dealloc(data);
+
+				if(block->freeElems == ElemsPerBlock)
+				{
+					// Keep a single free block around, so we don't end up constantly allocating and freeing blocks
+					if(mNumFreeBlocks > 0)
+					{
+						unlinkBlock(block);
+						deallocBlock(block);
+
+						mBlocks.erase(iterFind);
+					}
+					else
+						mNumFreeBlocks++;
+				}
+			}
+
+			magazine->count = 0;
+		}
+
+		/** Adds the block to the front of the list of blocks with free elements. */
+		void linkBlock(MemBlock* block)
+		{
+			block->prev = nullptr;
+			block->next = mPartialBlocks;
+
+			if(mPartialBlocks != nullptr)
+				mPartialBlocks->prev = block;
+
+			mPartialBlocks = block;
+		}
+
+		/** Removes the block from the list of blocks with free elements. */
+		void unlinkBlock(MemBlock* block)
+		{
+			if(block->prev != nullptr)
+				block->prev->next = block->next;
+			else
+				mPartialBlocks = block->next;
+
+			if(block->next != nullptr)
+				block->next->prev = block->prev;
+
+			block->prev = nullptr;
+			block->next = nullptr;
+		}
+
+		/** Allocates a new block of memory using a heap allocator, and adds it to the list of blocks with free elements. */
+		void allocBlock()
+		{
+			constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
+			size_t paddedBlockDataSize = blockDataSize + (Alignment - 1); // Padding for potential alignment correction
+
+			UINT8* data = (UINT8*)bs_alloc<PoolBlockAlloc>(sizeof(MemBlock) + (UINT32)paddedBlockDataSize);
+
+			void* blockData = data + sizeof(MemBlock);
+			blockData = std::align(Alignment, blockDataSize, blockData, paddedBlockDataSize);
+
+			MemBlock* block = new (data) MemBlock((UINT8*)blockData);
+			mBlocks[block->blockData] = block;
+			mNumFreeBlocks++;
+
+			linkBlock(block);
+		}
+
+		/** Deallocates a block of memory. */
+		void deallocBlock(MemBlock* block)
+		{
+			block->~MemBlock();
+			bs_free<PoolBlockAlloc>(block);
+		}
+
+		/** Returns all elements in the magazine to the blocks and frees the magazine. */
+		void releaseMagazine(Magazine* magazine)
+		{
+			if(magazine == nullptr)
+				return;
+
+			drainMagazine(magazine);
+			bs_delete<Magazine, PoolBlockAlloc>(magazine);
+		}
+
+		/** Releases all magazines in a linked list of magazines. */
+		void releaseMagazineList(Magazine* magazine)
+		{
+			while(magazine != nullptr)
+			{
+				Magazine* next = magazine->next;
+				releaseMagazine(magazine);
+
+				magazine = next;
+			}
+		}
+
+		static constexpr int ActualElemSize = ((ElemSize + Alignment - 1) / Alignment) * Alignment;
+
+		ThreadSlot mSlots[NUM_THREAD_SLOTS];
+
+		mutable Mutex mDepotMutex;
+		Magazine* mFullMagazines = nullptr;
+		Magazine* mEmptyMagazines = nullptr;
+		UINT32 mNumFullMagazines = 0;
+
+		/** All blocks owned by the pool, keyed by the address of their element data. */
+		Map<UINT8*, MemBlock*> mBlocks;
+
+		/** Linked list of blocks that have at least one free element. */
+		MemBlock* mPartialBlocks = nullptr;
+
+		/** Number of blocks with no allocated elements. */
+		UINT32 mNumFreeBlocks = 0;
+	};
+
+	/**
+	 * Allocator compatible with the standard library, allocating single objects from a ConcurrentPoolAlloc shared by all
+	 * objects of the same type. Allocations of multiple objects are forwarded to the general allocator.
+	 *
+	 * Primarily meant to be used with std::allocate_shared, for objects that are frequently created and destroyed from
+	 * multiple threads.
+	 */
+	template <class T>
+	class StdConcurrentPoolAlloc
+	{
+	public:
+		using value_type = T;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		constexpr StdConcurrentPoolAlloc() = default;
+		constexpr StdConcurrentPoolAlloc(StdConcurrentPoolAlloc&&) = default;
+		constexpr StdConcurrentPoolAlloc(const StdConcurrentPoolAlloc&) = default;
+		template<class U> constexpr StdConcurrentPoolAlloc(const StdConcurrentPoolAlloc<U>&) { };
+		template<class U> constexpr bool operator==(const StdConcurrentPoolAlloc<U>&) const noexcept { return true; }
+		template<class U> constexpr bool operator!=(const StdConcurrentPoolAlloc<U>&) const noexcept { return false; }
+
+		template<class U> class rebind { public: using other = StdConcurrentPoolAlloc<U>; };
+
+		/** Allocate but don't initialize number elements of type T. */
+		static T* allocate(const size_t num)
+		{
+			if (num == 0)
+				return nullptr;
+
+			if (num == 1)
+				return (T*)getPool().alloc();
+
+			if (num > std::numeric_limits<size_t>::max() / sizeof(T))
+				return nullptr; // Error
+
+			return static_cast<T*>(bs_alloc(num * sizeof(T)));
+		}
+
+		/** Deallocate storage p of deleted elements. */
+		static void deallocate(pointer p, size_type num)
+		{
+			if (num == 1)
+				getPool().free(p);
+			else
+				bs_free(p);
+		}
+
+		static constexpr size_t max_size() { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+	private:
+		static constexpr int PoolElemSize = std::max((int)sizeof(T), 4);
+		static constexpr int PoolAlignment = std::max((int)alignof(T), 4);
+
+		using Pool = ConcurrentPoolAlloc<PoolElemSize, 512, PoolAlignment>;
+
+		/** Returns the pool shared by all allocations of type T. */
+		static Pool& getPool()
+		{
+			static Pool sPool;
+			return sPool;
+		}
+	};
+
+	/** @} */
+	/** @} */
+}
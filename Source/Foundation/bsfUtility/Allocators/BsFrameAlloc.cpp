@@ -261,7 +261,8 @@ namespace bs
 		{
 			UINT32 alignOffset = 16 - (sizeof(MemBlock) & (16 - 1));
 
-			UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(bs_alloc_aligned16(blockSize + sizeof(MemBlock) + alignOffset));
+			UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(MemoryAllocator<FrameBlockAlloc>::allocateAligned16(
+				blockSize + sizeof(MemBlock) + alignOffset));
 			newBlock = new (data) MemBlock(blockSize);
 			data += sizeof(MemBlock) + alignOffset;
 			newBlock->mData = data;
@@ -278,7 +279,7 @@ namespace bs
 	void FrameAlloc::deallocBlock(MemBlock* block)
 	{
 		block->~MemBlock();
-		bs_free_aligned16(block);
+		MemoryAllocator<FrameBlockAlloc>::freeAligned16(block);
 	}
 
 	void FrameAlloc::setOwnerThread(ThreadId thread)
@@ -20,6 +20,13 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Allocation category used for memory blocks owned by frame allocators. */
+	class FrameBlockAlloc
+	{ };
+
+	template<> struct MemoryCategoryName<FrameBlockAlloc> { static constexpr const char* get() { return "Frame"; } };
+	template<> struct UseThreadCachingAlloc<FrameBlockAlloc> { static constexpr bool value = false; };
+
 	/**
 	 * Frame allocator. Performs very fast allocations but can only free all of its memory at once. Perfect for allocations 
 	 * that last just a single frame.
@@ -1,9 +1,245 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include <cstring>
 
 namespace bs
 {
 	UINT64 BS_THREADLOCAL MemoryCounter::Allocs = 0;
 	UINT64 BS_THREADLOCAL MemoryCounter::Frees = 0;
-}
\ No newline at end of file
+
+	namespace
+	{
+		/**
+		 * Number of bytes a thread can allocate or free before the change is applied to the shared counters. Lower values
+		 * make the high-water mark more precise, at the cost of more frequent atomic operations.
+		 */
+		constexpr INT64 FLUSH_THRESHOLD = 64 * 1024;
+
+		/** Maximum length of a category name, including the null terminator. */
+		constexpr UINT32 MAX_CATEGORY_NAME_LENGTH = 32;
+
+		/** Counters for a single allocation category, shared between all threads. */
+		struct CategoryCounters
+		{
+			char name[MAX_CATEGORY_NAME_LENGTH];
+			std::atomic<INT64> liveBytes;
+			std::atomic<INT64> peakBytes;
+		};
+
+		/**
+		 * Counters for all allocation categories, owned by a single thread. Only the owner writes to the counters, but any
+		 * thread can read them. Counters are never freed, but are instead reused by new threads once their owner thread
+		 * terminates.
+		 */
+		struct ThreadCounters
+		{
+			std::atomic<UINT64> numAllocs[MemoryCounter::MAX_CATEGORIES];
+			std::atomic<UINT64> numFrees[MemoryCounter::MAX_CATEGORIES];
+
+			/** Bytes allocated minus bytes freed by this thread, not yet applied to the shared counters. */
+			std::atomic<INT64> pendingBytes[MemoryCounter::MAX_CATEGORIES];
+
+			std::atomic<bool> inUse;
+			ThreadCounters* next;
+		};
+
+		/** Releases the counters of the current thread when the thread terminates. */
+		struct ThreadCountersReleaser
+		{
+			~ThreadCountersReleaser();
+
+			ThreadCounters* counters = nullptr;
+		};
+
+		CategoryCounters gCategories[MemoryCounter::MAX_CATEGORIES] = { { "Other", { 0 }, { 0 } } };
+		std::atomic<UINT32> gNumCategories { 1 };
+		Mutex gCategoryMutex;
+
+		std::atomic<ThreadCounters*> gThreadCounters { nullptr };
+
+		/**
+		 * Counters used by threads after their own counters have been released (i.e. allocations performed by other
+		 * thread local object destructors). Can be written to by multiple threads at once.
+		 */
+		ThreadCounters gSharedCounters;
+
+		BS_THREADLOCAL ThreadCounters* tThreadCounters = nullptr;
+		thread_local ThreadCountersReleaser tThreadCountersReleaser;
+
+		/** Applies a change in the number of allocated bytes to the shared counters of the provided category. */
+		void applyBytes(UINT32 category, INT64 bytes)
+		{
+			CategoryCounters& counters = gCategories[category];
+
+			INT64 liveBytes = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			INT64 peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+			while (liveBytes > peakBytes &&
+				!counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+			{ }
+		}
+
+		/** Finds unused counters or creates new ones, and assigns them to the current thread. */
+		ThreadCounters* acquireThreadCounters()
+		{
+			ThreadCounters* counters = nullptr;
+			for (ThreadCounters* entry = gThreadCounters.load(std::memory_order_acquire); entry; entry = entry->next)
+			{
+				bool inUse = false;
+				if (entry->inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+				{
+					counters = entry;
+					break;
+				}
+			}
+
+			if (counters == nullptr)
+			{
+				// Using malloc directly since these allocations must not be tracked
+				void* data = ::malloc(sizeof(ThreadCounters));
+				if (data == nullptr)
+					return &gSharedCounters;
+
+				counters = new (data) ThreadCounters();
+				counters->inUse.store(true, std::memory_order_relaxed);
+
+				ThreadCounters* head = gThreadCounters.load(std::memory_order_relaxed);
+				do
+				{
+					counters->next = head;
+				} while (!gThreadCounters.compare_exchange_weak(head, counters, std::memory_order_release,
+					std::memory_order_relaxed));
+			}
+
+			tThreadCountersReleaser.counters = counters;
+			return counters;
+		}
+
+		/** Returns the counters owned by the current thread. */
+		ThreadCounters* getThreadCounters()
+		{
+			if (tThreadCounters == nullptr)
+				tThreadCounters = acquireThreadCounters();
+
+			return tThreadCounters;
+		}
+
+		/** Increments a counter that's written to only by the current thread, unless the thread uses shared counters. */
+		void increment(ThreadCounters* counters, std::atomic<UINT64>& counter)
+		{
+			if (counters == &gSharedCounters)
+				counter.fetch_add(1, std::memory_order_relaxed);
+			else
+				counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		/** Registers a change in the number of allocated bytes made by the current thread. */
+		void addBytes(ThreadCounters* counters, UINT32 category, INT64 bytes)
+		{
+			if (counters == &gSharedCounters)
+			{
+				applyBytes(category, bytes);
+				return;
+			}
+
+			std::atomic<INT64>& pendingBytes = counters->pendingBytes[category];
+
+			INT64 pending = pendingBytes.load(std::memory_order_relaxed) + bytes;
+			if (pending >= FLUSH_THRESHOLD || pending <= -FLUSH_THRESHOLD)
+			{
+				applyBytes(category, pending);
+				pending = 0;
+			}
+
+			pendingBytes.store(pending, std::memory_order_relaxed);
+		}
+
+		ThreadCountersReleaser::~ThreadCountersReleaser()
+		{
+			if (counters == nullptr)
+				return;
+
+			for (UINT32 i = 0; i < MemoryCounter::MAX_CATEGORIES; i++)
+			{
+				INT64 pending = counters->pendingBytes[i].load(std::memory_order_relaxed);
+				if (pending != 0)
+				{
+					applyBytes(i, pending);
+					counters->pendingBytes[i].store(0, std::memory_order_relaxed);
+				}
+			}
+
+			counters->inUse.store(false, std::memory_order_release);
+			counters = nullptr;
+
+			tThreadCounters = &gSharedCounters;
+		}
+	}
+
+	UINT32 MemoryCounter::getNumCategories()
+	{
+		return gNumCategories.load(std::memory_order_acquire);
+	}
+
+	MemoryCategoryStats MemoryCounter::getCategoryStats(UINT32 category)
+	{
+		MemoryCategoryStats stats;
+		if (category >= getNumCategories())
+			return stats;
+
+		const auto accumulate = [&stats, category](const ThreadCounters& counters)
+		{
+			stats.numAllocs += counters.numAllocs[category].load(std::memory_order_relaxed);
+			stats.numFrees += counters.numFrees[category].load(std::memory_order_relaxed);
+			stats.liveBytes += counters.pendingBytes[category].load(std::memory_order_relaxed);
+		};
+
+		for (ThreadCounters* entry = gThreadCounters.load(std::memory_order_acquire); entry; entry = entry->next)
+			accumulate(*entry);
+
+		accumulate(gSharedCounters);
+
+		const CategoryCounters& counters = gCategories[category];
+		stats.name = counters.name;
+		stats.liveBytes += counters.liveBytes.load(std::memory_order_relaxed);
+		stats.peakBytes = std::max(counters.peakBytes.load(std::memory_order_relaxed), stats.liveBytes);
+
+		return stats;
+	}
+
+	UINT32 MemoryCounter::registerCategory(const char* name)
+	{
+		Lock lock(gCategoryMutex);
+
+		UINT32 numCategories = gNumCategories.load(std::memory_order_relaxed);
+		for (UINT32 i = 0; i < numCategories; i++)
+		{
+			if (strncmp(gCategories[i].name, name, MAX_CATEGORY_NAME_LENGTH - 1) == 0)
+				return i;
+		}
+
+		if (numCategories >= MAX_CATEGORIES)
+			return 0;
+
+		strncpy(gCategories[numCategories].name, name, MAX_CATEGORY_NAME_LENGTH - 1);
+		gNumCategories.store(numCategories + 1, std::memory_order_release);
+
+		return numCategories;
+	}
+
+	void MemoryCounter::trackAlloc(UINT32 category, size_t bytes)
+	{
+		ThreadCounters* counters = getThreadCounters();
+
+		increment(counters, counters->numAllocs[category]);
+		addBytes(counters, category, (INT64)bytes);
+	}
+
+	void MemoryCounter::trackFree(UINT32 category, size_t bytes)
+	{
+		ThreadCounters* counters = getThreadCounters();
+
+		increment(counters, counters->numFrees[category]);
+		addBytes(counters, category, -(INT64)bytes);
+	}
+}
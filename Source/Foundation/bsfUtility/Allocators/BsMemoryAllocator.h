@@ -9,10 +9,19 @@
 #include <cstdint>
 #include <utility>
 
-#if BS_PLATFORM == BS_PLATFORM_LINUX
+#if BS_PLATFORM == BS_PLATFORM_LINUX || BS_PLATFORM == BS_PLATFORM_ANDROID
 #  include <malloc.h>
+#elif BS_PLATFORM == BS_PLATFORM_OSX || BS_PLATFORM == BS_PLATFORM_IOS
+#  include <malloc/malloc.h>
 #endif
 
+#include "BsFrameworkConfig.h"
+#include "Allocators/BsThreadCachingAlloc.h"
+
+// Enables tracking of the number of bytes allocated per allocation category (see MemoryCounter). Cheap enough to be
+// left on in release builds.
+#define BS_MEMORY_ACCOUNTING_ENABLED 1
+
 namespace bs
 {
 	class MemoryAllocatorBase;
@@ -36,14 +45,16 @@ namespace bs
 		_aligned_free(ptr);
 	}
 
-	inline void* platformAlignedAlloc(size_t size, size_t alignment)
+	/** Returns the number of bytes usable in a block of memory allocated by malloc(). */
+	inline size_t platformAllocSize(void* ptr)
 	{
-		return _aligned_malloc(size, alignment);
+		return _msize(ptr);
 	}
 
-	inline void platformAlignedFree(void* ptr)
+	/** Returns the number of bytes usable in a block of memory allocated by platformAlignedAlloc16(). */
+	inline size_t platformAlignedAllocSize16(void* ptr)
 	{
-		_aligned_free(ptr);
+		return _aligned_msize(ptr, 16, 0);
 	}
 #elif BS_PLATFORM == BS_PLATFORM_LINUX || BS_PLATFORM == BS_PLATFORM_ANDROID
 	inline void* platformAlignedAlloc16(size_t size)
@@ -65,6 +76,24 @@ namespace bs
 	{
 		::free(ptr);
 	}
+
+	/** Returns the number of bytes usable in a block of memory allocated by malloc(). */
+	inline size_t platformAllocSize(void* ptr)
+	{
+		return ::malloc_usable_size(ptr);
+	}
+
+	/** Returns the number of bytes usable in a block of memory allocated by platformAlignedAlloc16(). */
+	inline size_t platformAlignedAllocSize16(void* ptr)
+	{
+		return ::malloc_usable_size(ptr);
+	}
+
+	/** Returns the number of bytes usable in a block of memory allocated by platformAlignedAlloc(). */
+	inline size_t platformAlignedAllocSize(void* ptr)
+	{
+		return ::malloc_usable_size(ptr);
+	}
 #else // 16 byte aligment by default
 	inline void* platformAlignedAlloc16(size_t size)
 	{
@@ -76,6 +105,23 @@ namespace bs
 		::free(ptr);
 	}
 
+	/** Returns the number of bytes usable in a block of memory allocated by malloc(). */
+	inline size_t platformAllocSize(void* ptr)
+	{
+		return ::malloc_size(ptr);
+	}
+
+	/** Returns the number of bytes usable in a block of memory allocated by platformAlignedAlloc16(). */
+	inline size_t platformAlignedAllocSize16(void* ptr)
+	{
+		return ::malloc_size(ptr);
+	}
+#endif
+
+#if BS_PLATFORM != BS_PLATFORM_LINUX && BS_PLATFORM != BS_PLATFORM_ANDROID
+	// Allocates enough memory to fit the requested size after aligning the returned pointer, with the pointer to the
+	// allocated block stored right before the aligned data. This allows the block to be freed and its size queried
+	// without needing to know the alignment.
 	inline void* platformAlignedAlloc(size_t size, size_t alignment)
 	{
 		void* data = ::malloc(size + (alignment - 1) + sizeof(void*));
@@ -91,18 +137,72 @@ namespace bs
 
 	inline void platformAlignedFree(void* ptr)
 	{
-		// TODO: Document how this works.
 		::free(((void**)ptr)[-1]);
 	}
+
+	/** Returns the number of bytes usable in a block of memory allocated by platformAlignedAlloc(). */
+	inline size_t platformAlignedAllocSize(void* ptr)
+	{
+		return platformAllocSize(((void**)ptr)[-1]);
+	}
 #endif
 
+	/** Statistics about memory allocated through a single allocation category. */
+	struct MemoryCategoryStats
+	{
+		/** Name of the category. */
+		const char* name = nullptr;
+
+		/** Number of bytes currently allocated. */
+		int64_t liveBytes = 0;
+
+		/** Highest number of bytes that were allocated at the same time (high-water mark). */
+		int64_t peakBytes = 0;
+
+		/** Total number of allocations made. */
+		uint64_t numAllocs = 0;
+
+		/** Total number of frees made. */
+		uint64_t numFrees = 0;
+	};
+
+	/**
+	 * Provides a human readable name for the allocation category identified by the allocator type @p T. Allocations
+	 * made through allocator types without a name are accounted for together, under the "Other" category. Specialize in
+	 * order to track a category separately.
+	 */
+	template<class T>
+	struct MemoryCategoryName
+	{
+		static constexpr const char* get() { return "Other"; }
+	};
+
+	/**
+	 * Determines if allocations made through the allocator type @p T use ThreadCachingAlloc instead of the system
+	 * allocator. By default this is controlled by the ALLOCATOR CMake option. Specialize in order to choose the allocator
+	 * for a specific category (e.g. to always use ThreadCachingAlloc for short lived allocations made from many threads).
+	 */
+	template<class T>
+	struct UseThreadCachingAlloc
+	{
+		static constexpr bool value = BS_THREAD_CACHING_ALLOC != 0;
+	};
+
 	/**
 	 * Thread safe class used for storing total number of memory allocations and deallocations, primarily for statistic
 	 * purposes.
+	 *
+	 * Additionally keeps track of the number of bytes allocated per allocation category (i.e. per type used as the
+	 * parameter of MemoryAllocator). Each thread accumulates its changes in its own set of counters, which are only
+	 * merged into the shared counters once a thread allocates or frees more than a certain amount of memory. This means
+	 * the number of live bytes is exact, while the high-water mark might be off by at most 64KB per thread.
 	 */
 	class MemoryCounter
 	{
 	public:
+		/** Maximum number of separately tracked allocation categories. */
+		static constexpr uint32_t MAX_CATEGORIES = 32;
+
 		static BS_UTILITY_EXPORT uint64_t getNumAllocs()
 		{
 			return Allocs;
@@ -113,6 +213,19 @@ namespace bs
 			return Frees;
 		}
 
+		/** Returns the number of allocation categories registered so far. */
+		static BS_UTILITY_EXPORT uint32_t getNumCategories();
+
+		/** Returns statistics about all memory allocated in the category with the specified index. */
+		static BS_UTILITY_EXPORT MemoryCategoryStats getCategoryStats(uint32_t category);
+
+		/**
+		 * Registers a new allocation category and returns its index. If a category with the same name already exists,
+		 * index of the existing category is returned instead. If the maximum number of categories was reached, index of
+		 * the "Other" category is returned.
+		 */
+		static BS_UTILITY_EXPORT uint32_t registerCategory(const char* name);
+
 	private:
 		friend class MemoryAllocatorBase;
 
@@ -120,6 +233,12 @@ namespace bs
 		static BS_UTILITY_EXPORT void incAllocCount() { ++Allocs; }
 		static BS_UTILITY_EXPORT void incFreeCount() { ++Frees; }
 
+		/** Registers an allocation of @p bytes bytes in the provided category. */
+		static BS_UTILITY_EXPORT void trackAlloc(uint32_t category, size_t bytes);
+
+		/** Registers a free of @p bytes bytes in the provided category. */
+		static BS_UTILITY_EXPORT void trackFree(uint32_t category, size_t bytes);
+
 		static BS_THREADLOCAL uint64_t Allocs;
 		static BS_THREADLOCAL uint64_t Frees;
 	};
@@ -130,6 +249,8 @@ namespace bs
 	protected:
 		static void incAllocCount() { MemoryCounter::incAllocCount(); }
 		static void incFreeCount() { MemoryCounter::incFreeCount(); }
+		static void trackAlloc(uint32_t category, size_t bytes) { MemoryCounter::trackAlloc(category, bytes); }
+		static void trackFree(uint32_t category, size_t bytes) { MemoryCounter::trackFree(category, bytes); }
 	};
 
 	/**
@@ -149,7 +270,14 @@ namespace bs
 			incAllocCount();
 #endif
 
-			return malloc(bytes);
+			void* ptr = UseThreadCachingAlloc<T>::value ? ThreadCachingAlloc::allocate(bytes) : malloc(bytes);
+
+#if BS_MEMORY_ACCOUNTING_ENABLED
+			if (ptr != nullptr)
+				trackAlloc(getCategory(), getAllocSize(ptr));
+#endif
+
+			return ptr;
 		}
 
 		/**
@@ -162,7 +290,14 @@ namespace bs
 			incAllocCount();
 #endif
 
-			return platformAlignedAlloc(bytes, alignment);
+			void* ptr = platformAlignedAlloc(bytes, alignment);
+
+#if BS_MEMORY_ACCOUNTING_ENABLED
+			if (ptr != nullptr)
+				trackAlloc(getCategory(), platformAlignedAllocSize(ptr));
+#endif
+
+			return ptr;
 		}
 
 		/** Allocates @p bytes and aligns them to a 16 byte boundary. */
@@ -172,7 +307,16 @@ namespace bs
 			incAllocCount();
 #endif
 
-			return platformAlignedAlloc16(bytes);
+			// Memory returned by ThreadCachingAlloc is always 16 byte aligned
+			void* ptr = UseThreadCachingAlloc<T>::value ? ThreadCachingAlloc::allocate(bytes) : 
+				platformAlignedAlloc16(bytes);
+
+#if BS_MEMORY_ACCOUNTING_ENABLED
+			if (ptr != nullptr)
+				trackAlloc(getCategory(), getAlignedAllocSize16(ptr));
+#endif
+
+			return ptr;
 		}
 
 		/** Frees the memory at the specified location. */
@@ -182,7 +326,15 @@ namespace bs
 			incFreeCount();
 #endif
 
-			::free(ptr);
+#if BS_MEMORY_ACCOUNTING_ENABLED
+			if (ptr != nullptr)
+				trackFree(getCategory(), getAllocSize(ptr));
+#endif
+
+			if (UseThreadCachingAlloc<T>::value)
+				ThreadCachingAlloc::free(ptr);
+			else
+				::free(ptr);
 		}
 
 		/** Frees memory allocated with allocateAligned() */
@@ -192,6 +344,11 @@ namespace bs
 			incFreeCount();
 #endif
 
+#if BS_MEMORY_ACCOUNTING_ENABLED
+			if (ptr != nullptr)
+				trackFree(getCategory(), platformAlignedAllocSize(ptr));
+#endif
+
 			platformAlignedFree(ptr);
 		}
 
@@ -202,7 +359,35 @@ namespace bs
 			incFreeCount();
 #endif
 
-			platformAlignedFree16(ptr);
+#if BS_MEMORY_ACCOUNTING_ENABLED
+			if (ptr != nullptr)
+				trackFree(getCategory(), getAlignedAllocSize16(ptr));
+#endif
+
+			if (UseThreadCachingAlloc<T>::value)
+				ThreadCachingAlloc::free(ptr);
+			else
+				platformAlignedFree16(ptr);
+		}
+
+	private:
+		/** Returns the index of the category memory allocated by this allocator is accounted under. */
+		static uint32_t getCategory()
+		{
+			static const uint32_t category = MemoryCounter::registerCategory(MemoryCategoryName<T>::get());
+			return category;
+		}
+
+		/** Returns the number of bytes usable in a block of memory allocated with allocate(). */
+		static size_t getAllocSize(void* ptr)
+		{
+			return UseThreadCachingAlloc<T>::value ? ThreadCachingAlloc::getSize(ptr) : platformAllocSize(ptr);
+		}
+
+		/** Returns the number of bytes usable in a block of memory allocated with allocateAligned16(). */
+		static size_t getAlignedAllocSize16(void* ptr)
+		{
+			return UseThreadCachingAlloc<T>::value ? ThreadCachingAlloc::getSize(ptr) : platformAlignedAllocSize16(ptr);
 		}
 	};
 
@@ -213,6 +398,8 @@ namespace bs
 	class GenAlloc
 	{ };
 
+	template<> struct MemoryCategoryName<GenAlloc> { static constexpr const char* get() { return "General"; } };
+
 	/** @} */
 	/** @} */
 
@@ -15,6 +15,13 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Allocation category used for memory blocks owned by pool allocators. */
+	class PoolBlockAlloc
+	{ };
+
+	template<> struct MemoryCategoryName<PoolBlockAlloc> { static constexpr const char* get() { return "Pool"; } };
+	template<> struct UseThreadCachingAlloc<PoolBlockAlloc> { static constexpr bool value = false; };
+
 	/**
 	 * A memory allocator that allocates elements of the same size. Allows for fairly quick allocations and deallocations.
 	 * 
@@ -192,7 +199,7 @@ namespace bs
 				constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
 				size_t paddedBlockDataSize = blockDataSize + (Alignment - 1); // Padding for potential alignment correction
 
-				UINT8* data = (UINT8*)bs_alloc(sizeof(MemBlock) + (UINT32)paddedBlockDataSize);
+				UINT8* data = (UINT8*)bs_alloc<PoolBlockAlloc>(sizeof(MemBlock) + (UINT32)paddedBlockDataSize);
 
 				void* blockData = data + sizeof(MemBlock);
 				blockData = std::align(Alignment, blockDataSize, blockData, paddedBlockDataSize);
@@ -211,7 +218,7 @@ namespace bs
 		void deallocBlock(MemBlock* block)
 		{
 			block->~MemBlock();
-			bs_free(block);
+			bs_free<PoolBlockAlloc>(block);
 
 			mNumBlocks--;
 		}
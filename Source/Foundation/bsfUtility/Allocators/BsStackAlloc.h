@@ -20,6 +20,13 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Allocation category used for memory blocks owned by stack allocators. */
+	class StackBlockAlloc
+	{ };
+
+	template<> struct MemoryCategoryName<StackBlockAlloc> { static constexpr const char* get() { return "Stack"; } };
+	template<> struct UseThreadCachingAlloc<StackBlockAlloc> { static constexpr bool value = false; };
+
 	/**
 	 * Describes a memory stack of a certain block capacity. See MemStack for more information.
 	 *
@@ -185,7 +192,7 @@ namespace bs
 
 			if (newBlock == nullptr)
 			{
-				UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(bs_alloc(blockSize + sizeof(MemBlock)));
+				UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(bs_alloc<StackBlockAlloc>(blockSize + sizeof(MemBlock)));
 				newBlock = new (data)MemBlock(blockSize);
 				data += sizeof(MemBlock);
 
@@ -210,7 +217,7 @@ namespace bs
 		void deallocBlock(MemBlock* block)
 		{
 			block->~MemBlock();
-			bs_free(block);
+			bs_free<StackBlockAlloc>(block);
 		}
 	};
 
@@ -0,0 +1,430 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsThreadCachingAlloc.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	namespace
+	{
+		/** Size of a span, in bytes. */
+		constexpr size_t SPAN_SIZE = 64 * 1024;
+
+		/** Size of the header at the start of each span. Elements follow the header. */
+		constexpr size_t SPAN_HEADER_SIZE = 64;
+
+		/** Number of size classes of equal 16 byte increments, used for small sizes. */
+		constexpr UINT32 NUM_LINEAR_SIZE_CLASSES = 16;
+
+		/** Number of size classes each power of two range is split into, used for sizes above the linear classes. */
+		constexpr UINT32 SIZE_CLASSES_PER_POW2 = 4;
+
+		/** Total number of size classes. Linear classes cover sizes up to 256 bytes, followed by classes up to 8KB. */
+		constexpr UINT32 NUM_SIZE_CLASSES = NUM_LINEAR_SIZE_CLASSES + 5 * SIZE_CLASSES_PER_POW2;
+
+		/** Size of the header in front of each large allocation. Keeps the returned memory 16 byte aligned. */
+		constexpr size_t LARGE_HEADER_SIZE = 16;
+
+		/** Number of address bits taken into account by the span map. Any higher bits (e.g. pointer tags) are ignored. */
+		constexpr UINT32 SPAN_MAP_ADDRESS_BITS = sizeof(void*) == 8 ? 48 : 32;
+
+		/** Number of low address bits ignored by the span map. Each span map entry covers a range of this size. */
+		constexpr UINT32 SPAN_MAP_GRANULE_BITS = 16;
+
+		/** Number of address bits indexing into leaf nodes of the span map. */
+		constexpr UINT32 SPAN_MAP_LEAF_BITS = 12;
+
+		/** Number of address bits indexing into middle nodes of the span map. */
+		constexpr UINT32 SPAN_MAP_MID_BITS = (SPAN_MAP_ADDRESS_BITS - SPAN_MAP_GRANULE_BITS - SPAN_MAP_LEAF_BITS) / 2;
+
+		/** Number of address bits indexing into the root node of the span map. */
+		constexpr UINT32 SPAN_MAP_ROOT_BITS = 
+			SPAN_MAP_ADDRESS_BITS - SPAN_MAP_GRANULE_BITS - SPAN_MAP_LEAF_BITS - SPAN_MAP_MID_BITS;
+
+		static_assert(((size_t)1 << SPAN_MAP_GRANULE_BITS) == SPAN_SIZE, 
+			"Span map granules must be of the same size as spans.");
+
+		struct ThreadHeap;
+
+		/** Header at the start of each span. */
+		struct Span
+		{
+			/** Heap that owns the elements in the span. */
+			ThreadHeap* heap;
+
+			/** Size class of the elements in the span. */
+			UINT32 sizeClass;
+
+			/** Size of each element in the span. */
+			size_t elemSize;
+		};
+
+		static_assert(sizeof(Span) <= SPAN_HEADER_SIZE, "Span header doesn't fit in the reserved space.");
+
+		/** 
+		 * Entry in the span map covering a single granule of the address space. Spans are allocated from the system 
+		 * allocator and are not aligned to the granule size, so a granule can overlap the end of one span and the start of
+		 * another.
+		 */
+		struct SpanMapLeafEntry
+		{
+			std::atomic<Span*> spans[2];
+		};
+
+		struct SpanMapLeaf
+		{
+			SpanMapLeafEntry entries[1 << SPAN_MAP_LEAF_BITS];
+		};
+
+		struct SpanMapMid
+		{
+			std::atomic<SpanMapLeaf*> leaves[1 << SPAN_MAP_MID_BITS];
+		};
+
+		/** 
+		 * Radix tree mapping address ranges to the spans that contain them. Used for determining whether memory being
+		 * freed belongs to a span, and which one. Nodes are created as needed and never freed, same as spans.
+		 */
+		std::atomic<SpanMapMid*> gSpanMap[1 << SPAN_MAP_ROOT_BITS];
+
+		/** Cache of free elements of a single size class, owned by a single thread. */
+		struct SizeClassCache
+		{
+			/** Singly linked list of free elements, with the link stored in the first bytes of each element. */
+			void* freeList = nullptr;
+
+			/** Next unused element in the most recently allocated span. */
+			UINT8* spanPtr = nullptr;
+
+			/** End of the most recently allocated span. */
+			UINT8* spanEnd = nullptr;
+		};
+
+		/**
+		 * Per-thread state of the allocator. Heaps are never freed. Instead once a thread terminates its heap gets reused
+		 * by the next thread that starts, as elements of the heap might still get freed by other threads.
+		 */
+		struct ThreadHeap
+		{
+			SizeClassCache caches[NUM_SIZE_CLASSES];
+
+			/** Elements freed by threads other than the owner, linked in the same way as the free list. */
+			std::atomic<void*> remoteFrees[NUM_SIZE_CLASSES];
+
+			std::atomic<bool> inUse;
+			ThreadHeap* next;
+		};
+
+		/** Releases the heap of the current thread when the thread terminates. */
+		struct ThreadHeapReleaser
+		{
+			~ThreadHeapReleaser();
+
+			ThreadHeap* heap = nullptr;
+		};
+
+		std::atomic<ThreadHeap*> gThreadHeaps { nullptr };
+
+		/**
+		 * Heap used by threads after their own heap has been released (i.e. allocations performed by other thread local
+		 * object destructors), or if a thread heap cannot be allocated. Access must be synchronized by gSharedHeapMutex.
+		 */
+		ThreadHeap gSharedHeap;
+		Mutex gSharedHeapMutex;
+
+		BS_THREADLOCAL ThreadHeap* tThreadHeap = nullptr;
+		thread_local ThreadHeapReleaser tThreadHeapReleaser;
+
+		/** Returns the size class a small allocation of the provided size belongs to. */
+		UINT32 getSizeClass(size_t size)
+		{
+			if (size <= NUM_LINEAR_SIZE_CLASSES * 16)
+				return size == 0 ? 0 : (UINT32)((size + 15) / 16) - 1;
+
+			// Split each power of two range into equally sized classes
+			UINT32 value = (UINT32)size - 1;
+			UINT32 pow2 = Bitwise::mostSignificantBitSet(value);
+			UINT32 subClass = (value >> (pow2 - 2)) - SIZE_CLASSES_PER_POW2;
+
+			return NUM_LINEAR_SIZE_CLASSES + (pow2 - 8) * SIZE_CLASSES_PER_POW2 + subClass;
+		}
+
+		/** Returns the size of elements in the provided size class. */
+		size_t getSizeClassSize(UINT32 sizeClass)
+		{
+			if (sizeClass < NUM_LINEAR_SIZE_CLASSES)
+				return (sizeClass + 1) * 16;
+
+			UINT32 pow2 = (sizeClass - NUM_LINEAR_SIZE_CLASSES) / SIZE_CLASSES_PER_POW2;
+			UINT32 subClass = (sizeClass - NUM_LINEAR_SIZE_CLASSES) % SIZE_CLASSES_PER_POW2;
+
+			return ((size_t)256 << pow2) * (SIZE_CLASSES_PER_POW2 + 1 + subClass) / SIZE_CLASSES_PER_POW2;
+		}
+
+		/** Returns the span map entry covering the provided address, optionally creating it if it doesn't exist. */
+		SpanMapLeafEntry* getSpanMapEntry(uintptr_t address, bool create)
+		{
+			uintptr_t granule = address >> SPAN_MAP_GRANULE_BITS;
+			uintptr_t leafIdx = granule & ((1 << SPAN_MAP_LEAF_BITS) - 1);
+			uintptr_t midIdx = (granule >> SPAN_MAP_LEAF_BITS) & ((1 << SPAN_MAP_MID_BITS) - 1);
+			uintptr_t rootIdx = (granule >> (SPAN_MAP_LEAF_BITS + SPAN_MAP_MID_BITS)) & ((1 << SPAN_MAP_ROOT_BITS) - 1);
+
+			SpanMapMid* mid = gSpanMap[rootIdx].load(std::memory_order_acquire);
+			if (mid == nullptr)
+			{
+				if (!create)
+					return nullptr;
+
+				SpanMapMid* newMid = (SpanMapMid*)::calloc(1, sizeof(SpanMapMid));
+				if (newMid == nullptr)
+					return nullptr;
+
+				if (gSpanMap[rootIdx].compare_exchange_strong(mid, newMid, std::memory_order_acq_rel))
+					mid = newMid;
+				else
+					::free(newMid);
+			}
+
+			SpanMapLeaf* leaf = mid->leaves[midIdx].load(std::memory_order_acquire);
+			if (leaf == nullptr)
+			{
+				if (!create)
+					return nullptr;
+
+				SpanMapLeaf* newLeaf = (SpanMapLeaf*)::calloc(1, sizeof(SpanMapLeaf));
+				if (newLeaf == nullptr)
+					return nullptr;
+
+				if (mid->leaves[midIdx].compare_exchange_strong(leaf, newLeaf, std::memory_order_acq_rel))
+					leaf = newLeaf;
+				else
+					::free(newLeaf);
+			}
+
+			return &leaf->entries[leafIdx];
+		}
+
+		/** Records the span in the span map entries of all granules it overlaps. Returns false if out of memory. */
+		bool registerSpan(Span* span)
+		{
+			uintptr_t start = (uintptr_t)span;
+			uintptr_t end = start + SPAN_SIZE - 1;
+
+			SpanMapLeafEntry* entries[2];
+			entries[0] = getSpanMapEntry(start, true);
+			entries[1] = getSpanMapEntry(end, true);
+
+			if (entries[0] == nullptr || entries[1] == nullptr)
+				return false;
+
+			UINT32 numEntries = entries[0] == entries[1] ? 1 : 2;
+			for (UINT32 i = 0; i < numEntries; i++)
+			{
+				// Spans are never freed, and at most two spans can overlap a granule, so a free slot must exist
+				for (auto& slot : entries[i]->spans)
+				{
+					Span* expected = nullptr;
+					if (slot.compare_exchange_strong(expected, span, std::memory_order_release))
+						break;
+				}
+			}
+
+			return true;
+		}
+
+		/** Returns the span the provided element belongs to, or null if the element isn't part of a span. */
+		Span* getSpan(void* ptr)
+		{
+			SpanMapLeafEntry* entry = getSpanMapEntry((uintptr_t)ptr, false);
+			if (entry == nullptr)
+				return nullptr;
+
+			for (auto& slot : entry->spans)
+			{
+				Span* span = slot.load(std::memory_order_acquire);
+				if (span != nullptr && (UINT8*)ptr >= (UINT8*)span && (UINT8*)ptr < (UINT8*)span + SPAN_SIZE)
+					return span;
+			}
+
+			return nullptr;
+		}
+
+		/** Finds an unused heap or creates a new one, and assigns it to the current thread. */
+		ThreadHeap* acquireThreadHeap()
+		{
+			ThreadHeap* heap = nullptr;
+			for (ThreadHeap* entry = gThreadHeaps.load(std::memory_order_acquire); entry; entry = entry->next)
+			{
+				bool inUse = false;
+				if (entry->inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+				{
+					heap = entry;
+					break;
+				}
+			}
+
+			if (heap == nullptr)
+			{
+				void* data = ::malloc(sizeof(ThreadHeap));
+				if (data == nullptr)
+					return &gSharedHeap;
+
+				heap = new (data) ThreadHeap();
+				heap->inUse.store(true, std::memory_order_relaxed);
+
+				ThreadHeap* head = gThreadHeaps.load(std::memory_order_relaxed);
+				do
+				{
+					heap->next = head;
+				} while (!gThreadHeaps.compare_exchange_weak(head, heap, std::memory_order_release,
+					std::memory_order_relaxed));
+			}
+
+			tThreadHeapReleaser.heap = heap;
+			return heap;
+		}
+
+		ThreadHeapReleaser::~ThreadHeapReleaser()
+		{
+			if (heap == nullptr)
+				return;
+
+			heap->inUse.store(false, std::memory_order_release);
+			heap = nullptr;
+
+			tThreadHeap = &gSharedHeap;
+		}
+
+		/** Allocates an element of the provided size class from the provided heap. */
+		void* allocateSmall(ThreadHeap* heap, UINT32 sizeClass)
+		{
+			SizeClassCache& cache = heap->caches[sizeClass];
+
+			void* element = cache.freeList;
+			if (element != nullptr)
+			{
+				cache.freeList = *(void**)element;
+				return element;
+			}
+
+			// Reclaim all elements freed by other threads
+			std::atomic<void*>& remoteFrees = heap->remoteFrees[sizeClass];
+			if (remoteFrees.load(std::memory_order_relaxed) != nullptr)
+			{
+				element = remoteFrees.exchange(nullptr, std::memory_order_acquire);
+				if (element != nullptr)
+				{
+					cache.freeList = *(void**)element;
+					return element;
+				}
+			}
+
+			size_t elemSize = getSizeClassSize(sizeClass);
+			if (cache.spanPtr + elemSize > cache.spanEnd)
+			{
+				UINT8* data = (UINT8*)platformAlignedAlloc16(SPAN_SIZE);
+				if (data == nullptr)
+					return nullptr;
+
+				Span* span = (Span*)data;
+				span->heap = heap;
+				span->sizeClass = sizeClass;
+				span->elemSize = elemSize;
+
+				if (!registerSpan(span))
+				{
+					platformAlignedFree16(data);
+					return nullptr;
+				}
+
+				cache.spanPtr = data + SPAN_HEADER_SIZE;
+				cache.spanEnd = data + SPAN_SIZE;
+			}
+
+			element = cache.spanPtr;
+			cache.spanPtr += elemSize;
+
+			return element;
+		}
+
+		/** 
+		 * Allocates memory for an allocation too large to fit in any of the size classes. Allocation size is stored in a 
+		 * header in front of the returned memory.
+		 */
+		void* allocateLarge(size_t bytes)
+		{
+			UINT8* data = (UINT8*)platformAlignedAlloc16(LARGE_HEADER_SIZE + bytes);
+			if (data == nullptr)
+				return nullptr;
+
+			*(size_t*)data = bytes;
+			return data + LARGE_HEADER_SIZE;
+		}
+	}
+
+	void* ThreadCachingAlloc::allocate(size_t bytes)
+	{
+		if (bytes > MAX_SMALL_SIZE)
+			return allocateLarge(bytes);
+
+		ThreadHeap* heap = tThreadHeap;
+		if (heap == nullptr)
+		{
+			heap = acquireThreadHeap();
+			tThreadHeap = heap;
+		}
+
+		UINT32 sizeClass = getSizeClass(bytes);
+		if (heap == &gSharedHeap)
+		{
+			Lock lock(gSharedHeapMutex);
+			return allocateSmall(heap, sizeClass);
+		}
+
+		return allocateSmall(heap, sizeClass);
+	}
+
+	void ThreadCachingAlloc::free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		// Memory not belonging to any span must be a large allocation
+		Span* span = getSpan(ptr);
+		if (span == nullptr)
+		{
+			platformAlignedFree16((UINT8*)ptr - LARGE_HEADER_SIZE);
+			return;
+		}
+
+		ThreadHeap* heap = span->heap;
+		if (heap == tThreadHeap && heap != &gSharedHeap)
+		{
+			SizeClassCache& cache = heap->caches[span->sizeClass];
+
+			*(void**)ptr = cache.freeList;
+			cache.freeList = ptr;
+		}
+		else
+		{
+			std::atomic<void*>& remoteFrees = heap->remoteFrees[span->sizeClass];
+
+			void* head = remoteFrees.load(std::memory_order_relaxed);
+			do
+			{
+				*(void**)ptr = head;
+			} while (!remoteFrees.compare_exchange_weak(head, ptr, std::memory_order_release,
+				std::memory_order_relaxed));
+		}
+	}
+
+	size_t ThreadCachingAlloc::getSize(void* ptr)
+	{
+		Span* span = getSpan(ptr);
+		if (span == nullptr)
+			return *(size_t*)((UINT8*)ptr - LARGE_HEADER_SIZE);
+
+		return span->elemSize;
+	}
+}
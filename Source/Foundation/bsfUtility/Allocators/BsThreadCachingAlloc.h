@@ -0,0 +1,54 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include <cstddef>
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/**
+	 * General purpose allocator optimized for frequent allocations from multiple threads.
+	 *
+	 * Small allocations are rounded up to one of a fixed set of size classes. Each thread has its own cache of free
+	 * elements per size class, allowing most allocations and frees to proceed without any synchronization. Elements are
+	 * carved out of 64KB spans, each span holding elements of a single size class and belonging to a single thread.
+	 * Elements freed by a thread other than the owner are pushed onto the owner's lock-free list of remote frees, which
+	 * the owner reclaims once its own cache runs dry.
+	 *
+	 * Spans are allocated from the system allocator and recorded in a global span map, through which the span owning a
+	 * freed element is found. Allocations larger than the largest size class are forwarded to the system allocator, with
+	 * a small header storing their size.
+	 *
+	 * All returned memory is aligned to a 16 byte boundary.
+	 *
+	 * @note	Memory of small allocations is never returned to the system, but is instead reused for further
+	 *			allocations. Once a thread terminates its cache is handed to the next thread that gets started.
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT ThreadCachingAlloc
+	{
+	public:
+		/** Size of the largest allocation served from the per-thread caches, in bytes. */
+		static constexpr size_t MAX_SMALL_SIZE = 8192;
+
+		/** Allocates @p bytes bytes. */
+		static void* allocate(size_t bytes);
+
+		/** Frees memory previously allocated with allocate(). */
+		static void free(void* ptr);
+
+		/** Returns the number of bytes usable in a block of memory allocated with allocate(). */
+		static size_t getSize(void* ptr);
+	};
+
+	/** @} */
+	/** @} */
+}
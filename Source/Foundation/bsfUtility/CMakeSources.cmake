@@ -4,6 +4,7 @@ set(BS_UTILITY_INC_THREADING
 	"bsfUtility/Threading/BsSpinLock.h"
 	"bsfUtility/Threading/BsThreadPool.h"
 	"bsfUtility/Threading/BsTaskScheduler.h"
+	"bsfUtility/Threading/BsTaskQueue.h"
 )
 
 set(BS_UTILITY_SRC_THIRDPARTY
@@ -54,23 +55,27 @@ set(BS_UTILITY_INC_DEBUG
 	"bsfUtility/Debug/BsBitmapWriter.h"
 	"bsfUtility/Debug/BsDebug.h"
 	"bsfUtility/Debug/BsLog.h"
+	"bsfUtility/Debug/BsProfilerTimeline.h"
 )
 
 set(BS_UTILITY_INC_FILESYSTEM
 	"bsfUtility/FileSystem/BsFileSystem.h"
 	"bsfUtility/FileSystem/BsDataStream.h"
 	"bsfUtility/FileSystem/BsPath.h"
+	"bsfUtility/FileSystem/BsAsyncFileIO.h"
 )
 
 set(BS_UTILITY_SRC_FILESYSTEM
 	"bsfUtility/FileSystem/BsDataStream.cpp"
 	"bsfUtility/FileSystem/BsFileSystem.cpp"
 	"bsfUtility/FileSystem/BsPath.cpp"
+	"bsfUtility/FileSystem/BsAsyncFileIO.cpp"
 )
 
 set(BS_UTILITY_SRC_THREADING
 	"bsfUtility/Threading/BsAsyncOp.cpp"
 	"bsfUtility/Threading/BsTaskScheduler.cpp"
+	"bsfUtility/Threading/BsTaskQueue.cpp"
 	"bsfUtility/Threading/BsThreadPool.cpp"
 )
 
@@ -101,6 +106,7 @@ set(BS_UTILITY_SRC_ALLOCATORS
 	"bsfUtility/Allocators/BsFrameAlloc.cpp"
 	"bsfUtility/Allocators/BsStackAlloc.cpp"
 	"bsfUtility/Allocators/BsMemoryAllocator.cpp"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.cpp"
 )
 
 set(BS_UTILITY_SRC_REFLECTION
@@ -113,6 +119,7 @@ set(BS_UTILITY_SRC_DEBUG
 	"bsfUtility/Debug/BsBitmapWriter.cpp"
 	"bsfUtility/Debug/BsLog.cpp"
 	"bsfUtility/Debug/BsDebug.cpp"
+	"bsfUtility/Debug/BsProfilerTimeline.cpp"
 )
 
 set(BS_UTILITY_INC_RTTI
@@ -129,6 +136,8 @@ set(BS_UTILITY_INC_ALLOCATORS
 	"bsfUtility/Allocators/BsGroupAlloc.h"
 	"bsfUtility/Allocators/BsFreeAlloc.h"
 	"bsfUtility/Allocators/BsPoolAlloc.h"
+	"bsfUtility/Allocators/BsConcurrentPoolAlloc.h"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.h"
 )
 
 set(BS_UTILITY_INC_THIRDPARTY
@@ -267,6 +276,7 @@ set(BS_UTILITY_SRC_UNIX
 set(BS_UTILITY_SRC_LINUX
 	"bsfUtility/Private/Linux/BsLinuxCrashHandler.cpp"
 	"bsfUtility/Private/Linux/BsLinuxPlatformUtility.cpp"
+	"bsfUtility/Private/Linux/BsLinuxAsyncFileIO.cpp"
 )
 
 set(BS_UTILITY_SRC_MACOS
@@ -0,0 +1,478 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Debug/BsProfilerTimeline.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include <chrono>
+#include <iomanip>
+
+namespace bs
+{
+	namespace
+	{
+		/** Writes a string to the stream as a quoted JSON string, escaping any special characters. */
+		void writeJsonString(StringStream& stream, const String& value)
+		{
+			stream << '"';
+			for (char ch : value)
+			{
+				switch (ch)
+				{
+				case '"': stream << "\\\""; break;
+				case '\\': stream << "\\\\"; break;
+				case '\n': stream << "\\n"; break;
+				case '\r': stream << "\\r"; break;
+				case '\t': stream << "\\t"; break;
+				default:
+					if ((UINT8)ch < 0x20)
+						stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (UINT32)ch << std::dec;
+					else
+						stream << ch;
+					break;
+				}
+			}
+			stream << '"';
+		}
+
+		/** Type of an event recorded in a thread's ring buffer. */
+		enum class TimelineEventType : UINT32
+		{
+			Begin,
+			End
+		};
+
+		/** Single event recorded in a thread's ring buffer. */
+		struct TimelineEvent
+		{
+			UINT64 timestamp;
+			UINT32 nameId;
+			TimelineEventType type;
+		};
+
+		/** Single recorded GPU sample. */
+		struct GPUSample
+		{
+			UINT64 timestamp;
+			UINT32 nameId;
+			float durationMs;
+		};
+
+		/**
+		 * Ring buffer of events recorded by a single thread. Buffers are never freed. Instead once a thread terminates its
+		 * buffer gets reused by the next thread that starts recording.
+		 */
+		struct ThreadBuffer
+		{
+			TimelineEvent events[ProfilerTimeline::EVENTS_PER_THREAD];
+
+			/** Total number of events written to the buffer. Written only by the owning thread. */
+			std::atomic<UINT64> writePos { 0 };
+
+			std::atomic<bool> inUse { false };
+			UINT32 threadIdx = 0;
+			String name;
+
+			ThreadBuffer* next = nullptr;
+		};
+
+		/** Releases the buffer of the current thread when the thread terminates. */
+		struct ThreadBufferReleaser
+		{
+			~ThreadBufferReleaser();
+
+			ThreadBuffer* buffer = nullptr;
+		};
+
+		/** Global state of the timeline. */
+		struct TimelineState
+		{
+			TimelineState()
+			{
+				startTimestamp = ProfilerTimeline::getTimestamp();
+				startTime = std::chrono::steady_clock::now();
+			}
+
+			// Thread buffers
+			Mutex threadMutex;
+			ThreadBuffer* threadBuffers = nullptr;
+			UINT32 numThreadBuffers = 0;
+
+			// Sample names
+			Mutex nameMutex;
+			UnorderedMap<String, UINT32> nameLookup;
+			Vector<String> names;
+
+			// GPU samples, recorded by a single thread at a time
+			Mutex gpuMutex;
+			GPUSample gpuSamples[ProfilerTimeline::MAX_GPU_SAMPLES];
+			UINT64 gpuWritePos = 0;
+
+			// Reference points for converting timestamps into real time
+			UINT64 startTimestamp;
+			std::chrono::steady_clock::time_point startTime;
+
+			// Automatic capture, accessed only from the simulation thread
+			float autoCaptureThresholdMs = 0.0f;
+			Path autoCaptureFolder;
+			UINT64 lastFrameTimestamp = 0;
+			UINT32 framesUntilCapture = 0;
+			UINT32 numCaptures = 0;
+			std::atomic<bool> captureInProgress { false };
+		};
+
+		/**
+		 * Returns the global timeline state. The state is never freed, as samples can still be recorded by other threads
+		 * during static destruction.
+		 */
+		TimelineState& getState()
+		{
+			static TimelineState* state = new TimelineState();
+			return *state;
+		}
+
+		BS_THREADLOCAL ThreadBuffer* tThreadBuffer = nullptr;
+		BS_THREADLOCAL const char* tThreadName = nullptr;
+		thread_local ThreadBufferReleaser tThreadBufferReleaser;
+
+		ThreadBufferReleaser::~ThreadBufferReleaser()
+		{
+			if (buffer == nullptr)
+				return;
+
+			buffer->inUse.store(false, std::memory_order_release);
+			buffer = nullptr;
+
+			tThreadBuffer = nullptr;
+		}
+
+		/** Finds an unused thread buffer or creates a new one, and assigns it to the current thread. */
+		ThreadBuffer* acquireThreadBuffer()
+		{
+			TimelineState& state = getState();
+			Lock lock(state.threadMutex);
+
+			ThreadBuffer* buffer = nullptr;
+			for (ThreadBuffer* entry = state.threadBuffers; entry; entry = entry->next)
+			{
+				if (!entry->inUse.load(std::memory_order_acquire))
+				{
+					buffer = entry;
+					break;
+				}
+			}
+
+			if (buffer == nullptr)
+			{
+				buffer = bs_new<ThreadBuffer>();
+				buffer->threadIdx = state.numThreadBuffers++;
+				buffer->next = state.threadBuffers;
+
+				state.threadBuffers = buffer;
+			}
+
+			buffer->inUse.store(true, std::memory_order_relaxed);
+			buffer->name = tThreadName != nullptr ? tThreadName : "Thread " + toString(buffer->threadIdx);
+
+			tThreadBufferReleaser.buffer = buffer;
+			return buffer;
+		}
+
+		/** Records a new event in the ring buffer of the calling thread. */
+		void recordEvent(UINT32 nameId, TimelineEventType type)
+		{
+			ThreadBuffer* buffer = tThreadBuffer;
+			if (buffer == nullptr)
+			{
+				buffer = acquireThreadBuffer();
+				tThreadBuffer = buffer;
+			}
+
+			UINT64 pos = buffer->writePos.load(std::memory_order_relaxed);
+
+			TimelineEvent& event = buffer->events[pos % ProfilerTimeline::EVENTS_PER_THREAD];
+			event.timestamp = ProfilerTimeline::getTimestamp();
+			event.nameId = nameId;
+			event.type = type;
+
+			buffer->writePos.store(pos + 1, std::memory_order_release);
+		}
+
+		/**
+		 * Copies the most recent entries from a ring buffer being concurrently written to. Entries that might have been
+		 * overwritten while copying are discarded.
+		 */
+		template<class T>
+		void copyRingBuffer(const T* entries, UINT32 capacity, const std::atomic<UINT64>& writePos, Vector<T>& output)
+		{
+			UINT64 end = writePos.load(std::memory_order_acquire);
+			UINT64 start = end > capacity ? end - capacity : 0;
+
+			output.resize((size_t)(end - start));
+			for (UINT64 i = start; i < end; i++)
+				output[(size_t)(i - start)] = entries[i % capacity];
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			UINT64 newEnd = writePos.load(std::memory_order_relaxed);
+			UINT64 firstValid = newEnd > capacity ? newEnd - capacity : 0;
+			if (firstValid > start)
+				output.erase(output.begin(), output.begin() + (size_t)std::min(firstValid - start, end - start));
+		}
+	}
+
+	std::atomic<bool> ProfilerTimeline::sEnabled { false };
+
+	void ProfilerTimeline::setEnabled(bool enabled)
+	{
+		// Make sure the timing reference point is initialized before any samples are recorded
+		getState();
+
+		sEnabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	UINT32 ProfilerTimeline::registerName(const char* name)
+	{
+		TimelineState& state = getState();
+		Lock lock(state.nameMutex);
+
+		auto iterFind = state.nameLookup.find(name);
+		if (iterFind != state.nameLookup.end())
+			return iterFind->second;
+
+		UINT32 nameId = (UINT32)state.names.size();
+		state.names.push_back(name);
+		state.nameLookup[name] = nameId;
+
+		return nameId;
+	}
+
+	void ProfilerTimeline::setThreadName(const char* name)
+	{
+		if (tThreadName == name)
+			return;
+
+		tThreadName = name;
+
+		ThreadBuffer* buffer = tThreadBuffer;
+		if (buffer != nullptr)
+		{
+			Lock lock(getState().threadMutex);
+			buffer->name = name;
+		}
+	}
+
+	void ProfilerTimeline::beginSample(UINT32 nameId)
+	{
+		if (!isEnabled())
+			return;
+
+		recordEvent(nameId, TimelineEventType::Begin);
+	}
+
+	void ProfilerTimeline::endSample(UINT32 nameId)
+	{
+		if (!isEnabled())
+			return;
+
+		recordEvent(nameId, TimelineEventType::End);
+	}
+
+	void ProfilerTimeline::addGPUSample(UINT32 nameId, UINT64 timestamp, float durationMs)
+	{
+		if (!isEnabled())
+			return;
+
+		TimelineState& state = getState();
+		Lock lock(state.gpuMutex);
+
+		GPUSample& sample = state.gpuSamples[state.gpuWritePos % MAX_GPU_SAMPLES];
+		sample.timestamp = timestamp;
+		sample.nameId = nameId;
+		sample.durationMs = durationMs;
+
+		state.gpuWritePos++;
+	}
+
+	String ProfilerTimeline::exportChromeTrace()
+	{
+		TimelineState& state = getState();
+
+		// Calculate timestamp frequency, using the longest available time period for best accuracy
+		UINT64 endTimestamp = getTimestamp();
+		std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+		double elapsedUs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			endTime - state.startTime).count() / 1000.0;
+
+		double usPerTick = 0.0;
+		if (endTimestamp > state.startTimestamp && elapsedUs > 0.0)
+			usPerTick = elapsedUs / (double)(endTimestamp - state.startTimestamp);
+
+		auto toUs = [&](UINT64 timestamp)
+		{
+			if (timestamp < state.startTimestamp)
+				return 0.0;
+
+			return (double)(timestamp - state.startTimestamp) * usPerTick;
+		};
+
+		Vector<String> names;
+		{
+			Lock lock(state.nameMutex);
+			names = state.names;
+		}
+
+		auto getName = [&](UINT32 nameId) -> const String&
+		{
+			static String unknown = "Unknown";
+			return nameId < (UINT32)names.size() ? names[nameId] : unknown;
+		};
+
+		StringStream trace;
+		trace << std::fixed << std::setprecision(3);
+		trace << "{\"traceEvents\":[";
+
+		bool firstEvent = true;
+		auto beginEvent = [&]()
+		{
+			if (!firstEvent)
+				trace << ',';
+
+			firstEvent = false;
+		};
+
+		auto writeTrackName = [&](UINT32 trackIdx, const String& name)
+		{
+			beginEvent();
+			trace << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << trackIdx << ",\"args\":{\"name\":";
+			writeJsonString(trace, name);
+			trace << "}}";
+		};
+
+		Lock lock(state.threadMutex);
+
+		Vector<TimelineEvent> events;
+		for (ThreadBuffer* buffer = state.threadBuffers; buffer; buffer = buffer->next)
+		{
+			copyRingBuffer(buffer->events, EVENTS_PER_THREAD, buffer->writePos, events);
+			if (events.empty())
+				continue;
+
+			writeTrackName(buffer->threadIdx, buffer->name.c_str());
+
+			// Older events could have been overwritten, so skip ends of samples whose beginnings are missing
+			UINT32 depth = 0;
+			for (auto& event : events)
+			{
+				if (event.type == TimelineEventType::End)
+				{
+					if (depth == 0)
+						continue;
+
+					depth--;
+				}
+				else
+					depth++;
+
+				beginEvent();
+				trace << "{\"name\":";
+				writeJsonString(trace, getName(event.nameId));
+				trace << ",\"cat\":\"CPU\",\"ph\":\"" << (event.type == TimelineEventType::Begin ? "B" : "E") << "\"";
+				trace << ",\"ts\":" << toUs(event.timestamp) << ",\"pid\":0,\"tid\":" << buffer->threadIdx << "}";
+			}
+		}
+
+		Vector<GPUSample> gpuSamples;
+		{
+			Lock gpuLock(state.gpuMutex);
+
+			UINT64 start = state.gpuWritePos > MAX_GPU_SAMPLES ? state.gpuWritePos - MAX_GPU_SAMPLES : 0;
+			for (UINT64 i = start; i < state.gpuWritePos; i++)
+				gpuSamples.push_back(state.gpuSamples[i % MAX_GPU_SAMPLES]);
+		}
+
+		if (!gpuSamples.empty())
+		{
+			// GPU samples are displayed on their own track, after all the threads
+			UINT32 gpuTrackIdx = state.numThreadBuffers;
+			writeTrackName(gpuTrackIdx, "GPU");
+
+			for (auto& sample : gpuSamples)
+			{
+				beginEvent();
+				trace << "{\"name\":";
+				writeJsonString(trace, getName(sample.nameId));
+				trace << ",\"cat\":\"GPU\",\"ph\":\"X\",\"ts\":" << toUs(sample.timestamp);
+				trace << ",\"dur\":" << sample.durationMs * 1000.0 << ",\"pid\":0,\"tid\":" << gpuTrackIdx << "}";
+			}
+		}
+
+		trace << "],\"displayTimeUnit\":\"ms\"}";
+		return trace.str();
+	}
+
+	void ProfilerTimeline::exportChromeTrace(const Path& path)
+	{
+		String trace = exportChromeTrace();
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		stream->write(trace.data(), trace.size());
+		stream->close();
+	}
+
+	void ProfilerTimeline::setAutoCapture(float frameTimeThresholdMs, const Path& outputFolder)
+	{
+		TimelineState& state = getState();
+
+		state.autoCaptureThresholdMs = frameTimeThresholdMs;
+		state.autoCaptureFolder = outputFolder;
+	}
+
+	void ProfilerTimeline::_update()
+	{
+		TimelineState& state = getState();
+
+		UINT64 timestamp = getTimestamp();
+		UINT64 lastTimestamp = state.lastFrameTimestamp;
+		state.lastFrameTimestamp = timestamp;
+
+		if (!isEnabled() || state.autoCaptureThresholdMs <= 0.0f || lastTimestamp == 0)
+			return;
+
+		if (state.framesUntilCapture > 0)
+		{
+			if (--state.framesUntilCapture > 0)
+				return;
+
+			// Export on a worker, as the export itself can take a while
+			Path path = state.autoCaptureFolder;
+			path.append("Timeline_" + toString(state.numCaptures++) + ".json");
+
+			state.captureInProgress.store(true);
+
+			SPtr<Task> task = Task::create("ProfilerTimelineExport", [path]()
+			{
+				exportChromeTrace(path);
+				getState().captureInProgress.store(false);
+			});
+
+			TaskScheduler::instance().addTask(task);
+			return;
+		}
+
+		if (state.captureInProgress.load())
+			return;
+
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		double elapsedMs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			now - state.startTime).count() / 1000000.0;
+
+		if (timestamp <= state.startTimestamp)
+			return;
+
+		double frameTimeMs = elapsedMs * (double)(timestamp - lastTimestamp) / (double)(timestamp - state.startTimestamp);
+		if (frameTimeMs > state.autoCaptureThresholdMs)
+			state.framesUntilCapture = 2;
+	}
+}
@@ -0,0 +1,162 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#define BS_TIMELINE_USE_RDTSC 1
+
+	#if BS_COMPILER == BS_COMPILER_MSVC
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#else
+	#define BS_TIMELINE_USE_RDTSC 0
+
+	#include <chrono>
+#endif
+
+namespace bs
+{
+	/** @addtogroup Debug
+	 *  @{
+	 */
+
+	/**
+	 * Records a timeline of profiling samples across all threads, for diagnosing individual slow frames. Unlike ProfilerCPU
+	 * which only keeps aggregated per-frame statistics, the timeline keeps the start and end time of every sample.
+	 *
+	 * Each thread records its samples in its own fixed-size ring buffer without any synchronization, meaning only the most
+	 * recent samples are kept. Samples are identified by name identifiers retrieved from registerName(), which should
+	 * be called once per name and cached (see BS_TIMELINE_SAMPLE).
+	 *
+	 * Recorded samples can be exported in the Chrome trace format, viewable in chrome://tracing or Perfetto, either on
+	 * demand or automatically whenever a frame takes longer than a specified threshold.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT ProfilerTimeline
+	{
+	public:
+		/** Maximum number of events (sample begin or end) stored per thread. Older events get overwritten. */
+		static constexpr UINT32 EVENTS_PER_THREAD = 64 * 1024;
+
+		/** Maximum number of GPU samples stored. Older samples get overwritten. */
+		static constexpr UINT32 MAX_GPU_SAMPLES = 8 * 1024;
+
+		/** Enables or disables recording of samples. Recording is disabled by default. */
+		static void setEnabled(bool enabled);
+
+		/** Checks is recording of samples enabled. */
+		static bool isEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+		/**
+		 * Returns an identifier for the provided sample name. The same name always returns the same identifier. This
+		 * involves a lookup in a global table so the identifier should be cached whenever possible.
+		 */
+		static UINT32 registerName(const char* name);
+
+		/** @copydoc registerName(const char*) */
+		static UINT32 registerName(const String& name) { return registerName(name.c_str()); }
+
+		/** Assigns a name to the calling thread, under which its samples will be displayed. */
+		static void setThreadName(const char* name);
+
+		/** Begins a new sample on the calling thread. Must be followed by endSample(). */
+		static void beginSample(UINT32 nameId);
+
+		/** Ends a sample previously started with beginSample() on the calling thread. */
+		static void endSample(UINT32 nameId);
+
+		/**
+		 * Records a sample executed on the GPU.
+		 *
+		 * @param[in]	nameId		Identifier of the sample name, as returned by registerName().
+		 * @param[in]	timestamp	Time at which the sample was issued on the CPU, as returned by getTimestamp(). The
+		 *							sample is displayed starting at this time, as there is no way to correlate GPU and CPU
+		 *							time exactly.
+		 * @param[in]	durationMs	Time the GPU took to execute the sample, in milliseconds.
+		 */
+		static void addGPUSample(UINT32 nameId, UINT64 timestamp, float durationMs);
+
+		/**
+		 * Writes all currently recorded samples to the provided file, in the Chrome trace event JSON format. Can be called
+		 * while samples are being recorded.
+		 */
+		static void exportChromeTrace(const Path& path);
+
+		/** Returns all currently recorded samples in the Chrome trace event JSON format. */
+		static String exportChromeTrace();
+
+		/**
+		 * Enables automatic export whenever a frame on the simulation thread takes longer than the provided threshold.
+		 * Samples of the next two frames are included in the export, so the core thread counterpart of the frame gets
+		 * captured as well.
+		 *
+		 * @param[in]	frameTimeThresholdMs	Frame time in milliseconds that triggers the export. Zero disables
+		 *										automatic export.
+		 * @param[in]	outputFolder			Folder to write the exported traces to.
+		 */
+		static void setAutoCapture(float frameTimeThresholdMs, const Path& outputFolder);
+
+		/** Returns a timestamp usable for timing samples, in unspecified units. */
+		static UINT64 getTimestamp()
+		{
+#if BS_TIMELINE_USE_RDTSC
+			return __rdtsc();
+#elif defined(__aarch64__) && (BS_COMPILER == BS_COMPILER_GNUC || BS_COMPILER == BS_COMPILER_CLANG)
+			UINT64 value;
+			asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+
+			return value;
+#else
+			return (UINT64)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+		}
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Marks the end of a frame on the simulation thread. Triggers automatic export if enabled. */
+		static void _update();
+
+		/** @} */
+
+		/** Helper class that records a sample for as long as it is in scope. */
+		class ScopedSample
+		{
+		public:
+			ScopedSample(UINT32 nameId)
+				:mNameId(nameId)
+			{
+				beginSample(mNameId);
+			}
+
+			~ScopedSample()
+			{
+				endSample(mNameId);
+			}
+
+		private:
+			UINT32 mNameId;
+		};
+
+	private:
+		static std::atomic<bool> sEnabled;
+	};
+
+#define BS_TIMELINE_CONCAT_INNER(a, b) a##b
+#define BS_TIMELINE_CONCAT(a, b) BS_TIMELINE_CONCAT_INNER(a, b)
+
+	/** Records a timeline sample with the provided name (string literal) until the end of the current scope. */
+#define BS_TIMELINE_SAMPLE(name)																				\
+	static const bs::UINT32 BS_TIMELINE_CONCAT(bsTimelineNameId, __LINE__) =									\
+		bs::ProfilerTimeline::registerName(name);																\
+	bs::ProfilerTimeline::ScopedSample BS_TIMELINE_CONCAT(bsTimelineSample, __LINE__)(							\
+		BS_TIMELINE_CONCAT(bsTimelineNameId, __LINE__))
+
+	/** @} */
+}
@@ -0,0 +1,155 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "FileSystem/BsAsyncFileIO.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsThreadPool.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+	/** Creates a backend using io_uring. Returns null if io_uring isn't supported by the kernel. */
+	AsyncFileIOBackend* createIoUringFileIOBackend();
+#endif
+
+	/** Backend that performs blocking reads on a set of dedicated threads. Used when no native backend is available. */
+	class ThreadedAsyncFileIOBackend : public AsyncFileIOBackend
+	{
+	public:
+		ThreadedAsyncFileIOBackend(UINT32 numThreads)
+		{
+			for (UINT32 i = 0; i < numThreads; i++)
+				mThreads.push_back(ThreadPool::instance().run("AsyncFileIO", std::bind(&ThreadedAsyncFileIOBackend::runWorker, this)));
+		}
+
+		~ThreadedAsyncFileIOBackend()
+		{
+			{
+				Lock lock(mMutex);
+				mShutdown = true;
+			}
+
+			mSignal.notify_all();
+
+			for (auto& thread : mThreads)
+				thread.blockUntilComplete();
+
+			// Fail any reads that never got started
+			while (!mQueue.empty())
+			{
+				mQueue.front().callback(nullptr);
+				mQueue.pop();
+			}
+		}
+
+		/** @copydoc AsyncFileIOBackend::submit */
+		void submit(Vector<ASYNC_READ_DESC>& reads) override
+		{
+			{
+				Lock lock(mMutex);
+				for (auto& entry : reads)
+					mQueue.push(std::move(entry));
+			}
+
+			mSignal.notify_all();
+		}
+
+		/** @copydoc AsyncFileIOBackend::getName */
+		const char* getName() const override { return "Threaded"; }
+
+	private:
+		/** Executes queued reads until shut down. Runs on each of the I/O threads. */
+		void runWorker()
+		{
+			while (true)
+			{
+				ASYNC_READ_DESC desc;
+				{
+					Lock lock(mMutex);
+					mSignal.wait(lock, [this]() { return mShutdown || !mQueue.empty(); });
+
+					if (mShutdown)
+						return;
+
+					desc = std::move(mQueue.front());
+					mQueue.pop();
+				}
+
+				desc.callback(readFile(desc));
+			}
+		}
+
+		/** Performs a blocking read described by @p desc. Returns null on failure. */
+		static SPtr<MemoryDataStream> readFile(const ASYNC_READ_DESC& desc)
+		{
+			// Only hold the lock while opening the file, so the I/O threads don't serialize each other, or synchronous
+			// file access, while reading
+			SPtr<DataStream> file;
+			{
+				Lock fileLock = FileScheduler::getLock(desc.path);
+
+				if (!FileSystem::isFile(desc.path))
+				{
+					LOGWRN("Asynchronous read failed. File: " + desc.path.toString() + " doesn't exist.");
+					return nullptr;
+				}
+
+				file = FileSystem::openFile(desc.path, true);
+			}
+
+			if (file == nullptr || desc.offset > file->size())
+				return nullptr;
+
+			size_t size = (size_t)desc.size;
+			if (size == 0)
+				size = file->size() - (size_t)desc.offset;
+
+			SPtr<MemoryDataStream> data = bs_shared_ptr_new<MemoryDataStream>(size);
+
+			file->seek((size_t)desc.offset);
+			if (file->read(data->getPtr(), size) != size)
+			{
+				LOGWRN("Asynchronous read failed. Unable to read " + toString((UINT64)size) + " bytes from file: " +
+					desc.path.toString());
+				return nullptr;
+			}
+
+			return data;
+		}
+
+		Vector<HThread> mThreads;
+		Queue<ASYNC_READ_DESC> mQueue;
+		bool mShutdown = false;
+
+		Mutex mMutex;
+		Signal mSignal;
+	};
+
+	AsyncFileIO::AsyncFileIO(UINT32 numThreads)
+	{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		mBackend = createIoUringFileIOBackend();
+#endif
+
+		if (mBackend == nullptr)
+			mBackend = bs_new<ThreadedAsyncFileIOBackend>(std::max(numThreads, 1U));
+	}
+
+	AsyncFileIO::~AsyncFileIO()
+	{
+		bs_delete(mBackend);
+	}
+
+	void AsyncFileIO::read(const ASYNC_READ_DESC& desc)
+	{
+		Vector<ASYNC_READ_DESC> reads = { desc };
+		mBackend->submit(reads);
+	}
+
+	void AsyncFileIO::read(Vector<ASYNC_READ_DESC> reads)
+	{
+		if (!reads.empty())
+			mBackend->submit(reads);
+	}
+}
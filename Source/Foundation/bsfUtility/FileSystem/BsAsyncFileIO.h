@@ -0,0 +1,103 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsModule.h"
+#include "FileSystem/BsPath.h"
+
+namespace bs
+{
+	/** @addtogroup Filesystem
+	 *  @{
+	 */
+
+	/** Information about a single file read to be performed by AsyncFileIO. */
+	struct ASYNC_READ_DESC
+	{
+		/** Path of the file to read from. */
+		Path path;
+
+		/** Offset in bytes from the start of the file at which to start reading. */
+		UINT64 offset = 0;
+
+		/** Number of bytes to read. Zero reads everything from @p offset until the end of the file. */
+		UINT64 size = 0;
+
+		/**
+		 * Triggered when the read completes. Receives a memory stream containing the read data, or null if the read
+		 * failed. The callback is executed on an I/O thread and should therefore not perform any heavy work, but rather
+		 * queue it on the TaskScheduler.
+		 */
+		std::function<void(const SPtr<MemoryDataStream>&)> callback;
+	};
+
+	/** @} */
+
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Platform-Utility-Internal
+	 *  @{
+	 */
+
+	/** Interface for a platform specific implementation of asynchronous file reads used by AsyncFileIO. */
+	class BS_UTILITY_EXPORT AsyncFileIOBackend
+	{
+	public:
+		virtual ~AsyncFileIOBackend() = default;
+
+		/** Queues the provided reads for execution. */
+		virtual void submit(Vector<ASYNC_READ_DESC>& reads) = 0;
+
+		/** Returns a name identifying the backend, for diagnostic purposes. */
+		virtual const char* getName() const = 0;
+	};
+
+	/** @} */
+	/** @} */
+
+	/** @addtogroup Filesystem
+	 *  @{
+	 */
+
+	/**
+	 * Performs file reads asynchronously, without blocking the calling thread or any TaskScheduler workers while waiting
+	 * on the disk. Reads are submitted in batches and report their results through a callback.
+	 *
+	 * On Linux reads are performed using io_uring if the kernel supports it, allowing many reads to be in flight using
+	 * a single thread. Otherwise reads are performed by a small set of dedicated I/O threads.
+	 *
+	 * Files are opened while holding the FileScheduler lock, so they are never opened while another thread is writing
+	 * to them. The lock is released before the data is read, which means a write to the file that starts after it was
+	 * opened can be observed by the read.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT AsyncFileIO : public Module<AsyncFileIO>
+	{
+	public:
+		/**
+		 * Creates the asynchronous I/O system.
+		 *
+		 * @param[in]	numThreads	Number of I/O threads used if the platform doesn't support native asynchronous I/O.
+		 */
+		AsyncFileIO(UINT32 numThreads = 2);
+		~AsyncFileIO();
+
+		/** Queues a single read. */
+		void read(const ASYNC_READ_DESC& desc);
+
+		/** Queues a batch of reads. Submitting related reads together allows the backend to issue them all at once. */
+		void read(Vector<ASYNC_READ_DESC> reads);
+
+		/** Returns the name of the backend that performs the reads, for diagnostic purposes. */
+		const char* getBackendName() const { return mBackend->getName(); }
+
+	private:
+		AsyncFileIOBackend* mBackend = nullptr;
+	};
+
+	/** @} */
+}
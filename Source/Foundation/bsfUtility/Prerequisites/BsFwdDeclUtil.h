@@ -84,6 +84,7 @@ namespace bs
 	class AsyncOpSyncData;
 	struct RTTIField;
 	struct RTTIReflectablePtrFieldBase;
+	struct RTTIPlainFieldBase;
 	struct SerializedObject;
 	struct SerializedInstance;
 	class FrameAlloc;
@@ -46,6 +46,7 @@ namespace bs
 
 		enum { id = 0 /**< Unique id for the serializable type. */ };
 		enum { hasDynamicSize = 0 /**< 0 (Object has static size less than 255 bytes, for example int) or 1 (Dynamic size with no size restriction, for example string) */ };
+		enum { isMemcpySerializable = 1 /**< Optional. 1 if toMemory() and fromMemory() do nothing but copy sizeof(T) bytes of object memory, allowing arrays of the type to be serialized in bulk. */ };
 
 		/** Serializes the provided object into the provided pre-allocated memory buffer. */
 		static void toMemory(const T& data, char* memory)
@@ -70,6 +71,27 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Checks if the RTTIPlainType specialization of the provided type serializes it by just copying its memory (i.e. it
+	 * specifies isMemcpySerializable). Contiguous arrays of such types can be serialized using a single memcpy.
+	 */
+	template<class T>
+	struct RTTIMemcpySerializable
+	{
+	private:
+		template<class U>
+		static constexpr bool check(decltype(RTTIPlainType<U>::isMemcpySerializable)*)
+		{
+			return RTTIPlainType<U>::isMemcpySerializable != 0 && RTTIPlainType<U>::hasDynamicSize == 0;
+		}
+
+		template<class U>
+		static constexpr bool check(...) { return false; }
+
+	public:
+		static constexpr bool value = check<T>(nullptr);
+	};
+
 	/**
 	 * Helper method when serializing known data types that have valid
 	 * RTTIPlainType specialization.
@@ -167,6 +189,7 @@ namespace bs
 						#type " is not trivially copyable");			\
 	template<> struct RTTIPlainType<type>								\
 	{	enum { id=0 }; enum { hasDynamicSize = 0 };						\
+		enum { isMemcpySerializable = 1 };								\
 		static void toMemory(const type& data, char* memory)			\
 		{ memcpy(memory, &data, sizeof(type)); }						\
 		static UINT32 fromMemory(type& data, char* memory)				\
@@ -186,6 +209,10 @@ namespace bs
 	{
 		enum { id = TID_Vector }; enum { hasDynamicSize = 1 };
 
+		/** Elements that are serialized using a memcpy are copied all at once. (std::vector<bool> isn't contiguous.) */
+		typedef std::integral_constant<bool, RTTIMemcpySerializable<T>::value && !std::is_same<T, bool>::value> 
+			CopyInBulk;
+
 		/** @copydoc RTTIPlainType::toMemory */
 		static void toMemory(const std::vector<T, StdAlloc<T>>& data, char* memory)
 		{
@@ -198,14 +225,7 @@ namespace bs
 			memory += sizeof(UINT32);
 			size += sizeof(UINT32);
 
-			for(const auto& item : data)
-			{
-				UINT32 elementSize = rttiGetElemSize(item);
-				RTTIPlainType<T>::toMemory(item, memory);
-
-				memory += elementSize;
-				size += elementSize;
-			}
+			size += elementsToMemory(data, memory, CopyInBulk());
 
 			memcpy(memoryStart, &size, sizeof(UINT32));
 		}
@@ -221,14 +241,7 @@ namespace bs
 			memcpy(&numElements, memory, sizeof(UINT32));
 			memory += sizeof(UINT32);
 
-			for(UINT32 i = 0; i < numElements; i++)
-			{
-				T element;
-				UINT32 elementSize = RTTIPlainType<T>::fromMemory(element, memory);
-				data.push_back(element);
-
-				memory += elementSize;
-			}
+			elementsFromMemory(data, numElements, memory, CopyInBulk());
 
 			return size;
 		}
@@ -238,13 +251,71 @@ namespace bs
 		{
 			UINT64 dataSize = sizeof(UINT32) * 2;
 
-			for(const auto& item : data)
-				dataSize += rttiGetElemSize(item);
+			if(CopyInBulk::value)
+				dataSize += data.size() * sizeof(T);
+			else
+			{
+				for(const auto& item : data)
+					dataSize += rttiGetElemSize(item);
+			}
 
 			assert(dataSize <= std::numeric_limits<UINT32>::max());
 
 			return (UINT32)dataSize;
 		}
+
+	private:
+		/** Writes all the vector elements to memory and returns the number of bytes written. */
+		static UINT32 elementsToMemory(const std::vector<T, StdAlloc<T>>& data, char* memory, std::true_type)
+		{
+			UINT32 size = (UINT32)(data.size() * sizeof(T));
+			if(size > 0)
+				memcpy(memory, data.data(), size);
+
+			return size;
+		}
+
+		/** @copydoc elementsToMemory */
+		static UINT32 elementsToMemory(const std::vector<T, StdAlloc<T>>& data, char* memory, std::false_type)
+		{
+			UINT32 size = 0;
+			for(const auto& item : data)
+			{
+				UINT32 elementSize = rttiGetElemSize(item);
+				RTTIPlainType<T>::toMemory(item, memory);
+
+				memory += elementSize;
+				size += elementSize;
+			}
+
+			return size;
+		}
+
+		/** Reads the provided number of elements from memory and appends them to the vector. */
+		static void elementsFromMemory(std::vector<T, StdAlloc<T>>& data, UINT32 numElements, char* memory, 
+			std::true_type)
+		{
+			if(numElements == 0)
+				return;
+
+			size_t start = data.size();
+			data.resize(start + numElements);
+			memcpy(&data[start], memory, numElements * sizeof(T));
+		}
+
+		/** @copydoc elementsFromMemory */
+		static void elementsFromMemory(std::vector<T, StdAlloc<T>>& data, UINT32 numElements, char* memory, 
+			std::false_type)
+		{
+			for(UINT32 i = 0; i < numElements; i++)
+			{
+				T element;
+				UINT32 elementSize = RTTIPlainType<T>::fromMemory(element, memory);
+				data.push_back(element);
+
+				memory += elementSize;
+			}
+		}
 	};
 
 	/**
@@ -0,0 +1,430 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "FileSystem/BsAsyncFileIO.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsThreadPool.h"
+#include "Debug/BsDebug.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace bs
+{
+	static int ioUringSetup(UINT32 numEntries, io_uring_params* params)
+	{
+		return (int)syscall(__NR_io_uring_setup, numEntries, params);
+	}
+
+	static int ioUringEnter(int ringFd, UINT32 toSubmit, UINT32 minComplete, UINT32 flags)
+	{
+		return (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0);
+	}
+
+	/**
+	 * Backend that performs reads using io_uring. All reads are issued and completed by a single thread, which keeps
+	 * up to QUEUE_DEPTH reads in flight at once.
+	 */
+	class IoUringFileIOBackend : public AsyncFileIOBackend
+	{
+		/** A read that has been issued to the kernel. */
+		struct InFlightRead
+		{
+			ASYNC_READ_DESC desc;
+			int fd = -1;
+			SPtr<MemoryDataStream> data;
+			UINT64 bytesRead = 0;
+			iovec buffer;
+		};
+
+	public:
+		/** Maximum number of reads in flight at once. One extra entry is used for waking up the I/O thread. */
+		static constexpr UINT32 QUEUE_DEPTH = 64;
+
+		~IoUringFileIOBackend()
+		{
+			if (mRingFd == -1)
+				return;
+
+			if (mRunning)
+			{
+				{
+					Lock lock(mMutex);
+					mShutdown = true;
+				}
+
+				wakeUp();
+				mThread.blockUntilComplete();
+			}
+
+			if (mSQEs != nullptr)
+				munmap(mSQEs, mSQEsSize);
+
+			if (mCQRing != nullptr && mCQRing != mSQRing)
+				munmap(mCQRing, mCQRingSize);
+
+			if (mSQRing != nullptr)
+				munmap(mSQRing, mSQRingSize);
+
+			if (mEventFd != -1)
+				close(mEventFd);
+
+			close(mRingFd);
+		}
+
+		/** Sets up the ring and starts the I/O thread. Returns false if io_uring isn't supported. */
+		bool initialize()
+		{
+			io_uring_params params;
+			memset(&params, 0, sizeof(params));
+
+			mRingFd = ioUringSetup(QUEUE_DEPTH + 1, &params);
+			if (mRingFd < 0)
+			{
+				mRingFd = -1;
+				return false;
+			}
+
+			mSQRingSize = params.sq_off.array + params.sq_entries * sizeof(UINT32);
+			mCQRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+			bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if (singleMap)
+			{
+				mSQRingSize = std::max(mSQRingSize, mCQRingSize);
+				mCQRingSize = mSQRingSize;
+			}
+
+			mSQRing = mmap(nullptr, mSQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd,
+				IORING_OFF_SQ_RING);
+			if (mSQRing == MAP_FAILED)
+			{
+				mSQRing = nullptr;
+				return false;
+			}
+
+			if (singleMap)
+				mCQRing = mSQRing;
+			else
+			{
+				mCQRing = mmap(nullptr, mCQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd,
+					IORING_OFF_CQ_RING);
+				if (mCQRing == MAP_FAILED)
+				{
+					mCQRing = nullptr;
+					return false;
+				}
+			}
+
+			mSQEsSize = params.sq_entries * sizeof(io_uring_sqe);
+			void* sqes = mmap(nullptr, mSQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd,
+				IORING_OFF_SQES);
+			if (sqes == MAP_FAILED)
+				return false;
+
+			mSQEs = (io_uring_sqe*)sqes;
+
+			UINT8* sqRing = (UINT8*)mSQRing;
+			mSQTail = (UINT32*)(sqRing + params.sq_off.tail);
+			mSQMask = *(UINT32*)(sqRing + params.sq_off.ring_mask);
+			mSQArray = (UINT32*)(sqRing + params.sq_off.array);
+
+			UINT8* cqRing = (UINT8*)mCQRing;
+			mCQHead = (UINT32*)(cqRing + params.cq_off.head);
+			mCQTail = (UINT32*)(cqRing + params.cq_off.tail);
+			mCQMask = *(UINT32*)(cqRing + params.cq_off.ring_mask);
+			mCQEs = (io_uring_cqe*)(cqRing + params.cq_off.cqes);
+
+			mEventFd = eventfd(0, EFD_CLOEXEC);
+			if (mEventFd == -1)
+				return false;
+
+			mThread = ThreadPool::instance().run("AsyncFileIO", std::bind(&IoUringFileIOBackend::run, this));
+			mRunning = true;
+
+			return true;
+		}
+
+		/** @copydoc AsyncFileIOBackend::submit */
+		void submit(Vector<ASYNC_READ_DESC>& reads) override
+		{
+			{
+				Lock lock(mMutex);
+				for (auto& entry : reads)
+					mPending.push_back(std::move(entry));
+			}
+
+			wakeUp();
+		}
+
+		/** @copydoc AsyncFileIOBackend::getName */
+		const char* getName() const override { return "io_uring"; }
+
+	private:
+		/** Main loop of the I/O thread. */
+		void run()
+		{
+			queuePoll();
+
+			while (true)
+			{
+				bool shutdown;
+				{
+					Lock lock(mMutex);
+					for (auto& entry : mPending)
+						mWaiting.push(std::move(entry));
+
+					mPending.clear();
+					shutdown = mShutdown;
+				}
+
+				if (shutdown)
+				{
+					while (!mWaiting.empty())
+					{
+						mWaiting.front().callback(nullptr);
+						mWaiting.pop();
+					}
+
+					// Reads already issued must complete before their buffers can be released
+					if (mNumInFlight == 0)
+						break;
+				}
+
+				while (mNumInFlight < QUEUE_DEPTH && !mWaiting.empty())
+				{
+					startRead(mWaiting.front());
+					mWaiting.pop();
+				}
+
+				// Submit queued reads and wait for at least one completion, or for new reads to be submitted
+				int numSubmitted = ioUringEnter(mRingFd, mNumToSubmit, 1, IORING_ENTER_GETEVENTS);
+				if (numSubmitted < 0)
+				{
+					if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+					{
+						LOGERR("io_uring_enter failed with error: " + toString(errno));
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					}
+				}
+				else
+					mNumToSubmit -= (UINT32)numSubmitted;
+
+				processCompletions();
+			}
+		}
+
+		/** Opens the file and issues the read described by @p desc. Reports failures immediately. */
+		void startRead(ASYNC_READ_DESC& desc)
+		{
+			// Only hold the lock while opening the file, so a file that's being written to by another thread isn't
+			// opened half-written. Holding it for the duration of the read would block synchronous file access.
+			int fd;
+			struct stat fileInfo;
+			bool validOffset = false;
+			{
+				Lock fileLock = FileScheduler::getLock(desc.path);
+
+				fd = open(desc.path.toString().c_str(), O_RDONLY | O_CLOEXEC);
+				if (fd != -1)
+					validOffset = fstat(fd, &fileInfo) == 0 && desc.offset <= (UINT64)fileInfo.st_size;
+			}
+
+			if (fd == -1)
+			{
+				LOGWRN("Asynchronous read failed. Unable to open file: " + desc.path.toString());
+				desc.callback(nullptr);
+				return;
+			}
+
+			if (!validOffset)
+			{
+				close(fd);
+				desc.callback(nullptr);
+				return;
+			}
+
+			UINT64 size = desc.size;
+			if (size == 0)
+				size = (UINT64)fileInfo.st_size - desc.offset;
+
+			if (size == 0)
+			{
+				close(fd);
+				desc.callback(bs_shared_ptr_new<MemoryDataStream>((size_t)0));
+				return;
+			}
+
+			InFlightRead* read = bs_new<InFlightRead>();
+			read->desc = std::move(desc);
+			read->fd = fd;
+			read->data = bs_shared_ptr_new<MemoryDataStream>((size_t)size);
+
+			mNumInFlight++;
+			queueRead(read);
+		}
+
+		/** Queues a submission entry reading the remaining data of @p read. */
+		void queueRead(InFlightRead* read)
+		{
+			// Single reads are limited to 1GB, larger reads continue after each completion
+			UINT64 remaining = read->data->size() - read->bytesRead;
+			read->buffer.iov_base = read->data->getPtr() + read->bytesRead;
+			read->buffer.iov_len = (size_t)std::min(remaining, (UINT64)(1U << 30));
+
+			io_uring_sqe* sqe = getSQE();
+			sqe->opcode = IORING_OP_READV;
+			sqe->fd = read->fd;
+			sqe->off = read->desc.offset + read->bytesRead;
+			sqe->addr = (UINT64)&read->buffer;
+			sqe->len = 1;
+			sqe->user_data = (UINT64)read;
+
+			commitSQE();
+		}
+
+		/** Queues a poll on the event used for waking up the I/O thread. */
+		void queuePoll()
+		{
+			io_uring_sqe* sqe = getSQE();
+			sqe->opcode = IORING_OP_POLL_ADD;
+			sqe->fd = mEventFd;
+			sqe->poll_events = POLLIN;
+			sqe->user_data = 0;
+
+			commitSQE();
+		}
+
+		/** Returns the next free submission queue entry, cleared. Must be followed by commitSQE() once filled in. */
+		io_uring_sqe* getSQE()
+		{
+			UINT32 index = *mSQTail & mSQMask;
+
+			io_uring_sqe* sqe = &mSQEs[index];
+			memset(sqe, 0, sizeof(*sqe));
+
+			return sqe;
+		}
+
+		/** Makes the entry returned by the last getSQE() call visible to the kernel on the next submit. */
+		void commitSQE()
+		{
+			UINT32 tail = *mSQTail;
+			UINT32 index = tail & mSQMask;
+
+			mSQArray[index] = index;
+			__atomic_store_n(mSQTail, tail + 1, __ATOMIC_RELEASE);
+			mNumToSubmit++;
+		}
+
+		/** Handles all available completion queue entries. */
+		void processCompletions()
+		{
+			UINT32 head = *mCQHead;
+			while (head != __atomic_load_n(mCQTail, __ATOMIC_ACQUIRE))
+			{
+				const io_uring_cqe& cqe = mCQEs[head & mCQMask];
+				UINT64 userData = cqe.user_data;
+				INT32 result = cqe.res;
+
+				head++;
+				__atomic_store_n(mCQHead, head, __ATOMIC_RELEASE);
+
+				// Wake up event, re-arm it
+				if (userData == 0)
+				{
+					eventfd_t value;
+					eventfd_read(mEventFd, &value);
+
+					queuePoll();
+					continue;
+				}
+
+				InFlightRead* read = (InFlightRead*)userData;
+				if (result == -EINTR || result == -EAGAIN)
+				{
+					queueRead(read);
+					continue;
+				}
+
+				if (result <= 0)
+				{
+					LOGWRN("Asynchronous read failed. Unable to read from file: " + read->desc.path.toString());
+					finishRead(read, false);
+					continue;
+				}
+
+				read->bytesRead += (UINT64)result;
+				if (read->bytesRead < read->data->size())
+					queueRead(read);
+				else
+					finishRead(read, true);
+			}
+		}
+
+		/** Releases the resources used by @p read and reports its result. */
+		void finishRead(InFlightRead* read, bool success)
+		{
+			close(read->fd);
+			mNumInFlight--;
+
+			read->desc.callback(success ? read->data : nullptr);
+			bs_delete(read);
+		}
+
+		/** Wakes up the I/O thread if it is waiting for completions. */
+		void wakeUp()
+		{
+			eventfd_write(mEventFd, 1);
+		}
+
+		int mRingFd = -1;
+		int mEventFd = -1;
+
+		void* mSQRing = nullptr;
+		void* mCQRing = nullptr;
+		io_uring_sqe* mSQEs = nullptr;
+		size_t mSQRingSize = 0;
+		size_t mCQRingSize = 0;
+		size_t mSQEsSize = 0;
+
+		UINT32* mSQTail = nullptr;
+		UINT32* mSQArray = nullptr;
+		UINT32 mSQMask = 0;
+
+		UINT32* mCQHead = nullptr;
+		UINT32* mCQTail = nullptr;
+		UINT32 mCQMask = 0;
+		io_uring_cqe* mCQEs = nullptr;
+
+		// Accessed only by the I/O thread
+		Queue<ASYNC_READ_DESC> mWaiting;
+		UINT32 mNumInFlight = 0;
+		UINT32 mNumToSubmit = 0;
+
+		HThread mThread;
+		bool mRunning = false;
+		Vector<ASYNC_READ_DESC> mPending;
+		bool mShutdown = false;
+		Mutex mMutex;
+	};
+
+	AsyncFileIOBackend* createIoUringFileIOBackend()
+	{
+		IoUringFileIOBackend* backend = bs_new<IoUringFileIOBackend>();
+		if (!backend->initialize())
+		{
+			bs_delete(backend);
+			return nullptr;
+		}
+
+		return backend;
+	}
+}
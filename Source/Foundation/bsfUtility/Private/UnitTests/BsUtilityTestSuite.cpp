@@ -3,6 +3,19 @@
 #include "Private/UnitTests/BsUtilityTestSuite.h"
 #include "Private/UnitTests/BsFileSystemTestSuite.h"
 #include "Utility/BsOctree.h"
+#include "Utility/BsTimer.h"
+#include "Allocators/BsConcurrentPoolAlloc.h"
+#include "Threading/BsTaskQueue.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Serialization/BsSerializedObject.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsBinaryDiff.h"
+#include "Reflection/BsRTTIType.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+#include "Debug/BsProfilerTimeline.h"
+#include "ThirdParty/json.hpp"
 
 namespace bs
 {
@@ -38,19 +51,184 @@ namespace bs
 	};
 
 	typedef Octree<UINT32, DebugOctreeOptions> DebugOctree;
+
+	class DebugMemoryAlloc
+	{ };
+
+	template<> struct MemoryCategoryName<DebugMemoryAlloc> { static constexpr const char* get() { return "Debug"; } };
+
+	/**
+	 * Runs an allocation heavy workload on multiple threads and returns the time it took in microseconds. Each thread
+	 * repeatedly allocates a batch of randomly sized blocks and frees them, half of the blocks being freed by a different
+	 * thread than the one that allocated them.
+	 */
+	template<class AllocFunc, class FreeFunc>
+	UINT64 runAllocBenchmark(AllocFunc alloc, FreeFunc free)
+	{
+		static constexpr UINT32 NUM_THREADS = 4;
+		static constexpr UINT32 NUM_ITERATIONS = 2000;
+		static constexpr UINT32 BATCH_SIZE = 64;
+
+		Vector<void*> handoff[NUM_THREADS];
+		Mutex handoffMutex[NUM_THREADS];
+
+		Timer timer;
+		Vector<Thread> threads;
+		for(UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			threads.push_back(Thread([&, i]()
+			{
+				UINT32 seed = i + 1;
+				void* blocks[BATCH_SIZE];
+				Vector<void*> received;
+
+				for(UINT32 j = 0; j < NUM_ITERATIONS; j++)
+				{
+					for(UINT32 k = 0; k < BATCH_SIZE; k++)
+					{
+						seed = seed * 1664525 + 1013904223;
+						blocks[k] = alloc(16 + (seed >> 8) % 1024);
+					}
+
+					for(UINT32 k = 0; k < BATCH_SIZE / 2; k++)
+						free(blocks[k]);
+
+					{
+						Lock lock(handoffMutex[(i + 1) % NUM_THREADS]);
+						auto& target = handoff[(i + 1) % NUM_THREADS];
+						target.insert(target.end(), blocks + BATCH_SIZE / 2, blocks + BATCH_SIZE);
+					}
+
+					{
+						Lock lock(handoffMutex[i]);
+						std::swap(received, handoff[i]);
+					}
+
+					for(auto& entry : received)
+						free(entry);
+
+					received.clear();
+				}
+			}));
+		}
+
+		for(auto& thread : threads)
+			thread.join();
+
+		UINT64 time = timer.getMicroseconds();
+
+		for(auto& entry : handoff)
+		{
+			for(auto& block : entry)
+				free(block);
+		}
+
+		return time;
+	}
+
+	/** Returns statistics about the memory category with the specified name. */
+	MemoryCategoryStats getMemoryCategoryStats(const char* name)
+	{
+		for(UINT32 i = 0; i < MemoryCounter::getNumCategories(); i++)
+		{
+			MemoryCategoryStats stats = MemoryCounter::getCategoryStats(i);
+			if(strcmp(stats.name, name) == 0)
+				return stats;
+		}
+
+		return MemoryCategoryStats();
+	}
+
+	/** Checks if the fields of all the sub-objects of two serialized objects are equal. */
+	bool compareSerializedObjects(const SPtr<SerializedObject>& a, const SPtr<SerializedObject>& b)
+	{
+		if(a == nullptr || b == nullptr || a->subObjects.size() != b->subObjects.size())
+			return false;
+
+		for(UINT32 i = 0; i < (UINT32)a->subObjects.size(); i++)
+		{
+			const SerializedSubObject& subObjectA = a->subObjects[i];
+			const SerializedSubObject& subObjectB = b->subObjects[i];
+
+			if(subObjectA.typeId != subObjectB.typeId || subObjectA.entries.size() != subObjectB.entries.size())
+				return false;
+
+			for(auto& entry : subObjectA.entries)
+			{
+				auto iterFind = subObjectB.entries.find(entry.first);
+				if(iterFind == subObjectB.entries.end())
+					return false;
+
+				SPtr<SerializedField> fieldA = std::static_pointer_cast<SerializedField>(entry.second.serialized);
+				SPtr<SerializedField> fieldB = std::static_pointer_cast<SerializedField>(iterFind->second.serialized);
+
+				if(fieldA == nullptr || fieldB == nullptr || fieldA->size != fieldB->size)
+					return false;
+
+				if(memcmp(fieldA->value, fieldB->value, fieldA->size) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Creates a serialized object with the specified number of sub-objects, each containing a number of plain fields. */
+	SPtr<SerializedObject> createSerializedObject(UINT32 numSubObjects, UINT32 numEntries, UINT32 fieldSize)
+	{
+		SPtr<SerializedObject> output = bs_shared_ptr_new<SerializedObject>();
+		for(UINT32 i = 0; i < numSubObjects; i++)
+		{
+			output->subObjects.push_back(SerializedSubObject());
+
+			SerializedSubObject& subObject = output->subObjects.back();
+			subObject.typeId = i;
+
+			for(UINT32 j = 0; j < numEntries; j++)
+			{
+				SPtr<SerializedField> field = bs_shared_ptr_new<SerializedField>();
+				field->value = (UINT8*)bs_alloc(fieldSize);
+				field->size = fieldSize;
+				field->ownsMemory = true;
+
+				for(UINT32 k = 0; k < fieldSize; k++)
+					field->value[k] = (UINT8)(i * 7 + j * 3 + k);
+
+				SerializedEntry entry;
+				entry.fieldId = j;
+				entry.serialized = field;
+
+				subObject.entries[j] = entry;
+			}
+		}
+
+		return output;
+	}
+
 	void UtilityTestSuite::startUp()
 	{
+		// Serializers use stack allocations
+		MemStack::beginThread();
+
 		SPtr<TestSuite> fileSystemTests = create<FileSystemTestSuite>();
 		add(fileSystemTests);
 	}
 
 	void UtilityTestSuite::shutDown()
 	{
+		MemStack::endThread();
 	}
 
 	UtilityTestSuite::UtilityTestSuite()
 	{
 		BS_ADD_TEST(UtilityTestSuite::testOctree);
+		BS_ADD_TEST(UtilityTestSuite::testBinarySerializer);
+		BS_ADD_TEST(UtilityTestSuite::testBinaryDiff);
+		BS_ADD_TEST(UtilityTestSuite::testMemoryCounter);
+		BS_ADD_TEST(UtilityTestSuite::testThreadCachingAlloc);
+		BS_ADD_TEST(UtilityTestSuite::testConcurrentPoolAlloc);
+		BS_ADD_TEST(UtilityTestSuite::testTaskQueue);
+		BS_ADD_TEST(UtilityTestSuite::testProfilerTimeline);
 	}
 
 	void UtilityTestSuite::testOctree()
@@ -143,4 +321,416 @@ namespace bs
 		for(auto& entry : octreeData.elements)
 			octree.removeElement(entry.octreeId);
 	}
-}
+
+	void UtilityTestSuite::testBinarySerializer()
+	{
+		// Serialized objects make for a good test subject as they contain embedded objects, derived types, pointer
+		// references and data blocks
+		SPtr<SerializedObject> original = createSerializedObject(200, 50, 16);
+
+		MemorySerializer ms;
+		UINT32 size = 0;
+		UINT8* data = ms.encode(original.get(), size);
+
+		// Decode directly from the stream
+		Timer timer;
+		UINT64 numAllocs = MemoryCounter::getNumAllocs();
+
+		SPtr<SerializedObject> streamed = std::static_pointer_cast<SerializedObject>(ms.decode(data, size));
+
+		UINT64 streamedTime = timer.getMicroseconds();
+		UINT64 streamedNumAllocs = MemoryCounter::getNumAllocs() - numAllocs;
+
+		// Decode through the intermediate representation
+		timer.reset();
+		numAllocs = MemoryCounter::getNumAllocs();
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data, size, false);
+		BinarySerializer bs;
+		SPtr<SerializedObject> intermediate = std::static_pointer_cast<SerializedObject>(
+			bs._decodeFromIntermediate(bs._decodeToIntermediate(stream, size)));
+
+		UINT64 intermediateTime = timer.getMicroseconds();
+		UINT64 intermediateNumAllocs = MemoryCounter::getNumAllocs() - numAllocs;
+
+		bs_free(data);
+
+		BS_TEST_ASSERT(compareSerializedObjects(original, streamed));
+		BS_TEST_ASSERT(compareSerializedObjects(original, intermediate));
+
+		LOGDBG("Binary decode of " + toString(size) + " bytes. Streamed: " + toString(streamedTime) + " us, " + 
+			toString(streamedNumAllocs) + " allocations. Intermediate: " + toString(intermediateTime) + " us, " + 
+			toString(intermediateNumAllocs) + " allocations.");
+	}
+
+	void UtilityTestSuite::testBinaryDiff()
+	{
+		SPtr<SerializedObject> original = createSerializedObject(200, 50, 16);
+
+		// Encoding directly into the intermediate format must produce the same object as encoding into binary and 
+		// decoding the binary into the intermediate format
+		BinarySerializer bs;
+		Timer timer;
+		SPtr<SerializedObject> encoded = bs._encodeToIntermediate(original.get());
+		UINT64 directTime = timer.getMicroseconds();
+
+		timer.reset();
+		MemorySerializer ms;
+		UINT32 size = 0;
+		UINT8* data = ms.encode(original.get(), size);
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data, size, false);
+		SPtr<SerializedObject> decoded = bs._decodeToIntermediate(stream, size, true);
+		UINT64 binaryTime = timer.getMicroseconds();
+
+		bs_free(data);
+
+		BS_TEST_ASSERT(compareSerializedObjects(original, 
+			std::static_pointer_cast<SerializedObject>(bs._decodeFromIntermediate(encoded))));
+		BS_TEST_ASSERT(compareSerializedObjects(original, 
+			std::static_pointer_cast<SerializedObject>(bs._decodeFromIntermediate(decoded))));
+
+		LOGDBG("Intermediate encode of " + toString(size) + " bytes. Direct: " + toString(directTime) + " us. " +
+			"Through binary: " + toString(binaryTime) + " us.");
+
+		// Identical objects must produce no diff, and identical sub-objects must have matching hashes. Encode anew, as
+		// the data blocks of the objects above were consumed when decoding.
+		IDiff& diffHandler = original->getRTTI()->getDiffHandler();
+		BS_TEST_ASSERT(diffHandler.generateDiff(bs._encodeToIntermediate(original.get()), 
+			bs._encodeToIntermediate(original.get())) == nullptr);
+
+		SPtr<SerializedField> fieldA = std::static_pointer_cast<SerializedField>(original->subObjects[0].entries[0].serialized);
+		SPtr<SerializedField> fieldB = std::static_pointer_cast<SerializedField>(fieldA->clone());
+
+		SPtr<SerializedObject> encodedA = bs._encodeToIntermediate(fieldA.get());
+		SPtr<SerializedObject> encodedB = bs._encodeToIntermediate(fieldB.get());
+
+		BS_TEST_ASSERT(encodedA->subObjects[0].hash != 0 && encodedA->subObjects[0].hash == encodedB->subObjects[0].hash);
+		BS_TEST_ASSERT(diffHandler.generateDiff(encodedA, encodedB) == nullptr);
+
+		// Modified objects must produce a diff
+		fieldB->value[0]++;
+		encodedB = bs._encodeToIntermediate(fieldB.get());
+
+		BS_TEST_ASSERT(encodedA->subObjects[0].hash != encodedB->subObjects[0].hash);
+		BS_TEST_ASSERT(diffHandler.generateDiff(encodedA, encodedB) != nullptr);
+	}
+
+	void UtilityTestSuite::testMemoryCounter()
+	{
+		static constexpr UINT32 NUM_ALLOCS = 100;
+		static constexpr UINT32 ALLOC_SIZE = 10000;
+
+		// Allocate on one thread and free on another, the live byte count must match the allocated memory
+		void* allocs[NUM_ALLOCS];
+		for(UINT32 i = 0; i < NUM_ALLOCS; i++)
+			allocs[i] = bs_alloc<DebugMemoryAlloc>(ALLOC_SIZE);
+
+		MemoryCategoryStats stats = getMemoryCategoryStats("Debug");
+		BS_TEST_ASSERT(stats.numAllocs == NUM_ALLOCS);
+		BS_TEST_ASSERT(stats.liveBytes >= NUM_ALLOCS * ALLOC_SIZE);
+		BS_TEST_ASSERT(stats.peakBytes >= stats.liveBytes);
+
+		const INT64 peakBytes = stats.liveBytes;
+
+		Thread thread([&allocs]()
+		{
+			for(UINT32 i = 0; i < NUM_ALLOCS; i++)
+				bs_free<DebugMemoryAlloc>(allocs[i]);
+		});
+		thread.join();
+
+		stats = getMemoryCategoryStats("Debug");
+		BS_TEST_ASSERT(stats.numFrees == NUM_ALLOCS);
+		BS_TEST_ASSERT(stats.liveBytes == 0);
+		BS_TEST_ASSERT(stats.peakBytes >= peakBytes - 64 * 1024);
+	}
+
+	void UtilityTestSuite::testThreadCachingAlloc()
+	{
+		// Allocations of all sizes must be aligned, usable and reusable
+		Vector<std::pair<UINT8*, UINT32>> blocks;
+		for(UINT32 size = 1; size < ThreadCachingAlloc::MAX_SMALL_SIZE * 4; size += size / 8 + 1)
+		{
+			UINT8* data = (UINT8*)ThreadCachingAlloc::allocate(size);
+			BS_TEST_ASSERT(((UINT64)data & 15) == 0);
+			BS_TEST_ASSERT(ThreadCachingAlloc::getSize(data) >= size);
+
+			memset(data, (UINT8)size, size);
+			blocks.push_back(std::make_pair(data, size));
+		}
+
+		bool valid = true;
+		for(auto& entry : blocks)
+		{
+			for(UINT32 i = 0; i < entry.second; i++)
+				valid &= entry.first[i] == (UINT8)entry.second;
+		}
+
+		BS_TEST_ASSERT(valid);
+
+		// Memory freed by another thread must be returned to the thread that allocated it
+		Thread thread([&blocks]()
+		{
+			for(auto& entry : blocks)
+				ThreadCachingAlloc::free(entry.first);
+		});
+		thread.join();
+
+		// Note: Only testable if nothing else is using the allocator on this thread, as otherwise the allocation could be
+		// served from the local cache instead
+		if(!UseThreadCachingAlloc<GenAlloc>::value)
+		{
+			void* reused = ThreadCachingAlloc::allocate(blocks[0].second);
+			auto iterFind = std::find_if(blocks.begin(), blocks.end(), 
+				[reused](const std::pair<UINT8*, UINT32>& entry) { return entry.first == reused; });
+
+			BS_TEST_ASSERT(iterFind != blocks.end());
+			ThreadCachingAlloc::free(reused);
+		}
+
+		UINT64 cachingTime = runAllocBenchmark(&ThreadCachingAlloc::allocate, &ThreadCachingAlloc::free);
+		UINT64 systemTime = runAllocBenchmark(&malloc, &free);
+
+		LOGDBG("Multi-threaded allocation benchmark. ThreadCachingAlloc: " + toString(cachingTime) + " us. " +
+			"System allocator: " + toString(systemTime) + " us.");
+	}
+
+	void UtilityTestSuite::testConcurrentPoolAlloc()
+	{
+		static constexpr UINT32 NUM_THREADS = 4;
+		static constexpr UINT32 NUM_ALLOCS = 2000;
+		static constexpr UINT32 ELEMS_PER_BLOCK = 64;
+
+		using Pool = ConcurrentPoolAlloc<16, ELEMS_PER_BLOCK, 16, 8>;
+		Pool pool;
+
+		// Allocate from multiple threads, each element must be unique and aligned
+		Vector<UINT8*> allocs[NUM_THREADS];
+		Vector<Thread> threads;
+		for(UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			threads.push_back(Thread([&pool, &allocs, i]()
+			{
+				for(UINT32 j = 0; j < NUM_ALLOCS; j++)
+				{
+					UINT8* data = pool.alloc();
+					memset(data, (UINT8)i, 16);
+
+					allocs[i].push_back(data);
+				}
+			}));
+		}
+
+		for(auto& thread : threads)
+			thread.join();
+
+		UnorderedSet<UINT8*> uniqueAllocs;
+		bool valid = true;
+		for(UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			for(auto& entry : allocs[i])
+			{
+				valid &= ((UINT64)entry & 15) == 0;
+				valid &= entry[0] == (UINT8)i && entry[15] == (UINT8)i;
+
+				uniqueAllocs.insert(entry);
+			}
+		}
+
+		BS_TEST_ASSERT(valid);
+		BS_TEST_ASSERT(uniqueAllocs.size() == NUM_THREADS * NUM_ALLOCS);
+		BS_TEST_ASSERT(pool.getNumBlocks() >= NUM_THREADS * NUM_ALLOCS / ELEMS_PER_BLOCK);
+
+		// Free elements on a different thread than the one that allocated them
+		threads.clear();
+		for(UINT32 i = 0; i < NUM_THREADS; i++)
+		{
+			threads.push_back(Thread([&pool, &allocs, i]()
+			{
+				for(auto& entry : allocs[(i + 1) % NUM_THREADS])
+					pool.free(entry);
+			}));
+		}
+
+		for(auto& thread : threads)
+			thread.join();
+
+		// Free blocks must be returned, apart from the ones still referenced by cached elements
+		BS_TEST_ASSERT(pool.getNumBlocks() < NUM_THREADS * NUM_ALLOCS / ELEMS_PER_BLOCK);
+
+		pool.trim();
+		BS_TEST_ASSERT(pool.getNumBlocks() == 0);
+
+		// Pool must remain usable after trimming
+		UINT8* data = pool.alloc();
+		BS_TEST_ASSERT(data != nullptr);
+		pool.free(data);
+
+		ConcurrentPoolAlloc<1040> benchPool;
+		UINT64 poolTime = runAllocBenchmark(
+			[&benchPool](size_t) { return (void*)benchPool.alloc(); },
+			[&benchPool](void* data) { benchPool.free(data); });
+		UINT64 systemTime = runAllocBenchmark(
+			[](size_t) { return malloc(1040); },
+			[](void* data) { free(data); });
+
+		LOGDBG("Multi-threaded pool allocation benchmark. ConcurrentPoolAlloc: " + toString(poolTime) + " us. " +
+			"System allocator: " + toString(systemTime) + " us.");
+	}
+
+	void UtilityTestSuite::testTaskQueue()
+	{
+		static constexpr UINT32 NUM_TASKS = 5000;
+		static constexpr UINT32 NUM_NESTED_TASKS = 100;
+
+		bool startedScheduler = !TaskScheduler::isStarted();
+		if(startedScheduler)
+		{
+			ThreadPool::startUp<TThreadPool<>>(BS_THREAD_HARDWARE_CONCURRENCY + 2);
+			TaskScheduler::startUp();
+		}
+
+		struct TaskData
+		{
+			TaskQueue* queue;
+			std::atomic<UINT32> numExecuted { 0 };
+			std::atomic<UINT32> numNestedSubmitted { 0 };
+		};
+
+		TaskQueue queue("TestTaskQueue", 256);
+		TaskData data;
+		data.queue = &queue;
+
+		// Tasks submitting further tasks from the worker threads, same as PhysX does
+		auto taskFunc = [](void* userData)
+		{
+			TaskData* data = (TaskData*)userData;
+			if(data->numNestedSubmitted.fetch_add(1) < NUM_NESTED_TASKS)
+			{
+				data->queue->submit([](void* userData) { ((TaskData*)userData)->numExecuted++; }, userData);
+			}
+
+			data->numExecuted++;
+		};
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_TASKS; i++)
+			queue.submit(taskFunc, &data);
+
+		while(data.numExecuted.load() < NUM_TASKS + NUM_NESTED_TASKS || queue.getNumActiveWorkers() > 0)
+			std::this_thread::yield();
+
+		UINT64 queueTime = timer.getMicroseconds();
+		BS_TEST_ASSERT(data.numExecuted.load() == NUM_TASKS + NUM_NESTED_TASKS);
+
+		// Same number of tasks, each scheduled separately
+		std::atomic<UINT32> numExecuted { 0 };
+
+		timer.reset();
+		Vector<SPtr<Task>> tasks;
+		tasks.reserve(NUM_TASKS);
+		for(UINT32 i = 0; i < NUM_TASKS; i++)
+		{
+			SPtr<Task> task = Task::create("TestTask", [&numExecuted]() { numExecuted++; });
+			TaskScheduler::instance().addTask(task);
+
+			tasks.push_back(task);
+		}
+
+		for(auto& task : tasks)
+			task->wait();
+
+		UINT64 schedulerTime = timer.getMicroseconds();
+		BS_TEST_ASSERT(numExecuted.load() == NUM_TASKS);
+
+		LOGDBG("Executed " + toString(NUM_TASKS) + " small tasks. TaskQueue: " + toString(queueTime) + " us. " +
+			"Individual scheduler tasks: " + toString(schedulerTime) + " us.");
+
+		tasks.clear();
+		if(startedScheduler)
+		{
+			TaskScheduler::shutDown();
+			ThreadPool::shutDown();
+		}
+	}
+
+	void UtilityTestSuite::testProfilerTimeline()
+	{
+		static constexpr UINT32 NUM_SAMPLES = 1000;
+
+		UINT32 outerId = ProfilerTimeline::registerName("TestOuter");
+		UINT32 innerId = ProfilerTimeline::registerName("TestInner");
+		BS_TEST_ASSERT(ProfilerTimeline::registerName(String("TestOuter")) == outerId);
+
+		ProfilerTimeline::setEnabled(true);
+
+		auto recordSamples = [outerId, innerId](const char* threadName)
+		{
+			ProfilerTimeline::setThreadName(threadName);
+
+			for(UINT32 i = 0; i < NUM_SAMPLES; i++)
+			{
+				ProfilerTimeline::beginSample(outerId);
+				ProfilerTimeline::beginSample(innerId);
+				ProfilerTimeline::endSample(innerId);
+				ProfilerTimeline::endSample(outerId);
+			}
+		};
+
+		Timer timer;
+		recordSamples("TestMain");
+		UINT64 recordTime = timer.getMicroseconds();
+
+		Thread thread(std::bind(recordSamples, "TestWorker"));
+		thread.join();
+
+		ProfilerTimeline::setEnabled(false);
+
+		// Disabled timeline must not record anything
+		ProfilerTimeline::beginSample(outerId);
+		ProfilerTimeline::endSample(outerId);
+
+		nlohmann::json trace = nlohmann::json::parse(ProfilerTimeline::exportChromeTrace().c_str());
+		const nlohmann::json& events = trace["traceEvents"];
+
+		UnorderedMap<UINT32, String> threadNames;
+		for(auto& event : events)
+		{
+			if(event["ph"] == "M")
+				threadNames[event["tid"].get<UINT32>()] = event["args"]["name"].get<std::string>().c_str();
+		}
+
+		UINT32 numMainEvents = 0;
+		UINT32 numWorkerEvents = 0;
+		bool timeIncreasing = true;
+		double lastTime = 0.0;
+		for(auto& event : events)
+		{
+			if(event["ph"] == "M")
+				continue;
+
+			String name = event["name"].get<std::string>().c_str();
+			if(name != "TestOuter" && name != "TestInner")
+				continue;
+
+			const String& threadName = threadNames[event["tid"].get<UINT32>()];
+			if(threadName == "TestMain")
+			{
+				numMainEvents++;
+
+				double time = event["ts"].get<double>();
+				timeIncreasing &= time >= lastTime;
+				lastTime = time;
+			}
+			else if(threadName == "TestWorker")
+				numWorkerEvents++;
+		}
+
+		BS_TEST_ASSERT(numMainEvents == NUM_SAMPLES * 4);
+		BS_TEST_ASSERT(numWorkerEvents == NUM_SAMPLES * 4);
+		BS_TEST_ASSERT(timeIncreasing);
+
+		LOGDBG("Recorded " + toString(NUM_SAMPLES * 2) + " timeline samples in " + toString(recordTime) + " us.");
+	}
+}
\ No newline at end of file
@@ -15,5 +15,12 @@ namespace bs
 
 	private:
 		void testOctree();
+		void testBinarySerializer();
+		void testBinaryDiff();
+		void testMemoryCounter();
+		void testThreadCachingAlloc();
+		void testConcurrentPoolAlloc();
+		void testTaskQueue();
+		void testProfilerTimeline();
 	};
 }
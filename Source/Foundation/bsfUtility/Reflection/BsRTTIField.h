@@ -67,7 +67,15 @@ namespace bs
 		 * would not contribute to the reference search anyway. Whether or not a field contributes to the reference
 		 * search depends on the search and should be handled on a case by case basis.
 		 */
-		RTTI_Flag_SkipInReferenceSearch = 0x02
+		RTTI_Flag_SkipInReferenceSearch = 0x02,
+		/**
+		 * This flag is only used on plain array fields. It signals that the array elements are stored contiguously in 
+		 * memory, in which case the getter must return a reference to the element stored in the array, and the setter 
+		 * must do nothing but assign the value to that same element (after the array has been resized). If the element 
+		 * type is also serialized by just copying its memory (see RTTIMemcpySerializable), the serializer is then allowed
+		 * to copy the entire array at once, instead of calling the getter/setter for each element.
+		 */
+		RTTI_Flag_ContiguousArray = 0x04
 	};
 
 	/**
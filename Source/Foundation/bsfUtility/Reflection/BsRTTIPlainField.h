@@ -94,6 +94,40 @@ namespace bs
 		 * location and contains the proper type.
 		 */
 		virtual void arrayElemFromBuffer(void* object, int index, void* buffer) = 0;
+
+		/**
+		 * Checks can the entire array managed by the field be copied using a single memcpy. This is true if the field was
+		 * flagged with RTTI_Flag_ContiguousArray, and its type is serialized by just copying its memory. If true
+		 * arrayToBuffer() and arrayFromBuffer() can be used to copy all array elements at once, and each element
+		 * has the size returned by getTypeSize().
+		 */
+		virtual bool canMemcpyArray()
+		{
+			return false;
+		}
+
+		/**
+		 * Retrieves the first @p numElements values of the array on the provided field of the provided object, and copies 
+		 * them into the buffer. It does not check if buffer is large enough. Only valid if canMemcpyArray() returns true.
+		 */
+		virtual void arrayToBuffer(void* object, UINT32 numElements, void* buffer)
+		{
+			UINT32 typeSize = getTypeSize();
+			for(UINT32 i = 0; i < numElements; i++)
+				arrayElemToBuffer(object, i, (UINT8*)buffer + i * typeSize);
+		}
+
+		/**
+		 * Sets the first @p numElements values of the array on the provided field of the provided object. Values are 
+		 * copied from the buffer, and the array must already be large enough to hold them. Only valid if canMemcpyArray() 
+		 * returns true.
+		 */
+		virtual void arrayFromBuffer(void* object, UINT32 numElements, void* buffer)
+		{
+			UINT32 typeSize = getTypeSize();
+			for(UINT32 i = 0; i < numElements; i++)
+				arrayElemFromBuffer(object, i, (UINT8*)buffer + i * typeSize);
+		}
 	};
 
 	/** Represents a plain class field containing a specific type. */
@@ -287,6 +321,49 @@ namespace bs
 			std::function<void(ObjectType*, UINT32, DataType&)> f = any_cast<std::function<void(ObjectType*, UINT32, DataType&)>>(valueSetter);
 			f(castObject, index, value);
 		}
+
+		/** @copydoc RTTIPlainFieldBase::canMemcpyArray */
+		bool canMemcpyArray() override
+		{
+			return mIsVectorType && (mFlags & RTTI_Flag_ContiguousArray) != 0 && 
+				RTTIMemcpySerializable<DataType>::value;
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayToBuffer */
+		void arrayToBuffer(void* object, UINT32 numElements, void* buffer) override
+		{
+			if(!canMemcpyArray())
+			{
+				RTTIPlainFieldBase::arrayToBuffer(object, numElements, buffer);
+				return;
+			}
+
+			if(numElements == 0)
+				return;
+
+			ObjectType* castObject = static_cast<ObjectType*>(object);
+
+			std::function<DataType&(ObjectType*, UINT32)> f = any_cast<std::function<DataType&(ObjectType*, UINT32)>>(valueGetter);
+			memcpy(buffer, &f(castObject, 0), numElements * sizeof(DataType));
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayFromBuffer */
+		void arrayFromBuffer(void* object, UINT32 numElements, void* buffer) override
+		{
+			if(!canMemcpyArray())
+			{
+				RTTIPlainFieldBase::arrayFromBuffer(object, numElements, buffer);
+				return;
+			}
+
+			if(numElements == 0)
+				return;
+
+			ObjectType* castObject = static_cast<ObjectType*>(object);
+
+			std::function<DataType&(ObjectType*, UINT32)> f = any_cast<std::function<DataType&(ObjectType*, UINT32)>>(valueGetter);
+			memcpy(&f(castObject, 0), buffer, numElements * sizeof(DataType));
+		}
 	};
 
 	/** @} */
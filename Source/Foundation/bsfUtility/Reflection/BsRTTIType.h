@@ -68,7 +68,8 @@ namespace bs
 
 /**
  * Registers a new member field in the RTTI type. The field references the @p name member in the owner class.
- * The type of the member must be an array of valid plain types. Each field must specify a unique ID for @p id.
+ * The type of the member must be an array of valid plain types, with its elements stored contiguously in memory
+ * (e.g. Vector). Each field must specify a unique ID for @p id.
  */
 #define BS_RTTI_MEMBER_PLAIN_ARRAY(name, id)													\
 	META_Entry_##name;																			\
@@ -81,7 +82,7 @@ namespace bs
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name, RTTI_Flag_ContiguousArray);	\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -101,7 +102,7 @@ namespace bs
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name, RTTI_Flag_ContiguousArray);	\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
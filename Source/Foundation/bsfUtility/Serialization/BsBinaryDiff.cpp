@@ -9,6 +9,143 @@
 
 namespace bs
 {
+	/** 
+	 * Returns a pointer to the contents of the provided data block. File streams are read into a stack allocated buffer
+	 * that must be freed with bs_stack_free(), while memory streams are accessed directly. Returns null if the block lies
+	 * outside of its stream. The position of the stream is left unchanged.
+	 */
+	static UINT8* getDataBlockPtr(const SerializedDataBlock& block)
+	{
+		if (block.stream == nullptr || (size_t)block.offset + block.size > block.stream->size())
+			return nullptr;
+
+		if (block.stream->isFile())
+		{
+			size_t position = block.stream->tell();
+
+			UINT8* data = (UINT8*)bs_stack_alloc(block.size);
+			block.stream->seek(block.offset);
+			block.stream->read(data, block.size);
+			block.stream->seek(position);
+
+			return data;
+		}
+
+		SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(block.stream);
+		return memStream->getPtr() + block.offset;
+	}
+
+	/** Checks if two data blocks contain identical data. */
+	static bool compareDataBlocks(const SerializedDataBlock& a, const SerializedDataBlock& b)
+	{
+		if (a.size != b.size)
+			return false;
+
+		if (a.size == 0)
+			return true;
+
+		UINT8* aData = getDataBlockPtr(a);
+		UINT8* bData = getDataBlockPtr(b);
+
+		bool equal = aData != nullptr && bData != nullptr && memcmp(aData, bData, b.size) == 0;
+
+		// Stack allocations must be freed in reverse order
+		if (bData != nullptr && b.stream->isFile())
+			bs_stack_free(bData);
+
+		if (aData != nullptr && a.stream->isFile())
+			bs_stack_free(aData);
+
+		return equal;
+	}
+
+	static bool compareInstances(const SPtr<SerializedInstance>& a, const SPtr<SerializedInstance>& b);
+
+	/** Checks if two sub-objects contain identical fields. */
+	static bool compareSubObjects(const SerializedSubObject& a, const SerializedSubObject& b)
+	{
+		if (a.typeId != b.typeId || a.entries.size() != b.entries.size())
+			return false;
+
+		for (auto& entry : a.entries)
+		{
+			auto iterFind = b.entries.find(entry.first);
+			if (iterFind == b.entries.end())
+				return false;
+
+			if (!compareInstances(entry.second.serialized, iterFind->second.serialized))
+				return false;
+		}
+
+		return true;
+	}
+
+	/** 
+	 * Checks if two serialized instances contain identical data. Referenced objects are compared by content, so this 
+	 * should only be used on objects without reference cycles.
+	 */
+	static bool compareInstances(const SPtr<SerializedInstance>& a, const SPtr<SerializedInstance>& b)
+	{
+		if (a == nullptr || b == nullptr)
+			return a == b;
+
+		UINT32 typeId = a->getTypeId();
+		if (typeId != b->getTypeId())
+			return false;
+
+		switch (typeId)
+		{
+		case TID_SerializedField:
+		{
+			SerializedField* aField = static_cast<SerializedField*>(a.get());
+			SerializedField* bField = static_cast<SerializedField*>(b.get());
+
+			return aField->size == bField->size && memcmp(aField->value, bField->value, aField->size) == 0;
+		}
+		case TID_SerializedDataBlock:
+			return compareDataBlocks(*static_cast<SerializedDataBlock*>(a.get()), 
+				*static_cast<SerializedDataBlock*>(b.get()));
+		case TID_SerializedArray:
+		{
+			SerializedArray* aArray = static_cast<SerializedArray*>(a.get());
+			SerializedArray* bArray = static_cast<SerializedArray*>(b.get());
+
+			if (aArray->numElements != bArray->numElements || aArray->entries.size() != bArray->entries.size())
+				return false;
+
+			for (auto& entry : aArray->entries)
+			{
+				auto iterFind = bArray->entries.find(entry.first);
+				if (iterFind == bArray->entries.end())
+					return false;
+
+				if (!compareInstances(entry.second.serialized, iterFind->second.serialized))
+					return false;
+			}
+
+			return true;
+		}
+		case TID_SerializedObject:
+		{
+			SerializedObject* aObject = static_cast<SerializedObject*>(a.get());
+			SerializedObject* bObject = static_cast<SerializedObject*>(b.get());
+
+			if (aObject->subObjects.size() != bObject->subObjects.size())
+				return false;
+
+			for (UINT32 i = 0; i < (UINT32)aObject->subObjects.size(); i++)
+			{
+				if (!compareSubObjects(aObject->subObjects[i], bObject->subObjects[i]))
+					return false;
+			}
+
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
 	SPtr<SerializedObject> IDiff::generateDiff(const SPtr<SerializedObject>& orgObj,
 		const SPtr<SerializedObject>& newObj)
 	{
@@ -69,43 +206,7 @@ namespace bs
 			SPtr<SerializedDataBlock> orgFieldData = std::static_pointer_cast<SerializedDataBlock>(orgData);
 			SPtr<SerializedDataBlock> newFieldData = std::static_pointer_cast<SerializedDataBlock>(newData);
 
-			bool isModified = orgFieldData->size != newFieldData->size;
-			if (!isModified)
-			{
-				UINT8* orgStreamData = nullptr;
-				if(orgFieldData->stream->isFile())
-				{
-					orgStreamData = (UINT8*)bs_stack_alloc(orgFieldData->size);
-					orgFieldData->stream->seek(orgFieldData->offset);
-					orgFieldData->stream->read(orgStreamData, orgFieldData->size);
-				}
-				else
-				{
-					SPtr<MemoryDataStream> orgMemStream = std::static_pointer_cast<MemoryDataStream>(orgFieldData->stream);
-					orgStreamData = orgMemStream->getCurrentPtr();
-				}
-
-				UINT8* newStreamData = nullptr;
-				if (newFieldData->stream->isFile())
-				{
-					newStreamData = (UINT8*)bs_stack_alloc(newFieldData->size);
-					newFieldData->stream->seek(newFieldData->offset);
-					newFieldData->stream->read(newStreamData, newFieldData->size);
-				}
-				else
-				{
-					SPtr<MemoryDataStream> newMemStream = std::static_pointer_cast<MemoryDataStream>(newFieldData->stream);
-					newStreamData = newMemStream->getCurrentPtr();
-				}
-
-				isModified = memcmp(orgStreamData, newStreamData, newFieldData->size) != 0;
-
-				if (newFieldData->stream->isFile())
-					bs_stack_free(newStreamData);
-
-				if (orgFieldData->stream->isFile())
-					bs_stack_free(orgStreamData);
-			}
+			bool isModified = !compareDataBlocks(*orgFieldData, *newFieldData);
 
 			if (isModified)
 				modification = newFieldData->clone();
@@ -271,6 +372,14 @@ namespace bs
 					break;
 				}
 			}
+
+			// Sub-objects with matching content hashes are very likely identical. Confirm by comparing their contents 
+			// directly, which is cheaper than generating a diff, and fall back to a full diff on the rare hash collision.
+			if (orgSubObject != nullptr && subObject.hash != 0 && subObject.hash == orgSubObject->hash)
+			{
+				if (compareSubObjects(subObject, *orgSubObject))
+					continue;
+			}
 			
 			SerializedSubObject* diffSubObject = nullptr;
 			for (auto& newEntry : subObject.entries)
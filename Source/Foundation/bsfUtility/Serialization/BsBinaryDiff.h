@@ -109,6 +109,10 @@ namespace bs
 	 * Generates and applies "diffs". Diffs contain per-field differences between an original and new object. These 
 	 * differences can be saved and then applied to an original object to transform it to the new version.
 	 *
+	 * Sub-objects with matching content hashes (see SerializedSubObject::hash) are skipped without comparing their 
+	 * fields, so when diffing objects encoded with BinarySerializer::_encodeToIntermediate() the cost of generating a 
+	 * diff mostly depends on the number of modified sub-objects.
+	 *
 	 * @note	Objects must be in intermediate serialized format generated by BinarySerializer.
 	 */
 	class BS_UTILITY_EXPORT BinaryDiff : public IDiff
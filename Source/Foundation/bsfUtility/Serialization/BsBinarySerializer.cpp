@@ -40,6 +40,48 @@ buffer += size;															\
 
 namespace bs
 {
+	/** Initial value of the hashes calculated by hashData(). */
+	static const UINT64 HASH_SEED = 0xcbf29ce484222325ULL;
+
+	/** Scrambles the bits of a 64-bit word so that every input bit affects every output bit (MurmurHash3 finalizer). */
+	static UINT64 mixWord(UINT64 word)
+	{
+		word ^= word >> 33;
+		word *= 0xff51afd7ed558ccdULL;
+		word ^= word >> 33;
+		word *= 0xc4ceb9fe1a85ec53ULL;
+		word ^= word >> 33;
+
+		return word;
+	}
+
+	/** 
+	 * Appends the provided data to a 64-bit hash. Data is consumed in 8 byte words, each of which is fully mixed before
+	 * being combined with the hash, so changes in any bit of the input (including the high bits) propagate through the 
+	 * entire hash.
+	 */
+	static void hashData(UINT64& hash, const void* data, UINT32 size)
+	{
+		const UINT8* bytes = (const UINT8*)data;
+		for(; size >= sizeof(UINT64); size -= sizeof(UINT64), bytes += sizeof(UINT64))
+		{
+			UINT64 word;
+			memcpy(&word, bytes, sizeof(word));
+
+			hash = mixWord(hash ^ mixWord(word));
+		}
+
+		if(size > 0)
+		{
+			// Include the number of remaining bytes so that trailing zeroes aren't ignored
+			UINT64 word = (UINT64)size << 56;
+			for(UINT32 i = 0; i < size; i++)
+				word |= (UINT64)bytes[i] << (i * 8);
+
+			hash = mixWord(hash ^ mixWord(word));
+		}
+	}
+
 	void BinarySerializer::encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, UINT32* bytesWritten, 
 		std::function<UINT8*(UINT8*, UINT32, UINT32&)> flushBufferCallback, bool shallow, 
 		const UnorderedMap<String, UINT64>& params)
@@ -124,11 +166,57 @@ namespace bs
 		if (dataLength == 0)
 			return nullptr;
 
-		SPtr<SerializedObject> intermediateObject = _decodeToIntermediate(data, dataLength);
-		if (intermediateObject == nullptr)
-			return nullptr;
+		size_t start = data->tell();
+		mStreamPos = start;
+		mStreamEnd = start + dataLength;
+		mStreamIsMemory = !data->isFile();
+		mStreamSubObjects.clear();
+		mStreamObjects.clear();
+
+		UINT32 rootId = 0;
+		if (!indexStream(data, rootId))
+		{
+			// Fields were encoded by a different version of one of the types, resolve them through the intermediate
+			// representation instead
+			mStreamSubObjects.clear();
+			mStreamObjects.clear();
+
+			data->seek(start);
+
+			SPtr<SerializedObject> intermediateObject = _decodeToIntermediate(data, dataLength);
+			if (intermediateObject == nullptr)
+				return nullptr;
+
+			return _decodeFromIntermediate(intermediateObject);
+		}
+
+		SPtr<IReflectable> output;
+		auto iterFindRoot = mStreamObjects.find(rootId);
+		if (iterFindRoot != mStreamObjects.end())
+		{
+			output = decodeStreamReference(data, rootId, false);
+
+			// Go through the remaining objects (should be only ones with weak refs)
+			for (auto& entry : mStreamObjects)
+			{
+				StreamObject& streamObject = entry.second;
+				if (streamObject.object == nullptr || streamObject.isDecoded)
+					continue;
+
+				streamObject.decodeInProgress = true;
+				decodeStreamObject(data, streamObject.object.get(), streamObject.firstSubObject, 
+					streamObject.numSubObjects);
+				streamObject.decodeInProgress = false;
+				streamObject.isDecoded = true;
+			}
+		}
+
+		data->seek(mStreamEnd);
 
-		return _decodeFromIntermediate(intermediateObject);
+		mStreamSubObjects.clear();
+		mStreamObjects.clear();
+
+		return output;
 	}
 
 	SPtr<IReflectable> BinarySerializer::_decodeFromIntermediate(const SPtr<SerializedObject>& serializedObject)
@@ -166,25 +254,35 @@ namespace bs
 		return output;
 	}
 
-	SPtr<SerializedObject> BinarySerializer::_encodeToIntermediate(IReflectable* object, bool shallow)
+	SPtr<SerializedObject> BinarySerializer::_encodeToIntermediate(IReflectable* object, bool shallow, 
+		const UnorderedMap<String, UINT64>& params)
 	{
-		// TODO: This is a hacky way of generating an intermediate format to save development time and complexity.
-		// It is hacky because it requires a full on encode to binary and then decode into intermediate. It should 
-		// be better to modify encoding process so it outputs the intermediate format directly (similar to how decoding works). 
-		// This also means that once you have an intermediate format you cannot use it to encode to binary. 
+		mObjectsToEncode.clear();
+		mObjectAddrToId.clear();
+		mInterimObjectMap.clear();
+		mLastUsedObjectId = 1;
+		mParams = params;
 
-		std::function<void*(UINT32)> allocator = &MemoryAllocator<GenAlloc>::allocate;
+		UINT32 objectId = findOrCreatePersistentId(object);
+
+		SPtr<SerializedObject> output = bs_shared_ptr_new<SerializedObject>();
+		mInterimObjectMap[objectId] = output;
 
-		MemorySerializer ms;
-		UINT32 dataLength = 0;
-		UINT8* data = ms.encode(object, dataLength, allocator, shallow);
+		encodeEntry(object, *output, shallow);
 
-		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data, dataLength);
+		// Encode pointed to objects. Each object is registered only once so they can be processed in order. They also
+		// remain referenced by mObjectsToEncode until the end, so their addresses (used as IDs) cannot be re-used.
+		for(size_t i = 0; i < mObjectsToEncode.size(); i++)
+		{
+			ObjectToEncode objectToEncode = mObjectsToEncode[i];
+			encodeEntry(objectToEncode.object.get(), *mInterimObjectMap[objectToEncode.objectId], shallow);
+		}
 
-		BinarySerializer bs;
-		SPtr<SerializedObject> obj = bs._decodeToIntermediate(stream, dataLength, true);
+		mObjectsToEncode.clear();
+		mObjectAddrToId.clear();
+		mInterimObjectMap.clear();
 
-		return obj;
+		return output;
 	}
 
 	SPtr<SerializedObject> BinarySerializer::_decodeToIntermediate(const SPtr<DataStream>& data, UINT32 dataLength, bool copyData)
@@ -284,6 +382,34 @@ namespace bs
 						{
 							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+							// Contiguous arrays of plain-old-data can be written all at once
+							if(curField->canMemcpyArray())
+							{
+								UINT32 arraySize = arrayNumElems * curField->getTypeSize();
+								if ((*bytesWritten + arraySize) > bufferLength)
+								{
+									UINT8* tempBuffer = (UINT8*)bs_alloc(arraySize);
+									curField->arrayToBuffer(object, arrayNumElems, tempBuffer);
+
+									buffer = dataBlockToBuffer(tempBuffer, arraySize, buffer, bufferLength, bytesWritten, flushBufferCallback);
+									bs_free(tempBuffer);
+
+									if (buffer == nullptr || bufferLength == 0)
+									{
+										si->onSerializationEnded(object, mParams);
+										return nullptr;
+									}
+								}
+								else
+								{
+									curField->arrayToBuffer(object, arrayNumElems, buffer);
+									buffer += arraySize;
+									*bytesWritten += arraySize;
+								}
+
+								break;
+							}
+
 							for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
 							{
 								UINT32 typeSize = 0;
@@ -430,6 +556,217 @@ namespace bs
 		return buffer;
 	}
 
+	void BinarySerializer::encodeEntry(IReflectable* object, SerializedObject& output, bool shallow)
+	{
+		RTTITypeBase* si = object->getRTTI();
+
+		// If an object has base classes, we need to iterate through all of them
+		do
+		{
+			si->onSerializationStarted(object, mParams);
+
+			output.subObjects.push_back(SerializedSubObject());
+			SerializedSubObject& subObject = output.subObjects.back();
+			subObject.typeId = si->getRTTIId();
+
+			UINT64 hash = HASH_SEED;
+			bool hashValid = true;
+			hashData(hash, &subObject.typeId, sizeof(subObject.typeId));
+
+			UINT32 numFields = si->getNumFields();
+			for(UINT32 i = 0; i < numFields; i++)
+			{
+				RTTIField* curGenericField = si->getField(i);
+				hashData(hash, &curGenericField->mUniqueId, sizeof(curGenericField->mUniqueId));
+
+				SPtr<SerializedInstance> serializedEntry;
+				if(curGenericField->mIsVectorType)
+				{
+					UINT32 arrayNumElems = curGenericField->getArraySize(object);
+					hashData(hash, &arrayNumElems, sizeof(arrayNumElems));
+
+					SPtr<SerializedArray> serializedArray = bs_shared_ptr_new<SerializedArray>();
+					serializedArray->numElements = arrayNumElems;
+
+					for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
+					{
+						SPtr<SerializedInstance> serializedArrayEntry;
+						switch(curGenericField->mType)
+						{
+						case SerializableFT_ReflectablePtr:
+							{
+								RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+								SPtr<IReflectable> childObject;
+								if (!shallow)
+									childObject = curField->getArrayValue(object, arrIdx);
+
+								serializedArrayEntry = encodeReferenceEntry(childObject);
+								hashValid &= serializedArrayEntry == nullptr;
+								break;
+							}
+						case SerializableFT_Reflectable:
+							{
+								RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+								IReflectable& childObject = curField->getArrayValue(object, arrIdx);
+
+								serializedArrayEntry = encodeEmbeddedEntry(&childObject, shallow, hash, hashValid);
+								break;
+							}
+						case SerializableFT_Plain:
+							{
+								RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+								serializedArrayEntry = encodePlainEntry(curField, object, (INT32)arrIdx, hash);
+								break;
+							}
+						default:
+							BS_EXCEPT(InternalErrorException, 
+								"Error encoding data. Encountered a type I don't know how to encode. Type: " + 
+								toString(UINT32(curGenericField->mType)) + ", Is array: " + 
+								toString(curGenericField->mIsVectorType));
+						}
+
+						SerializedArrayEntry arrayEntry;
+						arrayEntry.index = arrIdx;
+						arrayEntry.serialized = serializedArrayEntry;
+
+						serializedArray->entries[arrIdx] = arrayEntry;
+					}
+
+					serializedEntry = serializedArray;
+				}
+				else
+				{
+					switch(curGenericField->mType)
+					{
+					case SerializableFT_ReflectablePtr:
+						{
+							RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+
+							SPtr<IReflectable> childObject;
+							if (!shallow)
+								childObject = curField->getValue(object);
+
+							serializedEntry = encodeReferenceEntry(childObject);
+							hashValid &= serializedEntry == nullptr;
+							break;
+						}
+					case SerializableFT_Reflectable:
+						{
+							RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+							IReflectable& childObject = curField->getValue(object);
+
+							serializedEntry = encodeEmbeddedEntry(&childObject, shallow, hash, hashValid);
+							break;
+						}
+					case SerializableFT_Plain:
+						{
+							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+							serializedEntry = encodePlainEntry(curField, object, -1, hash);
+							break;
+						}
+					case SerializableFT_DataBlock:
+						{
+							RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
+
+							UINT32 dataBlockSize = 0;
+							SPtr<DataStream> blockStream = curField->getValue(object, dataBlockSize);
+
+							SPtr<MemoryDataStream> dataBlockStream = bs_shared_ptr_new<MemoryDataStream>(dataBlockSize);
+							blockStream->read(dataBlockStream->getPtr(), dataBlockSize);
+							hashData(hash, dataBlockStream->getPtr(), dataBlockSize);
+
+							SPtr<SerializedDataBlock> serializedDataBlock = bs_shared_ptr_new<SerializedDataBlock>();
+							serializedDataBlock->stream = dataBlockStream;
+							serializedDataBlock->offset = 0;
+							serializedDataBlock->size = dataBlockSize;
+
+							serializedEntry = serializedDataBlock;
+							break;
+						}
+					default:
+						BS_EXCEPT(InternalErrorException, 
+							"Error encoding data. Encountered a type I don't know how to encode. Type: " + 
+							toString(UINT32(curGenericField->mType)) + ", Is array: " + 
+							toString(curGenericField->mIsVectorType));
+					}
+				}
+
+				SerializedEntry entry;
+				entry.fieldId = curGenericField->mUniqueId;
+				entry.serialized = serializedEntry;
+
+				subObject.entries.insert(std::make_pair(curGenericField->mUniqueId, entry));
+			}
+
+			// Zero is reserved for unknown hashes
+			if (hashValid)
+				subObject.hash = hash != 0 ? hash : 1;
+
+			si->onSerializationEnded(object, mParams);
+			si = si->getBaseClass();
+
+		} while(si != nullptr); // Repeat until we reach the top of the inheritance hierarchy
+	}
+
+	SPtr<SerializedField> BinarySerializer::encodePlainEntry(RTTIPlainFieldBase* field, IReflectable* object, 
+		INT32 arrayIdx, UINT64& hash)
+	{
+		UINT32 typeSize = 0;
+		if(field->hasDynamicSize())
+		{
+			if(arrayIdx >= 0)
+				typeSize = field->getArrayElemDynamicSize(object, arrayIdx);
+			else
+				typeSize = field->getDynamicSize(object);
+		}
+		else
+			typeSize = field->getTypeSize();
+
+		SPtr<SerializedField> serializedField = bs_shared_ptr_new<SerializedField>();
+		serializedField->value = (UINT8*)bs_alloc(typeSize);
+		serializedField->size = typeSize;
+		serializedField->ownsMemory = true;
+
+		if(arrayIdx >= 0)
+			field->arrayElemToBuffer(object, arrayIdx, serializedField->value);
+		else
+			field->toBuffer(object, serializedField->value);
+
+		hashData(hash, serializedField->value, typeSize);
+		return serializedField;
+	}
+
+	SPtr<SerializedObject> BinarySerializer::encodeEmbeddedEntry(IReflectable* object, bool shallow, UINT64& hash,
+		bool& hashValid)
+	{
+		SPtr<SerializedObject> serializedObject = bs_shared_ptr_new<SerializedObject>();
+		encodeEntry(object, *serializedObject, shallow);
+
+		for(auto& subObject : serializedObject->subObjects)
+		{
+			if (subObject.hash == 0)
+				hashValid = false;
+			else
+				hashData(hash, &subObject.hash, sizeof(subObject.hash));
+		}
+
+		return serializedObject;
+	}
+
+	SPtr<SerializedObject> BinarySerializer::encodeReferenceEntry(const SPtr<IReflectable>& object)
+	{
+		UINT32 objectId = registerObjectPtr(object);
+		if(objectId == 0)
+			return nullptr;
+
+		SPtr<SerializedObject>& serializedObject = mInterimObjectMap[objectId];
+		if(serializedObject == nullptr)
+			serializedObject = bs_shared_ptr_new<SerializedObject>();
+
+		return serializedObject;
+	}
+
 	bool BinarySerializer::decodeEntry(const SPtr<DataStream>& data, UINT32 dataLength, UINT32& bytesRead,
 		SPtr<SerializedObject>& output, bool copyData, bool streamDataBlock)
 	{
@@ -1110,6 +1447,621 @@ namespace bs
 		}
 	}
 
+	bool BinarySerializer::indexStream(const SPtr<DataStream>& data, UINT32& rootId)
+	{
+		bool isRoot = true;
+		while (mStreamPos < mStreamEnd)
+		{
+			ObjectMetaData objectMetaData;
+			objectMetaData.objectMeta = 0;
+			objectMetaData.typeId = 0;
+
+			if(readStream(data, &objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			UINT32 objectId = 0;
+			UINT32 objectTypeId = 0;
+			bool objectIsBaseClass = false;
+			decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+			if (objectIsBaseClass)
+			{
+				BS_EXCEPT(InternalErrorException, "Encountered a base-class object while looking for a new object. " \
+					"Base class objects are only supposed to be parts of a larger object.");
+			}
+
+			if (isRoot)
+			{
+				rootId = objectId;
+				isRoot = false;
+			}
+
+			RTTITypeBase* rtti = IReflectable::_getRTTIfromTypeId(objectTypeId);
+
+			UINT32 firstSubObject = (UINT32)mStreamSubObjects.size();
+			UINT32 numSubObjects = 0;
+			if (!skimStreamObject(data, rtti, true, numSubObjects))
+				return false;
+
+			if (rtti != nullptr)
+			{
+				StreamObject& streamObject = mStreamObjects[objectId];
+				streamObject.firstSubObject = firstSubObject;
+				streamObject.numSubObjects = numSubObjects;
+			}
+		}
+
+		return true;
+	}
+
+	bool BinarySerializer::skimStreamObject(const SPtr<DataStream>& data, RTTITypeBase* rtti, bool record, 
+		UINT32& numSubObjects)
+	{
+		if (rtti != nullptr && record)
+		{
+			StreamSubObject subObject;
+			subObject.rtti = rtti;
+			subObject.offset = mStreamPos;
+
+			mStreamSubObjects.push_back(subObject);
+			numSubObjects++;
+		}
+
+		UINT32 nextFieldIdx = 0;
+		while (mStreamPos < mStreamEnd)
+		{
+			UINT32 metaData = 0;
+			if(readStream(data, &metaData, META_SIZE) != META_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			if (isObjectMetaData(metaData)) // We've reached a new object or a base class of the current one
+			{
+				ObjectMetaData objMetaData;
+				objMetaData.objectMeta = metaData;
+				objMetaData.typeId = 0;
+
+				if (readStream(data, &objMetaData.typeId, sizeof(objMetaData.typeId)) != sizeof(objMetaData.typeId))
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				UINT32 objId = 0;
+				UINT32 objTypeId = 0;
+				bool objIsBaseClass = false;
+				decodeObjectMetaData(objMetaData, objId, objTypeId, objIsBaseClass);
+
+				if (!objIsBaseClass)
+				{
+					// Found new object, we're done
+					seekStream(data, mStreamPos - sizeof(ObjectMetaData));
+					return true;
+				}
+
+				if (rtti != nullptr)
+					rtti = rtti->getBaseClass();
+
+				// Saved and current base classes don't match, so just skip over all that data
+				if (rtti == nullptr || rtti->getRTTIId() != objTypeId)
+					rtti = nullptr;
+
+				if (rtti != nullptr && record)
+				{
+					StreamSubObject subObject;
+					subObject.rtti = rtti;
+					subObject.offset = mStreamPos;
+
+					mStreamSubObjects.push_back(subObject);
+					numSubObjects++;
+				}
+
+				nextFieldIdx = 0;
+				continue;
+			}
+
+			bool isArray;
+			SerializableFieldType fieldType;
+			UINT16 fieldId;
+			UINT8 fieldSize;
+			bool hasDynamicSize;
+			bool terminator;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+
+			if (terminator)
+				return true;
+
+			if (rtti != nullptr)
+			{
+				// Fields are encoded in the order they are registered with the type. If a known field is found out of
+				// that order, the type was changed since the data was encoded.
+				RTTIField* curGenericField = nullptr;
+				UINT32 numFields = rtti->getNumFields();
+				for (UINT32 i = nextFieldIdx; i < numFields; i++)
+				{
+					RTTIField* field = rtti->getField(i);
+					if (field->mUniqueId == fieldId)
+					{
+						curGenericField = field;
+						nextFieldIdx = i + 1;
+						break;
+					}
+				}
+
+				if (curGenericField == nullptr && rtti->findField(fieldId) != nullptr)
+					return false;
+
+				if (curGenericField != nullptr)
+				{
+					if (!hasDynamicSize && curGenericField->getTypeSize() != fieldSize)
+					{
+						BS_EXCEPT(InternalErrorException,
+							"Data type mismatch. Type size stored in file and actual type size don't match. ("
+							+ toString(curGenericField->getTypeSize()) + " vs. " + toString(fieldSize) + ")");
+					}
+
+					if (curGenericField->mIsVectorType != isArray)
+					{
+						BS_EXCEPT(InternalErrorException,
+							"Data type mismatch. One is array, other is a single type.");
+					}
+
+					if (curGenericField->mType != fieldType)
+					{
+						BS_EXCEPT(InternalErrorException,
+							"Data type mismatch. Field types don't match. " + toString(UINT32(curGenericField->mType)) + " vs. " + toString(UINT32(fieldType)));
+					}
+				}
+			}
+
+			if (!skipStreamField(data, isArray, fieldType, fieldSize, hasDynamicSize))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool BinarySerializer::skipStreamField(const SPtr<DataStream>& data, bool isArray, SerializableFieldType type,
+		UINT8 fieldSize, bool hasDynamicSize)
+	{
+		UINT32 arrayNumElems = 1;
+		if (isArray)
+		{
+			if(readStream(data, &arrayNumElems, NUM_ELEM_FIELD_SIZE) != NUM_ELEM_FIELD_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+		}
+
+		switch (type)
+		{
+		case SerializableFT_ReflectablePtr:
+			skipStream(data, arrayNumElems * COMPLEX_TYPE_FIELD_SIZE);
+			break;
+		case SerializableFT_Reflectable:
+			for (UINT32 i = 0; i < arrayNumElems; i++)
+			{
+				ObjectMetaData objectMetaData;
+				objectMetaData.objectMeta = 0;
+				objectMetaData.typeId = 0;
+
+				if(readStream(data, &objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				UINT32 objectId = 0;
+				UINT32 objectTypeId = 0;
+				bool objectIsBaseClass = false;
+				decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+				if (objectIsBaseClass)
+				{
+					BS_EXCEPT(InternalErrorException, "Encountered a base-class object while looking for a new object. " \
+						"Base class objects are only supposed to be parts of a larger object.");
+				}
+
+				RTTITypeBase* childRtti = IReflectable::_getRTTIfromTypeId(objectTypeId);
+
+				UINT32 numSubObjects = 0;
+				if (!skimStreamObject(data, childRtti, false, numSubObjects))
+					return false;
+			}
+			break;
+		case SerializableFT_Plain:
+			if (hasDynamicSize)
+			{
+				for (UINT32 i = 0; i < arrayNumElems; i++)
+				{
+					// Dynamic size includes the size field itself
+					UINT32 typeSize = 0;
+					if(readStream(data, &typeSize, sizeof(UINT32)) != sizeof(UINT32) || typeSize < sizeof(UINT32))
+					{
+						BS_EXCEPT(InternalErrorException, "Error decoding data.");
+					}
+
+					skipStream(data, typeSize - sizeof(UINT32));
+				}
+			}
+			else
+				skipStream(data, arrayNumElems * fieldSize);
+			break;
+		case SerializableFT_DataBlock:
+		{
+			if (isArray)
+			{
+				BS_EXCEPT(InternalErrorException,
+					"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(type)) +
+					", Is array: " + toString(isArray));
+			}
+
+			UINT32 dataBlockSize = 0;
+			if(readStream(data, &dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			skipStream(data, dataBlockSize);
+		}
+			break;
+		default:
+			BS_EXCEPT(InternalErrorException,
+				"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(type)) +
+				", Is array: " + toString(isArray));
+		}
+
+		return true;
+	}
+
+	void BinarySerializer::decodeStreamObject(const SPtr<DataStream>& data, IReflectable* object, UINT32 firstSubObject,
+		UINT32 numSubObjects)
+	{
+		// Base class fields are encoded after the fields of the derived class, but need to be decoded first
+		for (INT32 subObjectIdx = numSubObjects - 1; subObjectIdx >= 0; subObjectIdx--)
+		{
+			// Note: Copying, as decoding embedded objects might append to the array
+			StreamSubObject subObject = mStreamSubObjects[firstSubObject + subObjectIdx];
+
+			subObject.rtti->onDeserializationStarted(object, mParams);
+
+			seekStream(data, subObject.offset);
+			decodeStreamFields(data, object, subObject.rtti);
+		}
+
+		for (INT32 subObjectIdx = numSubObjects - 1; subObjectIdx >= 0; subObjectIdx--)
+			mStreamSubObjects[firstSubObject + subObjectIdx].rtti->onDeserializationEnded(object, mParams);
+	}
+
+	bool BinarySerializer::decodeStreamFields(const SPtr<DataStream>& data, IReflectable* object, RTTITypeBase* rtti)
+	{
+		UINT32 nextFieldIdx = 0;
+		UINT32 numFields = rtti->getNumFields();
+		while (mStreamPos < mStreamEnd)
+		{
+			UINT32 metaData = 0;
+			readStream(data, &metaData, META_SIZE);
+
+			if (isObjectMetaData(metaData)) // We've reached a new object or a base class of the current one
+			{
+				seekStream(data, mStreamPos - META_SIZE);
+				return false;
+			}
+
+			bool isArray;
+			SerializableFieldType fieldType;
+			UINT16 fieldId;
+			UINT8 fieldSize;
+			bool hasDynamicSize;
+			bool terminator;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+
+			if (terminator)
+				return true;
+
+			// Fields are guaranteed to be in type order, as it was checked when indexing the stream
+			RTTIField* curGenericField = nullptr;
+			for (UINT32 i = nextFieldIdx; i < numFields; i++)
+			{
+				RTTIField* field = rtti->getField(i);
+				if (field->mUniqueId == fieldId)
+				{
+					curGenericField = field;
+					nextFieldIdx = i + 1;
+					break;
+				}
+			}
+
+			if (curGenericField == nullptr)
+			{
+				skipStreamField(data, isArray, fieldType, fieldSize, hasDynamicSize);
+				continue;
+			}
+
+			if (isArray)
+			{
+				UINT32 arrayNumElems = 0;
+				readStream(data, &arrayNumElems, NUM_ELEM_FIELD_SIZE);
+
+				curGenericField->setArraySize(object, arrayNumElems);
+
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+					bool isWeakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						UINT32 childObjectId = 0;
+						readStream(data, &childObjectId, COMPLEX_TYPE_FIELD_SIZE);
+
+						curField->setArrayValue(object, i, decodeStreamReference(data, childObjectId, isWeakRef));
+					}
+
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						SPtr<IReflectable> childObject = decodeStreamEmbedded(data);
+						if (childObject != nullptr)
+							curField->setArrayValue(object, i, *childObject);
+					}
+
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					// Contiguous arrays of plain-old-data are read all at once, as long as the element size matches
+					if (!hasDynamicSize && fieldSize == curField->getTypeSize() && curField->canMemcpyArray())
+					{
+						UINT8* arrayData = readStreamData(data, arrayNumElems * fieldSize, false);
+						curField->arrayFromBuffer(object, arrayNumElems, arrayData);
+
+						break;
+					}
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						curField->arrayElemFromBuffer(object, i, readStreamData(data, fieldSize, hasDynamicSize));
+					}
+
+					break;
+				}
+				default:
+					break;
+				}
+			}
+			else
+			{
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+					bool isWeakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
+
+					UINT32 childObjectId = 0;
+					readStream(data, &childObjectId, COMPLEX_TYPE_FIELD_SIZE);
+
+					curField->setValue(object, decodeStreamReference(data, childObjectId, isWeakRef));
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					SPtr<IReflectable> childObject = decodeStreamEmbedded(data);
+					if (childObject != nullptr)
+						curField->setValue(object, *childObject);
+
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					curField->fromBuffer(object, readStreamData(data, fieldSize, hasDynamicSize));
+					break;
+				}
+				case SerializableFT_DataBlock:
+				{
+					RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
+
+					UINT32 dataBlockSize = 0;
+					readStream(data, &dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE);
+
+					// The field is free to read as much of the block as it wants, so restore the position afterwards
+					size_t dataBlockStart = mStreamPos;
+					curField->setValue(object, data, dataBlockSize);
+
+					mStreamPos = dataBlockStart + dataBlockSize;
+					data->seek(mStreamPos);
+
+					break;
+				}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	SPtr<IReflectable> BinarySerializer::decodeStreamEmbedded(const SPtr<DataStream>& data)
+	{
+		ObjectMetaData objectMetaData;
+		objectMetaData.objectMeta = 0;
+		objectMetaData.typeId = 0;
+		readStream(data, &objectMetaData, sizeof(ObjectMetaData));
+
+		UINT32 objectId = 0;
+		UINT32 objectTypeId = 0;
+		bool objectIsBaseClass = false;
+		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+		RTTITypeBase* rtti = IReflectable::_getRTTIfromTypeId(objectTypeId);
+		if (rtti == nullptr)
+		{
+			UINT32 numSubObjects = 0;
+			skimStreamObject(data, nullptr, false, numSubObjects);
+
+			return nullptr;
+		}
+
+		SPtr<IReflectable> object = rtti->newRTTIObject();
+		if (rtti->getBaseClass() == nullptr)
+		{
+			// No base classes, so the fields can be decoded in the same order they are read
+			rtti->onDeserializationStarted(object.get(), mParams);
+
+			// Skip any base class data left over from a previous version of the type
+			if (!decodeStreamFields(data, object.get(), rtti))
+			{
+				UINT32 numSubObjects = 0;
+				skimStreamObject(data, nullptr, false, numSubObjects);
+			}
+
+			rtti->onDeserializationEnded(object.get(), mParams);
+		}
+		else
+		{
+			UINT32 firstSubObject = (UINT32)mStreamSubObjects.size();
+			UINT32 numSubObjects = 0;
+			skimStreamObject(data, rtti, true, numSubObjects);
+
+			size_t end = mStreamPos;
+			decodeStreamObject(data, object.get(), firstSubObject, numSubObjects);
+			seekStream(data, end);
+
+			mStreamSubObjects.resize(firstSubObject);
+		}
+
+		return object;
+	}
+
+	SPtr<IReflectable> BinarySerializer::decodeStreamReference(const SPtr<DataStream>& data, UINT32 objectId, 
+		bool isWeakRef)
+	{
+		if (objectId == 0)
+			return nullptr;
+
+		auto iterFind = mStreamObjects.find(objectId);
+		if (iterFind == mStreamObjects.end())
+			return nullptr;
+
+		StreamObject& streamObject = iterFind->second;
+		if (streamObject.object == nullptr)
+			streamObject.object = mStreamSubObjects[streamObject.firstSubObject].rtti->newRTTIObject();
+
+		bool needsDecoding = !isWeakRef && !streamObject.isDecoded;
+		if (needsDecoding)
+		{
+			if (streamObject.decodeInProgress)
+			{
+				LOGWRN("Detected a circular reference when decoding. Referenced object's fields " \
+					"will be resolved in an undefined order (i.e. one of the objects will not " \
+					"be fully deserialized when assigned to its field). Use RTTI_Flag_WeakRef to " \
+					"get rid of this warning and tell the system which of the objects is allowed " \
+					"to be deserialized after it is assigned to its field.");
+			}
+			else
+			{
+				// Referenced objects are encoded after the objects referencing them, so jump ahead and come back
+				size_t returnPos = mStreamPos;
+
+				streamObject.decodeInProgress = true;
+				decodeStreamObject(data, streamObject.object.get(), streamObject.firstSubObject, 
+					streamObject.numSubObjects);
+				streamObject.decodeInProgress = false;
+				streamObject.isDecoded = true;
+
+				seekStream(data, returnPos);
+			}
+		}
+
+		return streamObject.object;
+	}
+
+	UINT8* BinarySerializer::readStreamData(const SPtr<DataStream>& data, UINT32 fieldSize, bool hasDynamicSize)
+	{
+		// Reference memory streams directly, without copying
+		if (mStreamIsMemory)
+		{
+			MemoryDataStream* memStream = static_cast<MemoryDataStream*>(data.get());
+			UINT8* output = memStream->getCurrentPtr();
+
+			// Dynamic size includes the size field itself
+			UINT32 typeSize = fieldSize;
+			if (hasDynamicSize)
+				memcpy(&typeSize, output, sizeof(UINT32));
+
+			skipStream(data, typeSize);
+			return output;
+		}
+
+		if (hasDynamicSize)
+		{
+			UINT32 typeSize = 0;
+			readStream(data, &typeSize, sizeof(UINT32));
+
+			if (mStreamBuffer.size() < typeSize)
+				mStreamBuffer.resize(typeSize);
+
+			memcpy(mStreamBuffer.data(), &typeSize, sizeof(UINT32));
+			readStream(data, mStreamBuffer.data() + sizeof(UINT32), typeSize - sizeof(UINT32));
+		}
+		else
+		{
+			if (mStreamBuffer.size() < fieldSize)
+				mStreamBuffer.resize(fieldSize);
+
+			readStream(data, mStreamBuffer.data(), fieldSize);
+		}
+
+		return mStreamBuffer.data();
+	}
+
+	size_t BinarySerializer::readStream(const SPtr<DataStream>& data, void* buffer, size_t size)
+	{
+		size_t numRead = data->read(buffer, size);
+		mStreamPos += numRead;
+
+		return numRead;
+	}
+
+	void BinarySerializer::skipStream(const SPtr<DataStream>& data, size_t size)
+	{
+		// Seeking discards the read buffer of file streams, so small amounts of data are read instead
+		if (!mStreamIsMemory && size <= STREAM_SKIP_READ_SIZE)
+		{
+			UINT8 buffer[STREAM_SKIP_READ_SIZE];
+			data->read(buffer, size);
+		}
+		else
+			data->skip(size);
+
+		mStreamPos += size;
+	}
+
+	void BinarySerializer::seekStream(const SPtr<DataStream>& data, size_t pos)
+	{
+		if (pos > mStreamPos)
+			skipStream(data, pos - mStreamPos);
+		else if (pos < mStreamPos)
+		{
+			data->seek(pos);
+			mStreamPos = pos;
+		}
+	}
+
 	UINT32 BinarySerializer::encodeFieldMetaData(UINT16 id, UINT8 size, bool array, 
 		SerializableFieldType type, bool hasDynamicSize, bool terminator)
 	{
@@ -67,7 +67,10 @@ namespace bs
 			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
 
 		/**
-		 * Decodes an object from binary data.
+		 * Decodes an object from binary data. Fields are decoded directly into the newly created objects as they are read
+		 * from the stream, without building an intermediate representation. Only if the data was encoded using a
+		 * different version of a type (i.e. the type's fields were re-ordered since) does decoding fall back to the
+		 * intermediate representation, which resolves the fields in the order of the current type.
 		 *
 		 * @param[in]	data  		Binary data to decode.
 		 * @param[in]	dataLength	Length of the data in bytes.
@@ -82,14 +85,19 @@ namespace bs
 		 */
 
 		/**
-		 * Encodes an object into an intermediate representation.
+		 * Encodes an object into an intermediate representation. Fields are encoded directly into the intermediate 
+		 * representation, without encoding them to binary first. Each of the output sub-objects will also contain a hash
+		 * of its contents, allowing identical sub-objects to be detected quickly (e.g. when generating diffs).
 		 *
 		 * @param[in]	object		Object to encode.
 		 * @param[in]	shallow		Determines how to handle referenced objects. If true then references will not be encoded
 		 *							and will be set to null. If false then references will be encoded as well and restored
 		 *							upon decoding.
+		 * @param[in]	params		Optional parameters to be passed to the serialization callbacks on the objects being
+		 *							serialized.
 		 */
-		SPtr<SerializedObject> _encodeToIntermediate(IReflectable* object, bool shallow = false);
+		SPtr<SerializedObject> _encodeToIntermediate(IReflectable* object, bool shallow = false,
+			const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
 
 		/**
 		 * Decodes a serialized object into an intermediate representation for easier parsing.
@@ -140,10 +148,52 @@ namespace bs
 			bool decodeInProgress; // Used for error reporting circular references
 		};
 
+		/** Location of a single type in an object's inheritance hierarchy, in the stream being decoded. */
+		struct StreamSubObject
+		{
+			RTTITypeBase* rtti = nullptr;
+			size_t offset = 0; /**< Stream position of the first field of the type. */
+		};
+
+		/** Object in the stream being decoded that can be referenced through reflectable pointer fields. */
+		struct StreamObject
+		{
+			SPtr<IReflectable> object;
+			UINT32 firstSubObject = 0; /**< Index into mStreamSubObjects, sub-objects are ordered from most derived type. */
+			UINT32 numSubObjects = 0;
+			bool isDecoded = false;
+			bool decodeInProgress = false; // Used for error reporting circular references
+		};
+
 		/** Encodes a single IReflectable object. */
 		UINT8* encodeEntry(IReflectable* object, UINT32 objectId, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
 
+		/** 
+		 * Encodes a single IReflectable object into an intermediate representation, appending a sub-object to @p output
+		 * for each type in the object's inheritance hierarchy. 
+		 */
+		void encodeEntry(IReflectable* object, SerializedObject& output, bool shallow);
+
+		/** 
+		 * Encodes the value of a plain field (or a single array element, if @p arrayIdx is not -1) into an intermediate
+		 * representation, and appends its data to the provided hash. 
+		 */
+		SPtr<SerializedField> encodePlainEntry(RTTIPlainFieldBase* field, IReflectable* object, INT32 arrayIdx, 
+			UINT64& hash);
+
+		/**
+		 * Encodes an object embedded in a reflectable field into an intermediate representation, and appends the hash of
+		 * its contents to the provided hash. @p hashValid is set to false if the object's contents cannot be hashed.
+		 */
+		SPtr<SerializedObject> encodeEmbeddedEntry(IReflectable* object, bool shallow, UINT64& hash, bool& hashValid);
+
+		/**
+		 * Returns the intermediate representation of an object referenced through a reflectable pointer field, and 
+		 * registers the object for encoding if it wasn't already. Returns null if the object is null.
+		 */
+		SPtr<SerializedObject> encodeReferenceEntry(const SPtr<IReflectable>& object);
+
 		/**	Decodes a single IReflectable object. */
 		void decodeEntry(const SPtr<IReflectable>& object, const SPtr<SerializedObject>& serializableObject);
 
@@ -151,6 +201,68 @@ namespace bs
 		bool decodeEntry(const SPtr<DataStream>& data, UINT32 dataLength, UINT32& bytesRead, SPtr<SerializedObject>& output, 
 			bool copyData, bool streamDataBlock);
 
+		/**
+		 * Quickly goes over all the objects in the stream, without decoding their fields, and records where the types
+		 * of each object are located. Returns false if the stream contains data that cannot be decoded in a single pass,
+		 * in which case the intermediate representation should be used instead.
+		 */
+		bool indexStream(const SPtr<DataStream>& data, UINT32& rootId);
+
+		/**
+		 * Skips over an object starting at the current stream position, immediately after its object meta-data. Stops at
+		 * the start of the next object, or after the object's terminator field, whichever comes first. Validates all
+		 * the fields and returns false if they were not encoded in the order the current type version expects.
+		 *
+		 * @param[in]	data			Stream to read the object from.
+		 * @param[in]	rtti			Type of the object. Can be null if the type is unknown.
+		 * @param[in]	record			If true, the locations of all the object's types will be appended to
+		 *								mStreamSubObjects.
+		 * @param[out]	numSubObjects	Number of types appended to mStreamSubObjects.
+		 */
+		bool skimStreamObject(const SPtr<DataStream>& data, RTTITypeBase* rtti, bool record, UINT32& numSubObjects);
+
+		/**
+		 * Skips over the data of a single field, starting at the current stream position, immediately after its meta-data.
+		 * Returns false if an embedded object is encountered whose fields are not in the expected order.
+		 */
+		bool skipStreamField(const SPtr<DataStream>& data, bool isArray, SerializableFieldType type, UINT8 fieldSize,
+			bool hasDynamicSize);
+
+		/** Decodes all types of an object whose locations were recorded in mStreamSubObjects. */
+		void decodeStreamObject(const SPtr<DataStream>& data, IReflectable* object, UINT32 firstSubObject,
+			UINT32 numSubObjects);
+
+		/**
+		 * Decodes fields of the provided type from the current stream position, into the provided object. Returns true
+		 * if decoding stopped at a terminator field, or false if it stopped at the start of another object or the end of
+		 * data.
+		 */
+		bool decodeStreamFields(const SPtr<DataStream>& data, IReflectable* object, RTTITypeBase* rtti);
+
+		/** Decodes an object embedded directly in the stream, starting at the current stream position. */
+		SPtr<IReflectable> decodeStreamEmbedded(const SPtr<DataStream>& data);
+
+		/**
+		 * Returns an object referenced through a reflectable pointer field, creating it if it wasn't created already.
+		 * Unless the reference is weak the object will be fully decoded before it is returned.
+		 */
+		SPtr<IReflectable> decodeStreamReference(const SPtr<DataStream>& data, UINT32 objectId, bool isWeakRef);
+
+		/**
+		 * Returns a pointer to the data of the plain field at the current stream position, and advances the stream past
+		 * it. The pointer is only valid until the next call.
+		 */
+		UINT8* readStreamData(const SPtr<DataStream>& data, UINT32 fieldSize, bool hasDynamicSize);
+
+		/** Reads data from the stream being decoded, while keeping track of the stream position. */
+		size_t readStream(const SPtr<DataStream>& data, void* buffer, size_t size);
+
+		/** Skips data in the stream being decoded, while keeping track of the stream position. */
+		void skipStream(const SPtr<DataStream>& data, size_t size);
+
+		/** Moves to the specified position in the stream being decoded, while keeping track of the stream position. */
+		void seekStream(const SPtr<DataStream>& data, size_t pos);
+
 		/**	Helper method for encoding a complex object and copying its data to a buffer. */
 		UINT8* complexTypeToBuffer(IReflectable* object, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
@@ -201,12 +313,20 @@ namespace bs
 		UnorderedMap<SPtr<SerializedObject>, ObjectToDecode> mObjectMap;
 		UnorderedMap<UINT32, SPtr<SerializedObject>> mInterimObjectMap;
 
+		Vector<StreamSubObject> mStreamSubObjects;
+		UnorderedMap<UINT32, StreamObject> mStreamObjects;
+		Vector<UINT8> mStreamBuffer;
+		size_t mStreamPos = 0;
+		size_t mStreamEnd = 0;
+		bool mStreamIsMemory = false;
+
 		UnorderedMap<String, UINT64> mParams;
 
 		static constexpr const int META_SIZE = 4; // Meta field size
 		static constexpr const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static constexpr const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
 		static constexpr const int DATA_BLOCK_TYPE_FIELD_SIZE = 4;
+		static constexpr const int STREAM_SKIP_READ_SIZE = 512; // Max. amount of data to read instead of seeking over it
 	};
 
 	/** @} */
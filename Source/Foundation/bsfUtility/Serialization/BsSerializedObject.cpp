@@ -59,6 +59,7 @@ namespace bs
 		for (auto& subObject : subObjects)
 		{
 			copy->subObjects[i].typeId = subObject.typeId;
+			copy->subObjects[i].hash = subObject.hash;
 
 			for (auto& entryPair : subObject.entries)
 			{
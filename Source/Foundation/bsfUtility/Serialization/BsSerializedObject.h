@@ -80,6 +80,14 @@ namespace bs
 		UINT32 typeId = 0;
 		UnorderedMap<UINT32, SerializedEntry> entries;
 
+		/**
+		 * Hash of the sub-object contents, if known. Two sub-objects with the same non-zero hash are very likely identical,
+		 * but their contents must still be compared to be certain.
+		 * Only set when encoding objects directly into intermediate representation, and only if the sub-object doesn't
+		 * reference other objects through reflectable pointers. Otherwise zero.
+		 */
+		UINT64 hash = 0;
+
 		/************************************************************************/
 		/* 								RTTI		                     		*/
 		/************************************************************************/
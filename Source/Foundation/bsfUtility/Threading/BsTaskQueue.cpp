@@ -0,0 +1,138 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Threading/BsTaskQueue.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	TaskQueue::TaskQueue(String name, UINT32 capacity)
+		:mName(std::move(name))
+	{
+		capacity = Bitwise::nextPow2(std::max(capacity, 2U));
+
+		mCells = bs_newN<Cell>(capacity);
+		mMask = capacity - 1;
+
+		for (UINT32 i = 0; i < capacity; i++)
+			mCells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	TaskQueue::~TaskQueue()
+	{
+		assert(mEnqueuePos.load() == mDequeuePos.load() && "Destroying a task queue with queued tasks.");
+
+		// Let any workers finishing up leave the queue before it's destroyed
+		while (mNumDrainingTasks.load(std::memory_order_acquire) > 0)
+			std::this_thread::yield();
+
+		bs_deleteN(mCells, mMask + 1);
+	}
+
+	void TaskQueue::submit(TaskFunc func, void* data)
+	{
+		if (!push(func, data))
+		{
+			func(data);
+			return;
+		}
+
+		// Ensures the push is visible before the worker count is read, see drain()
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		const UINT32 maxWorkers = std::max(TaskScheduler::instance().getNumWorkers(), 1U);
+		UINT32 numWorkers = mNumActiveWorkers.load(std::memory_order_relaxed);
+		while (numWorkers < maxWorkers)
+		{
+			if (mNumActiveWorkers.compare_exchange_weak(numWorkers, numWorkers + 1))
+			{
+				mNumDrainingTasks.fetch_add(1);
+
+				SPtr<Task> task = Task::create(mName, [this]() { drain(); });
+				TaskScheduler::instance().addTask(task);
+
+				break;
+			}
+		}
+	}
+
+	void TaskQueue::drain()
+	{
+		TaskFunc func;
+		void* data;
+
+		while (true)
+		{
+			while (pop(func, data))
+				func(data);
+
+			mNumActiveWorkers.fetch_sub(1);
+
+			// A task might have been pushed after our last attempt, but before the submitter saw the decremented worker
+			// count, in which case no other worker would get started for it. Check once more after decrementing.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (!pop(func, data))
+				break;
+
+			mNumActiveWorkers.fetch_add(1);
+			func(data);
+		}
+
+		// Must be the last access to the queue, as it may get destroyed as soon as this reaches zero
+		mNumDrainingTasks.fetch_sub(1, std::memory_order_release);
+	}
+
+	bool TaskQueue::push(TaskFunc func, void* data)
+	{
+		UINT32 pos = mEnqueuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Cell& cell = mCells[pos & mMask];
+			UINT32 sequence = cell.sequence.load(std::memory_order_acquire);
+			INT32 diff = (INT32)(sequence - pos);
+
+			if (diff == 0)
+			{
+				if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					cell.func = func;
+					cell.data = data;
+					cell.sequence.store(pos + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false; // Full
+			else
+				pos = mEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	bool TaskQueue::pop(TaskFunc& func, void*& data)
+	{
+		UINT32 pos = mDequeuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Cell& cell = mCells[pos & mMask];
+			UINT32 sequence = cell.sequence.load(std::memory_order_acquire);
+			INT32 diff = (INT32)(sequence - (pos + 1));
+
+			if (diff == 0)
+			{
+				if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					func = cell.func;
+					data = cell.data;
+					cell.sequence.store(pos + mMask + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+			else if (diff < 0)
+				return false; // Empty
+			else
+				pos = mDequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,90 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
+	/**
+	 * Queue of lightweight tasks executed by the workers of the TaskScheduler. Meant for large numbers of small tasks,
+	 * for which creating and scheduling a separate Task each would be too expensive.
+	 *
+	 * Tasks are stored in a fixed-size lock-free queue, which is drained by a number of scheduler tasks. New draining
+	 * tasks are only started when tasks are submitted and fewer than TaskScheduler::getNumWorkers() are already running,
+	 * meaning a burst of submitted tasks generally results in only a handful of scheduler tasks.
+	 *
+	 * @note	Thread safe.
+	 * @note	The queue must outlive all the tasks submitted to it.
+	 */
+	class BS_UTILITY_EXPORT TaskQueue
+	{
+	public:
+		/** Signature of a function executed by a task. */
+		typedef void(*TaskFunc)(void* data);
+
+		/**
+		 * Creates a new queue.
+		 *
+		 * @param[in]	name		Name given to the scheduler tasks draining the queue.
+		 * @param[in]	capacity	Maximum number of queued tasks. Will be rounded up to a power of two.
+		 */
+		TaskQueue(String name, UINT32 capacity = 4096);
+		~TaskQueue();
+
+		/**
+		 * Queues a task for execution on one of the scheduler's worker threads. If the queue is full the task is
+		 * executed immediately on the calling thread instead.
+		 *
+		 * @param[in]	func	Function to execute.
+		 * @param[in]	data	User data passed to the function.
+		 */
+		void submit(TaskFunc func, void* data);
+
+		/** Returns the number of scheduler tasks currently draining the queue. */
+		UINT32 getNumActiveWorkers() const { return mNumActiveWorkers.load(std::memory_order_relaxed); }
+
+	private:
+		/** Single entry in the ring buffer. */
+		struct Cell
+		{
+			std::atomic<UINT32> sequence;
+			TaskFunc func;
+			void* data;
+		};
+
+		/** Attempts to add a task to the queue. Returns false if the queue is full. */
+		bool push(TaskFunc func, void* data);
+
+		/** Attempts to remove a task from the queue. Returns false if the queue is empty. */
+		bool pop(TaskFunc& func, void*& data);
+
+		/** Executes queued tasks until the queue is empty. Executed by the scheduler tasks. */
+		void drain();
+
+		String mName;
+		Cell* mCells;
+		UINT32 mMask;
+
+		// Note: Positions are padded to separate cache lines since producers and consumers generally run on different
+		// threads
+		UINT8 mPadding0[64];
+		std::atomic<UINT32> mEnqueuePos { 0 };
+		UINT8 mPadding1[64];
+		std::atomic<UINT32> mDequeuePos { 0 };
+		UINT8 mPadding2[64];
+		std::atomic<UINT32> mNumActiveWorkers { 0 };
+
+		/** 
+		 * Number of scheduler tasks that haven't yet returned from drain(). Unlike mNumActiveWorkers this is only 
+		 * decremented once a task no longer accesses the queue.
+		 */
+		std::atomic<UINT32> mNumDrainingTasks { 0 };
+	};
+
+	/** @} */
+}
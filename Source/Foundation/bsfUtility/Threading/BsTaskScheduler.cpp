@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsTaskScheduler.h"
 #include "Threading/BsThreadPool.h"
+#include "Allocators/BsConcurrentPoolAlloc.h"
+#include "Debug/BsProfilerTimeline.h"
 
 namespace bs
 {
@@ -9,13 +11,17 @@ namespace bs
 		TaskPriority priority, SPtr<Task> dependency)
 		: mName(name), mPriority(priority), mTaskWorker(std::move(taskWorker)), mTaskDependency(std::move(dependency))
 	{
-
+		// Register the name once up front, rather than every time a task gets executed
+		if (ProfilerTimeline::isEnabled())
+			mTimelineNameId = ProfilerTimeline::registerName(mName);
 	}
 
 	SPtr<Task> Task::create(const String& name, std::function<void()> taskWorker, TaskPriority priority, 
 		SPtr<Task> dependency)
 	{
-		return bs_shared_ptr_new<Task>(PrivatelyConstruct(), name, std::move(taskWorker), priority, std::move(dependency));
+		// Tasks are frequently created from worker threads, so allocate them from a thread safe pool
+		return std::allocate_shared<Task>(StdConcurrentPoolAlloc<Task>(), PrivatelyConstruct(), name,
+			std::move(taskWorker), priority, std::move(dependency));
 	}
 
 	bool Task::isComplete() const
@@ -155,7 +161,20 @@ namespace bs
 
 	void TaskScheduler::runTask(SPtr<Task> task)
 	{
-		task->mTaskWorker();
+		if (ProfilerTimeline::isEnabled())
+		{
+			ProfilerTimeline::setThreadName("Task worker");
+
+			// Task might have been created before recording was enabled
+			if (task->mTimelineNameId == (UINT32)-1)
+				task->mTimelineNameId = ProfilerTimeline::registerName(task->mName);
+
+			ProfilerTimeline::beginSample(task->mTimelineNameId);
+			task->mTaskWorker();
+			ProfilerTimeline::endSample(task->mTimelineNameId);
+		}
+		else
+			task->mTaskWorker();
 
 		{
 			Lock lock(mReadyMutex);
@@ -68,6 +68,7 @@ namespace bs
 		friend class TaskScheduler;
 
 		String mName;
+		UINT32 mTimelineNameId = (UINT32)-1; /**< Name identifier used by ProfilerTimeline, if registered. */
 		TaskPriority mPriority;
 		UINT32 mTaskId = 0;
 		std::function<void()> mTaskWorker;
@@ -30,7 +30,7 @@ namespace bs { namespace ct
 
 		if(mUsage == GPBU_STATIC)
 			mBuffer = bs_new<D3D11HardwareBuffer>(D3D11HardwareBuffer::BT_CONSTANT, GBU_STATIC, 1, mSize, std::ref(device));
-		else if(mUsage == GPBU_DYNAMIC)
+		else if(mUsage == GPBU_DYNAMIC || mUsage == GPBU_TRANSIENT)
 			mBuffer = bs_new<D3D11HardwareBuffer>(D3D11HardwareBuffer::BT_CONSTANT, GBU_DYNAMIC, 1, mSize, std::ref(device));
 		else
 			BS_EXCEPT(InternalErrorException, "Invalid gpu param block usage.");
@@ -227,4 +227,9 @@ namespace bs { namespace ct
 		SAFE_RELEASE(microcode);
 		return bytecode;
 	}
+
+	String D3D11HLSLProgramFactory::getCompilerVersion() const
+	{
+		return "d3dcompiler_" + toString(D3D_COMPILER_VERSION);
+	}
 }}
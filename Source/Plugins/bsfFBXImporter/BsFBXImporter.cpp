@@ -126,7 +126,13 @@ namespace bs
 		if (meshImportOptions->getCPUCached())
 			desc.usage |= MU_CPUCACHED;
 
-		SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->getData(), desc);
+		SPtr<MeshData> meshData = rendererMeshData->getData();
+
+		VertexCompression vertexCompression = meshImportOptions->getVertexCompression();
+		if (vertexCompression != VertexCompressionFlag::None)
+			meshData = RendererMeshData::compress(meshData, vertexCompression);
+
+		SPtr<Mesh> mesh = Mesh::_createPtr(meshData, desc);
 
 		const String fileName = filePath.getFilename(false);
 		mesh->setName(fileName);
@@ -148,7 +154,13 @@ namespace bs
 		if (meshImportOptions->getCPUCached())
 			desc.usage |= MU_CPUCACHED;
 
-		SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->getData(), desc);
+		SPtr<MeshData> meshData = rendererMeshData->getData();
+
+		VertexCompression vertexCompression = meshImportOptions->getVertexCompression();
+		if (vertexCompression != VertexCompressionFlag::None)
+			meshData = RendererMeshData::compress(meshData, vertexCompression);
+
+		SPtr<Mesh> mesh = Mesh::_createPtr(meshData, desc);
 
 		const String fileName = filePath.getFilename(false);
 		mesh->setName(fileName);
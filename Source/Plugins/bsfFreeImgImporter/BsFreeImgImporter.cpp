@@ -7,6 +7,7 @@
 #include "Managers/BsTextureManager.h"
 #include "Image/BsTexture.h"
 #include "Importer/BsTextureImportOptions.h"
+#include "Importer/BsImporter.h"
 #include "FileSystem/BsFileSystem.h"
 #include "BsCoreApplication.h"
 #include "CoreThread/BsCoreThread.h"
@@ -16,11 +17,15 @@
 #include "FreeImage.h"
 #include "Utility/BsBitwise.h"
 #include "Renderer/BsRenderer.h"
+#include "Threading/BsTaskScheduler.h"
+#include <atomic>
 
 using namespace std::placeholders;
 
 namespace bs
 {
+	constexpr UINT32 FreeImgImporter::COMPRESSION_STRIP_HEIGHT;
+
 	void FreeImageLoadErrorHandler(FREE_IMAGE_FORMAT fif, const char *message) 
 	{
 		// Callback method as required by FreeImage to report problems
@@ -185,36 +190,151 @@ namespace bs
 		texDesc.format = textureImportOptions->getFormat();
 		texDesc.usage = usage;
 		texDesc.hwGamma = sRGB;
+		texDesc.streaming = textureImportOptions->getStreaming();
 
 		SPtr<Texture> newTexture = Texture::_createPtr(texDesc);
 
+		Vector<SPtr<PixelData>> textureData = generateTextureData(filePath, faceData, newTexture->getProperties());
+
 		UINT32 numFaces = (UINT32)faceData.size();
+		UINT32 numMipLevels = numMips + 1;
 		for (UINT32 i = 0; i < numFaces; i++)
 		{
-			Vector<SPtr<PixelData>> mipLevels;
-			if (numMips > 0)
+			for (UINT32 mip = 0; mip < numMipLevels; ++mip)
 			{
-				MipMapGenOptions mipOptions;
-				mipOptions.isSRGB = sRGB;
+				SPtr<PixelData> dst = textureData[i * numMipLevels + mip];
+				if (dst != nullptr)
+					newTexture->writeData(dst, i, mip);
+			}
+		}
+
+		const String fileName = filePath.getFilename(false);
+		newTexture->setName(fileName);
+
+		return newTexture;
+	}
+
+	Vector<SPtr<PixelData>> FreeImgImporter::generateTextureData(const Path& filePath, 
+		const Vector<SPtr<PixelData>>& faces, const TextureProperties& props)
+	{
+		UINT32 numFaces = (UINT32)faces.size();
+		UINT32 numMips = props.getNumMipmaps() + 1;
+		PixelFormat format = props.getFormat();
+
+		// Only compression is expensive enough to be worth splitting a single image across tasks
+		bool splitIntoStrips = PixelUtil::isCompressed(format) && !PixelUtil::isCompressed(faces[0]->getFormat());
 
-				mipLevels = PixelUtil::genMipmaps(*faceData[i], mipOptions);
+		// Progress is measured in the number of processed pixels
+		UINT64 totalWork = 0;
+		for (UINT32 mip = 0; mip < numMips; mip++)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), 1, mip, width, height, depth);
+
+			totalWork += (UINT64)width * height * numFaces;
+		}
+
+		if (numMips > 1)
+			totalWork += (UINT64)props.getWidth() * props.getHeight() * numFaces;
+
+		std::atomic<UINT64> completedWork{0};
+		auto reportWork = [&filePath, &completedWork, totalWork](UINT64 work)
+		{
+			UINT64 completed = completedWork.fetch_add(work) + work;
+			gImporter().onImportProgress(filePath, (float)((double)completed / totalWork));
+		};
+
+		// Generate mip levels for each face in parallel
+		Vector<Vector<SPtr<PixelData>>> mipLevels(numFaces);
+		Vector<SPtr<Task>> mipTasks(numFaces);
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			if (numMips == 1)
+			{
+				mipLevels[i].push_back(faces[i]);
+				continue;
 			}
-			else
-				mipLevels.push_back(faceData[i]);
 
-			for (UINT32 mip = 0; mip < (UINT32)mipLevels.size(); ++mip)
+			auto generateMips = [&faces, &props, &mipLevels, &reportWork, i]()
+			{
+				MipMapGenOptions mipOptions;
+				mipOptions.isSRGB = props.isHardwareGammaEnabled();
+
+				mipLevels[i] = PixelUtil::genMipmaps(*faces[i], mipOptions);
+				reportWork((UINT64)faces[i]->getWidth() * faces[i]->getHeight());
+			};
+
+			mipTasks[i] = Task::create("Texture mipmap generation", generateMips);
+		}
+
+		// Convert each mip level of a face as soon as the face's mip levels are generated. Compressed mip levels are
+		// split into horizontal strips. Compressed blocks of a strip are stored consecutively, so each strip can be
+		// written directly into its portion of the output buffer.
+		Vector<SPtr<PixelData>> output(numFaces * numMips);
+		Vector<SPtr<Task>> conversionTasks;
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			for (UINT32 mip = 0; mip < numMips; mip++)
 			{
-				SPtr<PixelData> dst = newTexture->getProperties().allocBuffer(0, mip);
+				SPtr<PixelData> dst = props.allocBuffer(i, mip);
+				output[i * numMips + mip] = dst;
+
+				UINT32 width = dst->getWidth();
+				UINT32 height = dst->getHeight();
+				UINT32 stripHeight = splitIntoStrips ? COMPRESSION_STRIP_HEIGHT : height;
+
+				for (UINT32 top = 0; top < height; top += stripHeight)
+				{
+					UINT32 bottom = std::min(top + stripHeight, height);
+
+					auto convert = [&mipLevels, &reportWork, i, mip, dst, width, height, top, bottom]()
+					{
+						// Mipmap generation failed, error was already reported
+						if (mip >= (UINT32)mipLevels[i].size())
+							return;
+
+						const PixelData& src = *mipLevels[i][mip];
+						if (top == 0 && bottom == height)
+							PixelUtil::bulkPixelConversion(src, *dst);
+						else
+						{
+							PixelData srcStrip = src.getSubVolume(PixelVolume(0, top, width, bottom));
+
+							PixelData dstStrip(width, bottom - top, 1, dst->getFormat());
+							dstStrip.setExternalBuffer(dst->getData() + 
+								PixelUtil::getMemorySize(width, top, 1, dst->getFormat()));
 
-				PixelUtil::bulkPixelConversion(*mipLevels[mip], *dst);
-				newTexture->writeData(dst, i, mip);
+							PixelUtil::bulkPixelConversion(srcStrip, dstStrip);
+						}
+
+						reportWork((UINT64)width * (bottom - top));
+					};
+
+					conversionTasks.push_back(Task::create("Texture conversion", convert, TaskPriority::Normal, 
+						mipTasks[i]));
+				}
 			}
 		}
 
-		const String fileName = filePath.getFilename(false);
-		newTexture->setName(fileName);
+		for (auto& task : mipTasks)
+		{
+			if (task != nullptr)
+				TaskScheduler::instance().addTask(task);
+		}
 
-		return newTexture;
+		for (auto& task : conversionTasks)
+			TaskScheduler::instance().addTask(task);
+
+		for (auto& task : conversionTasks)
+			task->wait();
+
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			for (UINT32 mip = (UINT32)mipLevels[i].size(); mip < numMips; mip++)
+				output[i * numMips + mip] = nullptr;
+		}
+
+		return output;
 	}
 
 	SPtr<PixelData> FreeImgImporter::importRawImage(const Path& filePath)
@@ -51,6 +51,26 @@ namespace bs
 		bool generateCubemap(const SPtr<PixelData>& source, CubemapSourceType sourceType, 
 			std::array<SPtr<PixelData>, 6>& output);
 
+		/**
+		 * Generates mip levels for all faces and converts them into the texture format, compressing them if needed. Work
+		 * is split into tasks that run in parallel: one per face for mipmap generation, and one per face and mip level
+		 * for conversion. Large mip levels are compressed in strips by separate tasks. Progress is reported through
+		 * Importer::onImportProgress.
+		 *
+		 * @param[in]	filePath	Path of the file being imported.
+		 * @param[in]	faces		Source data for each face of the texture.
+		 * @param[in]	props		Properties of the texture to generate the data for.
+		 * @return					Data for each face and mip level, with all mip levels of a face stored consecutively.
+		 */
+		Vector<SPtr<PixelData>> generateTextureData(const Path& filePath, const Vector<SPtr<PixelData>>& faces, 
+			const TextureProperties& props);
+
+		/** 
+		 * Number of rows compressed by a single task, when compressing large images. Must be a multiple of the 
+		 * compressed block size.
+		 */
+		static constexpr UINT32 COMPRESSION_STRIP_HEIGHT = 256;
+
 		Vector<String> mExtensions;
 		UnorderedMap<String, int> mExtensionToFID;
 	};
@@ -11,9 +11,187 @@ namespace bs { namespace ct
 			BS_EXCEPT(InvalidParametersException, "Only a single device supported on DX11.");
 	}
 
+	GLCommand& GLCommandBuffer::addCommand(GLCommandType type)
+	{
+		mCommands.emplace_back();
+
+		GLCommand& command = mCommands.back();
+		command.type = type;
+
+		return command;
+	}
+
 	void GLCommandBuffer::queueCommand(const std::function<void()> command)
 	{
-		mCommands.push_back(command);
+		GLCommand& cmd = addCommand(GLCommandType::Custom);
+		cmd.object.idx = (UINT32)mCustomCommands.size();
+
+		mCustomCommands.push_back(command);
+	}
+
+	void GLCommandBuffer::queueSetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
+	{
+		if (mRecordedState.hasGraphicsPipeline && mRecordedState.graphicsPipeline == pipelineState.get())
+			return;
+
+		GLCommand& cmd = addCommand(GLCommandType::SetGraphicsPipeline);
+		cmd.object.idx = (UINT32)mGraphicsPipelines.size();
+
+		mGraphicsPipelines.push_back(pipelineState);
+
+		mRecordedState.graphicsPipeline = pipelineState.get();
+		mRecordedState.hasGraphicsPipeline = true;
+	}
+
+	void GLCommandBuffer::queueSetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
+	{
+		if (mRecordedState.hasComputePipeline && mRecordedState.computePipeline == pipelineState.get())
+			return;
+
+		GLCommand& cmd = addCommand(GLCommandType::SetComputePipeline);
+		cmd.object.idx = (UINT32)mComputePipelines.size();
+
+		mComputePipelines.push_back(pipelineState);
+
+		mRecordedState.computePipeline = pipelineState.get();
+		mRecordedState.hasComputePipeline = true;
+	}
+
+	void GLCommandBuffer::queueSetGpuParams(const SPtr<GpuParams>& gpuParams)
+	{
+		// Note: Not filtering these, as binding depends on the currently bound programs
+		GLCommand& cmd = addCommand(GLCommandType::SetGpuParams);
+		cmd.object.idx = (UINT32)mGpuParams.size();
+
+		mGpuParams.push_back(gpuParams);
+	}
+
+	void GLCommandBuffer::queueSetStencilRef(UINT32 stencilRefValue)
+	{
+		GLCommand& cmd = addCommand(GLCommandType::SetStencilRef);
+		cmd.stencilRef = stencilRefValue;
+	}
+
+	void GLCommandBuffer::queueSetViewport(const Rect2& area)
+	{
+		GLCommand& cmd = addCommand(GLCommandType::SetViewport);
+		cmd.viewport.x = area.x;
+		cmd.viewport.y = area.y;
+		cmd.viewport.width = area.width;
+		cmd.viewport.height = area.height;
+	}
+
+	void GLCommandBuffer::queueSetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
+	{
+		bool redundant = true;
+		for (UINT32 i = 0; i < numBuffers; i++)
+		{
+			const UINT32 slot = index + i;
+			const bool isValid = (mRecordedState.validVertexBuffers & (1U << slot)) != 0;
+
+			if (!isValid || mRecordedState.vertexBuffers[slot] != buffers[i].get())
+			{
+				redundant = false;
+				break;
+			}
+		}
+
+		if (redundant)
+			return;
+
+		GLCommand& cmd = addCommand(GLCommandType::SetVertexBuffers);
+		cmd.vertexBuffers.index = index;
+		cmd.vertexBuffers.first = (UINT32)mVertexBuffers.size();
+		cmd.vertexBuffers.count = numBuffers;
+
+		for (UINT32 i = 0; i < numBuffers; i++)
+		{
+			mVertexBuffers.push_back(buffers[i]);
+
+			mRecordedState.vertexBuffers[index + i] = buffers[i].get();
+			mRecordedState.validVertexBuffers |= 1U << (index + i);
+		}
+	}
+
+	void GLCommandBuffer::queueSetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration)
+	{
+		if (mRecordedState.hasVertexDeclaration && mRecordedState.vertexDeclaration == vertexDeclaration.get())
+			return;
+
+		GLCommand& cmd = addCommand(GLCommandType::SetVertexDeclaration);
+		cmd.object.idx = (UINT32)mVertexDeclarations.size();
+
+		mVertexDeclarations.push_back(vertexDeclaration);
+
+		mRecordedState.vertexDeclaration = vertexDeclaration.get();
+		mRecordedState.hasVertexDeclaration = true;
+	}
+
+	void GLCommandBuffer::queueSetDrawOperation(DrawOperationType op)
+	{
+		if (mRecordedState.hasDrawOperation && mCurrentDrawOperation == op)
+			return;
+
+		GLCommand& cmd = addCommand(GLCommandType::SetDrawOperation);
+		cmd.drawOp = op;
+
+		mCurrentDrawOperation = op;
+		mRecordedState.hasDrawOperation = true;
+	}
+
+	void GLCommandBuffer::queueSetIndexBuffer(const SPtr<IndexBuffer>& buffer)
+	{
+		if (mRecordedState.hasIndexBuffer && mRecordedState.indexBuffer == buffer.get())
+			return;
+
+		GLCommand& cmd = addCommand(GLCommandType::SetIndexBuffer);
+		cmd.object.idx = (UINT32)mIndexBuffers.size();
+
+		mIndexBuffers.push_back(buffer);
+
+		mRecordedState.indexBuffer = buffer.get();
+		mRecordedState.hasIndexBuffer = true;
+	}
+
+	void GLCommandBuffer::queueSetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom)
+	{
+		GLCommand& cmd = addCommand(GLCommandType::SetScissorRect);
+		cmd.scissor.left = left;
+		cmd.scissor.top = top;
+		cmd.scissor.right = right;
+		cmd.scissor.bottom = bottom;
+	}
+
+	void GLCommandBuffer::queueDraw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
+	{
+		GLCommand& cmd = addCommand(GLCommandType::Draw);
+		cmd.draw.vertexOffset = vertexOffset;
+		cmd.draw.vertexCount = vertexCount;
+		cmd.draw.instanceCount = instanceCount;
+	}
+
+	void GLCommandBuffer::queueDrawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset,
+		UINT32 vertexCount, UINT32 instanceCount)
+	{
+		GLCommand& cmd = addCommand(GLCommandType::DrawIndexed);
+		cmd.drawIndexed.startIndex = startIndex;
+		cmd.drawIndexed.indexCount = indexCount;
+		cmd.drawIndexed.vertexOffset = vertexOffset;
+		cmd.drawIndexed.vertexCount = vertexCount;
+		cmd.drawIndexed.instanceCount = instanceCount;
+	}
+
+	void GLCommandBuffer::queueDispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
+	{
+		GLCommand& cmd = addCommand(GLCommandType::DispatchCompute);
+		cmd.dispatch.numGroupsX = numGroupsX;
+		cmd.dispatch.numGroupsY = numGroupsY;
+		cmd.dispatch.numGroupsZ = numGroupsZ;
+	}
+
+	void GLCommandBuffer::invalidateRecordedState()
+	{
+		mRecordedState = RecordedState();
 	}
 
 	void GLCommandBuffer::appendSecondary(const SPtr<GLCommandBuffer>& secondaryBuffer)
@@ -32,8 +210,63 @@ namespace bs { namespace ct
 		}
 #endif
 
+		const UINT32 graphicsPipelineOffset = (UINT32)mGraphicsPipelines.size();
+		const UINT32 computePipelineOffset = (UINT32)mComputePipelines.size();
+		const UINT32 gpuParamsOffset = (UINT32)mGpuParams.size();
+		const UINT32 vertexBufferOffset = (UINT32)mVertexBuffers.size();
+		const UINT32 vertexDeclarationOffset = (UINT32)mVertexDeclarations.size();
+		const UINT32 indexBufferOffset = (UINT32)mIndexBuffers.size();
+		const UINT32 customCommandOffset = (UINT32)mCustomCommands.size();
+
+		mGraphicsPipelines.insert(mGraphicsPipelines.end(),
+			secondaryBuffer->mGraphicsPipelines.begin(), secondaryBuffer->mGraphicsPipelines.end());
+		mComputePipelines.insert(mComputePipelines.end(),
+			secondaryBuffer->mComputePipelines.begin(), secondaryBuffer->mComputePipelines.end());
+		mGpuParams.insert(mGpuParams.end(), secondaryBuffer->mGpuParams.begin(), secondaryBuffer->mGpuParams.end());
+		mVertexBuffers.insert(mVertexBuffers.end(),
+			secondaryBuffer->mVertexBuffers.begin(), secondaryBuffer->mVertexBuffers.end());
+		mVertexDeclarations.insert(mVertexDeclarations.end(),
+			secondaryBuffer->mVertexDeclarations.begin(), secondaryBuffer->mVertexDeclarations.end());
+		mIndexBuffers.insert(mIndexBuffers.end(),
+			secondaryBuffer->mIndexBuffers.begin(), secondaryBuffer->mIndexBuffers.end());
+		mCustomCommands.insert(mCustomCommands.end(),
+			secondaryBuffer->mCustomCommands.begin(), secondaryBuffer->mCustomCommands.end());
+
 		for (auto& entry : secondaryBuffer->mCommands)
+		{
 			mCommands.push_back(entry);
+			GLCommand& cmd = mCommands.back();
+
+			switch(cmd.type)
+			{
+			case GLCommandType::SetGraphicsPipeline:
+				cmd.object.idx += graphicsPipelineOffset;
+				break;
+			case GLCommandType::SetComputePipeline:
+				cmd.object.idx += computePipelineOffset;
+				break;
+			case GLCommandType::SetGpuParams:
+				cmd.object.idx += gpuParamsOffset;
+				break;
+			case GLCommandType::SetVertexBuffers:
+				cmd.vertexBuffers.first += vertexBufferOffset;
+				break;
+			case GLCommandType::SetVertexDeclaration:
+				cmd.object.idx += vertexDeclarationOffset;
+				break;
+			case GLCommandType::SetIndexBuffer:
+				cmd.object.idx += indexBufferOffset;
+				break;
+			case GLCommandType::Custom:
+				cmd.object.idx += customCommandOffset;
+				break;
+			default:
+				break;
+			}
+		}
+
+		// Secondary buffer might have changed any of the state
+		invalidateRecordedState();
 	}
 
 	void GLCommandBuffer::executeCommands()
@@ -46,12 +279,74 @@ namespace bs { namespace ct
 		}
 #endif
 
+		GLRenderAPI& rapi = static_cast<GLRenderAPI&>(RenderAPI::instance());
 		for (auto& entry : mCommands)
-			entry();
+		{
+			switch(entry.type)
+			{
+			case GLCommandType::SetGraphicsPipeline:
+				rapi.executeSetGraphicsPipeline(mGraphicsPipelines[entry.object.idx]);
+				break;
+			case GLCommandType::SetComputePipeline:
+				rapi.executeSetComputePipeline(mComputePipelines[entry.object.idx]);
+				break;
+			case GLCommandType::SetGpuParams:
+				rapi.executeSetGpuParams(mGpuParams[entry.object.idx]);
+				break;
+			case GLCommandType::SetStencilRef:
+				rapi.executeSetStencilRef(entry.stencilRef);
+				break;
+			case GLCommandType::SetViewport:
+				rapi.executeSetViewport(
+					Rect2(entry.viewport.x, entry.viewport.y, entry.viewport.width, entry.viewport.height));
+				break;
+			case GLCommandType::SetVertexBuffers:
+				rapi.executeSetVertexBuffers(entry.vertexBuffers.index, &mVertexBuffers[entry.vertexBuffers.first],
+					entry.vertexBuffers.count);
+				break;
+			case GLCommandType::SetVertexDeclaration:
+				rapi.executeSetVertexDeclaration(mVertexDeclarations[entry.object.idx]);
+				break;
+			case GLCommandType::SetDrawOperation:
+				rapi.executeSetDrawOperation(entry.drawOp);
+				break;
+			case GLCommandType::SetIndexBuffer:
+				rapi.executeSetIndexBuffer(mIndexBuffers[entry.object.idx]);
+				break;
+			case GLCommandType::SetScissorRect:
+				rapi.executeSetScissorRect(entry.scissor.left, entry.scissor.top, entry.scissor.right,
+					entry.scissor.bottom);
+				break;
+			case GLCommandType::Draw:
+				rapi.executeDraw(entry.draw.vertexOffset, entry.draw.vertexCount, entry.draw.instanceCount);
+				break;
+			case GLCommandType::DrawIndexed:
+				rapi.executeDrawIndexed(entry.drawIndexed.startIndex, entry.drawIndexed.indexCount,
+					entry.drawIndexed.vertexOffset, entry.drawIndexed.vertexCount, entry.drawIndexed.instanceCount);
+				break;
+			case GLCommandType::DispatchCompute:
+				rapi.executeDispatchCompute(entry.dispatch.numGroupsX, entry.dispatch.numGroupsY,
+					entry.dispatch.numGroupsZ);
+				break;
+			case GLCommandType::Custom:
+				mCustomCommands[entry.object.idx]();
+				break;
+			}
+		}
 	}
 
 	void GLCommandBuffer::clear()
 	{
+		// Note: Clearing keeps the allocated capacity, so re-recording the buffer doesn't need to allocate
 		mCommands.clear();
+		mGraphicsPipelines.clear();
+		mComputePipelines.clear();
+		mGpuParams.clear();
+		mVertexBuffers.clear();
+		mVertexDeclarations.clear();
+		mIndexBuffers.clear();
+		mCustomCommands.clear();
+
+		invalidateRecordedState();
 	}
-}}
\ No newline at end of file
+}}
@@ -12,9 +12,112 @@ namespace bs { namespace ct
 	 *  @{
 	 */
 
+	/** Types of commands that can be recorded in a GLCommandBuffer. */
+	enum class GLCommandType : UINT32
+	{
+		SetGraphicsPipeline,
+		SetComputePipeline,
+		SetGpuParams,
+		SetStencilRef,
+		SetViewport,
+		SetVertexBuffers,
+		SetVertexDeclaration,
+		SetDrawOperation,
+		SetIndexBuffer,
+		SetScissorRect,
+		Draw,
+		DrawIndexed,
+		DispatchCompute,
+		Custom
+	};
+
+	/**
+	 * Single command recorded in a GLCommandBuffer. Contains only plain data. Any referenced objects are stored in
+	 * separate per-type arrays in the command buffer, and referenced by index.
+	 */
+	struct GLCommand
+	{
+		/** Arguments for commands referencing a single object. */
+		struct ObjectArgs
+		{
+			UINT32 idx;
+		};
+
+		/** Arguments for GLCommandType::SetVertexBuffers. */
+		struct VertexBufferArgs
+		{
+			UINT32 index;
+			UINT32 first;
+			UINT32 count;
+		};
+
+		/** Arguments for GLCommandType::Draw. */
+		struct DrawArgs
+		{
+			UINT32 vertexOffset;
+			UINT32 vertexCount;
+			UINT32 instanceCount;
+		};
+
+		/** Arguments for GLCommandType::DrawIndexed. */
+		struct DrawIndexedArgs
+		{
+			UINT32 startIndex;
+			UINT32 indexCount;
+			UINT32 vertexOffset;
+			UINT32 vertexCount;
+			UINT32 instanceCount;
+		};
+
+		/** Arguments for GLCommandType::DispatchCompute. */
+		struct DispatchArgs
+		{
+			UINT32 numGroupsX;
+			UINT32 numGroupsY;
+			UINT32 numGroupsZ;
+		};
+
+		/** Arguments for GLCommandType::SetViewport. */
+		struct ViewportArgs
+		{
+			float x;
+			float y;
+			float width;
+			float height;
+		};
+
+		/** Arguments for GLCommandType::SetScissorRect. */
+		struct ScissorArgs
+		{
+			UINT32 left;
+			UINT32 top;
+			UINT32 right;
+			UINT32 bottom;
+		};
+
+		GLCommandType type;
+		union
+		{
+			ObjectArgs object;
+			VertexBufferArgs vertexBuffers;
+			DrawArgs draw;
+			DrawIndexedArgs drawIndexed;
+			DispatchArgs dispatch;
+			ViewportArgs viewport;
+			ScissorArgs scissor;
+			UINT32 stencilRef;
+			DrawOperationType drawOp;
+		};
+	};
+
 	/**
 	 * Command buffer implementation for OpenGL, which doesn't support multi-threaded command generation. Instead all
 	 * commands are stored in an internal buffer, and then sent to the actual render API when the buffer is executed.
+	 *
+	 * Common commands are recorded as plain data packets in a linear array which is reused between recordings, so
+	 * recording them doesn't allocate once the buffer has grown to its working size. Redundant state changes (binding
+	 * the same pipeline, vertex buffers, index buffer, vertex declaration or draw operation as the previously recorded
+	 * command) are filtered out during recording. Less common commands are recorded as generic callbacks.
 	 */
 	class GLCommandBuffer : public CommandBuffer
 	{
@@ -22,6 +125,52 @@ namespace bs { namespace ct
 		/** Registers a new command in the command buffer. */
 		void queueCommand(const std::function<void()> command);
 
+		/** Records a GLRenderAPI::setGraphicsPipeline() command. */
+		void queueSetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState);
+
+		/** Records a GLRenderAPI::setComputePipeline() command. */
+		void queueSetComputePipeline(const SPtr<ComputePipelineState>& pipelineState);
+
+		/** Records a GLRenderAPI::setGpuParams() command. */
+		void queueSetGpuParams(const SPtr<GpuParams>& gpuParams);
+
+		/** Records a GLRenderAPI::setStencilRef() command. */
+		void queueSetStencilRef(UINT32 stencilRefValue);
+
+		/** Records a GLRenderAPI::setViewport() command. */
+		void queueSetViewport(const Rect2& area);
+
+		/** Records a GLRenderAPI::setVertexBuffers() command. */
+		void queueSetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers);
+
+		/** Records a GLRenderAPI::setVertexDeclaration() command. */
+		void queueSetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration);
+
+		/** Records a GLRenderAPI::setDrawOperation() command. */
+		void queueSetDrawOperation(DrawOperationType op);
+
+		/** Records a GLRenderAPI::setIndexBuffer() command. */
+		void queueSetIndexBuffer(const SPtr<IndexBuffer>& buffer);
+
+		/** Records a GLRenderAPI::setScissorRect() command. */
+		void queueSetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom);
+
+		/** Records a GLRenderAPI::draw() command. */
+		void queueDraw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount);
+
+		/** Records a GLRenderAPI::drawIndexed() command. */
+		void queueDrawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+			UINT32 instanceCount);
+
+		/** Records a GLRenderAPI::dispatchCompute() command. */
+		void queueDispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ);
+
+		/**
+		 * Notifies the command buffer that a previously recorded command might have modified the bound state in a way
+		 * the command buffer doesn't track (e.g. a context switch). Ensures the next state change isn't filtered out.
+		 */
+		void invalidateRecordedState();
+
 		/** Appends all commands from the secondary buffer into this command buffer. */
 		void appendSecondary(const SPtr<GLCommandBuffer>& secondaryBuffer);
 
@@ -35,12 +184,44 @@ namespace bs { namespace ct
 		friend class GLCommandBufferManager;
 		friend class GLRenderAPI;
 
+		/**
+		 * Keeps track of the state set by previously recorded commands, used for filtering out redundant state changes.
+		 * State is only valid if set by a command recorded in this buffer, since the state at the time of execution is
+		 * otherwise unknown.
+		 */
+		struct RecordedState
+		{
+			GraphicsPipelineState* graphicsPipeline = nullptr;
+			ComputePipelineState* computePipeline = nullptr;
+			VertexDeclaration* vertexDeclaration = nullptr;
+			IndexBuffer* indexBuffer = nullptr;
+			std::array<VertexBuffer*, GLRenderAPI::MAX_VB_COUNT> vertexBuffers;
+
+			bool hasGraphicsPipeline = false;
+			bool hasComputePipeline = false;
+			bool hasVertexDeclaration = false;
+			bool hasIndexBuffer = false;
+			bool hasDrawOperation = false;
+			UINT32 validVertexBuffers = 0; // Bitmask of vertex buffer slots that have been set
+		};
+
 		GLCommandBuffer(GpuQueueType type, UINT32 deviceIdx, UINT32 queueIdx, bool secondary);
 
-		Vector<std::function<void()>> mCommands;
+		/** Registers a command of the specified type and returns it so its arguments can be filled in. */
+		GLCommand& addCommand(GLCommandType type);
+
+		Vector<GLCommand> mCommands;
+		Vector<SPtr<GraphicsPipelineState>> mGraphicsPipelines;
+		Vector<SPtr<ComputePipelineState>> mComputePipelines;
+		Vector<SPtr<GpuParams>> mGpuParams;
+		Vector<SPtr<VertexBuffer>> mVertexBuffers;
+		Vector<SPtr<VertexDeclaration>> mVertexDeclarations;
+		Vector<SPtr<IndexBuffer>> mIndexBuffers;
+		Vector<std::function<void()>> mCustomCommands;
 
+		RecordedState mRecordedState;
 		DrawOperationType mCurrentDrawOperation;
 	};
 
 	/** @} */
-}}
\ No newline at end of file
+}}
@@ -3,6 +3,8 @@
 #include "BsGLGpuParamBlockBuffer.h"
 #include "Profiling/BsRenderStats.h"
 #include "Error/BsException.h"
+#include "BsGLHardwareBufferManager.h"
+#include "BsGLTransientUniformBuffer.h"
 
 namespace bs { namespace ct
 {
@@ -14,14 +16,30 @@ namespace bs { namespace ct
 
 	GLGpuParamBlockBuffer::~GLGpuParamBlockBuffer()
 	{
-		glDeleteBuffers(1, &mGLHandle);
-		BS_CHECK_GL_ERROR();
+		if (mGLHandle != 0)
+		{
+			glDeleteBuffers(1, &mGLHandle);
+			BS_CHECK_GL_ERROR();
+		}
 
 		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuParamBuffer);
 	}
 
 	void GLGpuParamBlockBuffer::initialize()
 	{
+		// Transient buffers are sub-allocated from a shared buffer, and only get their own buffer object as a fallback
+		if (mUsage != GPBU_TRANSIENT)
+			createGLBuffer();
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuParamBuffer);
+		GpuParamBlockBuffer::initialize();
+	}
+
+	void GLGpuParamBlockBuffer::createGLBuffer()
+	{
+		if (mGLHandle != 0)
+			return;
+
 		glGenBuffers(1, &mGLHandle);
 		BS_CHECK_GL_ERROR();
 
@@ -33,7 +51,7 @@ namespace bs { namespace ct
 			glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, GL_STATIC_DRAW);
 			BS_CHECK_GL_ERROR();
 		}
-		else if (mUsage == GPBU_DYNAMIC)
+		else if (mUsage == GPBU_DYNAMIC || mUsage == GPBU_TRANSIENT)
 		{
 			glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, GL_DYNAMIC_DRAW);
 			BS_CHECK_GL_ERROR();
@@ -43,13 +61,26 @@ namespace bs { namespace ct
 
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 		BS_CHECK_GL_ERROR();
-
-		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuParamBuffer);
-		GpuParamBlockBuffer::initialize();
 	}
 
 	void GLGpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
 	{
+		if (mUsage == GPBU_TRANSIENT)
+		{
+			GLHardwareBufferManager& hwbm = static_cast<GLHardwareBufferManager&>(HardwareBufferManager::instance());
+			GLTransientUniformBuffer* transientBuffer = hwbm.getTransientUniformBuffer();
+
+			if (transientBuffer->write(data, mSize, mTransientOffset))
+			{
+				mTransientFrameIdx = transientBuffer->getFrameIdx();
+				return;
+			}
+
+			// Out of transient memory for this frame, fall back to a dedicated buffer
+			mTransientFrameIdx = (UINT64)-1;
+			createGLBuffer();
+		}
+
 		glBindBuffer(GL_UNIFORM_BUFFER, mGLHandle);
 		BS_CHECK_GL_ERROR();
 
@@ -61,4 +92,28 @@ namespace bs { namespace ct
 
 		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
 	}
+
+	void GLGpuParamBlockBuffer::bind(UINT32 unit)
+	{
+		if (mUsage == GPBU_TRANSIENT)
+		{
+			GLHardwareBufferManager& hwbm = static_cast<GLHardwareBufferManager&>(HardwareBufferManager::instance());
+			GLTransientUniformBuffer* transientBuffer = hwbm.getTransientUniformBuffer();
+
+			// Contents are only valid for the frame they were written in
+			if (mTransientFrameIdx != transientBuffer->getFrameIdx())
+				writeToGPU(mCachedData);
+
+			if (mTransientFrameIdx == transientBuffer->getFrameIdx())
+			{
+				glBindBufferRange(GL_UNIFORM_BUFFER, unit, transientBuffer->getGLHandle(), mTransientOffset, mSize);
+				BS_CHECK_GL_ERROR();
+
+				return;
+			}
+		}
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, unit, mGLHandle);
+		BS_CHECK_GL_ERROR();
+	}
 }}
\ No newline at end of file
@@ -23,12 +23,24 @@ namespace bs { namespace ct
 
 		/**	Returns internal OpenGL uniform buffer handle. */
 		GLuint getGLHandle() const { return mGLHandle; }
+
+		/** 
+		 * Binds the buffer to the specified uniform buffer binding point. Transient buffers are bound as a range of
+		 * the shared transient buffer, and their contents are re-uploaded if they were last written in an earlier frame.
+		 */
+		void bind(UINT32 unit);
 	protected:
 		/** @copydoc GpuParamBlockBuffer::initialize */
 		void initialize() override ;
 
 	private:
+		/** Creates the dedicated OpenGL buffer object, if not already created. */
+		void createGLBuffer();
+
 		GLuint mGLHandle;
+
+		UINT32 mTransientOffset = 0;
+		UINT64 mTransientFrameIdx = (UINT64)-1;
 	};
 
 	/** @} */
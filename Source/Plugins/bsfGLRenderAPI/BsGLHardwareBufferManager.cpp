@@ -6,11 +6,33 @@
 #include "BsGLGpuBuffer.h"
 #include "RenderAPI/BsHardwareBuffer.h"
 #include "BsGLGpuParamBlockBuffer.h"
+#include "BsGLTransientUniformBuffer.h"
 #include "RenderAPI/BsRenderAPI.h"
 #include "RenderAPI/BsRenderAPICapabilities.h"
 
 namespace bs { namespace ct
 {
+	GLHardwareBufferManager::~GLHardwareBufferManager()
+	{
+		if (mTransientUniformBuffer != nullptr)
+			bs_delete(mTransientUniformBuffer);
+	}
+
+	GLTransientUniformBuffer* GLHardwareBufferManager::getTransientUniformBuffer()
+	{
+		if (mTransientUniformBuffer == nullptr)
+			mTransientUniformBuffer = bs_new<GLTransientUniformBuffer>(GLTransientUniformBuffer::DEFAULT_FRAME_SIZE);
+
+		return mTransientUniformBuffer;
+	}
+
+	void GLHardwareBufferManager::_endFrame()
+	{
+		// Transient allocations are only valid for a single frame
+		if (mTransientUniformBuffer != nullptr)
+			mTransientUniformBuffer->advanceFrame();
+	}
+
 	SPtr<VertexBuffer> GLHardwareBufferManager::createVertexBufferInternal(const VERTEX_BUFFER_DESC& desc, 
 		GpuDeviceFlags deviceMask)
 	{
@@ -72,6 +94,8 @@ namespace bs { namespace ct
 			case VET_FLOAT3:
 			case VET_FLOAT4:
 				return GL_FLOAT;
+			case VET_HALF2:
+				return GL_HALF_FLOAT;
 			case VET_SHORT1:
 			case VET_SHORT2:
 			case VET_SHORT4:
@@ -79,6 +103,7 @@ namespace bs { namespace ct
 			case VET_USHORT1:
 			case VET_USHORT2:
 			case VET_USHORT4:
+			case VET_USHORT4_NORM:
 				return GL_UNSIGNED_SHORT;
 			case VET_INT1:
 			case VET_INT2:
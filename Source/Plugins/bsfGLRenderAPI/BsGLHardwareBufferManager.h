@@ -15,6 +15,17 @@ namespace bs { namespace ct
 	class GLHardwareBufferManager : public HardwareBufferManager
 	{
 	public:
+		~GLHardwareBufferManager();
+
+		/** 
+		 * Returns the buffer used for sub-allocating transient GPU parameter block buffers. Created on first use.
+		 * Returns null if transient sub-allocation is not supported.
+		 */
+		GLTransientUniformBuffer* getTransientUniformBuffer();
+
+		/** @copydoc HardwareBufferManager::_endFrame */
+		void _endFrame() override;
+
 		/**	Converts engine buffer usage flags into OpenGL specific flags. */
 		static GLenum getGLUsage(GpuBufferUsage usage);
 
@@ -37,6 +48,8 @@ namespace bs { namespace ct
 		/** @copydoc HardwareBufferManager::createGpuBufferInternal */
 		SPtr<GpuBuffer> createGpuBufferInternal(const GPU_BUFFER_DESC& desc, 
 			GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		GLTransientUniformBuffer* mTransientUniformBuffer = nullptr;
 	};
 
 	/** @} */
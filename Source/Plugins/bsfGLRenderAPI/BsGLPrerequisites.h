@@ -95,7 +95,9 @@ namespace bs { namespace ct
 	class GLVertexArrayObject;
 	struct GLSLProgramPipeline;
 	class GLSLProgramPipelineManager;
+	class GLSLProgramBinaryCache;
 	class GLTextureView;
+	class GLTransientUniformBuffer;
 
 	/** @addtogroup GL
 	 *  @{
@@ -15,13 +15,16 @@
 #include "BsGLRenderTexture.h"
 #include "BsGLRenderWindowManager.h"
 #include "GLSL/BsGLSLProgramPipelineManager.h"
+#include "GLSL/BsGLSLProgramBinaryCache.h"
 #include "BsGLVertexArrayObjectManager.h"
 #include "Managers/BsRenderStateManager.h"
 #include "RenderAPI/BsGpuParams.h"
 #include "BsGLGpuParamBlockBuffer.h"
+#include "BsGLHardwareBufferManager.h"
 #include "CoreThread/BsCoreThread.h"
 #include "BsGLQueryManager.h"
 #include "Debug/BsDebug.h"
+#include "BsCoreApplication.h"
 #include "Profiling/BsRenderStats.h"
 #include "RenderAPI/BsGpuParamDesc.h"
 #include "BsGLGpuBuffer.h"
@@ -167,6 +170,18 @@ namespace bs { namespace ct
 		initFromCaps(mCurrentCapabilities);
 		GLVertexArrayObjectManager::startUp();
 
+		// Linked program binaries are stored next to the bytecode cache of other backends, and disabled along with it
+		const Path& bytecodeCache = CoreApplication::instance().getStartUpDesc().bytecodeCache;
+		if (!bytecodeCache.isEmpty())
+		{
+			mProgramBinaryCache = bs_new<GLSLProgramBinaryCache>(bytecodeCache + "GLProgramBinaries/");
+			if (!mProgramBinaryCache->isSupported())
+			{
+				bs_delete(mProgramBinaryCache);
+				mProgramBinaryCache = nullptr;
+			}
+		}
+
 		glFrontFace(GL_CW);
 		BS_CHECK_GL_ERROR();
 
@@ -242,6 +257,12 @@ namespace bs { namespace ct
 		if(mProgramPipelineManager != nullptr)
 			bs_delete(mProgramPipelineManager);
 
+		if(mProgramBinaryCache != nullptr)
+		{
+			bs_delete(mProgramBinaryCache);
+			mProgramBinaryCache = nullptr;
+		}
+
 		if(mCurrentContext)
 			mCurrentContext->endCurrent();
 
@@ -258,711 +279,700 @@ namespace bs { namespace ct
 	void GLRenderAPI::setGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState,
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const SPtr<GraphicsPipelineState>& pipelineState)
+		if (commandBuffer == nullptr)
+			executeSetGraphicsPipeline(pipelineState);
+		else
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			BlendState* blendState;
-			RasterizerState* rasterizerState;
-			DepthStencilState* depthStencilState;
-			if (pipelineState != nullptr)
-			{
-				mCurrentVertexProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getVertexProgram());
-				mCurrentFragmentProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getFragmentProgram());
-				mCurrentGeometryProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getGeometryProgram());
-				mCurrentDomainProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getDomainProgram());
-				mCurrentHullProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getHullProgram());
+			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
+			cb->queueSetGraphicsPipeline(pipelineState);
+		}
 
-				blendState = pipelineState->getBlendState().get();
-				rasterizerState = pipelineState->getRasterizerState().get();
-				depthStencilState = pipelineState->getDepthStencilState().get();
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
 
-				if (blendState == nullptr)
-					blendState = BlendState::getDefault().get();
+	void GLRenderAPI::executeSetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState)
+	{
+		THROW_IF_NOT_CORE_THREAD;
 
-				if (rasterizerState == nullptr)
-					rasterizerState = RasterizerState::getDefault().get();
+		BlendState* blendState;
+		RasterizerState* rasterizerState;
+		DepthStencilState* depthStencilState;
+		if (pipelineState != nullptr)
+		{
+			mCurrentVertexProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getVertexProgram());
+			mCurrentFragmentProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getFragmentProgram());
+			mCurrentGeometryProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getGeometryProgram());
+			mCurrentDomainProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getDomainProgram());
+			mCurrentHullProgram = std::static_pointer_cast<GLSLGpuProgram>(pipelineState->getHullProgram());
 
-				if(depthStencilState == nullptr)
-					depthStencilState = DepthStencilState::getDefault().get();
-			}
-			else
-			{
-				mCurrentVertexProgram = nullptr;
-				mCurrentFragmentProgram = nullptr;
-				mCurrentGeometryProgram = nullptr;
-				mCurrentDomainProgram = nullptr;
-				mCurrentHullProgram = nullptr;
+			blendState = pipelineState->getBlendState().get();
+			rasterizerState = pipelineState->getRasterizerState().get();
+			depthStencilState = pipelineState->getDepthStencilState().get();
 
+			if (blendState == nullptr)
 				blendState = BlendState::getDefault().get();
+
+			if (rasterizerState == nullptr)
 				rasterizerState = RasterizerState::getDefault().get();
+
+			if(depthStencilState == nullptr)
 				depthStencilState = DepthStencilState::getDefault().get();
-			}
+		}
+		else
+		{
+			mCurrentVertexProgram = nullptr;
+			mCurrentFragmentProgram = nullptr;
+			mCurrentGeometryProgram = nullptr;
+			mCurrentDomainProgram = nullptr;
+			mCurrentHullProgram = nullptr;
 
-			// Blend state
-			{
-				const BlendProperties& stateProps = blendState->getProperties();
+			blendState = BlendState::getDefault().get();
+			rasterizerState = RasterizerState::getDefault().get();
+			depthStencilState = DepthStencilState::getDefault().get();
+		}
 
-				// Alpha to coverage
-				setAlphaToCoverage(stateProps.getAlphaToCoverageEnabled());
+		// Blend state
+		{
+			const BlendProperties& stateProps = blendState->getProperties();
 
-				// Blend states
-				// OpenGL doesn't allow us to specify blend state per render target, so we just use the first one.
-				if (stateProps.getBlendEnabled(0))
-				{
-					setSceneBlending(stateProps.getSrcBlend(0), stateProps.getDstBlend(0), stateProps.getAlphaSrcBlend(0),
-						stateProps.getAlphaDstBlend(0), stateProps.getBlendOperation(0), stateProps.getAlphaBlendOperation(0));
-				}
-				else
-				{
-					setSceneBlending(BF_ONE, BF_ZERO, BO_ADD);
-				}
+			// Alpha to coverage
+			setAlphaToCoverage(stateProps.getAlphaToCoverageEnabled());
 
-				// Color write mask
-				UINT8 writeMask = stateProps.getRenderTargetWriteMask(0);
-				setColorBufferWriteEnabled((writeMask & 0x1) != 0, (writeMask & 0x2) != 0, (writeMask & 0x4) != 0, (writeMask & 0x8) != 0);
+			// Blend states
+			// OpenGL doesn't allow us to specify blend state per render target, so we just use the first one.
+			if (stateProps.getBlendEnabled(0))
+			{
+				setSceneBlending(stateProps.getSrcBlend(0), stateProps.getDstBlend(0), stateProps.getAlphaSrcBlend(0),
+					stateProps.getAlphaDstBlend(0), stateProps.getBlendOperation(0), stateProps.getAlphaBlendOperation(0));
 			}
-
-			// Rasterizer state
+			else
 			{
-				const RasterizerProperties& stateProps = rasterizerState->getProperties();
-
-				setDepthBias(stateProps.getDepthBias(), stateProps.getSlopeScaledDepthBias());
-				setCullingMode(stateProps.getCullMode());
-				setPolygonMode(stateProps.getPolygonMode());
-				setScissorTestEnable(stateProps.getScissorEnable());
-				setMultisamplingEnable(stateProps.getMultisampleEnable());
-				setDepthClipEnable(stateProps.getDepthClipEnable());
-				setAntialiasedLineEnable(stateProps.getAntialiasedLineEnable());
+				setSceneBlending(BF_ONE, BF_ZERO, BO_ADD);
 			}
 
-			// Depth stencil state
-			{
-				const DepthStencilProperties& stateProps = depthStencilState->getProperties();
+			// Color write mask
+			UINT8 writeMask = stateProps.getRenderTargetWriteMask(0);
+			setColorBufferWriteEnabled((writeMask & 0x1) != 0, (writeMask & 0x2) != 0, (writeMask & 0x4) != 0, (writeMask & 0x8) != 0);
+		}
 
-				// Set stencil buffer options
-				setStencilCheckEnabled(stateProps.getStencilEnable());
+		// Rasterizer state
+		{
+			const RasterizerProperties& stateProps = rasterizerState->getProperties();
 
-				setStencilBufferOperations(stateProps.getStencilFrontFailOp(), stateProps.getStencilFrontZFailOp(), 
-					stateProps.getStencilFrontPassOp(), true);
-				setStencilBufferFunc(stateProps.getStencilFrontCompFunc(), stateProps.getStencilReadMask(), true);
+			setDepthBias(stateProps.getDepthBias(), stateProps.getSlopeScaledDepthBias());
+			setCullingMode(stateProps.getCullMode());
+			setPolygonMode(stateProps.getPolygonMode());
+			setScissorTestEnable(stateProps.getScissorEnable());
+			setMultisamplingEnable(stateProps.getMultisampleEnable());
+			setDepthClipEnable(stateProps.getDepthClipEnable());
+			setAntialiasedLineEnable(stateProps.getAntialiasedLineEnable());
+		}
 
-				setStencilBufferOperations(stateProps.getStencilBackFailOp(), stateProps.getStencilBackZFailOp(), 
-					stateProps.getStencilBackPassOp(), false);
-				setStencilBufferFunc(stateProps.getStencilBackCompFunc(), stateProps.getStencilReadMask(), false);
+		// Depth stencil state
+		{
+			const DepthStencilProperties& stateProps = depthStencilState->getProperties();
 
-				setStencilBufferWriteMask(stateProps.getStencilWriteMask());
+			// Set stencil buffer options
+			setStencilCheckEnabled(stateProps.getStencilEnable());
 
-				// Set depth buffer options
-				setDepthBufferCheckEnabled(stateProps.getDepthReadEnable());
-				setDepthBufferWriteEnabled(stateProps.getDepthWriteEnable());
-				setDepthBufferFunction(stateProps.getDepthComparisonFunc());
-			}
-		};
+			setStencilBufferOperations(stateProps.getStencilFrontFailOp(), stateProps.getStencilFrontZFailOp(), 
+				stateProps.getStencilFrontPassOp(), true);
+			setStencilBufferFunc(stateProps.getStencilFrontCompFunc(), stateProps.getStencilReadMask(), true);
+
+			setStencilBufferOperations(stateProps.getStencilBackFailOp(), stateProps.getStencilBackZFailOp(), 
+				stateProps.getStencilBackPassOp(), false);
+			setStencilBufferFunc(stateProps.getStencilBackCompFunc(), stateProps.getStencilReadMask(), false);
+
+			setStencilBufferWriteMask(stateProps.getStencilWriteMask());
+
+			// Set depth buffer options
+			setDepthBufferCheckEnabled(stateProps.getDepthReadEnable());
+			setDepthBufferWriteEnabled(stateProps.getDepthWriteEnable());
+			setDepthBufferFunction(stateProps.getDepthComparisonFunc());
+		}
+	}
 
+	void GLRenderAPI::setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(pipelineState);
+			executeSetComputePipeline(pipelineState);
 		else
 		{
-			auto execute = [=]() { executeRef(pipelineState); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetComputePipeline(pipelineState);
 		}
 
 		BS_INC_RENDER_STAT(NumPipelineStateChanges);
 	}
 
-	void GLRenderAPI::setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
-		const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeSetComputePipeline(const SPtr<ComputePipelineState>& pipelineState)
 	{
-		auto executeRef = [&](const SPtr<ComputePipelineState>& pipelineState)
-		{
-			THROW_IF_NOT_CORE_THREAD;
+		THROW_IF_NOT_CORE_THREAD;
 
-			SPtr<GpuProgram> program;
-			if (pipelineState != nullptr)
-				program = pipelineState->getProgram();
+		SPtr<GpuProgram> program;
+		if (pipelineState != nullptr)
+			program = pipelineState->getProgram();
 
-			if (program != nullptr && program->getType() == GPT_COMPUTE_PROGRAM)
-				mCurrentComputeProgram = std::static_pointer_cast<GLSLGpuProgram>(program);
-			else
-				mCurrentComputeProgram = nullptr;
-		};
+		if (program != nullptr && program->getType() == GPT_COMPUTE_PROGRAM)
+			mCurrentComputeProgram = std::static_pointer_cast<GLSLGpuProgram>(program);
+		else
+			mCurrentComputeProgram = nullptr;
+	}
 
+	void GLRenderAPI::setGpuParams(const SPtr<GpuParams>& gpuParams, const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(pipelineState);
+			executeSetGpuParams(gpuParams);
 		else
 		{
-			auto execute = [=]() { executeRef(pipelineState); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetGpuParams(gpuParams);
 		}
 
-		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+		BS_INC_RENDER_STAT(NumGpuParamBinds);
 	}
 
-	void GLRenderAPI::setGpuParams(const SPtr<GpuParams>& gpuParams, const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeSetGpuParams(const SPtr<GpuParams>& gpuParams)
 	{
-		auto executeRef = [&](const SPtr<GpuParams>& gpuParams)
-		{
-			THROW_IF_NOT_CORE_THREAD;
+		THROW_IF_NOT_CORE_THREAD;
 
 #if BS_OPENGL_4_2 || BS_OPENGLES_3_1
-			for (UINT32 i = 0; i < 8; i++)
-			{
-				glBindImageTexture(i, 0, 0, false, 0, GL_READ_WRITE, GL_R32F);
-				BS_CHECK_GL_ERROR();
-			}
+		for (UINT32 i = 0; i < 8; i++)
+		{
+			glBindImageTexture(i, 0, 0, false, 0, GL_READ_WRITE, GL_R32F);
+			BS_CHECK_GL_ERROR();
+		}
 #endif
 
-			bs_frame_mark();
-			{
-				FrameVector<UINT32> textureUnits;
-				textureUnits.reserve(12);
+		bs_frame_mark();
+		{
+			FrameVector<UINT32> textureUnits;
+			textureUnits.reserve(12);
 
-				auto getTexUnit = [&](UINT32 binding)
+			auto getTexUnit = [&](UINT32 binding)
+			{
+				for(UINT32 i = 0; i < (UINT32)textureUnits.size(); i++)
 				{
-					for(UINT32 i = 0; i < (UINT32)textureUnits.size(); i++)
-					{
-						if (textureUnits[i] == binding)
-							return i;
-					}
+					if (textureUnits[i] == binding)
+						return i;
+				}
 
-					UINT32 unit = (UINT32)textureUnits.size();
-					textureUnits.push_back(binding);
+				UINT32 unit = (UINT32)textureUnits.size();
+				textureUnits.push_back(binding);
 
-					return unit;
-				};
+				return unit;
+			};
 
 #if BS_OPENGL_4_2 || BS_OPENGLES_3_1
-				UINT32 imageUnitCount = 0;
-				auto getImageUnit = [&](UINT32 binding)
-				{
-					return imageUnitCount++;
-				};
+			UINT32 imageUnitCount = 0;
+			auto getImageUnit = [&](UINT32 binding)
+			{
+				return imageUnitCount++;
+			};
 #endif
 
-				UINT32 uniformUnitCount = 0;
-				auto getUniformUnit = [&](UINT32 binding)
-				{
-					return uniformUnitCount++;
-				};
+			UINT32 uniformUnitCount = 0;
+			auto getUniformUnit = [&](UINT32 binding)
+			{
+				return uniformUnitCount++;
+			};
 
 #if BS_OPENGL_4_3 || BS_OPENGLES_3_1
-				UINT32 sharedStorageUnitCount = 0;
-				auto getSharedStorageUnit = [&](UINT32 binding)
-				{
-					return sharedStorageUnitCount++;
-				};
+			UINT32 sharedStorageUnitCount = 0;
+			auto getSharedStorageUnit = [&](UINT32 binding)
+			{
+				return sharedStorageUnitCount++;
+			};
 #endif
 
-				const UINT32 numStages = 6;
-				for(UINT32 i = 0; i < numStages; i++)
-				{
-					for(auto& entry : textureUnits)
-						entry = (UINT32)-1;
+			const UINT32 numStages = 6;
+			for(UINT32 i = 0; i < numStages; i++)
+			{
+				for(auto& entry : textureUnits)
+					entry = (UINT32)-1;
 
-					GpuProgramType type = (GpuProgramType)i;
+				GpuProgramType type = (GpuProgramType)i;
 
-					SPtr<GpuParamDesc> paramDesc = gpuParams->getParamDesc(type);
-					if (paramDesc == nullptr)
-						continue;
+				SPtr<GpuParamDesc> paramDesc = gpuParams->getParamDesc(type);
+				if (paramDesc == nullptr)
+					continue;
 
-					for (auto& entry : paramDesc->textures)
-					{
-						UINT32 binding = entry.second.slot;
-						SPtr<Texture> texture = gpuParams->getTexture(entry.second.set, binding);
-						const TextureSurface& surface = gpuParams->getTextureSurface(entry.second.set, binding);
+				for (auto& entry : paramDesc->textures)
+				{
+					UINT32 binding = entry.second.slot;
+					SPtr<Texture> texture = gpuParams->getTexture(entry.second.set, binding);
+					const TextureSurface& surface = gpuParams->getTextureSurface(entry.second.set, binding);
 
-						UINT32 unit = getTexUnit(binding);
-						if (!activateGLTextureUnit(unit))
-							continue;
+					UINT32 unit = getTexUnit(binding);
+					if (!activateGLTextureUnit(unit))
+						continue;
 
-						TextureInfo& texInfo = mTextureInfos[unit];
+					TextureInfo& texInfo = mTextureInfos[unit];
 
-						GLTexture* glTex = static_cast<GLTexture*>(texture.get());
-						GLenum newTextureType;
-						GLuint texId;
-						if (glTex != nullptr)
-						{
+					GLTexture* glTex = static_cast<GLTexture*>(texture.get());
+					GLenum newTextureType;
+					GLuint texId;
+					if (glTex != nullptr)
+					{
 #if BS_OPENGL_4_3 || BS_OPENGLES_3_1 
-							SPtr<TextureView> texView = glTex->requestView(
-								surface.mipLevel,
-								surface.numMipLevels,
-								surface.face,
-								surface.numFaces,
-								GVU_DEFAULT);
+						SPtr<TextureView> texView = glTex->requestView(
+							surface.mipLevel,
+							surface.numMipLevels,
+							surface.face,
+							surface.numFaces,
+							GVU_DEFAULT);
 
-							GLTextureView* glTexView = static_cast<GLTextureView*>(texView.get());
+						GLTextureView* glTexView = static_cast<GLTextureView*>(texView.get());
 
-							newTextureType = glTexView->getGLTextureTarget();
-							texId = glTexView->getGLID();
+						newTextureType = glTexView->getGLTextureTarget();
+						texId = glTexView->getGLID();
 #else
-							// Texture views are not supported, so if user requested a part of the texture surface report
-							// a warning
-							auto& props = texture->getProperties();
-							if (surface.mipLevel != 0 || surface.face != 0 ||
-								(surface.numMipLevels != 0 && surface.numMipLevels != props.getNumMipmaps()) ||
-								(surface.numFaces != 0 && surface.numFaces != props.getNumFaces()))
-							{
-								LOGWRN("Attempting to bind only a part of a texture, but texture views are not supported. "
-									"Entire texture will be bound instead.");
-							}
-
-							newTextureType = glTex->getGLTextureTarget();
-							texId = glTex->getGLID();
-#endif
-						}
-						else
+						// Texture views are not supported, so if user requested a part of the texture surface report
+						// a warning
+						auto& props = texture->getProperties();
+						if (surface.mipLevel != 0 || surface.face != 0 ||
+							(surface.numMipLevels != 0 && surface.numMipLevels != props.getNumMipmaps()) ||
+							(surface.numFaces != 0 && surface.numFaces != props.getNumFaces()))
 						{
-
-							newTextureType = GLTexture::getGLTextureTarget(entry.second.type);
-							texId = 0;
+							LOGWRN("Attempting to bind only a part of a texture, but texture views are not supported. "
+								"Entire texture will be bound instead.");
 						}
 
-						if (texInfo.type != newTextureType)
-						{
-							glBindTexture(texInfo.type, 0);
-							BS_CHECK_GL_ERROR();
-						}
+						newTextureType = glTex->getGLTextureTarget();
+						texId = glTex->getGLID();
+#endif
+					}
+					else
+					{
+
+						newTextureType = GLTexture::getGLTextureTarget(entry.second.type);
+						texId = 0;
+					}
 
-						glBindTexture(newTextureType, texId);
+					if (texInfo.type != newTextureType)
+					{
+						glBindTexture(texInfo.type, 0);
 						BS_CHECK_GL_ERROR();
+					}
 
-						texInfo.type = newTextureType;
+					glBindTexture(newTextureType, texId);
+					BS_CHECK_GL_ERROR();
 
-						SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
-						if (activeProgram != nullptr)
-						{
-							GLuint glProgram = activeProgram->getGLHandle();
+					texInfo.type = newTextureType;
 
-							glProgramUniform1i(glProgram, binding, unit);
-							BS_CHECK_GL_ERROR();
-						}
+					SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
+					if (activeProgram != nullptr)
+					{
+						GLuint glProgram = activeProgram->getGLHandle();
+
+						glProgramUniform1i(glProgram, binding, unit);
+						BS_CHECK_GL_ERROR();
 					}
+				}
 
-					for(auto& entry : paramDesc->samplers)
-					{
-						UINT32 binding = entry.second.slot;
-						SPtr<SamplerState> samplerState = gpuParams->getSamplerState(entry.second.set, binding);
+				for(auto& entry : paramDesc->samplers)
+				{
+					UINT32 binding = entry.second.slot;
+					SPtr<SamplerState> samplerState = gpuParams->getSamplerState(entry.second.set, binding);
 
-						if (samplerState == nullptr)
-							samplerState = SamplerState::getDefault();
+					if (samplerState == nullptr)
+						samplerState = SamplerState::getDefault();
 
-						UINT32 unit = getTexUnit(binding);
-						if (!activateGLTextureUnit(unit))
-							continue;
+					UINT32 unit = getTexUnit(binding);
+					if (!activateGLTextureUnit(unit))
+						continue;
 
-						// No sampler options for multisampled textures or buffers
-						bool supportsSampler = mTextureInfos[unit].type != GL_TEXTURE_2D_MULTISAMPLE &&
-							mTextureInfos[unit].type != GL_TEXTURE_2D_MULTISAMPLE_ARRAY &&
-							mTextureInfos[unit].type != GL_TEXTURE_BUFFER;
+					// No sampler options for multisampled textures or buffers
+					bool supportsSampler = mTextureInfos[unit].type != GL_TEXTURE_2D_MULTISAMPLE &&
+						mTextureInfos[unit].type != GL_TEXTURE_2D_MULTISAMPLE_ARRAY &&
+						mTextureInfos[unit].type != GL_TEXTURE_BUFFER;
 
-						if (supportsSampler)
-						{
-							const SamplerProperties& stateProps = samplerState->getProperties();
+					if (supportsSampler)
+					{
+						const SamplerProperties& stateProps = samplerState->getProperties();
 
-							setTextureFiltering(unit, FT_MIN, stateProps.getTextureFiltering(FT_MIN));
-							setTextureFiltering(unit, FT_MAG, stateProps.getTextureFiltering(FT_MAG));
-							setTextureFiltering(unit, FT_MIP, stateProps.getTextureFiltering(FT_MIP));
+						setTextureFiltering(unit, FT_MIN, stateProps.getTextureFiltering(FT_MIN));
+						setTextureFiltering(unit, FT_MAG, stateProps.getTextureFiltering(FT_MAG));
+						setTextureFiltering(unit, FT_MIP, stateProps.getTextureFiltering(FT_MIP));
 
-							setTextureAnisotropy(unit, stateProps.getTextureAnisotropy());
-							setTextureCompareMode(unit, stateProps.getComparisonFunction());
+						setTextureAnisotropy(unit, stateProps.getTextureAnisotropy());
+						setTextureCompareMode(unit, stateProps.getComparisonFunction());
 
-							setTextureMipmapBias(unit, stateProps.getTextureMipmapBias());
-							setTextureMipmapRange(unit, stateProps.getMinimumMip(), stateProps.getMaximumMip());
+						setTextureMipmapBias(unit, stateProps.getTextureMipmapBias());
+						setTextureMipmapRange(unit, stateProps.getMinimumMip(), stateProps.getMaximumMip());
 
-							const UVWAddressingMode& uvw = stateProps.getTextureAddressingMode();
-							setTextureAddressingMode(unit, uvw);
+						const UVWAddressingMode& uvw = stateProps.getTextureAddressingMode();
+						setTextureAddressingMode(unit, uvw);
 
-							setTextureBorderColor(unit, stateProps.getBorderColor());
-						}
+						setTextureBorderColor(unit, stateProps.getBorderColor());
 					}
+				}
 
-					for(auto& entry : paramDesc->buffers)
-					{
-						UINT32 binding = entry.second.slot;
-						SPtr<GpuBuffer> buffer = gpuParams->getBuffer(entry.second.set, binding);
+				for(auto& entry : paramDesc->buffers)
+				{
+					UINT32 binding = entry.second.slot;
+					SPtr<GpuBuffer> buffer = gpuParams->getBuffer(entry.second.set, binding);
 
-						GLGpuBuffer* glBuffer = static_cast<GLGpuBuffer*>(buffer.get());
+					GLGpuBuffer* glBuffer = static_cast<GLGpuBuffer*>(buffer.get());
 
-						switch(entry.second.type)
+					switch(entry.second.type)
+					{
+					case GPOT_BYTE_BUFFER: // Texture buffer (read-only, unstructured)
 						{
-						case GPOT_BYTE_BUFFER: // Texture buffer (read-only, unstructured)
-							{
-								UINT32 unit = getTexUnit(binding);
-								if (!activateGLTextureUnit(unit))
-									continue;
+							UINT32 unit = getTexUnit(binding);
+							if (!activateGLTextureUnit(unit))
+								continue;
 
-								GLuint texId = 0;
-								if (glBuffer != nullptr)
-									texId = glBuffer->getGLTextureId();
+							GLuint texId = 0;
+							if (glBuffer != nullptr)
+								texId = glBuffer->getGLTextureId();
 
-								if (mTextureInfos[unit].type != GL_TEXTURE_BUFFER)
-								{
-									glBindTexture(mTextureInfos[unit].type, 0);
-									BS_CHECK_GL_ERROR();
-								}
+							if (mTextureInfos[unit].type != GL_TEXTURE_BUFFER)
+							{
+								glBindTexture(mTextureInfos[unit].type, 0);
+								BS_CHECK_GL_ERROR();
+							}
 
-								mTextureInfos[unit].type = GL_TEXTURE_BUFFER;
+							mTextureInfos[unit].type = GL_TEXTURE_BUFFER;
 
-								glBindTexture(GL_TEXTURE_BUFFER, texId);
-								BS_CHECK_GL_ERROR();
+							glBindTexture(GL_TEXTURE_BUFFER, texId);
+							BS_CHECK_GL_ERROR();
 
-								SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
-								if (activeProgram != nullptr)
-								{
-									GLuint glProgram = activeProgram->getGLHandle();
+							SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
+							if (activeProgram != nullptr)
+							{
+								GLuint glProgram = activeProgram->getGLHandle();
 
-									glProgramUniform1i(glProgram, binding, unit);
-									BS_CHECK_GL_ERROR();
-								}
+								glProgramUniform1i(glProgram, binding, unit);
+								BS_CHECK_GL_ERROR();
 							}
-							break;
+						}
+						break;
 #if BS_OPENGL_4_2 || BS_OPENGLES_3_1
-						case GPOT_RWBYTE_BUFFER: // Storage buffer (read/write, unstructured)
-							{
-								UINT32 unit = getImageUnit(binding);
+					case GPOT_RWBYTE_BUFFER: // Storage buffer (read/write, unstructured)
+						{
+							UINT32 unit = getImageUnit(binding);
 
-								GLuint texId = 0;
-								GLuint format = GL_R32F;
-								if (glBuffer != nullptr)
-								{
-									texId = glBuffer->getGLTextureId();
-									format = glBuffer->getGLFormat();
-								}
+							GLuint texId = 0;
+							GLuint format = GL_R32F;
+							if (glBuffer != nullptr)
+							{
+								texId = glBuffer->getGLTextureId();
+								format = glBuffer->getGLFormat();
+							}
 
-								glBindImageTexture(unit, texId, 0, false, 0, GL_READ_WRITE, format);
-								BS_CHECK_GL_ERROR();
+							glBindImageTexture(unit, texId, 0, false, 0, GL_READ_WRITE, format);
+							BS_CHECK_GL_ERROR();
 
-								SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
-								if (activeProgram != nullptr)
-								{
-									GLuint glProgram = activeProgram->getGLHandle();
+							SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
+							if (activeProgram != nullptr)
+							{
+								GLuint glProgram = activeProgram->getGLHandle();
 
-									glProgramUniform1i(glProgram, binding, unit);
-									BS_CHECK_GL_ERROR();
-								}
+								glProgramUniform1i(glProgram, binding, unit);
+								BS_CHECK_GL_ERROR();
 							}
-							break;
+						}
+						break;
 #endif
 #if BS_OPENGL_4_3 || BS_OPENGLES_3_1
-						case GPOT_RWSTRUCTURED_BUFFER: // Shared storage block (read/write, structured)
-							{
-								UINT32 unit = getSharedStorageUnit(binding);
+					case GPOT_RWSTRUCTURED_BUFFER: // Shared storage block (read/write, structured)
+						{
+							UINT32 unit = getSharedStorageUnit(binding);
 
-								GLuint bufferId = 0;
-								if (glBuffer != nullptr)
-									bufferId = glBuffer->getGLBufferId();
+							GLuint bufferId = 0;
+							if (glBuffer != nullptr)
+								bufferId = glBuffer->getGLBufferId();
 
-								glBindBufferBase(GL_SHADER_STORAGE_BUFFER, unit, bufferId);
-								BS_CHECK_GL_ERROR();
+							glBindBufferBase(GL_SHADER_STORAGE_BUFFER, unit, bufferId);
+							BS_CHECK_GL_ERROR();
 
-								SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
-								if (activeProgram != nullptr)
-								{
-									GLuint glProgram = activeProgram->getGLHandle();
+							SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
+							if (activeProgram != nullptr)
+							{
+								GLuint glProgram = activeProgram->getGLHandle();
 
-									glShaderStorageBlockBinding(glProgram, binding, unit);
-									BS_CHECK_GL_ERROR();
-								}
+								glShaderStorageBlockBinding(glProgram, binding, unit);
+								BS_CHECK_GL_ERROR();
 							}
-							break;
-#endif
-						default:
-							break;
 						}
+						break;
+#endif
+					default:
+						break;
 					}
+				}
 
 #if BS_OPENGL_4_2 || BS_OPENGLES_3_1
-					for(auto& entry : paramDesc->loadStoreTextures)
-					{
-						UINT32 binding = entry.second.slot;
-
-						SPtr<Texture> texture = gpuParams->getLoadStoreTexture(entry.second.set, binding);
-						const TextureSurface& surface = gpuParams->getLoadStoreSurface(entry.second.set, binding);
+				for(auto& entry : paramDesc->loadStoreTextures)
+				{
+					UINT32 binding = entry.second.slot;
 
-						UINT32 unit = getImageUnit(binding);
-						GLuint texId = 0;
-						UINT32 mipLevel = 0;
-						UINT32 face = 0;
-						bool bindAllLayers = false;
-						GLenum format = GL_R32F;
+					SPtr<Texture> texture = gpuParams->getLoadStoreTexture(entry.second.set, binding);
+					const TextureSurface& surface = gpuParams->getLoadStoreSurface(entry.second.set, binding);
 
-						if (texture != nullptr)
-						{
-							GLTexture* tex = static_cast<GLTexture*>(texture.get());
-							auto& texProps = tex->getProperties();
+					UINT32 unit = getImageUnit(binding);
+					GLuint texId = 0;
+					UINT32 mipLevel = 0;
+					UINT32 face = 0;
+					bool bindAllLayers = false;
+					GLenum format = GL_R32F;
 
-							bindAllLayers = texProps.getNumFaces() == surface.numFaces || surface.numFaces == 0;
+					if (texture != nullptr)
+					{
+						GLTexture* tex = static_cast<GLTexture*>(texture.get());
+						auto& texProps = tex->getProperties();
 
-							if(!bindAllLayers && surface.numFaces > 1)
-							{
-								LOGWRN("Attempting to bind multiple faces of a load-store texture. You are allowed to bind \
-									either a single face, or all the faces of the texture. Only the first face will \
-									be bound instead.");
-							}
+						bindAllLayers = texProps.getNumFaces() == surface.numFaces || surface.numFaces == 0;
 
-							if(surface.numMipLevels > 1)
-							{
-								LOGWRN("Attempting to bind multiple mip levels of a load-store texture. This is not \
-									supported and only the first provided level will be bound.");
-							}
+						if(!bindAllLayers && surface.numFaces > 1)
+						{
+							LOGWRN("Attempting to bind multiple faces of a load-store texture. You are allowed to bind \
+								either a single face, or all the faces of the texture. Only the first face will \
+								be bound instead.");
+						}
 
-							texId = tex->getGLID();
-							format = tex->getGLFormat();
-							mipLevel = surface.mipLevel;
-							face = surface.face;
+						if(surface.numMipLevels > 1)
+						{
+							LOGWRN("Attempting to bind multiple mip levels of a load-store texture. This is not \
+								supported and only the first provided level will be bound.");
 						}
 
-						glBindImageTexture(unit, texId, mipLevel, bindAllLayers, face, GL_READ_WRITE, format);
-						BS_CHECK_GL_ERROR();
+						texId = tex->getGLID();
+						format = tex->getGLFormat();
+						mipLevel = surface.mipLevel;
+						face = surface.face;
+					}
 
-						SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
-						if (activeProgram != nullptr)
-						{
-							GLuint glProgram = activeProgram->getGLHandle();
+					glBindImageTexture(unit, texId, mipLevel, bindAllLayers, face, GL_READ_WRITE, format);
+					BS_CHECK_GL_ERROR();
 
-							glProgramUniform1i(glProgram, binding, unit);
-							BS_CHECK_GL_ERROR();
-						}
+					SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
+					if (activeProgram != nullptr)
+					{
+						GLuint glProgram = activeProgram->getGLHandle();
+
+						glProgramUniform1i(glProgram, binding, unit);
+						BS_CHECK_GL_ERROR();
 					}
+				}
 #endif
 
-					for (auto& entry : paramDesc->paramBlocks)
-					{
-						UINT32 binding = entry.second.slot;
-						SPtr<GpuParamBlockBuffer> buffer = gpuParams->getParamBlockBuffer(entry.second.set, binding);
-						
-						if (buffer == nullptr)
-							continue;
+				for (auto& entry : paramDesc->paramBlocks)
+				{
+					UINT32 binding = entry.second.slot;
+					SPtr<GpuParamBlockBuffer> buffer = gpuParams->getParamBlockBuffer(entry.second.set, binding);
+					
+					if (buffer == nullptr)
+						continue;
 
-						buffer->flushToGPU();
+					buffer->flushToGPU();
 
-						SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
-						GLuint glProgram = activeProgram->getGLHandle();
+					SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
+					GLuint glProgram = activeProgram->getGLHandle();
 
-						// 0 means uniforms are not in block, in which case we handle it specially
-						if (binding == 0)
+					// 0 means uniforms are not in block, in which case we handle it specially
+					if (binding == 0)
+					{
+						UINT8* uniformBufferData = (UINT8*)bs_stack_alloc(buffer->getSize());
+						buffer->read(0, uniformBufferData, buffer->getSize());
+
+						for (auto iter = paramDesc->params.begin(); iter != paramDesc->params.end(); ++iter)
 						{
-							UINT8* uniformBufferData = (UINT8*)bs_stack_alloc(buffer->getSize());
-							buffer->read(0, uniformBufferData, buffer->getSize());
+							const GpuParamDataDesc& param = iter->second;
+
+							if (param.paramBlockSlot != 0) // 0 means uniforms are not in a block
+								continue;
 
-							for (auto iter = paramDesc->params.begin(); iter != paramDesc->params.end(); ++iter)
+							const UINT8* ptrData = uniformBufferData + param.cpuMemOffset * sizeof(UINT32);
+
+							// Note: We don't transpose matrices here even though we don't use column major format
+							// because they are assumed to be pre-transposed in the GpuParams buffer
+							switch (param.type)
 							{
-								const GpuParamDataDesc& param = iter->second;
-
-								if (param.paramBlockSlot != 0) // 0 means uniforms are not in a block
-									continue;
-
-								const UINT8* ptrData = uniformBufferData + param.cpuMemOffset * sizeof(UINT32);
-
-								// Note: We don't transpose matrices here even though we don't use column major format
-								// because they are assumed to be pre-transposed in the GpuParams buffer
-								switch (param.type)
-								{
-								case GPDT_FLOAT1:
-									glProgramUniform1fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_FLOAT2:
-									glProgramUniform2fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_FLOAT3:
-									glProgramUniform3fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_FLOAT4:
-									glProgramUniform4fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_2X2:
-									glProgramUniformMatrix2fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_2X3:
-									glProgramUniformMatrix3x2fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_2X4:
-									glProgramUniformMatrix4x2fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_3X2:
-									glProgramUniformMatrix2x3fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_3X3:
-									glProgramUniformMatrix3fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_3X4:
-									glProgramUniformMatrix4x3fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_4X2:
-									glProgramUniformMatrix2x4fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_4X3:
-									glProgramUniformMatrix3x4fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_MATRIX_4X4:
-									glProgramUniformMatrix4fv(
-										glProgram,
-										param.gpuMemOffset,
-										param.arraySize,
-										GL_FALSE,
-										(GLfloat*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_INT1:
-									glProgramUniform1iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_INT2:
-									glProgramUniform2iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_INT3:
-									glProgramUniform3iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_INT4:
-									glProgramUniform4iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								case GPDT_BOOL:
-									glProgramUniform1uiv(glProgram, param.gpuMemOffset, param.arraySize, (GLuint*)ptrData);
-									BS_CHECK_GL_ERROR();
-									break;
-								default:
-								case GPDT_UNKNOWN:
-									break;
-								}
+							case GPDT_FLOAT1:
+								glProgramUniform1fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_FLOAT2:
+								glProgramUniform2fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_FLOAT3:
+								glProgramUniform3fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_FLOAT4:
+								glProgramUniform4fv(glProgram, param.gpuMemOffset, param.arraySize, (GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_2X2:
+								glProgramUniformMatrix2fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_2X3:
+								glProgramUniformMatrix3x2fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_2X4:
+								glProgramUniformMatrix4x2fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_3X2:
+								glProgramUniformMatrix2x3fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_3X3:
+								glProgramUniformMatrix3fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_3X4:
+								glProgramUniformMatrix4x3fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_4X2:
+								glProgramUniformMatrix2x4fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_4X3:
+								glProgramUniformMatrix3x4fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_MATRIX_4X4:
+								glProgramUniformMatrix4fv(
+									glProgram,
+									param.gpuMemOffset,
+									param.arraySize,
+									GL_FALSE,
+									(GLfloat*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_INT1:
+								glProgramUniform1iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_INT2:
+								glProgramUniform2iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_INT3:
+								glProgramUniform3iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_INT4:
+								glProgramUniform4iv(glProgram, param.gpuMemOffset, param.arraySize, (GLint*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							case GPDT_BOOL:
+								glProgramUniform1uiv(glProgram, param.gpuMemOffset, param.arraySize, (GLuint*)ptrData);
+								BS_CHECK_GL_ERROR();
+								break;
+							default:
+							case GPDT_UNKNOWN:
+								break;
 							}
-
-							if (uniformBufferData != nullptr)
-								bs_stack_free(uniformBufferData);
 						}
-						else
-						{
-							const GLGpuParamBlockBuffer* glParamBlockBuffer = static_cast<const GLGpuParamBlockBuffer*>(buffer.get());
 
-							UINT32 unit = getUniformUnit(binding - 1);
-							glUniformBlockBinding(glProgram, binding - 1, unit);
-							BS_CHECK_GL_ERROR();
+						if (uniformBufferData != nullptr)
+							bs_stack_free(uniformBufferData);
+					}
+					else
+					{
+						GLGpuParamBlockBuffer* glParamBlockBuffer = static_cast<GLGpuParamBlockBuffer*>(buffer.get());
 
-							glBindBufferBase(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLHandle());
-							BS_CHECK_GL_ERROR();
-						}
+						UINT32 unit = getUniformUnit(binding - 1);
+						glUniformBlockBinding(glProgram, binding - 1, unit);
+						BS_CHECK_GL_ERROR();
+
+						glParamBlockBuffer->bind(unit);
 					}
 				}
 			}
-			bs_frame_clear();
-
-			activateGLTextureUnit(0);
-		};
-
-		if (commandBuffer == nullptr)
-			executeRef(gpuParams);
-		else
-		{
-			auto execute = [=]() { executeRef(gpuParams); };
-
-			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
 		}
+		bs_frame_clear();
 
-		BS_INC_RENDER_STAT(NumGpuParamBinds);
+		activateGLTextureUnit(0);
 	}
 
 	void GLRenderAPI::setStencilRef(UINT32 stencilRefValue, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 stencilRefValue)
-		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			setStencilRefValue(stencilRefValue);
-		};
-
 		if (commandBuffer == nullptr)
-			executeRef(stencilRefValue);
+			executeSetStencilRef(stencilRefValue);
 		else
 		{
-			auto execute = [=]() { executeRef(stencilRefValue); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetStencilRef(stencilRefValue);
 		}
 	}
 
-	void GLRenderAPI::setViewport(const Rect2& area,
-		const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeSetStencilRef(UINT32 stencilRefValue)
 	{
-		auto executeRef = [&](const Rect2& area)
-		{
-			THROW_IF_NOT_CORE_THREAD;
+		THROW_IF_NOT_CORE_THREAD;
 
-			mViewportNorm = area;
-			applyViewport();
-		};
+		setStencilRefValue(stencilRefValue);
+	}
 
+	void GLRenderAPI::setViewport(const Rect2& area,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(area);
+			executeSetViewport(area);
 		else
 		{
-			auto execute = [=]() { executeRef(area); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetViewport(area);
 		}
 	}
 
+	void GLRenderAPI::executeSetViewport(const Rect2& area)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mViewportNorm = area;
+		applyViewport();
+	}
+
 	void GLRenderAPI::setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags, 
 		RenderSurfaceMask loadMask, const SPtr<CommandBuffer>& commandBuffer)
 	{
@@ -1024,6 +1034,9 @@ namespace bs { namespace ct
 
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
 			cb->queueCommand(execute);
+
+			// Might switch contexts, which resets the bound pipeline
+			cb->invalidateRecordedState();
 		}
 
 		BS_INC_RENDER_STAT(NumRenderTargetChanges);
@@ -1042,130 +1055,96 @@ namespace bs { namespace ct
 		}
 #endif
 
-		auto executeRef = [&](UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
-		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			std::array<SPtr<VertexBuffer>, MAX_VB_COUNT> boundBuffers;
-			for (UINT32 i = 0; i < numBuffers; i++)
-				boundBuffers[index + i] = buffers[i];
-
-			for (UINT32 i = 0; i < numBuffers; i++)
-				mBoundVertexBuffers[index + i] = boundBuffers[index + i];
-		};
-
 		if (commandBuffer == nullptr)
-			executeRef(index, buffers, numBuffers);
+			executeSetVertexBuffers(index, buffers, numBuffers);
 		else
 		{
-			auto execute = [=]() { executeRef(index, buffers, numBuffers); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetVertexBuffers(index, buffers, numBuffers);
 		}
 	}
 
-	void GLRenderAPI::setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration,
-		const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeSetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
 	{
-		auto executeRef = [&](const SPtr<VertexDeclaration>& vertexDeclaration)
-		{
-			THROW_IF_NOT_CORE_THREAD;
+		THROW_IF_NOT_CORE_THREAD;
 
-			mBoundVertexDeclaration = vertexDeclaration;
-		};
+		std::array<SPtr<VertexBuffer>, MAX_VB_COUNT> boundBuffers;
+		for (UINT32 i = 0; i < numBuffers; i++)
+			boundBuffers[index + i] = buffers[i];
+
+		for (UINT32 i = 0; i < numBuffers; i++)
+			mBoundVertexBuffers[index + i] = boundBuffers[index + i];
+	}
 
+	void GLRenderAPI::setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(vertexDeclaration);
+			executeSetVertexDeclaration(vertexDeclaration);
 		else
 		{
-			auto execute = [=]() { executeRef(vertexDeclaration); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetVertexDeclaration(vertexDeclaration);
 		}
 	}
 
-	void GLRenderAPI::setDrawOperation(DrawOperationType op, const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeSetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration)
 	{
-		auto executeRef = [&](DrawOperationType op)
-		{
-			THROW_IF_NOT_CORE_THREAD;
+		THROW_IF_NOT_CORE_THREAD;
 
-			mCurrentDrawOperation = op;
-		};
+		mBoundVertexDeclaration = vertexDeclaration;
+	}
 
+	void GLRenderAPI::setDrawOperation(DrawOperationType op, const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(op);
+			executeSetDrawOperation(op);
 		else
 		{
-			auto execute = [=]() { executeRef(op); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
-
-			cb->mCurrentDrawOperation = op;
+			cb->queueSetDrawOperation(op);
 		}
 	}
 
-	void GLRenderAPI::setIndexBuffer(const SPtr<IndexBuffer>& buffer, const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeSetDrawOperation(DrawOperationType op)
 	{
-		auto executeRef = [&](const SPtr<IndexBuffer>& buffer)
-		{
-			THROW_IF_NOT_CORE_THREAD;
+		THROW_IF_NOT_CORE_THREAD;
 
-			mBoundIndexBuffer = buffer;
-		};
+		mCurrentDrawOperation = op;
+	}
 
+	void GLRenderAPI::setIndexBuffer(const SPtr<IndexBuffer>& buffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(buffer);
+			executeSetIndexBuffer(buffer);
 		else
 		{
-			auto execute = [=]() { executeRef(buffer); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetIndexBuffer(buffer);
 		}
 	}
 
-	void GLRenderAPI::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount, 
-		const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeSetIndexBuffer(const SPtr<IndexBuffer>& buffer)
 	{
-		auto executeRef = [&](UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
-		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			// Find the correct type to render
-			GLint primType = getGLDrawMode();
-			beginDraw();
-
-			if (instanceCount <= 1)
-			{
-				glDrawArrays(primType, vertexOffset, vertexCount);
-				BS_CHECK_GL_ERROR();
-			}
-			else
-			{
-				glDrawArraysInstanced(primType, vertexOffset, vertexCount, instanceCount);
-				BS_CHECK_GL_ERROR();
-			}
+		THROW_IF_NOT_CORE_THREAD;
 
-			endDraw();
-		};
+		mBoundIndexBuffer = buffer;
+	}
 
+	void GLRenderAPI::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount, 
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
 		UINT32 primCount;
 		if (commandBuffer == nullptr)
 		{
-			executeRef(vertexOffset, vertexCount, instanceCount);
+			executeDraw(vertexOffset, vertexCount, instanceCount);
 
 			primCount = vertexCountToPrimCount(mCurrentDrawOperation, vertexCount);
 		}
 		else
 		{
-			auto execute = [=]() { executeRef(vertexOffset, vertexCount, instanceCount); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueDraw(vertexOffset, vertexCount, instanceCount);
 
 			primCount = vertexCountToPrimCount(cb->mCurrentDrawOperation, vertexCount);
 		}
@@ -1175,70 +1154,42 @@ namespace bs { namespace ct
 		BS_ADD_RENDER_STAT(NumPrimitives, primCount);
 	}
 
-	void GLRenderAPI::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
-		UINT32 instanceCount, const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeDraw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
 	{
-		auto executeRef = [&](UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
-			UINT32 instanceCount)
-		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			if (mBoundIndexBuffer == nullptr)
-			{
-				LOGWRN("Cannot draw indexed because index buffer is not set.");
-				return;
-			}
-
-			// Find the correct type to render
-			GLint primType = getGLDrawMode();
+		THROW_IF_NOT_CORE_THREAD;
 
-			beginDraw();
+		// Find the correct type to render
+		GLint primType = getGLDrawMode();
+		beginDraw();
 
-			SPtr<GLIndexBuffer> indexBuffer = std::static_pointer_cast<GLIndexBuffer>(mBoundIndexBuffer);
-			const IndexBufferProperties& ibProps = indexBuffer->getProperties();
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getGLBufferId());
+		if (instanceCount <= 1)
+		{
+			glDrawArrays(primType, vertexOffset, vertexCount);
 			BS_CHECK_GL_ERROR();
+		}
+		else
+		{
+			glDrawArraysInstanced(primType, vertexOffset, vertexCount, instanceCount);
+			BS_CHECK_GL_ERROR();
+		}
 
-			GLenum indexType = (ibProps.getType() == IT_16BIT) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-
-			if (instanceCount <= 1)
-			{
-				glDrawElementsBaseVertex(
-					primType,
-					indexCount,
-					indexType,
-					(GLvoid*)(UINT64)(ibProps.getIndexSize() * startIndex),
-					vertexOffset);
-				BS_CHECK_GL_ERROR();
-			}
-			else
-			{
-				glDrawElementsInstancedBaseVertex(
-					primType,
-					indexCount,
-					indexType,
-					(GLvoid*)(UINT64)(ibProps.getIndexSize() * startIndex),
-					instanceCount,
-					vertexOffset);
-				BS_CHECK_GL_ERROR();
-			}
-
-			endDraw();
-		};
+		endDraw();
+	}
 
+	void GLRenderAPI::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+		UINT32 instanceCount, const SPtr<CommandBuffer>& commandBuffer)
+	{
 		UINT32 primCount;
 		if (commandBuffer == nullptr)
 		{
-			executeRef(startIndex, indexCount, vertexOffset, vertexCount, instanceCount);
+			executeDrawIndexed(startIndex, indexCount, vertexOffset, vertexCount, instanceCount);
 
 			primCount = vertexCountToPrimCount(mCurrentDrawOperation, vertexCount);
 		}
 		else
 		{
-			auto execute = [=]() { executeRef(startIndex, indexCount, vertexOffset, vertexCount, instanceCount); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueDrawIndexed(startIndex, indexCount, vertexOffset, vertexCount, instanceCount);
 
 			primCount = vertexCountToPrimCount(cb->mCurrentDrawOperation, vertexCount);
 		}
@@ -1250,67 +1201,111 @@ namespace bs { namespace ct
 		BS_INC_RENDER_STAT(NumIndexBufferBinds);
 	}
 
-	void GLRenderAPI::dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ, 
-		const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeDrawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+			UINT32 instanceCount)
 	{
-		auto executeRef = [&](UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mBoundIndexBuffer == nullptr)
 		{
-			THROW_IF_NOT_CORE_THREAD;
+			LOGWRN("Cannot draw indexed because index buffer is not set.");
+			return;
+		}
 
-			if (mCurrentComputeProgram == nullptr)
-			{
-				LOGWRN("Cannot dispatch compute without a set compute program.");
-				return;
-			}
+		// Find the correct type to render
+		GLint primType = getGLDrawMode();
 
-#if BS_OPENGL_4_3 || BS_OPENGLES_3_1
-			glUseProgram(mCurrentComputeProgram->getGLHandle());
-			BS_CHECK_GL_ERROR();
+		beginDraw();
 
-			glDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+		SPtr<GLIndexBuffer> indexBuffer = std::static_pointer_cast<GLIndexBuffer>(mBoundIndexBuffer);
+		const IndexBufferProperties& ibProps = indexBuffer->getProperties();
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getGLBufferId());
+		BS_CHECK_GL_ERROR();
+
+		GLenum indexType = (ibProps.getType() == IT_16BIT) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+		if (instanceCount <= 1)
+		{
+			glDrawElementsBaseVertex(
+				primType,
+				indexCount,
+				indexType,
+				(GLvoid*)(UINT64)(ibProps.getIndexSize() * startIndex),
+				vertexOffset);
 			BS_CHECK_GL_ERROR();
-#else
-			LOGWRN("Compute shaders not supported on current OpenGL version.");
-#endif
-		};
+		}
+		else
+		{
+			glDrawElementsInstancedBaseVertex(
+				primType,
+				indexCount,
+				indexType,
+				(GLvoid*)(UINT64)(ibProps.getIndexSize() * startIndex),
+				instanceCount,
+				vertexOffset);
+			BS_CHECK_GL_ERROR();
+		}
 
+		endDraw();
+	}
+
+	void GLRenderAPI::dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ, 
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(numGroupsX, numGroupsY, numGroupsZ);
+			executeDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
 		else
 		{
-			auto execute = [=]() { executeRef(numGroupsX, numGroupsY, numGroupsZ); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
 		}
 
 		BS_INC_RENDER_STAT(NumComputeCalls);
 	}
 
-	void GLRenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom, 
-		const SPtr<CommandBuffer>& commandBuffer)
+	void GLRenderAPI::executeDispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
 	{
-		auto executeRef = [&](UINT32 left, UINT32 top, UINT32 right, UINT32 bottom)
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mCurrentComputeProgram == nullptr)
 		{
-			THROW_IF_NOT_CORE_THREAD;
+			LOGWRN("Cannot dispatch compute without a set compute program.");
+			return;
+		}
 
-			mScissorTop = top;
-			mScissorBottom = bottom;
-			mScissorLeft = left;
-			mScissorRight = right;
-		};
+#if BS_OPENGL_4_3 || BS_OPENGLES_3_1
+		glUseProgram(mCurrentComputeProgram->getGLHandle());
+		BS_CHECK_GL_ERROR();
 
+		glDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+		BS_CHECK_GL_ERROR();
+#else
+		LOGWRN("Compute shaders not supported on current OpenGL version.");
+#endif
+	}
+
+	void GLRenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom, 
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
 		if (commandBuffer == nullptr)
-			executeRef(left, top, right, bottom);
+			executeSetScissorRect(left, top, right, bottom);
 		else
 		{
-			auto execute = [=]() { executeRef(left, top, right, bottom); };
-
 			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			cb->queueSetScissorRect(left, top, right, bottom);
 		}
 	}
 
+	void GLRenderAPI::executeSetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mScissorTop = top;
+		mScissorBottom = bottom;
+		mScissorLeft = left;
+		mScissorRight = right;
+	}
+
 	void GLRenderAPI::clearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil, UINT8 targetMask,
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
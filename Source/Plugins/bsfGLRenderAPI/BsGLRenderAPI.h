@@ -116,7 +116,15 @@ namespace bs { namespace ct
 		/**	Returns a support object you may use for creating */
 		GLSupport* getGLSupport() const { return mGLSupport; }
 
+		/** 
+		 * Returns the cache used for storing compiled GLSL program binaries. Returns null if program binary caching is
+		 * disabled or not supported by the driver.
+		 */
+		GLSLProgramBinaryCache* _getProgramBinaryCache() const { return mProgramBinaryCache; }
+
 	protected:
+		friend class GLCommandBuffer;
+
 		/** @copydoc RenderAPI::initialize */
 		void initialize() override;
 
@@ -126,6 +134,50 @@ namespace bs { namespace ct
 		/** @copydoc RenderAPI::destroyCore */
 		void destroyCore() override;
 
+		/************************************************************************/
+		/* 		Command execution, shared by immediate and deferred paths		*/
+		/************************************************************************/
+
+		/** Executes the command recorded by setGraphicsPipeline(). */
+		void executeSetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState);
+
+		/** Executes the command recorded by setComputePipeline(). */
+		void executeSetComputePipeline(const SPtr<ComputePipelineState>& pipelineState);
+
+		/** Executes the command recorded by setGpuParams(). */
+		void executeSetGpuParams(const SPtr<GpuParams>& gpuParams);
+
+		/** Executes the command recorded by setStencilRef(). */
+		void executeSetStencilRef(UINT32 stencilRefValue);
+
+		/** Executes the command recorded by setViewport(). */
+		void executeSetViewport(const Rect2& area);
+
+		/** Executes the command recorded by setVertexBuffers(). */
+		void executeSetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers);
+
+		/** Executes the command recorded by setVertexDeclaration(). */
+		void executeSetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration);
+
+		/** Executes the command recorded by setDrawOperation(). */
+		void executeSetDrawOperation(DrawOperationType op);
+
+		/** Executes the command recorded by setIndexBuffer(). */
+		void executeSetIndexBuffer(const SPtr<IndexBuffer>& buffer);
+
+		/** Executes the command recorded by draw(). */
+		void executeDraw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount);
+
+		/** Executes the command recorded by drawIndexed(). */
+		void executeDrawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount, 
+			UINT32 instanceCount);
+
+		/** Executes the command recorded by dispatchCompute(). */
+		void executeDispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ);
+
+		/** Executes the command recorded by setScissorRect(). */
+		void executeSetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom);
+
 		/**	Call before doing a draw operation, this method sets everything up. */
 		void beginDraw();
 
@@ -390,6 +442,7 @@ namespace bs { namespace ct
 
 		GLSLProgramFactory* mGLSLProgramFactory;
 		GLSLProgramPipelineManager* mProgramPipelineManager;
+		GLSLProgramBinaryCache* mProgramBinaryCache = nullptr;
 
 		SPtr<GLSLGpuProgram> mCurrentVertexProgram;
 		SPtr<GLSLGpuProgram> mCurrentFragmentProgram;
@@ -0,0 +1,132 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsGLTransientUniformBuffer.h"
+#include "Profiling/BsRenderStats.h"
+#include "Math/BsMath.h"
+
+namespace bs { namespace ct
+{
+	GLTransientUniformBuffer::GLTransientUniformBuffer(UINT32 frameSize)
+	{
+		for (UINT32 i = 0; i < NUM_FRAMES; i++)
+			mFences[i] = nullptr;
+
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		BS_CHECK_GL_ERROR();
+
+		if (alignment > 0)
+			mAlignment = (UINT32)alignment;
+
+		mFrameSize = Math::divideAndRoundUp(frameSize, mAlignment) * mAlignment;
+		const UINT32 totalSize = mFrameSize * NUM_FRAMES;
+
+		glGenBuffers(1, &mGLHandle);
+		BS_CHECK_GL_ERROR();
+
+		glBindBuffer(GL_UNIFORM_BUFFER, mGLHandle);
+		BS_CHECK_GL_ERROR();
+
+#if BS_OPENGL_4_4
+		if (GLEW_ARB_buffer_storage)
+		{
+			const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			glBufferStorage(GL_UNIFORM_BUFFER, totalSize, nullptr, flags);
+			BS_CHECK_GL_ERROR();
+
+			mMappedData = (UINT8*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, totalSize, flags);
+			BS_CHECK_GL_ERROR();
+		}
+		else
+#endif
+		{
+			glBufferData(GL_UNIFORM_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+			BS_CHECK_GL_ERROR();
+		}
+
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		BS_CHECK_GL_ERROR();
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuParamBuffer);
+	}
+
+	GLTransientUniformBuffer::~GLTransientUniformBuffer()
+	{
+		for (UINT32 i = 0; i < NUM_FRAMES; i++)
+		{
+			if (mFences[i] != nullptr)
+				glDeleteSync(mFences[i]);
+		}
+
+		if (mMappedData != nullptr)
+		{
+			glBindBuffer(GL_UNIFORM_BUFFER, mGLHandle);
+			BS_CHECK_GL_ERROR();
+
+			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			BS_CHECK_GL_ERROR();
+
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			BS_CHECK_GL_ERROR();
+		}
+
+		glDeleteBuffers(1, &mGLHandle);
+		BS_CHECK_GL_ERROR();
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuParamBuffer);
+	}
+
+	bool GLTransientUniformBuffer::write(const UINT8* data, UINT32 size, UINT32& offset)
+	{
+		const UINT32 alignedSize = Math::divideAndRoundUp(size, mAlignment) * mAlignment;
+		if ((mRegionOffset + alignedSize) > mFrameSize)
+			return false;
+
+		offset = mRegionIdx * mFrameSize + mRegionOffset;
+		mRegionOffset += alignedSize;
+
+		if (mMappedData != nullptr)
+			memcpy(mMappedData + offset, data, size);
+		else
+		{
+			glBindBuffer(GL_UNIFORM_BUFFER, mGLHandle);
+			BS_CHECK_GL_ERROR();
+
+			glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+			BS_CHECK_GL_ERROR();
+
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			BS_CHECK_GL_ERROR();
+		}
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+		return true;
+	}
+
+	void GLTransientUniformBuffer::advanceFrame()
+	{
+		// Nothing was allocated this frame, no need to switch regions
+		if (mRegionOffset == 0)
+			return;
+
+		mFences[mRegionIdx] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		BS_CHECK_GL_ERROR();
+
+		mRegionIdx = (mRegionIdx + 1) % NUM_FRAMES;
+		mRegionOffset = 0;
+		mFrameIdx++;
+
+		// Make sure the GPU is done reading from the region we're about to overwrite
+		GLsync fence = mFences[mRegionIdx];
+		if (fence != nullptr)
+		{
+			GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			while (result == GL_TIMEOUT_EXPIRED)
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+			glDeleteSync(fence);
+			mFences[mRegionIdx] = nullptr;
+		}
+	}
+}}
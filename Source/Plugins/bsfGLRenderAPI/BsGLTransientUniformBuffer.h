@@ -0,0 +1,76 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsGLPrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup GL
+	 *  @{
+	 */
+
+	/**
+	 * Large uniform buffer that gets linearly sub-allocated from by transient GPU parameter block buffers
+	 * (GPBU_TRANSIENT). The buffer is split into a set of regions, one per frame in flight. Each frame allocates from
+	 * its own region, and a region is only reused once the GPU signals it has finished with the frame that used it.
+	 * If supported the buffer is persistently mapped so writes are a simple memcpy.
+	 *
+	 * @note	Core thread only.
+	 */
+	class GLTransientUniformBuffer
+	{
+	public:
+		/**
+		 * Creates a new transient buffer.
+		 *
+		 * @param[in]	frameSize	Size of the region available to a single frame, in bytes.
+		 */
+		GLTransientUniformBuffer(UINT32 frameSize);
+		~GLTransientUniformBuffer();
+
+		/**
+		 * Allocates a new block of memory in the current frame's region and writes the provided data to it.
+		 *
+		 * @param[in]	data		Data to write.
+		 * @param[in]	size		Size of the data, in bytes.
+		 * @param[out]	offset		Offset of the allocated block, relative to the start of the GL buffer. Suitable
+		 *							for passing to glBindBufferRange().
+		 * @return					True if the allocation succeeded, false if the frame region is out of space.
+		 */
+		bool write(const UINT8* data, UINT32 size, UINT32& offset);
+
+		/**
+		 * Notifies the buffer that the current frame has been submitted. All allocations made so far become invalid
+		 * and the next frame region is made current, waiting for the GPU to finish with it if needed.
+		 */
+		void advanceFrame();
+
+		/**
+		 * Returns an index that gets incremented every time advanceFrame() is called. Allocations are only valid
+		 * for the frame index they were made in.
+		 */
+		UINT64 getFrameIdx() const { return mFrameIdx; }
+
+		/** Returns the internal OpenGL uniform buffer handle. */
+		GLuint getGLHandle() const { return mGLHandle; }
+
+		/** Number of frames that can be in flight before the CPU waits on the GPU. */
+		static const UINT32 NUM_FRAMES = 3;
+
+		/** Default size of the region available to a single frame, in bytes. */
+		static const UINT32 DEFAULT_FRAME_SIZE = 4 * 1024 * 1024;
+	private:
+		GLuint mGLHandle = 0;
+		UINT8* mMappedData = nullptr;
+		GLsync mFences[NUM_FRAMES];
+
+		UINT32 mFrameSize;
+		UINT32 mAlignment = 256;
+		UINT32 mRegionIdx = 0;
+		UINT32 mRegionOffset = 0;
+		UINT64 mFrameIdx = 0;
+	};
+
+	/** @} */
+}}
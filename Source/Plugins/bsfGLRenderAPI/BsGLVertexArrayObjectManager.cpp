@@ -178,6 +178,7 @@ namespace bs { namespace ct
 			case VET_COLOR_ABGR:
 			case VET_COLOR_ARGB:
 			case VET_UBYTE4_NORM:
+			case VET_USHORT4_NORM:
 				normalized = GL_TRUE;
 				isInteger = false;
 				break;
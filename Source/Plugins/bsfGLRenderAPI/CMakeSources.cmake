@@ -1,5 +1,6 @@
 set(BS_GLRENDERAPI_SRC_GLSL
 	"GLSL/BsGLSLProgramPipelineManager.cpp"
+	"GLSL/BsGLSLProgramBinaryCache.cpp"
 	"GLSL/BsGLSLProgramFactory.cpp"
 	"GLSL/BsGLSLGpuProgram.cpp"
 	"GLSL/BsGLSLParamParser.cpp"
@@ -22,6 +23,7 @@ set(BS_GLRENDERAPI_INC_NOFILTER
 	"BsGLIndexBuffer.h"
 	"BsGLHardwareBufferManager.h"
 	"BsGLGpuParamBlockBuffer.h"
+	"BsGLTransientUniformBuffer.h"
 	"BsGLGpuBuffer.h"
 	"BsGLFrameBufferObject.h"
 	"BsGLEventQuery.h"
@@ -51,6 +53,7 @@ set(BS_GLRENDERAPI_SRC_NOFILTER
 	"BsGLIndexBuffer.cpp"
 	"BsGLHardwareBufferManager.cpp"
 	"BsGLGpuParamBlockBuffer.cpp"
+	"BsGLTransientUniformBuffer.cpp"
 	"BsGLGpuBuffer.cpp"
 	"BsGLFrameBufferObject.cpp"
 	"BsGLEventQuery.cpp"
@@ -66,6 +69,7 @@ set(BS_GLRENDERAPI_SRC_NOFILTER
 
 set(BS_GLRENDERAPI_INC_GLSL
 	"GLSL/BsGLSLProgramPipelineManager.h"
+	"GLSL/BsGLSLProgramBinaryCache.h"
 	"GLSL/BsGLSLProgramFactory.h"
 	"GLSL/BsGLSLParamParser.h"
 	"GLSL/BsGLSLGpuProgram.h"
@@ -7,6 +7,9 @@
 #include "Managers/BsHardwareBufferManager.h"
 #include "Profiling/BsRenderStats.h"
 #include "RenderAPI/BsGpuParams.h"
+#include "GLSL/BsGLSLProgramBinaryCache.h"
+#include "BsGLRenderAPI.h"
+#include "Utility/BsTimer.h"
 
 namespace bs { namespace ct
 {
@@ -50,6 +53,73 @@ namespace bs { namespace ct
 		outErrorMsg = stream.str();
 		return !linkCompileSuccess;
 	}
+
+	/** 
+	 * Compiles and links a separable program from a single shader. Equivalent to glCreateShaderProgramv() except it
+	 * allows the binary of the linked program to be retrieved. Any shader compilation errors are output in
+	 * @p outCompileLog.
+	 */
+	GLuint createRetrievableShaderProgram(GLenum shaderType, const char* code, String& outCompileLog)
+	{
+		GLuint shader = glCreateShader(shaderType);
+		BS_CHECK_GL_ERROR();
+
+		glShaderSource(shader, 1, (const GLchar**)&code, nullptr);
+		BS_CHECK_GL_ERROR();
+
+		glCompileShader(shader);
+		BS_CHECK_GL_ERROR();
+
+		GLuint program = glCreateProgram();
+		BS_CHECK_GL_ERROR();
+
+		glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+		BS_CHECK_GL_ERROR();
+
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		BS_CHECK_GL_ERROR();
+
+		GLint compileSuccess = 0;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &compileSuccess);
+		BS_CHECK_GL_ERROR();
+
+		if (compileSuccess)
+		{
+			glAttachShader(program, shader);
+			BS_CHECK_GL_ERROR();
+
+			glLinkProgram(program);
+			BS_CHECK_GL_ERROR();
+
+			glDetachShader(program, shader);
+			BS_CHECK_GL_ERROR();
+		}
+		else
+		{
+			GLint infologLength = 0;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infologLength);
+			BS_CHECK_GL_ERROR();
+
+			if (infologLength > 0)
+			{
+				GLint charsWritten = 0;
+
+				GLchar* infoLog = (GLchar*)bs_alloc(sizeof(GLchar)* infologLength);
+
+				glGetShaderInfoLog(shader, infologLength, &charsWritten, infoLog);
+				BS_CHECK_GL_ERROR();
+
+				outCompileLog = "Compile info log: \n" + String(infoLog);
+
+				bs_free(infoLog);
+			}
+		}
+
+		glDeleteShader(shader);
+		BS_CHECK_GL_ERROR();
+
+		return program;
+	}
 	
 	GLSLGpuProgram::GLSLGpuProgram(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask)
 		:GpuProgram(desc, deviceMask), mProgramID(0), mGLHandle(0)
@@ -244,11 +314,45 @@ namespace bs { namespace ct
 
 			String code = codeStream.str();
 			const char* codeRaw = code.c_str();
-			mGLHandle = glCreateShaderProgramv(shaderType, 1, (const GLchar**)&codeRaw);
-			BS_CHECK_GL_ERROR();
 
-			mCompileMessages = "";
-			mIsCompiled = !checkForGLSLError(mGLHandle, mCompileMessages);
+			GLRenderAPI* rapi = static_cast<GLRenderAPI*>(RenderAPI::instancePtr());
+			GLSLProgramBinaryCache* binaryCache = rapi->_getProgramBinaryCache();
+
+			if (binaryCache != nullptr)
+			{
+				String cacheKey = binaryCache->getKey(code, mType);
+				mGLHandle = binaryCache->load(cacheKey);
+
+				if (mGLHandle != 0)
+				{
+					mCompileMessages = "";
+					mIsCompiled = true;
+				}
+				else
+				{
+					Timer timer;
+
+					String compileLog;
+					mGLHandle = createRetrievableShaderProgram(shaderType, codeRaw, compileLog);
+
+					mCompileMessages = "";
+					mIsCompiled = !checkForGLSLError(mGLHandle, mCompileMessages);
+					mCompileMessages = compileLog + mCompileMessages;
+
+					if (mIsCompiled)
+						binaryCache->save(cacheKey, mGLHandle);
+
+					binaryCache->_notifyCompiled(timer.getMicroseconds());
+				}
+			}
+			else
+			{
+				mGLHandle = glCreateShaderProgramv(shaderType, 1, (const GLchar**)&codeRaw);
+				BS_CHECK_GL_ERROR();
+
+				mCompileMessages = "";
+				mIsCompiled = !checkForGLSLError(mGLHandle, mCompileMessages);
+			}
 		}
 
 		if (mIsCompiled)
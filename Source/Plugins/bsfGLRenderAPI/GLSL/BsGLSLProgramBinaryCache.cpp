@@ -0,0 +1,240 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "GLSL/BsGLSLProgramBinaryCache.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsTimer.h"
+#include "Debug/BsDebug.h"
+
+namespace bs { namespace ct
+{
+	/** Header written at the start of each cache entry. */
+	struct GLSLProgramBinaryHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		GLenum format;
+		UINT32 size;
+	};
+
+	static const UINT32 PROGRAM_BINARY_MAGIC = 0x42534C47; // "GLSB"
+	static const UINT32 PROGRAM_BINARY_VERSION = 1;
+
+	constexpr UINT64 GLSLProgramBinaryCache::DEFAULT_MAX_DISK_SIZE;
+
+	GLSLProgramBinaryCache::GLSLProgramBinaryCache(const Path& cacheFolder, UINT64 maxDiskSize)
+		:mMaxDiskSize(maxDiskSize)
+	{
+		GLint numFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+		BS_CHECK_GL_ERROR();
+
+		mIsSupported = numFormats > 0;
+		if (!mIsSupported)
+			return;
+
+		const char* vendor = (const char*)glGetString(GL_VENDOR);
+		BS_CHECK_GL_ERROR();
+
+		const char* renderer = (const char*)glGetString(GL_RENDERER);
+		BS_CHECK_GL_ERROR();
+
+		const char* version = (const char*)glGetString(GL_VERSION);
+		BS_CHECK_GL_ERROR();
+
+		// Binaries are only valid for the exact driver they were retrieved from, so each driver gets its own folder. 
+		// Folders of other drivers are left alone, as they might belong to other GPUs in the same machine.
+		String driverId = String(vendor) + "|" + String(renderer) + "|" + String(version);
+
+		mFolder = cacheFolder;
+		mFolder.append(md5(driverId) + "/");
+
+		if (!FileSystem::exists(mFolder))
+			FileSystem::createDir(mFolder);
+
+		FileSystem::iterate(mFolder, [this](const Path& path)
+		{
+			if (path.getExtension() == ".bin")
+				mDiskSize += FileSystem::getFileSize(path);
+
+			return true;
+		}, nullptr, false);
+
+		if (mMaxDiskSize > 0 && mDiskSize > mMaxDiskSize)
+			trimDiskSize();
+	}
+
+	GLSLProgramBinaryCache::~GLSLProgramBinaryCache()
+	{
+		if (!mIsSupported)
+			return;
+
+		LOGDBG("GLSL program binary cache: " + toString(mNumHits) + " programs loaded from cache in " +
+			toString(mHitTime / 1000) + " ms, " + toString(mNumMisses) + " programs compiled from source in " +
+			toString(mMissTime / 1000) + " ms.");
+	}
+
+	String GLSLProgramBinaryCache::getKey(const String& source, GpuProgramType type) const
+	{
+		return md5(source) + "_" + toString((UINT32)type);
+	}
+
+	GLuint GLSLProgramBinaryCache::load(const String& key)
+	{
+		Timer timer;
+
+		Path entryPath = getEntryPath(key);
+		if (!FileSystem::isFile(entryPath))
+			return 0;
+
+		Vector<UINT8> binary;
+		GLSLProgramBinaryHeader header;
+		UINT64 fileSize = 0;
+		{
+			SPtr<DataStream> stream = FileSystem::openFile(entryPath);
+			if (stream == nullptr)
+				return 0;
+
+			bool valid = stream->read(&header, sizeof(header)) == sizeof(header);
+			valid &= header.magic == PROGRAM_BINARY_MAGIC && header.version == PROGRAM_BINARY_VERSION;
+
+			if (valid)
+			{
+				binary.resize(header.size);
+				valid = stream->read(binary.data(), header.size) == header.size;
+			}
+
+			fileSize = stream->size();
+			stream->close();
+
+			if (!valid)
+			{
+				mDiskSize -= std::min(mDiskSize, fileSize);
+				FileSystem::remove(entryPath);
+				return 0;
+			}
+		}
+
+		GLuint program = glCreateProgram();
+		BS_CHECK_GL_ERROR();
+
+		glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+		BS_CHECK_GL_ERROR();
+
+		glProgramBinary(program, header.format, binary.data(), (GLsizei)header.size);
+
+		// Note: Not checking for errors here, as the driver is allowed to reject the binary (e.g. after an update)
+		// and will report it through the link status
+		glGetError();
+
+		GLint linkStatus = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+		BS_CHECK_GL_ERROR();
+
+		if (!linkStatus)
+		{
+			glDeleteProgram(program);
+			BS_CHECK_GL_ERROR();
+
+			mDiskSize -= std::min(mDiskSize, fileSize);
+			FileSystem::remove(entryPath);
+			return 0;
+		}
+
+		mNumHits++;
+		mHitTime += timer.getMicroseconds();
+
+		return program;
+	}
+
+	void GLSLProgramBinaryCache::save(const String& key, GLuint program)
+	{
+		GLint binarySize = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+		BS_CHECK_GL_ERROR();
+
+		if (binarySize <= 0)
+			return;
+
+		Vector<UINT8> binary(binarySize);
+
+		GLSLProgramBinaryHeader header;
+		header.magic = PROGRAM_BINARY_MAGIC;
+		header.version = PROGRAM_BINARY_VERSION;
+		header.format = 0;
+		header.size = 0;
+
+		GLsizei writtenSize = 0;
+		glGetProgramBinary(program, binarySize, &writtenSize, &header.format, binary.data());
+		BS_CHECK_GL_ERROR();
+
+		if (writtenSize <= 0)
+			return;
+
+		header.size = (UINT32)writtenSize;
+
+		Path entryPath = getEntryPath(key);
+		if (FileSystem::isFile(entryPath))
+			mDiskSize -= std::min(mDiskSize, FileSystem::getFileSize(entryPath));
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(entryPath);
+		if (stream == nullptr)
+			return;
+
+		stream->write(&header, sizeof(header));
+		stream->write(binary.data(), header.size);
+		stream->close();
+
+		mDiskSize += sizeof(header) + header.size;
+		if (mMaxDiskSize > 0 && mDiskSize > mMaxDiskSize)
+			trimDiskSize();
+	}
+
+	void GLSLProgramBinaryCache::trimDiskSize()
+	{
+		struct DiskEntry
+		{
+			Path path;
+			std::time_t lastModified;
+			UINT64 size;
+		};
+
+		Vector<DiskEntry> entries;
+		UINT64 diskSize = 0;
+		FileSystem::iterate(mFolder, [&entries, &diskSize](const Path& path)
+		{
+			if (path.getExtension() == ".bin")
+			{
+				DiskEntry entry = { path, FileSystem::getLastModifiedTime(path), FileSystem::getFileSize(path) };
+				entries.push_back(entry);
+
+				diskSize += entry.size;
+			}
+
+			return true;
+		}, nullptr, false);
+
+		std::sort(entries.begin(), entries.end(), [](const DiskEntry& a, const DiskEntry& b)
+		{
+			return a.lastModified < b.lastModified;
+		});
+
+		// Trim below the limit, so the folder doesn't need to be scanned on every save
+		UINT64 targetSize = mMaxDiskSize / 4 * 3;
+		for (auto& entry : entries)
+		{
+			if (diskSize <= targetSize)
+				break;
+
+			FileSystem::remove(entry.path);
+			diskSize -= entry.size;
+		}
+
+		mDiskSize = diskSize;
+	}
+
+	Path GLSLProgramBinaryCache::getEntryPath(const String& key) const
+	{
+		return mFolder + (key + ".bin");
+	}
+}}
@@ -0,0 +1,87 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsGLPrerequisites.h"
+#include "FileSystem/BsPath.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup GL
+	 *  @{
+	 */
+
+	/**
+	 * Stores linked OpenGL program binaries on disk so they can be loaded with glProgramBinary() instead of being
+	 * compiled from source on the next start-up.
+	 *
+	 * Entries are keyed by a hash of the final program source (which includes any defines) and the program type. All
+	 * entries are stored in a sub-folder named after a hash of the driver vendor, renderer and version strings, so
+	 * multiple drivers or GPUs on the same machine each keep their own entries. Entries the driver refuses to load are
+	 * removed on load. When the entries of the current driver exceed the size limit, the least recently written ones are
+	 * removed.
+	 *
+	 * @note	Core thread only.
+	 */
+	class GLSLProgramBinaryCache
+	{
+	public:
+		/** Default limit on the size of the cache on disk, in bytes. */
+		static constexpr UINT64 DEFAULT_MAX_DISK_SIZE = 128 * 1024 * 1024;
+
+		/**
+		 * Creates a new cache that stores its entries in the provided folder.
+		 *
+		 * @param[in]	cacheFolder		Folder to store the entries in. Created if it doesn't exist.
+		 * @param[in]	maxDiskSize		Maximum size of the entries of the current driver, in bytes. Zero for no limit.
+		 */
+		GLSLProgramBinaryCache(const Path& cacheFolder, UINT64 maxDiskSize = DEFAULT_MAX_DISK_SIZE);
+		~GLSLProgramBinaryCache();
+
+		/** Returns false if the driver doesn't support retrieving program binaries, in which case the cache is unused. */
+		bool isSupported() const { return mIsSupported; }
+
+		/** Generates a key that uniquely identifies a program compiled from the provided source. */
+		String getKey(const String& source, GpuProgramType type) const;
+
+		/**
+		 * Attempts to create a separable program from a binary previously stored under the provided key. Returns the
+		 * program handle on success, or 0 if the entry doesn't exist or the driver failed to load it.
+		 */
+		GLuint load(const String& key);
+
+		/**
+		 * Retrieves the binary of the provided linked program and stores it under the provided key. Program should have
+		 * been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT enabled.
+		 */
+		void save(const String& key, GLuint program);
+
+		/**
+		 * Records the time it took to create a program from source, in microseconds. Used for reporting cache
+		 * effectiveness.
+		 */
+		void _notifyCompiled(UINT64 time) { mNumMisses++; mMissTime += time; }
+
+		/** Returns the size of the entries of the current driver stored on disk, in bytes. */
+		UINT64 getDiskSize() const { return mDiskSize; }
+
+	private:
+		/** Returns the path of the file that stores the entry with the provided key. */
+		Path getEntryPath(const String& key) const;
+
+		/** Removes the least recently written entries from disk until the disk size is below the limit. */
+		void trimDiskSize();
+
+		Path mFolder;
+		UINT64 mMaxDiskSize;
+		UINT64 mDiskSize = 0;
+		bool mIsSupported = false;
+
+		UINT32 mNumHits = 0;
+		UINT32 mNumMisses = 0;
+		UINT64 mHitTime = 0;
+		UINT64 mMissTime = 0;
+	};
+
+	/** @} */
+}}
@@ -5,8 +5,9 @@
 #include "BsOAAudioListener.h"
 #include "BsOAAudioSource.h"
 #include "Math/BsMath.h"
-#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
 #include "Audio/BsAudioUtility.h"
+#include "Utility/BsTime.h"
 #include "AL/al.h"
 
 namespace bs
@@ -64,12 +65,22 @@ namespace bs
 			LOGERR("Failed to open OpenAL device: " + defaultDeviceName);
 
 		rebuildContexts();
+
+		mStreamingThread = ThreadPool::instance().run("AudioStream", std::bind(&OAAudio::runStreamingThread, this));
 	}
 
 	OAAudio::~OAAudio()
 	{
 		stopManualSources();
 
+		{
+			Lock lock(mMutex);
+			mStreamingShutdown = true;
+		}
+
+		mStreamingSignal.notify_all();
+		mStreamingThread.blockUntilComplete();
+
 		assert(mListeners.empty() && mSources.empty()); // Everything should be destroyed at this point
 		clearContexts();
 
@@ -103,16 +114,62 @@ namespace bs
 
 	void OAAudio::_update()
 	{
-		auto worker = [this]() { updateStreaming(); };
+		if (!mIsPaused)
+		{
+			float deltaTime = gTime().getFrameDelta();
+			for (auto& source : mSources)
+				source->updateVirtual(deltaTime);
+
+			updateVoices();
+		}
+
+		Audio::_update();
+	}
+
+	void OAAudio::setMaxVoices(UINT32 count)
+	{
+		mMaxVoices = count;
+		updateVoices();
+	}
 
-		// If previous task still hasn't completed, just skip streaming this frame, queuing more tasks won't help
-		if (mStreamingTask != nullptr && !mStreamingTask->isComplete())
+	void OAAudio::updateVoices()
+	{
+		// Voices are assigned while unpaused, so their playback resumes properly
+		if (mIsPaused || mContexts.empty())
 			return;
 
-		mStreamingTask = Task::create("AudioStream", worker, TaskPriority::VeryHigh);
-		TaskScheduler::instance().addTask(mStreamingTask);
+		mVoiceCandidates.clear();
+		mVoiceCandidateSources.clear();
+		for (auto& source : mSources)
+		{
+			source->mRequiresVoice = false;
 
-		Audio::_update();
+			if (source->getState() != AudioSourceState::Playing)
+				continue;
+
+			AudioVoiceCandidate candidate;
+			candidate.id = (UINT32)mVoiceCandidateSources.size();
+			candidate.priority = source->mPriority;
+			candidate.audibility = source->getAudibility(mListeners);
+			candidate.hasVoice = !source->isVirtual();
+
+			mVoiceCandidates.push_back(candidate);
+			mVoiceCandidateSources.push_back(source);
+		}
+
+		UINT32 numVoices = AudioUtility::assignVoices(mVoiceCandidates, mMaxVoices);
+		for (UINT32 i = 0; i < numVoices; i++)
+			mVoiceCandidateSources[mVoiceCandidates[i].id]->mRequiresVoice = true;
+
+		// Release voices first, so they can be reassigned
+		for (auto& source : mSources)
+		{
+			if (!source->mRequiresVoice)
+				source->clear();
+		}
+
+		for (UINT32 i = 0; i < numVoices; i++)
+			mVoiceCandidateSources[mVoiceCandidates[i].id]->rebuild();
 	}
 
 	void OAAudio::setActiveDevice(const AudioDevice& device)
@@ -174,10 +231,14 @@ namespace bs
 
 	void OAAudio::startStreaming(OAAudioSource* source)
 	{
-		Lock lock(mMutex);
+		{
+			Lock lock(mMutex);
+
+			mStreamingCommandQueue.push_back({ StreamingCommandType::Start, source });
+			mDestroyedSources.erase(source);
+		}
 
-		mStreamingCommandQueue.push_back({ StreamingCommandType::Start, source });
-		mDestroyedSources.erase(source);
+		mStreamingSignal.notify_all();
 	}
 
 	void OAAudio::stopStreaming(OAAudioSource* source)
@@ -188,6 +249,14 @@ namespace bs
 		mDestroyedSources.insert(source);
 	}
 
+	void OAAudio::waitUntilStreamed(OAAudioSource* source)
+	{
+		Lock lock(mMutex);
+
+		while (mActiveStreamingSource == source)
+			mStreamingSignal.wait(lock);
+	}
+
 	ALCcontext* OAAudio::_getContext(const OAAudioListener* listener) const
 	{
 		if (mListeners.size() > 0)
@@ -250,8 +319,7 @@ namespace bs
 		for (auto& listener : mListeners)
 			listener->rebuild();
 
-		for (auto& source : mSources)
-			source->rebuild();
+		updateVoices();
 	}
 
 	void OAAudio::clearContexts()
@@ -297,9 +365,38 @@ namespace bs
 				auto iterFind = mDestroyedSources.find(source);
 				if (iterFind != mDestroyedSources.end())
 					continue;
+
+				mActiveStreamingSource = source;
 			}
 
 			source->stream();
+
+			{
+				Lock lock(mMutex);
+				mActiveStreamingSource = nullptr;
+			}
+
+			// Wake up any thread waiting for the source to finish streaming
+			mStreamingSignal.notify_all();
+		}
+	}
+
+	void OAAudio::runStreamingThread()
+	{
+		while (true)
+		{
+			{
+				Lock lock(mMutex);
+
+				// Wake up periodically to refill buffers, or sooner if a source starts streaming
+				mStreamingSignal.wait_for(lock, std::chrono::milliseconds(STREAMING_INTERVAL_MS), 
+					[this]() { return mStreamingShutdown || !mStreamingCommandQueue.empty(); });
+
+				if (mStreamingShutdown)
+					break;
+			}
+
+			updateStreaming();
 		}
 	}
 
@@ -4,6 +4,8 @@
 
 #include "BsOAPrerequisites.h"
 #include "Audio/BsAudio.h"
+#include "Audio/BsAudioUtility.h"
+#include "Threading/BsThreadPool.h"
 #include "AL/alc.h"
 
 namespace bs
@@ -46,6 +48,39 @@ namespace bs
 		/** @copydoc Audio::getAllDevices */
 		const Vector<AudioDevice>& getAllDevices() const override { return mAllDevices; };
 
+		/** 
+		 * Determines the maximum number of audio sources that can be played back at once (voices). When more sources
+		 * are playing, sources with the lowest priority, and then the lowest audibility, become virtual. Virtual sources
+		 * release their OpenAL sources and only keep track of their playback time, until they get assigned a voice again.
+		 *
+		 * Each voice uses one OpenAL source per audio listener.
+		 */
+		void setMaxVoices(UINT32 count);
+
+		/** @copydoc setMaxVoices() */
+		UINT32 getMaxVoices() const { return mMaxVoices; }
+
+		/** Returns the number of audio sources that currently have a voice assigned. */
+		UINT32 getNumVoices() const { return mNumVoices; }
+
+		/** 
+		 * Determines how much audio data, in seconds, is decoded ahead of the playback position for each streaming audio
+		 * source. Larger values make sources more resilient to stalls of the streaming thread, at the cost of memory.
+		 * Applies to buffers queued after the change.
+		 */
+		void setStreamingReadAhead(float seconds) { mStreamingReadAhead = std::max(seconds, 0.1f); }
+
+		/** @copydoc setStreamingReadAhead() */
+		float getStreamingReadAhead() const { return mStreamingReadAhead; }
+
+		/** 
+		 * Returns the total number of times a streaming audio source ran out of data before the streaming thread could
+		 * provide more, causing an audible gap in playback.
+		 *
+		 * @note	Thread safe.
+		 */
+		UINT32 getNumStreamingUnderruns() const { return mNumStreamingUnderruns.load(std::memory_order_relaxed); }
+
 		/** @name Internal 
 		 *  @{
 		 */
@@ -83,6 +118,9 @@ namespace bs
 		 */
 		void _writeToOpenALBuffer(UINT32 bufferId, UINT8* samples, const AudioDataInfo& info);
 
+		/** Checks if there is a free voice that can be assigned to an audio source that started playing. */
+		bool _canAssignVoice() const { return !mContexts.empty() && mNumVoices < mMaxVoices; }
+
 		/** @} */
 
 	private:
@@ -123,9 +161,21 @@ namespace bs
 		/** Delete all existing OpenAL contexts. */
 		void clearContexts();
 
+		/** 
+		 * Assigns voices to the playing audio sources with the highest priority and audibility, and makes all other
+		 * sources virtual.
+		 */
+		void updateVoices();
+
 		/** Streams new data to audio sources that require it. */
 		void updateStreaming();
 
+		/** Main loop of the streaming thread. Periodically streams data until the audio system shuts down. */
+		void runStreamingThread();
+
+		/** Blocks until the streaming thread is done streaming the provided source, if it is currently streaming it. */
+		void waitUntilStreamed(OAAudioSource* source);
+
 		/** Starts data streaming for the provided source. */
 		void startStreaming(OAAudioSource* source);
 
@@ -144,11 +194,25 @@ namespace bs
 		Vector<ALCcontext*> mContexts;
 		UnorderedSet<OAAudioSource*> mSources;
 
+		// Voice management
+		static const UINT32 DEFAULT_MAX_VOICES = 64;
+		UINT32 mMaxVoices = DEFAULT_MAX_VOICES;
+		UINT32 mNumVoices = 0;
+		Vector<AudioVoiceCandidate> mVoiceCandidates;
+		Vector<OAAudioSource*> mVoiceCandidateSources;
+
 		// Streaming thread
+		static const UINT32 STREAMING_INTERVAL_MS = 10;
+
 		Vector<StreamingCommand> mStreamingCommandQueue;
 		UnorderedSet<OAAudioSource*> mStreamingSources;
 		UnorderedSet<OAAudioSource*> mDestroyedSources;
-		SPtr<Task> mStreamingTask;
+		OAAudioSource* mActiveStreamingSource = nullptr;
+		float mStreamingReadAhead = 3.0f;
+		std::atomic<UINT32> mNumStreamingUnderruns { 0 };
+		HThread mStreamingThread;
+		Signal mStreamingSignal;
+		bool mStreamingShutdown = false;
 		mutable Mutex mMutex;
 	};
 
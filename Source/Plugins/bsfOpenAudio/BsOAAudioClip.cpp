@@ -17,6 +17,9 @@ namespace bs
 	{
 		if (mBufferId != (UINT32)-1)
 			alDeleteBuffers(1, &mBufferId);
+
+		for (auto& decoder : mFreeDecoders)
+			bs_delete(decoder);
 	}
 
 	void OAAudioClip::initialize()
@@ -120,10 +123,12 @@ namespace bs
 			{
 				mNeedsDecompression = true;
 
+				// Open the first decoder right away, so any problems with the stream get reported on load
 				if (mStreamData != nullptr)
 				{
-					if (!mVorbisReader.open(mStreamData, info, mStreamOffset))
-						LOGERR("Failed decompressing AudioClip stream.");
+					PooledDecoder* decoder = acquireDecoder(0);
+					if (decoder != nullptr)
+						mFreeDecoders.push_back(decoder);
 				}
 			}
 		}
@@ -133,33 +138,47 @@ namespace bs
 
 	void OAAudioClip::getSamples(UINT8* samples, UINT32 offset, UINT32 count) const
 	{
-		Lock lock(mMutex);
-
-		// Try to read from normal stream, and if that fails read from in-memory stream if it exists
-		if (mStreamData != nullptr)
+		// Decode outside of the lock, so multiple sources can decode at once
+		if (mNeedsDecompression)
 		{
-			if (mNeedsDecompression)
+			PooledDecoder* decoder;
 			{
-				mVorbisReader.seek(offset);
-				mVorbisReader.read(samples, count);
+				Lock lock(mMutex);
+				decoder = acquireDecoder(offset);
 			}
-			else
-			{
-				UINT32 bytesPerSample = mDesc.bitDepth / 8;
-				UINT32 size = count * bytesPerSample;
-				UINT32 streamOffset = mStreamOffset + offset * bytesPerSample;
 
-				mStreamData->seek(streamOffset);
-				mStreamData->read(samples, size);
+			if (decoder == nullptr)
+			{
+				LOGWRN("Attempting to read samples while sample data is not available.");
+				return;
 			}
 
+			if (decoder->position != offset)
+				decoder->decoder.seek(offset);
+
+			decoder->position = offset + decoder->decoder.read(samples, count);
+
+			Lock lock(mMutex);
+			releaseDecoder(decoder);
 			return;
 		}
 
-		if (mSourceStreamData != nullptr)
+		Lock lock(mMutex);
+
+		// Try to read from normal stream, and if that fails read from in-memory stream if it exists
+		if (mStreamData != nullptr)
 		{
-			assert(!mNeedsDecompression); // Normal stream must exist if decompressing
+			UINT32 bytesPerSample = mDesc.bitDepth / 8;
+			UINT32 size = count * bytesPerSample;
+			UINT32 streamOffset = mStreamOffset + offset * bytesPerSample;
 
+			mStreamData->seek(streamOffset);
+			mStreamData->read(samples, size);
+			return;
+		}
+
+		if (mSourceStreamData != nullptr)
+		{
 			UINT32 bytesPerSample = mDesc.bitDepth / 8;
 			UINT32 size = count * bytesPerSample;
 			UINT32 streamOffset = offset * bytesPerSample;
@@ -172,6 +191,53 @@ namespace bs
 		LOGWRN("Attempting to read samples while sample data is not available.");
 	}
 
+	OAAudioClip::PooledDecoder* OAAudioClip::acquireDecoder(UINT32 offset) const
+	{
+		if (!mFreeDecoders.empty())
+		{
+			// Prefer a decoder that stopped exactly where we need to continue, so no seek is required
+			auto iterFind = std::find_if(mFreeDecoders.begin(), mFreeDecoders.end(),
+				[offset](const PooledDecoder* entry) { return entry->position == offset; });
+
+			if (iterFind == mFreeDecoders.end())
+				iterFind = mFreeDecoders.end() - 1;
+
+			PooledDecoder* decoder = *iterFind;
+			mFreeDecoders.erase(iterFind);
+
+			return decoder;
+		}
+
+		if (mStreamData == nullptr)
+			return nullptr;
+
+		// Each decoder reads from its own stream, as streams track their read position. Memory streams share the data.
+		PooledDecoder* decoder = bs_new<PooledDecoder>();
+		decoder->stream = mStreamData->clone(false);
+
+		AudioDataInfo info;
+		if (!decoder->decoder.open(decoder->stream, info, mStreamOffset))
+		{
+			LOGERR("Failed decompressing AudioClip stream.");
+
+			bs_delete(decoder);
+			return nullptr;
+		}
+
+		return decoder;
+	}
+
+	void OAAudioClip::releaseDecoder(PooledDecoder* decoder) const
+	{
+		if (mFreeDecoders.size() >= MAX_POOLED_DECODERS)
+		{
+			bs_delete(decoder);
+			return;
+		}
+
+		mFreeDecoders.push_back(decoder);
+	}
+
 	SPtr<DataStream> OAAudioClip::getSourceStream(UINT32& size)
 	{
 		Lock lock(mMutex);
@@ -29,7 +29,9 @@ namespace bs
 		 *							of channels).
 		 * @param[in]	count		Number of samples to read (should be a multiple of number of channels).
 		 *
-		 * @note	Implementation must be thread safe as this will get called from audio streaming thread.
+		 * @note	
+		 * Thread safe. Compressed data is decoded using a pool of decoders, so multiple sources playing the same clip can
+		 * decode in parallel, and sequential reads continue from where the decoder left off without seeking.
 		 */
 		void getSamples(UINT8* samples, UINT32 offset, UINT32 count) const;
 
@@ -48,8 +50,28 @@ namespace bs
 		/** @copydoc AudioClip::getSourceStream */
 		SPtr<DataStream> getSourceStream(UINT32& size) override;
 	private:
+		/** Decoder used for reading compressed audio data, along with the position it will read from next. */
+		struct PooledDecoder
+		{
+			OggVorbisDecoder decoder;
+			SPtr<DataStream> stream;
+			UINT32 position = 0;
+		};
+
+		/** Maximum number of idle decoders kept around for reuse. */
+		static const UINT32 MAX_POOLED_DECODERS = 4;
+
+		/** 
+		 * Returns an idle decoder, preferring one positioned at @p offset. Creates a new decoder if none are idle. Returns
+		 * null if the decoder cannot be created.
+		 */
+		PooledDecoder* acquireDecoder(UINT32 offset) const;
+
+		/** Returns a decoder retrieved from acquireDecoder() to the pool. */
+		void releaseDecoder(PooledDecoder* decoder) const;
+
 		mutable Mutex mMutex;
-		mutable OggVorbisDecoder mVorbisReader;
+		mutable Vector<PooledDecoder*> mFreeDecoders;
 		bool mNeedsDecompression;
 		UINT32 mBufferId;
 
@@ -3,6 +3,8 @@
 #include "BsOAAudioSource.h"
 #include "BsOAAudio.h"
 #include "BsOAAudioClip.h"
+#include "BsOAAudioListener.h"
+#include "Math/BsMath.h"
 #include "AL/al.h"
 
 namespace bs
@@ -11,13 +13,16 @@ namespace bs
 		: mSavedTime(0.0f), mSavedState(AudioSourceState::Stopped), mGloballyPaused(false), mStreamBuffers()
 		, mBusyBuffers(), mStreamProcessedPosition(0), mStreamQueuedPosition(0), mIsStreaming(false)
 	{
+		// Sources start out virtual, and get assigned a voice once they start playing
 		gOAAudio()._registerSource(this);
-		rebuild();
 	}
 
 	OAAudioSource::~OAAudioSource()
 	{
 		clear();
+
+		// Streaming has been stopped, but the streaming thread might still be in the middle of streaming this source
+		gOAAudio().waitUntilStreamed(this);
 		gOAAudio()._unregisterSource(this);
 	}
 
@@ -36,8 +41,8 @@ namespace bs
 		AudioSource::setTransform(transform);
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -57,8 +62,8 @@ namespace bs
 		AudioSource::setVelocity(velocity);
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -75,8 +80,8 @@ namespace bs
 		AudioSource::setVolume(volume);
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -90,8 +95,8 @@ namespace bs
 		AudioSource::setPitch(pitch);
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -109,8 +114,8 @@ namespace bs
 			loop = false;
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -131,8 +136,8 @@ namespace bs
 		AudioSource::setMinDistance(distance);
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -146,8 +151,8 @@ namespace bs
 		AudioSource::setAttenuation(attenuation);
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -161,6 +166,17 @@ namespace bs
 		if (mGloballyPaused)
 			return;
 
+		if (isVirtual())
+		{
+			mSavedState = AudioSourceState::Playing;
+
+			// Try to assign a voice right away, otherwise the source will be considered on the next voice update
+			if (gOAAudio()._canAssignVoice())
+				rebuild();
+
+			return;
+		}
+
 		if(requiresStreaming())
 		{
 			Lock lock(mMutex);
@@ -173,8 +189,8 @@ namespace bs
 		}
 		
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -192,9 +208,17 @@ namespace bs
 
 	void OAAudioSource::pause()
 	{
+		if (isVirtual())
+		{
+			if (mSavedState == AudioSourceState::Playing)
+				mSavedState = AudioSourceState::Paused;
+
+			return;
+		}
+
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -205,9 +229,18 @@ namespace bs
 
 	void OAAudioSource::stop()
 	{
+		if (isVirtual())
+		{
+			mSavedState = AudioSourceState::Stopped;
+			mSavedTime = 0.0f;
+		}
+
+		// Lock before stopping, so the streaming thread doesn't mistake the stopped source for a buffer underrun
+		Lock lock(mMutex);
+
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -216,15 +249,11 @@ namespace bs
 			alSourcef(mSourceIDs[i], AL_SEC_OFFSET, 0.0f);
 		}
 
-		{
-			Lock lock(mMutex);
+		mStreamProcessedPosition = 0;
+		mStreamQueuedPosition = 0;
 
-			mStreamProcessedPosition = 0;
-			mStreamQueuedPosition = 0;
-
-			if (mIsStreaming)
-				stopStreaming();
-		}
+		if (mIsStreaming)
+			stopStreaming();
 	}
 
 	void OAAudioSource::setGlobalPause(bool pause)
@@ -239,8 +268,8 @@ namespace bs
 			if (pause)
 			{
 				auto& contexts = gOAAudio()._getContexts();
-				UINT32 numContexts = (UINT32)contexts.size();
-				for (UINT32 i = 0; i < numContexts; i++)
+				UINT32 numSources = (UINT32)mSourceIDs.size();
+				for (UINT32 i = 0; i < numSources; i++)
 				{
 					if (contexts.size() > 1)
 						alcMakeContextCurrent(contexts[i]);
@@ -260,6 +289,12 @@ namespace bs
 		if (!mAudioClip.isLoaded())
 			return;
 
+		if (isVirtual())
+		{
+			mSavedTime = Math::clamp(time, 0.0f, mAudioClip->getLength());
+			return;
+		}
+
 		AudioSourceState state = getState();
 		stop();
 
@@ -283,8 +318,8 @@ namespace bs
 		}
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -301,6 +336,9 @@ namespace bs
 
 	float OAAudioSource::getTime() const
 	{
+		if (isVirtual())
+			return mSavedTime;
+
 		Lock lock(mMutex);
 
 		auto& contexts = gOAAudio()._getContexts();
@@ -329,6 +367,9 @@ namespace bs
 
 	AudioSourceState OAAudioSource::getState() const
 	{
+		if (isVirtual())
+			return mSavedState;
+
 		ALint state;
 		alGetSourcei(mSourceIDs[0], AL_SOURCE_STATE, &state);
 
@@ -347,15 +388,18 @@ namespace bs
 
 	void OAAudioSource::clear()
 	{
+		if (isVirtual())
+			return;
+
 		mSavedState = getState();
 		mSavedTime = getTime();
 		stop();
 		
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
+		UINT32 numSources = (UINT32)mSourceIDs.size();
 		
 		Lock lock(mMutex);
-		for (UINT32 i = 0; i < numContexts; i++)
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -365,6 +409,7 @@ namespace bs
 		}
 
 		mSourceIDs.clear();
+		gOAAudio().mNumVoices--;
 	}
 
 	void OAAudioSource::rebuild()
@@ -372,6 +417,11 @@ namespace bs
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 
+		if (!isVirtual() || numContexts == 0)
+			return;
+
+		gOAAudio().mNumVoices++;
+
 		{
 			Lock lock(mMutex);
 
@@ -461,8 +511,8 @@ namespace bs
 		gOAAudio().stopStreaming(this);
 
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -487,6 +537,10 @@ namespace bs
 
 	void OAAudioSource::streamUnlocked()
 	{
+		// Streaming might have been stopped after the streaming thread already decided to stream this source
+		if (!mIsStreaming)
+			return;
+
 		AudioDataInfo info;
 		info.bitDepth = mAudioClip->getBitDepth();
 		info.numChannels = mAudioClip->getNumChannels();
@@ -498,8 +552,8 @@ namespace bs
 		// Note: It is safe to access contexts here only because it is guaranteed by the OAAudio manager that it will always
 		// stop all streaming before changing contexts. Otherwise a mutex lock would be needed for every context access.
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -577,6 +631,31 @@ namespace bs
 			else
 				break;
 		}
+
+		// If a source played through all of its queued buffers before we could queue new ones, OpenAL stops it. Resume
+		// playback now that new data is queued.
+		for (UINT32 i = 0; i < numSources; i++)
+		{
+			if (contexts.size() > 1)
+				alcMakeContextCurrent(contexts[i]);
+
+			INT32 state;
+			alGetSourcei(mSourceIDs[i], AL_SOURCE_STATE, &state);
+
+			if (state != AL_STOPPED)
+				continue;
+
+			INT32 numQueuedBuffers = 0;
+			alGetSourcei(mSourceIDs[i], AL_BUFFERS_QUEUED, &numQueuedBuffers);
+
+			if (numQueuedBuffers > 0)
+			{
+				alSourcePlay(mSourceIDs[i]);
+
+				mNumStreamingUnderruns++;
+				gOAAudio().mNumStreamingUnderruns++;
+			}
+		}
 	}
 
 	bool OAAudioSource::fillBuffer(UINT32 buffer, AudioDataInfo& info, UINT32 maxNumSamples)
@@ -593,8 +672,11 @@ namespace bs
 				return false;
 		}
 
-		// Read audio data
-		UINT32 numSamples = std::min(numRemainingSamples, info.sampleRate * info.numChannels); // 1 second of data
+		// Read audio data, the read-ahead amount being split evenly between the buffers
+		float bufferDuration = gOAAudio().getStreamingReadAhead() / StreamBufferCount;
+		UINT32 numBufferSamples = (UINT32)(info.sampleRate * bufferDuration) * info.numChannels;
+
+		UINT32 numSamples = std::min(numRemainingSamples, std::max(numBufferSamples, info.numChannels));
 		UINT32 sampleBufferSize = numSamples * (info.bitDepth / 8);
 
 		UINT8* samples = (UINT8*)bs_stack_alloc(sampleBufferSize);
@@ -615,8 +697,8 @@ namespace bs
 	void OAAudioSource::applyClip()
 	{
 		auto& contexts = gOAAudio()._getContexts();
-		UINT32 numContexts = (UINT32)contexts.size();
-		for (UINT32 i = 0; i < numContexts; i++)
+		UINT32 numSources = (UINT32)mSourceIDs.size();
+		for (UINT32 i = 0; i < numSources; i++)
 		{
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
@@ -661,6 +743,50 @@ namespace bs
 			pause();
 	}
 
+	void OAAudioSource::updateVirtual(float deltaTime)
+	{
+		if (!isVirtual() || mSavedState != AudioSourceState::Playing || !mAudioClip.isLoaded())
+			return;
+
+		float length = mAudioClip->getLength();
+		mSavedTime += deltaTime * mPitch;
+
+		if (mSavedTime >= length)
+		{
+			if (mLoop && length > 0.0f)
+				mSavedTime = std::fmod(mSavedTime, length);
+			else
+			{
+				mSavedState = AudioSourceState::Stopped;
+				mSavedTime = 0.0f;
+			}
+		}
+	}
+
+	float OAAudioSource::getAudibility(const Vector<OAAudioListener*>& listeners) const
+	{
+		if (!is3D())
+			return mVolume;
+
+		// Matches the default OpenAL distance model (AL_INVERSE_DISTANCE_CLAMPED), using the nearest listener
+		const Vector3 position = mTransform.getPosition();
+
+		float minDistance;
+		if (!listeners.empty())
+		{
+			minDistance = std::numeric_limits<float>::max();
+			for (auto& listener : listeners)
+			{
+				float distance = listener->getTransform().getPosition().distance(position);
+				minDistance = std::min(minDistance, distance);
+			}
+		}
+		else
+			minDistance = position.length();
+
+		return AudioUtility::calculateAudibility(mVolume, minDistance, mMinDistance, mAttenuation);
+	}
+
 	bool OAAudioSource::is3D() const
 	{
 		if (!mAudioClip.isLoaded())
@@ -63,6 +63,12 @@ namespace bs
 		/** @copydoc AudioSource::getState */
 		AudioSourceState getState() const override;
 
+		/** 
+		 * Returns the number of times the source ran out of streamed data before more could be provided, causing an
+		 * audible gap in playback. Always zero for sources that don't stream.
+		 */
+		UINT32 getNumStreamingUnderruns() const { return mNumStreamingUnderruns; }
+
 	private:
 		friend class OAAudio;
 
@@ -87,6 +93,22 @@ namespace bs
 		/** Pauses or resumes audio playback due to the global pause setting. */
 		void setGlobalPause(bool pause);
 
+		/** 
+		 * Checks if the source is virtual. Virtual sources have no OpenAL sources (voices) assigned, and only keep track
+		 * of their playback state and time. The voice is assigned or released by OAAudio depending on the source's
+		 * priority and audibility, using clear() and rebuild().
+		 */
+		bool isVirtual() const { return mSourceIDs.empty(); }
+
+		/** Advances the playback time of a virtual source by the provided amount, in seconds. */
+		void updateVirtual(float deltaTime);
+
+		/** 
+		 * Estimates how loud the source is as heard by the closest of the provided listeners, in range [0, 1]. Used for
+		 * deciding which sources get assigned a voice.
+		 */
+		float getAudibility(const Vector<OAAudioListener*>& listeners) const;
+
 		/** 
 		 * Returns true if the sound source is three dimensional (volume and pitch varies based on listener distance
 		 * and velocity). 
@@ -112,6 +134,7 @@ namespace bs
 		float mSavedTime;
 		AudioSourceState mSavedState;
 		bool mGloballyPaused;
+		bool mRequiresVoice = false;
 
 		static const UINT32 StreamBufferCount = 3; // Maximum 32
 		UINT32 mStreamBuffers[StreamBufferCount];
@@ -119,6 +142,7 @@ namespace bs
 		UINT32 mStreamProcessedPosition;
 		UINT32 mStreamQueuedPosition;
 		bool mIsStreaming;
+		UINT32 mNumStreamingUnderruns = 0;
 		mutable Mutex mMutex;
 	};
 
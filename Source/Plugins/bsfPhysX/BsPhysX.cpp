@@ -18,9 +18,12 @@
 #include "BsPhysXD6Joint.h"
 #include "BsPhysXCharacterController.h"
 #include "Threading/BsTaskScheduler.h"
+#include "Threading/BsTaskQueue.h"
 #include "Components/BsCCollider.h"
 #include "BsFPhysXCollider.h"
 #include "Utility/BsTime.h"
+#include "BsCoreApplication.h"
+#include "Scene/BsSceneObject.h"
 #include "Math/BsVector3.h"
 #include "Math/BsAABox.h"
 #include "Math/BsCapsule.h"
@@ -287,23 +290,33 @@ namespace bs
 	class PhysXCPUDispatcher : public PxCpuDispatcher
 	{
 	public:
+		PhysXCPUDispatcher()
+			:mQueue("PhysX")
+		{ }
+
 		void submitTask(PxBaseTask& physxTask) override
 		{
-			// Note: Banshee's task scheduler is pretty low granularity. Consider a better task manager in case PhysX ends
-			// up submitting many tasks.
-			// - PhysX's task manager doesn't seem much lighter either. But perhaps I can at least create a task pool to 
-			//   avoid allocating them constantly.
-
-			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
-			SPtr<Task> task = Task::create("PhysX", runTask);
-
-			TaskScheduler::instance().addTask(task);
+			// Note: PhysX can submit hundreds of small tasks per step, so instead of creating a scheduler task for each
+			// they're queued on a lightweight queue drained by a few scheduler tasks
+			mQueue.submit(&PhysXCPUDispatcher::runTask, &physxTask);
 		}
 
 		PxU32 getWorkerCount() const override
 		{
 			return (PxU32)TaskScheduler::instance().getNumWorkers();
 		}
+
+	private:
+		/** Executes a single PhysX task. */
+		static void runTask(void* data)
+		{
+			PxBaseTask* physxTask = (PxBaseTask*)data;
+
+			physxTask->run();
+			physxTask->release();
+		}
+
+		TaskQueue mQueue;
 	};
 
 	class PhysXBroadPhaseCallback : public PxBroadPhaseCallback
@@ -507,6 +520,11 @@ namespace bs
 
 	PhysX::~PhysX()
 	{
+		fetchResults();
+
+		if (mScratchBuffer != nullptr)
+			bs_free_aligned16(mScratchBuffer);
+
 		mCharManager->release();
 		mScene->release();
 
@@ -519,13 +537,30 @@ namespace bs
 
 	void PhysX::fixedUpdate(float step)
 	{
+		// Finish the step started by the previous fixed update (if running asynchronously), even if paused
+		fetchResults();
+
 		if (mPaused)
+		{
+			triggerEvents();
 			return;
+		}
 
-		mUpdateInProgress = true;
+		if (mFlags.isSet(PhysicsFlag::AsyncSimulation))
+		{
+			triggerEvents();
+
+			// Scratch buffer must persist until the results are fetched, so it can't be allocated from the frame allocator
+			if (mScratchBuffer == nullptr)
+				mScratchBuffer = (UINT8*)bs_alloc_aligned16(SCRATCH_BUFFER_SIZE);
+
+			// Start the next step, its results will be fetched during the next fixed update
+			mScene->simulate(step, nullptr, mScratchBuffer, SCRATCH_BUFFER_SIZE);
+			mSimulationInProgress = true;
+
+			return;
+		}
 
-		// Note: Consider delaying fetchResults one frame. This could improve performance because Physics update would be
-		//       able to run parallel to the simulation thread, but at a cost to input latency.
 		bs_frame_mark();
 		UINT8* scratchBuffer = bs_frame_alloc_aligned(SCRATCH_BUFFER_SIZE, 16);
 
@@ -538,36 +573,144 @@ namespace bs
 		bs_frame_free_aligned(scratchBuffer);
 		bs_frame_clear();
 
+		updateTransforms(false);
+		triggerEvents();
+	}
+
+	void PhysX::update()
+	{
+		if (mInterpolatedRigidbodies.empty())
+			return;
+
+		// Note: Interpolated transforms lag behind the simulation for up to one fixed update step
+		float t = gCoreApplication().getFixedUpdateFraction();
+
+		for (auto& entry : mInterpolatedRigidbodies)
+		{
+			mTransformObjects.push_back(entry.sceneObject);
+			mTransformPositions.push_back(Vector3::lerp(t, entry.startPosition, entry.endPosition));
+			mTransformRotations.push_back(Quaternion::lerp(t, entry.startRotation, entry.endRotation));
+		}
+
+		applyTransforms();
+	}
+
+	void PhysX::fetchResults()
+	{
+		if (!mSimulationInProgress)
+			return;
+
+		UINT32 errorState;
+		if (!mScene->fetchResults(true, &errorState))
+			LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
+
+		mSimulationInProgress = false;
+		updateTransforms(mFlags.isSet(PhysicsFlag::AsyncSimulation));
+	}
+
+	void PhysX::updateTransforms(bool interpolate)
+	{
+		// Move any rigidbodies still being interpolated to their final transforms
+		for (auto& entry : mInterpolatedRigidbodies)
+		{
+			mTransformObjects.push_back(entry.sceneObject);
+			mTransformPositions.push_back(entry.endPosition);
+			mTransformRotations.push_back(entry.endRotation);
+
+			entry.rigidbody->_setInterpolationIdx((UINT32)-1);
+		}
+
+		mInterpolatedRigidbodies.clear();
+		applyTransforms();
+
 		// Update rigidbodies with new transforms
 		PxU32 numActiveTransforms;
 		const PxActiveTransform* activeTransforms = mScene->getActiveTransforms(numActiveTransforms);
 
-		for (PxU32 i = 0; i < numActiveTransforms; i++)
+		if (interpolate)
+			mInterpolatedRigidbodies.reserve(numActiveTransforms);
+		else
 		{
-			Rigidbody* rigidbody = static_cast<Rigidbody*>(activeTransforms[i].userData);
+			mTransformObjects.reserve(numActiveTransforms);
+			mTransformPositions.reserve(numActiveTransforms);
+			mTransformRotations.reserve(numActiveTransforms);
+		}
 
+		for (PxU32 i = 0; i < numActiveTransforms; i++)
+		{
 			// Note: This should never happen, as actors gets their userData set to null when they're destroyed. However
 			// in some cases PhysX seems to keep those actors alive for a frame or few, and reports their state here. Until
 			// I find out why I need to perform this check.
 			if(activeTransforms[i].actor->userData == nullptr)
 				continue;
 
+			PhysXRigidbody* rigidbody = static_cast<PhysXRigidbody*>(activeTransforms[i].userData);
+			SceneObject* so = rigidbody->_getLinkedSO().get();
 			const PxTransform& transform = activeTransforms[i].actor2World;
 
-			// Note: Make this faster, avoid dereferencing Rigidbody and attempt to access pos/rot destination directly,
-			//       use non-temporal writes
-			rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
+			if (interpolate)
+			{
+				// Interpolate from the transform resulting from the previous step, towards the new one
+				const Transform& currentTfrm = so->getTransform();
+
+				InterpolatedRigidbody entry;
+				entry.rigidbody = rigidbody;
+				entry.sceneObject = so;
+				entry.startPosition = currentTfrm.getPosition();
+				entry.startRotation = currentTfrm.getRotation();
+				entry.endPosition = fromPxVector(transform.p);
+				entry.endRotation = fromPxQuaternion(transform.q);
+
+				rigidbody->_setInterpolationIdx((UINT32)mInterpolatedRigidbodies.size());
+				mInterpolatedRigidbodies.push_back(entry);
+			}
+			else
+			{
+				mTransformObjects.push_back(so);
+				mTransformPositions.push_back(fromPxVector(transform.p));
+				mTransformRotations.push_back(fromPxQuaternion(transform.q));
+			}
 		}
 
-		// Note: Consider extrapolating for the remaining "simulationAmount" value
+		applyTransforms();
+	}
+
+	void PhysX::applyTransforms()
+	{
+		if (mTransformObjects.empty())
+			return;
+
+		mUpdateInProgress = true;
+
+		SceneObject::_setWorldTransforms(mTransformObjects.data(), mTransformPositions.data(),
+			mTransformRotations.data(), (UINT32)mTransformObjects.size());
+
 		mUpdateInProgress = false;
 
-		triggerEvents();
+		mTransformObjects.clear();
+		mTransformPositions.clear();
+		mTransformRotations.clear();
 	}
 
-	void PhysX::update()
+	void PhysX::_waitForSimulation()
 	{
-		// Note: Potentially interpolate (would mean a one frame delay needs to be introduced)
+		fetchResults();
+	}
+
+	void PhysX::_stopInterpolation(PhysXRigidbody* rigidbody)
+	{
+		UINT32 idx = rigidbody->_getInterpolationIdx();
+		if (idx == (UINT32)-1)
+			return;
+
+		if (idx != (UINT32)mInterpolatedRigidbodies.size() - 1)
+		{
+			mInterpolatedRigidbodies[idx] = mInterpolatedRigidbodies.back();
+			mInterpolatedRigidbodies[idx].rigidbody->_setInterpolationIdx(idx);
+		}
+
+		mInterpolatedRigidbodies.pop_back();
+		rigidbody->_setInterpolationIdx((UINT32)-1);
 	}
 
 	void PhysX::_reportContactEvent(const ContactEvent& event)
@@ -1110,6 +1253,7 @@ namespace bs
 
 	void PhysX::setFlag(PhysicsFlags flag, bool enabled)
 	{
+		_waitForSimulation();
 		Physics::setFlag(flag, enabled);
 
 		mCharManager->setOverlapRecoveryModule(mFlags.isSet(PhysicsFlag::CCT_OverlapRecovery));
@@ -1141,6 +1285,8 @@ namespace bs
 
 	UINT32 PhysX::addBroadPhaseRegion(const AABox& region)
 	{
+		_waitForSimulation();
+
 		UINT32 id = mNextRegionIdx++;
 
 		PxBroadPhaseRegion pxRegion;
@@ -1155,6 +1301,8 @@ namespace bs
 
 	void PhysX::removeBroadPhaseRegion(UINT32 regionId)
 	{
+		_waitForSimulation();
+
 		auto iterFind = mBroadPhaseRegionHandles.find(regionId);
 		if (iterFind == mBroadPhaseRegionHandles.end())
 			return;
@@ -1165,6 +1313,8 @@ namespace bs
 
 	void PhysX::clearBroadPhaseRegions()
 	{
+		_waitForSimulation();
+
 		for(auto& entry : mBroadPhaseRegionHandles)
 			mScene->removeBroadPhaseRegion(entry.second);
 
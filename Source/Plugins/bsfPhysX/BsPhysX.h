@@ -51,6 +51,17 @@ namespace bs
 			Joint* joint; /** Broken joint. */
 		};
 
+		/** Rigidbody whose scene object transform is being interpolated towards the last simulated transform. */
+		struct InterpolatedRigidbody
+		{
+			PhysXRigidbody* rigidbody;
+			SceneObject* sceneObject;
+			Vector3 startPosition;
+			Quaternion startRotation;
+			Vector3 endPosition;
+			Quaternion endRotation;
+		};
+
 	public:
 		PhysX(const PHYSICS_INIT_DESC& input);
 		~PhysX();
@@ -238,6 +249,16 @@ namespace bs
 		/** Triggered by the PhysX simulation when a joint breaks. */
 		void _reportJointBreakEvent(const JointBreakEvent& event);
 
+		/** 
+		 * Blocks until the asynchronous simulation step currently in progress, if any, finishes. Must be called before
+		 * performing operations that are not allowed while the scene is being simulated. Does nothing if asynchronous
+		 * simulation is disabled.
+		 */
+		void _waitForSimulation();
+
+		/** Stops interpolating the transform of the provided rigidbody. Called when the rigidbody is destroyed. */
+		void _stopInterpolation(PhysXRigidbody* rigidbody);
+
 		/** Returns the default PhysX material. */
 		physx::PxMaterial* getDefaultMaterial() const { return mDefaultMaterial; }
 
@@ -259,6 +280,21 @@ namespace bs
 		/** Sends out all events recorded during simulation to the necessary physics objects. */
 		void triggerEvents();
 
+		/** 
+		 * Retrieves the results of the simulation step in progress and updates the rigidbody transforms. Does nothing if
+		 * no step is in progress.
+		 */
+		void fetchResults();
+
+		/**
+		 * Updates transforms of all rigidbodies moved by the last simulation step. If @p interpolate is true the
+		 * transforms will instead be interpolated towards their new values during following update() calls.
+		 */
+		void updateTransforms(bool interpolate);
+
+		/** Writes all transforms queued in the transform buffers to their scene objects, and clears the buffers. */
+		void applyTransforms();
+
 		/**
 		 * Helper method that performs a sweep query by checking if the provided geometry hits any physics objects
 		 * when moved along the specified direction. Returns information about the first hit.
@@ -291,11 +327,19 @@ namespace bs
 		float mTesselationLength = 3.0f;
 		UINT32 mNextRegionIdx = 1;
 		bool mPaused = false;
+		bool mSimulationInProgress = false;
+		UINT8* mScratchBuffer = nullptr;
 
 		Vector<TriggerEvent> mTriggerEvents;
 		Vector<ContactEvent> mContactEvents;
 		Vector<JointBreakEvent> mJointBreakEvents;
 		UnorderedMap<UINT32, UINT32> mBroadPhaseRegionHandles;
+		Vector<InterpolatedRigidbody> mInterpolatedRigidbodies;
+
+		// Transforms to be written to scene objects, kept as separate arrays so they can be applied in bulk
+		Vector<SceneObject*> mTransformObjects;
+		Vector<Vector3> mTransformPositions;
+		Vector<Quaternion> mTransformRotations;
 
 		physx::PxFoundation* mFoundation = nullptr;
 		physx::PxPhysics* mPhysics = nullptr;
@@ -59,6 +59,9 @@ namespace bs
 
 	PhysXRigidbody::~PhysXRigidbody()
 	{
+		if (mInterpolationIdx != (UINT32)-1)
+			gPhysX()._stopInterpolation(this);
+
 		mInternal->userData = nullptr;
 		mInternal->release();
 	}
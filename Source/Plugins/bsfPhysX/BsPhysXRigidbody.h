@@ -157,8 +157,15 @@ namespace bs
 		/** Returns the internal PhysX dynamic actor. */
 		physx::PxRigidDynamic* _getInternal() const { return mInternal; }
 
+		/** Returns the index of the rigidbody in the list of rigidbodies being interpolated, or -1 if not interpolated. */
+		UINT32 _getInterpolationIdx() const { return mInterpolationIdx; }
+
+		/** @copydoc _getInterpolationIdx */
+		void _setInterpolationIdx(UINT32 idx) { mInterpolationIdx = idx; }
+
 	private:
 		physx::PxRigidDynamic* mInternal;
+		UINT32 mInterpolationIdx = (UINT32)-1;
 	};
 
 	/** @} */
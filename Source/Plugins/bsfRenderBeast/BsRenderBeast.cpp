@@ -7,6 +7,8 @@
 #include "Material/BsMaterial.h"
 #include "Material/BsShader.h"
 #include "Material/BsPass.h"
+#include "Material/BsMaterialParams.h"
+#include "Image/BsTextureStreamer.h"
 #include "RenderAPI/BsViewport.h"
 #include "RenderAPI/BsRenderTarget.h"
 #include "RenderAPI/BsGpuParamBlockBuffer.h"
@@ -355,6 +357,7 @@ namespace bs { namespace ct
 
 			mMainViewGroup->setViews(views.data(), (UINT32)views.size());
 			mMainViewGroup->determineVisibility(sceneInfo);
+			reportTextureUsage(*mMainViewGroup);
 
 			// Render everything
 			renderViews(*mMainViewGroup, frameInfo);
@@ -367,6 +370,69 @@ namespace bs { namespace ct
 		gProfilerCPU().endSample("renderAllCore");
 	}
 
+	void RenderBeast::reportTextureUsage(const RendererViewGroup& viewGroup)
+	{
+		// Avoid walking the material parameters of every visible renderable when there is nothing to stream
+		if (!TextureStreamer::isStarted() || TextureStreamer::instance().getNumTextures() == 0)
+			return;
+
+		const SceneInfo& sceneInfo = mScene->getSceneInfo();
+		UnorderedMap<const Texture*, float> screenSizes;
+
+		for (UINT32 i = 0; i < viewGroup.getNumViews(); i++)
+		{
+			const RendererView* view = viewGroup.getView(i);
+			if (view->getRenderSettings().overlayOnly)
+				continue;
+
+			const RendererViewProperties& viewProps = view->getProperties();
+			const VisibilityInfo& visibility = view->getVisibilityMasks();
+			float pixelsPerUnit = viewProps.viewRect.height * 0.5f * viewProps.projTransform[1][1];
+
+			for (UINT32 j = 0; j < (UINT32)visibility.renderables.size(); j++)
+			{
+				if (!visibility.renderables[j])
+					continue;
+
+				const Sphere& bounds = sceneInfo.renderableCullInfos[j].bounds.getSphere();
+
+				float screenSize = 2.0f * bounds.getRadius() * pixelsPerUnit;
+				if (viewProps.projType != PT_ORTHOGRAPHIC)
+				{
+					float distance = viewProps.viewOrigin.distance(bounds.getCenter()) - bounds.getRadius();
+					screenSize /= std::max(distance, viewProps.nearPlane);
+				}
+
+				for (auto& element : sceneInfo.renderables[j]->elements)
+				{
+					if (element.material == nullptr)
+						continue;
+
+					SPtr<MaterialParams> params = element.material->_getInternalParams();
+					for (UINT32 k = 0; k < params->getNumParams(); k++)
+					{
+						const MaterialParams::ParamData* paramData = params->getParamData(k);
+						if (paramData->type != MaterialParams::ParamType::Texture || params->getIsTextureLoadStore(*paramData))
+							continue;
+
+						SPtr<Texture> texture;
+						TextureSurface surface;
+						params->getTexture(*paramData, texture, surface);
+
+						if (texture == nullptr)
+							continue;
+
+						float& maxScreenSize = screenSizes[texture.get()];
+						maxScreenSize = std::max(maxScreenSize, screenSize);
+					}
+				}
+			}
+		}
+
+		if (!screenSizes.empty())
+			TextureStreamer::instance()._notifyTextureUsage(screenSizes);
+	}
+
 	void RenderBeast::renderViews(RendererViewGroup& viewGroup, const FrameInfo& frameInfo)
 	{
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
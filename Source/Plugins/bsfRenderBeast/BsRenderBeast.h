@@ -171,6 +171,15 @@ namespace bs
 		 */
 		void renderView(const RendererViewGroup& viewGroup, RendererView& view, const FrameInfo& frameInfo);
 
+		/**
+		 * Reports the on-screen size of textures used by renderables visible in the provided view group to the
+		 * TextureStreamer, so it can determine which mip levels need to be resident. The size of a texture is
+		 * approximated by the projected diameter of the bounds of the renderables using it.
+		 *
+		 * @note	Core thread only.
+		 */
+		void reportTextureUsage(const RendererViewGroup& viewGroup);
+
 		/**
 		 * Renders all overlay callbacks of the provided view.
 		 * 					
@@ -8,6 +8,7 @@
 #include "RenderAPI/BsGpuBuffer.h"
 #include "Utility/BsBitwise.h"
 #include "Mesh/BsMesh.h"
+#include "Profiling/BsProfilerGPU.h"
 #include "Material/BsGpuParamsSet.h"
 #include "Utility/BsGpuResourcePool.h"
 #include "Utility/BsRendererTextures.h"
@@ -26,6 +27,34 @@ namespace bs { namespace ct
 {
 	UnorderedMap<StringID, RenderCompositor::NodeType*> RenderCompositor::mNodeTypes;
 
+	UINT32 RenderCompositorResources::createOutput(const POOLED_RENDER_TEXTURE_DESC& desc)
+	{
+		TRANSIENT_RENDER_TEXTURE_DESC transientDesc;
+		transientDesc.desc = desc;
+		transientDesc.firstUse = mNodeIdx;
+		transientDesc.lastUse = mNodeLastUseIdx;
+
+		mDescs.push_back(transientDesc);
+		return (UINT32)mDescs.size() - 1;
+	}
+
+	UINT32 RenderCompositorResources::createTemporary(const POOLED_RENDER_TEXTURE_DESC& desc)
+	{
+		TRANSIENT_RENDER_TEXTURE_DESC transientDesc;
+		transientDesc.desc = desc;
+		transientDesc.firstUse = mNodeIdx;
+		transientDesc.lastUse = mNodeIdx;
+
+		mDescs.push_back(transientDesc);
+		return (UINT32)mDescs.size() - 1;
+	}
+
+	const SPtr<PooledRenderTexture>& RenderCompositorResources::getTexture(UINT32 handle) const
+	{
+		assert(mTextures != nullptr && handle < (UINT32)mTextures->textures.size());
+		return mTextures->textures[handle];
+	}
+
 	RenderCompositor::~RenderCompositor()
 	{
 		clear();
@@ -85,6 +114,7 @@ namespace bs { namespace ct
 					NodeInfo& nodeInfo = mNodeInfos.back();
 					nodeInfo.node = nodeType->create();
 					nodeInfo.lastUseIdx = -1;
+					nodeInfo.sampleName = nodeId.cstr();
 
 					for (auto& depId : depIds)
 					{
@@ -129,6 +159,14 @@ namespace bs { namespace ct
 				clear();
 		}
 		bs_frame_clear();
+
+		// Determine after which node's execution can each node's resources be released. Only the final node has no
+		// users, and it gets released once all nodes execute.
+		for (auto& entry : mNodeInfos)
+		{
+			if (entry.lastUseIdx != (UINT32)-1)
+				mNodeInfos[entry.lastUseIdx].releasedNodes.push_back(entry.node);
+		}
 	}
 
 	void RenderCompositor::execute(RenderCompositorNodeInputs& inputs) const
@@ -136,37 +174,59 @@ namespace bs { namespace ct
 		if (!mIsValid)
 			return;
 
-		bs_frame_mark();
+		// Let the nodes declare their transient textures. Outputs live until the last node depending on them executes,
+		// which for the final node is the end of the frame.
+		mResources.mDescs.clear();
+		for (UINT32 i = 0; i < (UINT32)mNodeInfos.size(); i++)
 		{
-			FrameVector<const NodeInfo*> activeNodes;
+			const NodeInfo& entry = mNodeInfos[i];
 
-			UINT32 idx = 0;
-			for (auto& entry : mNodeInfos)
-			{
-				inputs.inputNodes = entry.inputs;
-				entry.node->render(inputs);
+			mResources.mNodeIdx = i;
+			mResources.mNodeLastUseIdx = entry.lastUseIdx != (UINT32)-1 ? entry.lastUseIdx : i;
 
-				activeNodes.push_back(&entry);
+			inputs.inputNodes = entry.inputs;
+			entry.node->declareResources(inputs, mResources);
+		}
 
-				for (UINT32 i = 0; i < (UINT32)activeNodes.size(); ++i)
-				{
-					if (activeNodes[i] == nullptr)
-						continue;
+		// Allocate the textures, sharing memory between those whose lifetimes don't overlap. If the declarations match
+		// the previous frame, the previously allocated set is reused.
+		GpuResourcePool& resPool = GpuResourcePool::instance();
+		if (!mResources.mDescs.empty())
+			mResources.mTextures = resPool.get(mResources.mDescs);
+		else
+			mResources.mTextures = nullptr;
 
-					if (activeNodes[i]->lastUseIdx <= idx)
-					{
-						activeNodes[i]->node->clear();
-						activeNodes[i] = nullptr;
-					}
-				}
+		inputs.resources = &mResources;
+
+		// Views rendered outside of the main frame (e.g. reflection probe captures) cannot be profiled
+		ProfilerGPU& profiler = gProfilerGPU();
+		const bool profile = profiler.isFrameActive();
 
-				idx++;
+		for (auto& entry : mNodeInfos)
+		{
+			inputs.inputNodes = entry.inputs;
+
+			if (profile)
+			{
+				profiler.beginSample(entry.sampleName);
+				entry.node->render(inputs);
+				profiler.endSample(entry.sampleName);
 			}
+			else
+				entry.node->render(inputs);
+
+			for (auto& releasedNode : entry.releasedNodes)
+				releasedNode->clear();
 		}
-		bs_frame_clear();
 
 		if (!mNodeInfos.empty())
 			mNodeInfos.back().node->clear();
+
+		// Keep a reference so the set stays in the pool for the next frame
+		if (mResources.mTextures != nullptr)
+			resPool.release(mResources.mTextures);
+
+		inputs.resources = nullptr;
 	}
 
 	void RenderCompositor::clear()
@@ -202,10 +262,8 @@ namespace bs { namespace ct
 		return {};
 	}
 
-	void RCNodeGBuffer::render(const RenderCompositorNodeInputs& inputs)
+	void RCNodeGBuffer::declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources)
 	{
-		// Allocate necessary textures & targets
-		GpuResourcePool& resPool = GpuResourcePool::instance();
 		const RendererViewProperties& viewProps = inputs.view.getProperties();
 
 		UINT32 width = viewProps.viewRect.width;
@@ -213,12 +271,22 @@ namespace bs { namespace ct
 		UINT32 numSamples = viewProps.numSamples;
 
 		// Note: Consider customizable formats. e.g. for testing if quality can be improved with higher precision normals.
-		albedoTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA8, width, height, TU_RENDERTARGET,
-			numSamples, true));
-		normalTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGB10A2, width, height, TU_RENDERTARGET,
-			numSamples, false));
-		roughMetalTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RG16F, width, height, TU_RENDERTARGET,
-			numSamples, false)); // Note: Metal doesn't need 16-bit float
+		mAlbedoHandle = resources.createOutput(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA8, width, height, 
+			TU_RENDERTARGET, numSamples, true));
+		mNormalHandle = resources.createOutput(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGB10A2, width, height, 
+			TU_RENDERTARGET, numSamples, false));
+		mRoughMetalHandle = resources.createOutput(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RG16F, width, height, 
+			TU_RENDERTARGET, numSamples, false)); // Note: Metal doesn't need 16-bit float
+	}
+
+	void RCNodeGBuffer::render(const RenderCompositorNodeInputs& inputs)
+	{
+		// Retrieve necessary textures & targets
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		albedoTex = inputs.resources->getTexture(mAlbedoHandle);
+		normalTex = inputs.resources->getTexture(mNormalHandle);
+		roughMetalTex = inputs.resources->getTexture(mRoughMetalHandle);
 
 		RCNodeSceneDepth* sceneDepthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[0]);
 		SPtr<PooledRenderTexture> sceneDepthTex = sceneDepthNode->depthTex;
@@ -350,11 +418,7 @@ namespace bs { namespace ct
 
 	void RCNodeGBuffer::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		resPool.release(albedoTex);
-		resPool.release(normalTex);
-		resPool.release(roughMetalTex);
+		// Do nothing, textures are transient and owned by the compositor
 	}
 
 	SmallVector<StringID, 4> RCNodeGBuffer::getDependencies(const RendererView& view)
@@ -447,6 +511,20 @@ namespace bs { namespace ct
 		return { RCNodeSceneDepth::getNodeId() };
 	}
 
+	void RCNodeMSAACoverage::declareResources(const RenderCompositorNodeInputs& inputs, 
+		RenderCompositorResources& resources)
+	{
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+		if(viewProps.numSamples <= 1)
+			return;
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+
+		mOutputHandle = resources.createOutput(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R8, width, height, 
+			TU_RENDERTARGET));
+	}
+
 	void RCNodeMSAACoverage::render(const RenderCompositorNodeInputs& inputs)
 	{
 		const RendererViewProperties& viewProps = inputs.view.getProperties();
@@ -457,12 +535,7 @@ namespace bs { namespace ct
 			return;
 		}
 
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		UINT32 width = viewProps.viewRect.width;
-		UINT32 height = viewProps.viewRect.height;
-
-		output = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R8, width, height, TU_RENDERTARGET));
+		output = inputs.resources->getTexture(mOutputHandle);
 
 		RCNodeGBuffer* gbufferNode = static_cast<RCNodeGBuffer*>(inputs.inputNodes[0]);
 		RCNodeSceneDepth* sceneDepthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[1]);
@@ -488,11 +561,8 @@ namespace bs { namespace ct
 
 	void RCNodeMSAACoverage::clear()
 	{
-		if(output)
-		{
-			GpuResourcePool& resPool = GpuResourcePool::instance();
-			resPool.release(output);
-		}
+		// Texture is transient and owned by the compositor
+		output = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeMSAACoverage::getDependencies(const RendererView& view)
@@ -500,6 +570,24 @@ namespace bs { namespace ct
 		return { RCNodeGBuffer::getNodeId(), RCNodeSceneDepth::getNodeId() };
 	}
 
+	void RCNodeLightAccumulation::declareResources(const RenderCompositorNodeInputs& inputs, 
+		RenderCompositorResources& resources)
+	{
+		// Scene color is used directly if tiled deferred is not supported
+		bool supportsTiledDeferred = gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::DesktopMacOS;
+		if(!supportsTiledDeferred)
+			return;
+
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+		UINT32 numSamples = viewProps.numSamples;
+
+		mOutputHandle = resources.createOutput(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, 
+			TU_LOADSTORE | TU_RENDERTARGET, numSamples, false));
+	}
+
 	void RCNodeLightAccumulation::render(const RenderCompositorNodeInputs& inputs)
 	{
 		bool supportsTiledDeferred = gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::DesktopMacOS;
@@ -543,8 +631,7 @@ namespace bs { namespace ct
 		else
 			flattenedLightAccumBuffer = nullptr;
 
-		lightAccumulationTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width,
-			height, TU_LOADSTORE | TU_RENDERTARGET, numSamples, false));
+		lightAccumulationTex = inputs.resources->getTexture(mOutputHandle);
 
 		bool rebuildRT;
 		if (renderTarget != nullptr)
@@ -586,9 +673,9 @@ namespace bs { namespace ct
 	void RCNodeLightAccumulation::clear()
 	{
 		GpuResourcePool& resPool = GpuResourcePool::instance();
-		if(mOwnsTexture)
-			resPool.release(lightAccumulationTex);
-		else
+
+		// Owned texture is transient and belongs to the compositor, so only a borrowed texture needs to be let go
+		if(!mOwnsTexture)
 		{
 			lightAccumulationTex = nullptr;
 			renderTarget = nullptr;
@@ -611,6 +698,24 @@ namespace bs { namespace ct
 		return deps;
 	}
 
+	void RCNodeDeferredDirectLighting::declareResources(const RenderCompositorNodeInputs& inputs, 
+		RenderCompositorResources& resources)
+	{
+		// Light occlusion is only needed when rendering shadowed lights using standard deferred
+		bool tiledDeferredSupported = inputs.featureSet != RenderBeastFeatureSet::DesktopMacOS;
+		if (tiledDeferredSupported && !inputs.view.getRenderSettings().enableShadows)
+			return;
+
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+		UINT32 numSamples = viewProps.numSamples;
+
+		mLightOcclusionHandle = resources.createTemporary(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R8, width, height, 
+			TU_RENDERTARGET, numSamples, false));
+	}
+
 	void RCNodeDeferredDirectLighting::render(const RenderCompositorNodeInputs& inputs)
 	{
 		output = static_cast<RCNodeLightAccumulation*>(inputs.inputNodes[0]);
@@ -658,12 +763,6 @@ namespace bs { namespace ct
 		}
 
 		// Standard deferred used for shadowed lights, or when tiled deferred isn't supported
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		UINT32 width = viewProps.viewRect.width;
-		UINT32 height = viewProps.viewRect.height;
-		UINT32 numSamples = viewProps.numSamples;
-
 		const VisibleLightData& lightData = inputs.viewGroup.getVisibleLightData();
 
 		RenderAPI& rapi = RenderAPI::instance();
@@ -691,9 +790,7 @@ namespace bs { namespace ct
 			}
 		}
 
-		// Allocate light occlusion
-		SPtr<PooledRenderTexture> lightOcclusionTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R8, width,
-			height, TU_RENDERTARGET, numSamples, false));
+		const SPtr<PooledRenderTexture>& lightOcclusionTex = inputs.resources->getTexture(mLightOcclusionHandle);
 
 		bool rebuildRT = false;
 		if (mLightOcclusionRT != nullptr)
@@ -751,8 +848,6 @@ namespace bs { namespace ct
 
 		// Makes sure light accumulation can be read by following passes
 		rapi.setRenderTarget(nullptr);
-
-		resPool.release(lightOcclusionTex);
 	}
 
 	void RCNodeDeferredDirectLighting::clear()
@@ -857,6 +952,24 @@ namespace bs { namespace ct
 		return deps;
 	}
 
+	void RCNodeDeferredIndirectSpecularLighting::declareResources(const RenderCompositorNodeInputs& inputs, 
+		RenderCompositorResources& resources)
+	{
+		// Radiance texture is only needed by standard deferred
+		bool tiledDeferredSupported = inputs.featureSet != RenderBeastFeatureSet::DesktopMacOS;
+		if(tiledDeferredSupported)
+			return;
+
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+		UINT32 numSamples = viewProps.numSamples;
+
+		mIBLRadianceHandle = resources.createTemporary(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, 
+			TU_RENDERTARGET, numSamples, false));
+	}
+
 	void RCNodeDeferredIndirectSpecularLighting::render(const RenderCompositorNodeInputs& inputs)
 	{
 		RCNodeSceneColor* sceneColorNode = static_cast<RCNodeSceneColor*>(inputs.inputNodes[0]);
@@ -907,18 +1020,11 @@ namespace bs { namespace ct
 		{
 			SPtr<RenderTexture>	outputRT = lightAccumNode->renderTarget;
 
-			GpuResourcePool& resPool = GpuResourcePool::instance();
-
-			UINT32 width = viewProps.viewRect.width;
-			UINT32 height = viewProps.viewRect.height;
-			UINT32 numSamples = viewProps.numSamples;
-
 			RenderAPI& rapi = RenderAPI::instance();
 
 			bool isMSAA = viewProps.numSamples > 1;
 
-			SPtr<PooledRenderTexture> iblRadianceTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width,
-				height, TU_RENDERTARGET, numSamples, false));
+			const SPtr<PooledRenderTexture>& iblRadianceTex = inputs.resources->getTexture(mIBLRadianceHandle);
 
 			RENDER_TEXTURE_DESC rtDesc;
 			rtDesc.colorSurfaces[0].texture = iblRadianceTex->texture;
@@ -1388,24 +1494,13 @@ namespace bs { namespace ct
 	}
 
 	RCNodePostProcess::RCNodePostProcess()
-		:mOutput(), mAllocated()
+		:mOutput(), mAllocated(), mOutputHandles()
 	{ }
 
 	void RCNodePostProcess::getAndSwitch(const RendererView& view, SPtr<RenderTexture>& output, SPtr<Texture>& lastFrame) const
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		const RendererViewProperties& viewProps = view.getProperties();
-		UINT32 width = viewProps.viewRect.width;
-		UINT32 height = viewProps.viewRect.height;
-
-		if(!mAllocated[mCurrentIdx])
-		{
-			mOutput[mCurrentIdx] = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA8, width, height,
-					TU_RENDERTARGET, 1, false));
-
-			mAllocated[mCurrentIdx] = true;
-		}
+		assert(mCurrentIdx < mNumOutputs && "Post-process effect was not accounted for in declareResources().");
+		mAllocated[mCurrentIdx] = true;
 
 		output = mOutput[mCurrentIdx]->renderTexture;
 
@@ -1425,20 +1520,39 @@ namespace bs { namespace ct
 		return nullptr;
 	}
 
+	void RCNodePostProcess::declareResources(const RenderCompositorNodeInputs& inputs, 
+		RenderCompositorResources& resources)
+	{
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+		const RenderSettings& settings = inputs.view.getRenderSettings();
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+
+		// Tonemapping always outputs to a post-process texture, while any effect following it needs the second texture
+		// so it can read the previous output
+		mNumOutputs = 1;
+		if (RCNodeGaussianDOF::isEnabled(settings) || settings.enableFXAA)
+			mNumOutputs = 2;
+
+		for (UINT32 i = 0; i < mNumOutputs; i++)
+		{
+			mOutputHandles[i] = resources.createOutput(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA8, width, height,
+				TU_RENDERTARGET, 1, false));
+		}
+	}
+
 	void RCNodePostProcess::render(const RenderCompositorNodeInputs& inputs)
 	{
-		// Do nothing, this is just a helper node
+		for (UINT32 i = 0; i < mNumOutputs; i++)
+			mOutput[i] = inputs.resources->getTexture(mOutputHandles[i]);
 	}
 
 	void RCNodePostProcess::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		if (mAllocated[0])
-			resPool.release(mOutput[0]);
-
-		if (mAllocated[1])
-			resPool.release(mOutput[1]);
+		// Textures are transient and owned by the compositor
+		mOutput[0] = nullptr;
+		mOutput[1] = nullptr;
 
 		mAllocated[0] = false;
 		mAllocated[1] = false;
@@ -1447,7 +1561,9 @@ namespace bs { namespace ct
 
 	SmallVector<StringID, 4> RCNodePostProcess::getDependencies(const RendererView& view)
 	{
-		return {};
+		// Not a real dependency, but ensures the node executes right before the post-process effects, so its output
+		// textures don't need to live during scene rendering and can share memory with textures used there
+		return { RCNodeClusteredForward::getNodeId() };
 	}
 
 	RCNodeTonemapping::~RCNodeTonemapping()
@@ -1668,13 +1784,12 @@ namespace bs { namespace ct
 		RCNodePostProcess* postProcessNode = static_cast<RCNodePostProcess*>(inputs.inputNodes[2]);
 
 		const DepthOfFieldSettings& settings = inputs.view.getRenderSettings().depthOfField;
+		if(!isEnabled(inputs.view.getRenderSettings()))
+			return;
+
 		bool near = settings.nearBlurAmount > 0.0f;
 		bool far = settings.farBlurAmount > 0.0f;
 
-		bool enabled = settings.enabled && (near || far);
-		if(!enabled)
-			return;
-
 		GaussianDOFSeparateMat* separateMat = GaussianDOFSeparateMat::getVariation(near, far);
 		GaussianDOFCombineMat* combineMat = GaussianDOFCombineMat::getVariation(near, far);
 		GaussianBlurMat* blurMat = GaussianBlurMat::get();
@@ -1741,6 +1856,15 @@ namespace bs { namespace ct
 		// Do nothing
 	}
 
+	bool RCNodeGaussianDOF::isEnabled(const RenderSettings& settings)
+	{
+		const DepthOfFieldSettings& dofSettings = settings.depthOfField;
+		bool near = dofSettings.nearBlurAmount > 0.0f;
+		bool far = dofSettings.farBlurAmount > 0.0f;
+
+		return dofSettings.enabled && (near || far);
+	}
+
 	SmallVector<StringID, 4> RCNodeGaussianDOF::getDependencies(const RendererView& view)
 	{
 		return { RCNodeTonemapping::getNodeId(), RCNodeSceneDepth::getNodeId(), RCNodePostProcess::getNodeId() };
@@ -2118,6 +2242,22 @@ namespace bs { namespace ct
 		deallocOutputs();
 	}
 
+	void RCNodeSSR::declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources)
+	{
+		const ScreenSpaceReflectionsSettings& settings = inputs.view.getRenderSettings().screenSpaceReflections;
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		// Resolved scene color is only needed with MSAA
+		if (!settings.enabled || viewProps.numSamples <= 1)
+			return;
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+
+		mResolvedSceneColorHandle = resources.createTemporary(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, 
+			height, TU_RENDERTARGET));
+	}
+
 	void RCNodeSSR::render(const RenderCompositorNodeInputs& inputs)
 	{
 		const ScreenSpaceReflectionsSettings& settings = inputs.view.getRenderSettings().screenSpaceReflections;
@@ -2150,11 +2290,10 @@ namespace bs { namespace ct
 		SPtr<Texture> sceneColor = lightAccumNode->lightAccumulationTex->texture;
 
 		// Resolve multiple samples if MSAA is used
-		SPtr<PooledRenderTexture> resolvedSceneColor;
 		if (viewProps.numSamples > 1)
 		{
-			resolvedSceneColor = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height,
-				TU_RENDERTARGET));
+			const SPtr<PooledRenderTexture>& resolvedSceneColor = 
+				inputs.resources->getTexture(mResolvedSceneColorHandle);
 
 			rapi.setRenderTarget(resolvedSceneColor->renderTexture);
 			gRendererUtility().blit(sceneColor);
@@ -2189,12 +2328,6 @@ namespace bs { namespace ct
 		SSRTraceMat* traceMat = SSRTraceMat::getVariation(settings.quality, viewProps.numSamples > 1, true);
 		traceMat->execute(inputs.view, gbuffer, sceneColor, hiZ, settings, traceRt);
 
-		if (resolvedSceneColor)
-		{
-			resPool.release(resolvedSceneColor);
-			resolvedSceneColor = nullptr;
-		}
-
 		if (mPrevFrame)
 		{
 			mPooledOutput = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, TU_RENDERTARGET));
@@ -3,10 +3,12 @@
 #pragma once
 
 #include "BsRenderBeastPrerequisites.h"
+#include "Utility/BsGpuResourcePool.h"
 
 namespace bs 
 { 
 	class RendererExtension;
+	struct RenderSettings;
 
 namespace ct
 {
@@ -15,6 +17,7 @@ namespace ct
 	class RenderCompositorNode;
 	struct PooledStorageBuffer;
 	struct FrameInfo;
+	class RenderCompositorResources;
 
 	/** @addtogroup RenderBeast
 	 *  @{
@@ -43,6 +46,47 @@ namespace ct
 		SmallVector<RendererExtension*, 4> extOverlay;
 
 		SmallVector<RenderCompositorNode*, 4> inputNodes;
+
+		/** Transient textures declared by the nodes, allocated for the current frame. */
+		const RenderCompositorResources* resources = nullptr;
+	};
+
+	/**
+	 * Transient textures declared by render compositor nodes for a single frame. Textures declared as node outputs are
+	 * written by the declaring node and read by every node that depends on it, so they live until the last of those
+	 * nodes executes. Temporary textures are only used by the node declaring them. Once all nodes have declared their
+	 * textures, they are allocated from the GpuResourcePool using their lifetimes, so that textures used by different
+	 * parts of the frame share the same memory.
+	 */
+	class RenderCompositorResources
+	{
+	public:
+		/** 
+		 * Declares a texture written by the current node and read by the nodes that depend on it. Returns a handle that
+		 * can be used for retrieving the texture once it is allocated.
+		 */
+		UINT32 createOutput(const POOLED_RENDER_TEXTURE_DESC& desc);
+
+		/** 
+		 * Declares a texture only used by the current node during its render() call. Returns a handle that can be used
+		 * for retrieving the texture once it is allocated.
+		 */
+		UINT32 createTemporary(const POOLED_RENDER_TEXTURE_DESC& desc);
+
+		/** 
+		 * Returns the texture allocated for a handle returned by createOutput() or createTemporary(). Contents of the
+		 * texture are undefined until it is written to by the node that declared it, as its memory might have been used
+		 * by another texture earlier in the frame.
+		 */
+		const SPtr<PooledRenderTexture>& getTexture(UINT32 handle) const;
+
+	private:
+		friend class RenderCompositor;
+
+		UINT32 mNodeIdx = 0;
+		UINT32 mNodeLastUseIdx = 0;
+		Vector<TRANSIENT_RENDER_TEXTURE_DESC> mDescs;
+		SPtr<PooledTransientTextures> mTextures;
 	};
 
 	/** 
@@ -60,6 +104,13 @@ namespace ct
 	protected:
 		friend class RenderCompositor;
 
+		/** 
+		 * Declares transient textures the node is going to use in the following render() call. Called on every node
+		 * before any of the nodes render. Declared textures are available through RenderCompositorNodeInputs::resources
+		 * during render(), and are owned by the compositor, meaning they must not be released to the GpuResourcePool.
+		 */
+		virtual void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) { }
+
 		/** Executes the task implemented in the node. */
 		virtual void render(const RenderCompositorNodeInputs& inputs) = 0;
 
@@ -83,6 +134,15 @@ namespace ct
 			RenderCompositorNode* node;
 			UINT32 lastUseIdx;
 			SmallVector<RenderCompositorNode*, 4> inputs;
+
+			/** Name of the profiler sample recording the node's execution, equal to the node identifier. */
+			ProfilerString sampleName;
+
+			/** 
+			 * Nodes whose resources are no longer used once this node executes, and can be released so the resource pool
+			 * can reuse them for the nodes that follow.
+			 */
+			SmallVector<RenderCompositorNode*, 4> releasedNodes;
 		};
 	public:
 		~RenderCompositor();
@@ -98,7 +158,15 @@ namespace ct
 		 */
 		void build(const RendererView& view, const StringID& finalNode);
 
-		/** Performs rendering using the current render node hierarchy. This is expected to be called once per frame. */
+		/** 
+		 * Performs rendering using the current render node hierarchy. This is expected to be called once per frame. 
+		 * 
+		 * Before rendering, all nodes declare the transient textures they require, and textures with non-overlapping
+		 * lifetimes are assigned shared memory.
+		 *
+		 * If GPU profiling is active, execution of every node is recorded as a separate sample in the ProfilerGPU report,
+		 * named after the node identifier.
+		 */
 		void execute(RenderCompositorNodeInputs& inputs) const;
 
 	private:
@@ -108,6 +176,8 @@ namespace ct
 		Vector<NodeInfo> mNodeInfos;
 		bool mIsValid = false;
 
+		mutable RenderCompositorResources mResources;
+
 		/************************************************************************/
 		/* 							NODE TYPES	                     			*/
 		/************************************************************************/
@@ -205,11 +275,18 @@ namespace ct
 		static StringID getNodeId() { return "GBuffer"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
 	protected:
+		/** @copydoc RenderCompositorNode::declareResources */
+		void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) override;
+
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
 		/** @copydoc RenderCompositorNode::clear */
 		void clear() override;
+
+		UINT32 mAlbedoHandle = 0;
+		UINT32 mNormalHandle = 0;
+		UINT32 mRoughMetalHandle = 0;
 	};
 
 	/** Initializes the scene color texture and/or buffer. Does not perform any rendering. */
@@ -258,11 +335,16 @@ namespace ct
 		static StringID getNodeId() { return "MSAACoverage"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
 	protected:
+		/** @copydoc RenderCompositorNode::declareResources */
+		void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) override;
+
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
 		/** @copydoc RenderCompositorNode::clear */
 		void clear() override;
+
+		UINT32 mOutputHandle = 0;
 	};
 
 	/************************************************************************/
@@ -294,6 +376,9 @@ namespace ct
 		static StringID getNodeId() { return "LightAccumulation"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
 	protected:
+		/** @copydoc RenderCompositorNode::declareResources */
+		void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) override;
+
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -301,6 +386,7 @@ namespace ct
 		void clear() override;
 
 		bool mOwnsTexture = false;
+		UINT32 mOutputHandle = 0;
 	};
 
 	/** 
@@ -316,6 +402,9 @@ namespace ct
 		static StringID getNodeId() { return "DeferredDirectLighting"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
 	protected:
+		/** @copydoc RenderCompositorNode::declareResources */
+		void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) override;
+
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -323,6 +412,7 @@ namespace ct
 		void clear() override;
 
 		SPtr<RenderTexture> mLightOcclusionRT;
+		UINT32 mLightOcclusionHandle = 0;
 	};
 
 	/**
@@ -339,11 +429,16 @@ namespace ct
 		static StringID getNodeId() { return "DeferredIndirectSpecularLighting"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
 	protected:
+		/** @copydoc RenderCompositorNode::declareResources */
+		void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) override;
+
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
 		/** @copydoc RenderCompositorNode::clear */
 		void clear() override;
+
+		UINT32 mIBLRadianceHandle = (UINT32)-1;
 	};
 
 	/** 
@@ -442,15 +537,20 @@ namespace ct
 		static StringID getNodeId() { return "PostProcess"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
 	protected:
+		/** @copydoc RenderCompositorNode::declareResources */
+		void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) override;
+
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
 		/** @copydoc RenderCompositorNode::clear */
 		void clear() override;
 
-		mutable SPtr<PooledRenderTexture> mOutput[2];
+		SPtr<PooledRenderTexture> mOutput[2];
 		mutable bool mAllocated[2];
 		mutable UINT32 mCurrentIdx = 0;
+		UINT32 mOutputHandles[2];
+		UINT32 mNumOutputs = 0;
 	};
 
 	/**
@@ -490,6 +590,9 @@ namespace ct
 	public:
 		static StringID getNodeId() { return "GaussianDOF"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+
+		/** Checks will the node perform any rendering with the provided settings. */
+		static bool isEnabled(const RenderSettings& settings);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
@@ -579,6 +682,9 @@ namespace ct
 		static StringID getNodeId() { return "SSR"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
 	protected:
+		/** @copydoc RenderCompositorNode::declareResources */
+		void declareResources(const RenderCompositorNodeInputs& inputs, RenderCompositorResources& resources) override;
+
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
@@ -590,6 +696,7 @@ namespace ct
 
 		SPtr<PooledRenderTexture> mPooledOutput;
 		SPtr<PooledRenderTexture> mPrevFrame;
+		UINT32 mResolvedSceneColorHandle = (UINT32)-1;
 	};
 
 	/** @} */
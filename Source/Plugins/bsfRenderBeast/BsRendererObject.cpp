@@ -1,6 +1,8 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsRendererObject.h"
+#include "Mesh/BsMesh.h"
+#include "RenderAPI/BsVertexDataDesc.h"
 
 namespace bs { namespace ct
 {
@@ -9,8 +11,8 @@ namespace bs { namespace ct
 
 	RendererObject::RendererObject()
 	{
-		perObjectParamBuffer = gPerObjectParamDef.createBuffer();
-		perCallParamBuffer = gPerCallParamDef.createBuffer();
+		perObjectParamBuffer = gPerObjectParamDef.createBuffer(GPBU_TRANSIENT);
+		perCallParamBuffer = gPerCallParamDef.createBuffer(GPBU_TRANSIENT);
 	}
 
 	void RendererObject::updatePerObjectBuffer()
@@ -23,6 +25,26 @@ namespace bs { namespace ct
 		gPerObjectParamDef.gMatWorldNoScale.set(perObjectParamBuffer, worldNoScaleTransform);
 		gPerObjectParamDef.gMatInvWorldNoScale.set(perObjectParamBuffer, worldNoScaleTransform.inverseAffine());
 		gPerObjectParamDef.gWorldDeterminantSign.set(perObjectParamBuffer, worldTransform.determinant3x3() >= 0.0f ? 1.0f : -1.0f);
+
+		// Quantized positions are stored relative to mesh bounds, and are decoded in the vertex shader
+		Vector3 positionScale = Vector3::ONE;
+		Vector3 positionOffset = Vector3::ZERO;
+
+		SPtr<Mesh> mesh = renderable->getMesh();
+		if (mesh != nullptr)
+		{
+			const VertexElement* positionElem = mesh->getVertexDesc()->getElement(VES_POSITION);
+			if (positionElem != nullptr && positionElem->getType() == VET_USHORT4_NORM)
+			{
+				const AABox& bounds = mesh->getProperties().getQuantizationBounds();
+
+				positionScale = bounds.getSize();
+				positionOffset = bounds.getMin();
+			}
+		}
+
+		gPerObjectParamDef.gPositionScale.set(perObjectParamBuffer, positionScale);
+		gPerObjectParamDef.gPositionOffset.set(perObjectParamBuffer, positionOffset);
 	}
 
 	void RendererObject::updatePerCallBuffer(const Matrix4& viewProj, bool flush)
@@ -22,6 +22,8 @@ namespace bs { namespace ct
 		BS_PARAM_BLOCK_ENTRY(Matrix4, gMatWorldNoScale)
 		BS_PARAM_BLOCK_ENTRY(Matrix4, gMatInvWorldNoScale)
 		BS_PARAM_BLOCK_ENTRY(float, gWorldDeterminantSign)
+		BS_PARAM_BLOCK_ENTRY(Vector3, gPositionScale)
+		BS_PARAM_BLOCK_ENTRY(Vector3, gPositionOffset)
 	BS_PARAM_BLOCK_END
 
 	extern PerObjectParamDef gPerObjectParamDef;
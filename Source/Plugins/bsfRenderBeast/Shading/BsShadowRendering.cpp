@@ -11,6 +11,7 @@
 #include "Utility/BsBitwise.h"
 #include "RenderAPI/BsVertexDataDesc.h"
 #include "Renderer/BsRenderer.h"
+#include "Profiling/BsProfilerGPU.h"
 
 namespace bs { namespace ct
 {
@@ -894,7 +895,17 @@ namespace bs { namespace ct
 				++iter;
 		}
 
-		// Render shadow maps
+		// Render shadow maps, recording each one as a separate GPU profiler sample
+		ProfilerGPU& profiler = gProfilerGPU();
+		const bool profile = profiler.isFrameActive();
+
+		ProfilerString sampleName;
+		auto getSampleName = [](const char* type, UINT32 lightIdx, const String& suffix)
+		{
+			String name = String("ShadowMap (") + type + ", light " + toString(lightIdx) + suffix + ")";
+			return ProfilerString(name.c_str());
+		};
+
 		for (UINT32 i = 0; i < (UINT32)sceneInfo.directionalLights.size(); ++i)
 		{
 			const RendererLight& light = sceneInfo.directionalLights[i];
@@ -906,19 +917,49 @@ namespace bs { namespace ct
 			mDirectionalLightShadows[i].viewShadows.resize(numViews);
 
 			for (UINT32 j = 0; j < numViews; ++j)
+			{
+				if (profile)
+				{
+					String viewSuffix = numViews > 1 ? ", view " + toString(j) : StringUtil::BLANK;
+					sampleName = getSampleName("Cascaded", i, viewSuffix);
+					profiler.beginSample(sampleName);
+				}
+
 				renderCascadedShadowMaps(*viewGroup.getView(j), i, scene, frameInfo);
+
+				if (profile)
+					profiler.endSample(sampleName);
+			}
 		}
 
 		for(auto& entry : mSpotLightShadowOptions)
 		{
 			UINT32 lightIdx = entry.lightIdx;
+			if (profile)
+			{
+				sampleName = getSampleName("Spot", lightIdx, StringUtil::BLANK);
+				profiler.beginSample(sampleName);
+			}
+
 			renderSpotShadowMap(sceneInfo.spotLights[lightIdx], entry, scene, frameInfo);
+
+			if (profile)
+				profiler.endSample(sampleName);
 		}
 
 		for (auto& entry : mRadialLightShadowOptions)
 		{
 			UINT32 lightIdx = entry.lightIdx;
+			if (profile)
+			{
+				sampleName = getSampleName("Radial", lightIdx, StringUtil::BLANK);
+				profiler.beginSample(sampleName);
+			}
+
 			renderRadialShadowMap(sceneInfo.radialLights[lightIdx], entry, scene, frameInfo);
+
+			if (profile)
+				profiler.endSample(sampleName);
 		}
 	}
 
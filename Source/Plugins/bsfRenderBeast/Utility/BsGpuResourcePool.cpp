@@ -4,11 +4,42 @@
 #include "RenderAPI/BsRenderTexture.h"
 #include "Image/BsTexture.h"
 #include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "Image/BsPixelUtil.h"
 
 namespace bs { namespace ct
 {
+	/** 
+	 * Removes the entry at the specified index from a list of free resources. The entry is swapped with the last element
+	 * so the list order is not preserved.
+	 */
+	template<class T>
+	static T* removeFree(SmallVector<T*, 4>& freeList, UINT32 idx)
+	{
+		T* entry = freeList[idx];
+
+		std::swap(freeList[idx], freeList.back());
+		freeList.pop_back();
+
+		return entry;
+	}
+
+	/** Removes the provided entry from a list of free resources, if present. */
+	template<class T>
+	static void removeFree(SmallVector<T*, 4>& freeList, T* entry)
+	{
+		for (UINT32 i = 0; i < (UINT32)freeList.size(); i++)
+		{
+			if (freeList[i] == entry)
+			{
+				removeFree(freeList, i);
+				return;
+			}
+		}
+	}
+
 	PooledRenderTexture::PooledRenderTexture(GpuResourcePool* pool)
-		:mPool(pool), mIsFree(false)
+		:mPool(pool), mIsFree(false), mDescHash(0)
 	{ }
 
 	PooledRenderTexture::~PooledRenderTexture()
@@ -18,7 +49,7 @@ namespace bs { namespace ct
 	}
 
 	PooledStorageBuffer::PooledStorageBuffer(GpuResourcePool* pool)
-		:mPool(pool), mIsFree(false)
+		:mPool(pool), mIsFree(false), mDescHash(0)
 	{ }
 
 	PooledStorageBuffer::~PooledStorageBuffer()
@@ -27,6 +58,16 @@ namespace bs { namespace ct
 			mPool->_unregisterBuffer(this);
 	}
 
+	PooledTransientTextures::PooledTransientTextures(GpuResourcePool* pool)
+		:mPool(pool), mIsFree(false), mDescHash(0)
+	{ }
+
+	PooledTransientTextures::~PooledTransientTextures()
+	{
+		if (mPool != nullptr)
+			mPool->_unregisterTransient(this);
+	}
+
 	GpuResourcePool::~GpuResourcePool()
 	{
 		for (auto& texture : mTextures)
@@ -34,30 +75,54 @@ namespace bs { namespace ct
 
 		for (auto& buffer : mBuffers)
 			buffer.second.lock()->mPool = nullptr;
+
+		for (auto& textures : mTransientTextures)
+			textures.second.lock()->mPool = nullptr;
 	}
 
 	SPtr<PooledRenderTexture> GpuResourcePool::get(const POOLED_RENDER_TEXTURE_DESC& desc)
 	{
-		for (auto& texturePair : mTextures)
+		auto takeTexture = [this](PooledRenderTexture* entry)
 		{
-			SPtr<PooledRenderTexture> textureData = texturePair.second.lock();
-
-			if (!textureData->mIsFree)
-				continue;
-
-			if (textureData->texture == nullptr)
-				continue;
+			entry->mIsFree = false;
+			return mTextures.find(entry)->second.lock();
+		};
+
+		// Look for a texture created with the same descriptor first
+		size_t descHash = getHash(desc);
+		auto iterFind = mFreeTextures.find(descHash);
+		if (iterFind != mFreeTextures.end())
+		{
+			SmallVector<PooledRenderTexture*, 4>& freeTextures = iterFind->second;
+			for (UINT32 i = 0; i < (UINT32)freeTextures.size(); i++)
+			{
+				if (matches(freeTextures[i]->texture, desc))
+					return takeTexture(removeFree(freeTextures, i));
+			}
+		}
 
-			if (matches(textureData->texture, desc))
+		// Otherwise check the remaining free textures, as textures with more usage flags than requested are also valid
+		for (auto& entry : mFreeTextures)
+		{
+			SmallVector<PooledRenderTexture*, 4>& freeTextures = entry.second;
+			for (UINT32 i = 0; i < (UINT32)freeTextures.size(); i++)
 			{
-				textureData->mIsFree = false;
-				return textureData;
+				if (matches(freeTextures[i]->texture, desc))
+					return takeTexture(removeFree(freeTextures, i));
 			}
 		}
 
 		SPtr<PooledRenderTexture> newTextureData = bs_shared_ptr_new<PooledRenderTexture>(this);
+		newTextureData->mDescHash = descHash;
 		_registerTexture(newTextureData);
 
+		createTexture(*newTextureData, desc);
+		return newTextureData;
+	}
+
+	void GpuResourcePool::createTexture(PooledRenderTexture& entry, const POOLED_RENDER_TEXTURE_DESC& desc, 
+		const SPtr<Texture>& memorySource)
+	{
 		TEXTURE_DESC texDesc;
 		texDesc.type = desc.type;
 		texDesc.width = desc.width;
@@ -72,7 +137,10 @@ namespace bs { namespace ct
 		if (desc.type != TEX_TYPE_3D)
 			texDesc.numArraySlices = desc.arraySize;
 
-		newTextureData->texture = Texture::create(texDesc);
+		if (memorySource != nullptr)
+			entry.texture = Texture::createAliased(texDesc, memorySource);
+		else
+			entry.texture = Texture::create(texDesc);
 		
 		if ((desc.flag & (TU_RENDERTARGET | TU_DEPTHSTENCIL)) != 0)
 		{
@@ -80,46 +148,45 @@ namespace bs { namespace ct
 
 			if ((desc.flag & TU_RENDERTARGET) != 0)
 			{
-				rtDesc.colorSurfaces[0].texture = newTextureData->texture;
+				rtDesc.colorSurfaces[0].texture = entry.texture;
 				rtDesc.colorSurfaces[0].face = 0;
-				rtDesc.colorSurfaces[0].numFaces = newTextureData->texture->getProperties().getNumFaces();
+				rtDesc.colorSurfaces[0].numFaces = entry.texture->getProperties().getNumFaces();
 				rtDesc.colorSurfaces[0].mipLevel = 0;
 			}
 
 			if ((desc.flag & TU_DEPTHSTENCIL) != 0)
 			{
-				rtDesc.depthStencilSurface.texture = newTextureData->texture;
+				rtDesc.depthStencilSurface.texture = entry.texture;
 				rtDesc.depthStencilSurface.face = 0;
-				rtDesc.depthStencilSurface.numFaces = newTextureData->texture->getProperties().getNumFaces();
+				rtDesc.depthStencilSurface.numFaces = entry.texture->getProperties().getNumFaces();
 				rtDesc.depthStencilSurface.mipLevel = 0;
 			}
 
-			newTextureData->renderTexture = RenderTexture::create(rtDesc);
+			entry.renderTexture = RenderTexture::create(rtDesc);
 		}
-
-		return newTextureData;
 	}
 
 	SPtr<PooledStorageBuffer> GpuResourcePool::get(const POOLED_STORAGE_BUFFER_DESC& desc)
 	{
-		for (auto& bufferPair : mBuffers)
+		size_t descHash = getHash(desc);
+		auto iterFind = mFreeBuffers.find(descHash);
+		if (iterFind != mFreeBuffers.end())
 		{
-			SPtr<PooledStorageBuffer> bufferData = bufferPair.second.lock();
-
-			if (!bufferData->mIsFree)
-				continue;
-
-			if (bufferData->buffer == nullptr)
-				continue;
-
-			if (matches(bufferData->buffer, desc))
+			SmallVector<PooledStorageBuffer*, 4>& freeBuffers = iterFind->second;
+			for (UINT32 i = 0; i < (UINT32)freeBuffers.size(); i++)
 			{
-				bufferData->mIsFree = false;
-				return bufferData;
+				if (matches(freeBuffers[i]->buffer, desc))
+				{
+					PooledStorageBuffer* entry = removeFree(freeBuffers, i);
+					entry->mIsFree = false;
+
+					return mBuffers.find(entry)->second.lock();
+				}
 			}
 		}
 
 		SPtr<PooledStorageBuffer> newBufferData = bs_shared_ptr_new<PooledStorageBuffer>(this);
+		newBufferData->mDescHash = descHash;
 		_registerBuffer(newBufferData);
 
 		GPU_BUFFER_DESC bufferDesc;
@@ -134,16 +201,167 @@ namespace bs { namespace ct
 		return newBufferData;
 	}
 
+	SPtr<PooledTransientTextures> GpuResourcePool::get(const Vector<TRANSIENT_RENDER_TEXTURE_DESC>& descs)
+	{
+		size_t descHash = getHash(descs);
+		auto iterFind = mFreeTransientTextures.find(descHash);
+		if (iterFind != mFreeTransientTextures.end())
+		{
+			SmallVector<PooledTransientTextures*, 4>& freeSets = iterFind->second;
+			for (UINT32 i = 0; i < (UINT32)freeSets.size(); i++)
+			{
+				const Vector<TRANSIENT_RENDER_TEXTURE_DESC>& setDescs = freeSets[i]->mDescs;
+				if (setDescs.size() != descs.size())
+					continue;
+
+				bool match = true;
+				for (UINT32 j = 0; j < (UINT32)descs.size(); j++)
+				{
+					if (setDescs[j].firstUse != descs[j].firstUse || setDescs[j].lastUse != descs[j].lastUse ||
+						!isEqual(setDescs[j].desc, descs[j].desc))
+					{
+						match = false;
+						break;
+					}
+				}
+
+				if (match)
+				{
+					PooledTransientTextures* entry = removeFree(freeSets, i);
+					entry->mIsFree = false;
+
+					return mTransientTextures.find(entry)->second.lock();
+				}
+			}
+		}
+
+		SPtr<PooledTransientTextures> newTextures = createTransient(descs);
+		newTextures->mDescHash = descHash;
+
+		mTransientTextures.insert(std::make_pair(newTextures.get(), newTextures));
+		return newTextures;
+	}
+
+	SPtr<PooledTransientTextures> GpuResourcePool::createTransient(const Vector<TRANSIENT_RENDER_TEXTURE_DESC>& descs)
+	{
+		SPtr<PooledTransientTextures> output = bs_shared_ptr_new<PooledTransientTextures>(this);
+		output->mDescs = descs;
+		output->textures.resize(descs.size());
+
+		const RenderAPICapabilities& caps = RenderAPI::instance().getCapabilities(0);
+		const bool supportsAliasing = caps.hasCapability(RSC_TEXTURE_MEMORY_ALIASING);
+
+		// Memory block shared by one or multiple textures. The first texture assigned to the block owns its memory.
+		struct MemoryBlock
+		{
+			UINT32 owner;
+			UINT64 size;
+			SmallVector<std::pair<UINT32, UINT32>, 8> uses;
+		};
+
+		bs_frame_mark();
+		{
+			// Assign the largest textures first, so smaller ones can be placed in their memory
+			FrameVector<std::pair<UINT64, UINT32>> order;
+			order.reserve(descs.size());
+
+			for (UINT32 i = 0; i < (UINT32)descs.size(); i++)
+				order.push_back(std::make_pair(getMemorySize(descs[i].desc), i));
+
+			std::stable_sort(order.begin(), order.end(), 
+				[](const std::pair<UINT64, UINT32>& a, const std::pair<UINT64, UINT32>& b)
+			{
+				return a.first > b.first;
+			});
+
+			FrameVector<MemoryBlock> blocks;
+			for (auto& entry : order)
+			{
+				const UINT32 idx = entry.second;
+				const TRANSIENT_RENDER_TEXTURE_DESC& desc = descs[idx];
+
+				MemoryBlock* foundBlock = nullptr;
+				for (auto& block : blocks)
+				{
+					bool overlaps = false;
+					for (auto& use : block.uses)
+					{
+						if (desc.firstUse <= use.second && use.first <= desc.lastUse)
+						{
+							overlaps = true;
+							break;
+						}
+					}
+
+					if (overlaps)
+						continue;
+
+					// Textures with identical descriptors can share the same texture object, others need to alias the
+					// block memory
+					if (isEqual(descs[block.owner].desc, desc.desc) || (supportsAliasing && entry.first <= block.size))
+					{
+						foundBlock = &block;
+						break;
+					}
+				}
+
+				if (foundBlock == nullptr)
+				{
+					output->textures[idx] = bs_shared_ptr_new<PooledRenderTexture>(nullptr);
+					createTexture(*output->textures[idx], desc.desc);
+					output->memorySize += entry.first;
+
+					blocks.push_back(MemoryBlock());
+					MemoryBlock& block = blocks.back();
+					block.owner = idx;
+					block.size = entry.first;
+					block.uses.push_back(std::make_pair(desc.firstUse, desc.lastUse));
+				}
+				else
+				{
+					if (isEqual(descs[foundBlock->owner].desc, desc.desc))
+						output->textures[idx] = output->textures[foundBlock->owner];
+					else
+					{
+						output->textures[idx] = bs_shared_ptr_new<PooledRenderTexture>(nullptr);
+						createTexture(*output->textures[idx], desc.desc, 
+							output->textures[foundBlock->owner]->texture);
+					}
+
+					foundBlock->uses.push_back(std::make_pair(desc.firstUse, desc.lastUse));
+				}
+			}
+		}
+		bs_frame_clear();
+
+		return output;
+	}
+
 	void GpuResourcePool::release(const SPtr<PooledRenderTexture>& texture)
 	{
-		auto iterFind = mTextures.find(texture.get());
-		iterFind->second.lock()->mIsFree = true;
+		if (texture->mIsFree || texture->texture == nullptr)
+			return;
+
+		texture->mIsFree = true;
+		mFreeTextures[texture->mDescHash].push_back(texture.get());
 	}
 
 	void GpuResourcePool::release(const SPtr<PooledStorageBuffer>& buffer)
 	{
-		auto iterFind = mBuffers.find(buffer.get());
-		iterFind->second.lock()->mIsFree = true;
+		if (buffer->mIsFree || buffer->buffer == nullptr)
+			return;
+
+		buffer->mIsFree = true;
+		mFreeBuffers[buffer->mDescHash].push_back(buffer.get());
+	}
+
+	void GpuResourcePool::release(const SPtr<PooledTransientTextures>& textures)
+	{
+		if (textures->mIsFree)
+			return;
+
+		textures->mIsFree = true;
+		mFreeTransientTextures[textures->mDescHash].push_back(textures.get());
 	}
 
 	bool GpuResourcePool::matches(const SPtr<Texture>& texture, const POOLED_RENDER_TEXTURE_DESC& desc)
@@ -186,6 +404,82 @@ namespace bs { namespace ct
 		return match;
 	}
 
+	size_t GpuResourcePool::getHash(const POOLED_RENDER_TEXTURE_DESC& desc)
+	{
+		size_t hash = 0;
+		hash_combine(hash, desc.width);
+		hash_combine(hash, desc.height);
+		hash_combine(hash, desc.depth);
+		hash_combine(hash, desc.numSamples);
+		hash_combine(hash, (UINT32)desc.format);
+		hash_combine(hash, (UINT32)desc.flag);
+		hash_combine(hash, (UINT32)desc.type);
+		hash_combine(hash, desc.hwGamma);
+		hash_combine(hash, desc.arraySize);
+		hash_combine(hash, desc.numMipLevels);
+
+		return hash;
+	}
+
+	size_t GpuResourcePool::getHash(const POOLED_STORAGE_BUFFER_DESC& desc)
+	{
+		size_t hash = 0;
+		hash_combine(hash, (UINT32)desc.type);
+		hash_combine(hash, (UINT32)desc.format);
+		hash_combine(hash, desc.numElements);
+		hash_combine(hash, desc.elementSize);
+
+		return hash;
+	}
+
+	size_t GpuResourcePool::getHash(const Vector<TRANSIENT_RENDER_TEXTURE_DESC>& descs)
+	{
+		size_t hash = 0;
+		for (auto& entry : descs)
+		{
+			hash_combine(hash, getHash(entry.desc));
+			hash_combine(hash, entry.firstUse);
+			hash_combine(hash, entry.lastUse);
+		}
+
+		return hash;
+	}
+
+	bool GpuResourcePool::isEqual(const POOLED_RENDER_TEXTURE_DESC& a, const POOLED_RENDER_TEXTURE_DESC& b)
+	{
+		return a.width == b.width 
+			&& a.height == b.height 
+			&& a.depth == b.depth 
+			&& a.numSamples == b.numSamples 
+			&& a.format == b.format 
+			&& a.flag == b.flag 
+			&& a.type == b.type 
+			&& a.hwGamma == b.hwGamma 
+			&& a.arraySize == b.arraySize 
+			&& a.numMipLevels == b.numMipLevels;
+	}
+
+	UINT64 GpuResourcePool::getMemorySize(const POOLED_RENDER_TEXTURE_DESC& desc)
+	{
+		UINT32 numFaces = desc.type == TEX_TYPE_CUBE_MAP ? 6 * desc.arraySize : desc.arraySize;
+		UINT32 numSamples = std::max(desc.numSamples, 1U);
+
+		UINT64 size = 0;
+		UINT32 width = desc.width;
+		UINT32 height = desc.height;
+		UINT32 depth = desc.depth;
+		for (UINT32 i = 0; i <= desc.numMipLevels; i++)
+		{
+			size += PixelUtil::getMemorySize(width, height, depth, desc.format);
+
+			width = std::max(width / 2, 1U);
+			height = std::max(height / 2, 1U);
+			depth = std::max(depth / 2, 1U);
+		}
+
+		return size * numFaces * numSamples;
+	}
+
 	void GpuResourcePool::_registerTexture(const SPtr<PooledRenderTexture>& texture)
 	{
 		mTextures.insert(std::make_pair(texture.get(), texture));
@@ -193,6 +487,13 @@ namespace bs { namespace ct
 
 	void GpuResourcePool::_unregisterTexture(PooledRenderTexture* texture)
 	{
+		if (texture->mIsFree)
+		{
+			auto iterFind = mFreeTextures.find(texture->mDescHash);
+			if (iterFind != mFreeTextures.end())
+				removeFree(iterFind->second, texture);
+		}
+
 		mTextures.erase(texture);
 	}
 
@@ -203,9 +504,28 @@ namespace bs { namespace ct
 
 	void GpuResourcePool::_unregisterBuffer(PooledStorageBuffer* buffer)
 	{
+		if (buffer->mIsFree)
+		{
+			auto iterFind = mFreeBuffers.find(buffer->mDescHash);
+			if (iterFind != mFreeBuffers.end())
+				removeFree(iterFind->second, buffer);
+		}
+
 		mBuffers.erase(buffer);
 	}
 
+	void GpuResourcePool::_unregisterTransient(PooledTransientTextures* textures)
+	{
+		if (textures->mIsFree)
+		{
+			auto iterFind = mFreeTransientTextures.find(textures->mDescHash);
+			if (iterFind != mFreeTransientTextures.end())
+				removeFree(iterFind->second, textures);
+		}
+
+		mTransientTextures.erase(textures);
+	}
+
 	POOLED_RENDER_TEXTURE_DESC POOLED_RENDER_TEXTURE_DESC::create2D(PixelFormat format, UINT32 width, UINT32 height,
 		INT32 usage, UINT32 samples, bool hwGamma, UINT32 arraySize, UINT32 mipCount)
 	{
@@ -16,6 +16,8 @@ namespace bs { namespace ct
 	class GpuResourcePool;
 	struct POOLED_RENDER_TEXTURE_DESC;
 	struct POOLED_STORAGE_BUFFER_DESC;
+	struct TRANSIENT_RENDER_TEXTURE_DESC;
+	struct PooledTransientTextures;
 
 	/**	Contains data about a single render texture in the GPU resource pool. */
 	struct PooledRenderTexture
@@ -31,6 +33,7 @@ namespace bs { namespace ct
 
 		GpuResourcePool* mPool;
 		bool mIsFree;
+		size_t mDescHash;
 	};
 
 	/**	Contains data about a single storage buffer in the GPU resource pool. */
@@ -46,11 +49,15 @@ namespace bs { namespace ct
 
 		GpuResourcePool* mPool;
 		bool mIsFree;
+		size_t mDescHash;
 	};
 
 	/** 
 	 * Contains a pool of textures and buffers meant to accommodate reuse of such resources for the main purpose of using
 	 * them as write targets on the GPU.
+	 *
+	 * Free resources are kept in lists keyed by the hash of the descriptor they were created with, so retrieving a 
+	 * resource with the same descriptor doesn't need to search through the entire pool.
 	 */
 	class GpuResourcePool : public Module<GpuResourcePool>
 	{
@@ -73,6 +80,17 @@ namespace bs { namespace ct
 		 */
 		SPtr<PooledStorageBuffer> get(const POOLED_STORAGE_BUFFER_DESC& desc);
 
+		/**
+		 * Attempts to find an unused set of transient textures created from the same descriptors, or creates a new set
+		 * otherwise. When creating a new set, textures whose use ranges don't overlap are assigned the same memory. 
+		 * Textures with identical descriptors share the same texture object, while others are placed into the memory of 
+		 * a larger texture if the render API supports memory aliasing. When done with the set make sure to call
+		 * release(const SPtr<PooledTransientTextures>&).
+		 *
+		 * @param[in]	descs	Descriptors of all the textures in the set, along with the range of passes using them.
+		 */
+		SPtr<PooledTransientTextures> get(const Vector<TRANSIENT_RENDER_TEXTURE_DESC>& descs);
+
 		/**
 		 * Releases a texture previously allocated with get(const POOLED_RENDER_TEXTURE_DESC&). The texture is returned to
 		 * the pool so that it may be reused later.
@@ -93,9 +111,30 @@ namespace bs { namespace ct
 		 */
 		void release(const SPtr<PooledStorageBuffer>& buffer);
 
+		/**
+		 * Releases a set of textures previously allocated with get(const Vector<TRANSIENT_RENDER_TEXTURE_DESC>&). The set
+		 * is returned to the pool so that it may be reused later.
+		 *
+		 * @note	
+		 * The set will be removed from the pool if the last reference to it is deleted. Keep a reference to the set if
+		 * the same textures are going to be requested again.
+		 */
+		void release(const SPtr<PooledTransientTextures>& textures);
+
 	private:
 		friend struct PooledRenderTexture;
 		friend struct PooledStorageBuffer;
+		friend struct PooledTransientTextures;
+
+		/** 
+		 * Creates the texture (and render texture if applicable) described by @p desc and assigns it to @p entry. If
+		 * @p memorySource is provided the texture will attempt to share its memory.
+		 */
+		static void createTexture(PooledRenderTexture& entry, const POOLED_RENDER_TEXTURE_DESC& desc, 
+			const SPtr<Texture>& memorySource = nullptr);
+
+		/** Creates a new set of transient textures, assigning shared memory to textures with non-overlapping uses. */
+		SPtr<PooledTransientTextures> createTransient(const Vector<TRANSIENT_RENDER_TEXTURE_DESC>& descs);
 
 		/**	Registers a newly created render texture in the pool. */
 		void _registerTexture(const SPtr<PooledRenderTexture>& texture);
@@ -109,6 +148,9 @@ namespace bs { namespace ct
 		/**	Unregisters a created storage buffer in the pool. */
 		void _unregisterBuffer(PooledStorageBuffer* buffer);
 
+		/**	Unregisters a created set of transient textures in the pool. */
+		void _unregisterTransient(PooledTransientTextures* textures);
+
 		/**
 		 * Checks does the provided texture match the parameters.
 		 * 
@@ -125,8 +167,29 @@ namespace bs { namespace ct
 		 */
 		static bool matches(const SPtr<GpuBuffer>& buffer, const POOLED_STORAGE_BUFFER_DESC& desc);
 
+		/** Calculates a hash of the provided descriptor, used for looking up free textures. */
+		static size_t getHash(const POOLED_RENDER_TEXTURE_DESC& desc);
+
+		/** Calculates a hash of the provided descriptor, used for looking up free buffers. */
+		static size_t getHash(const POOLED_STORAGE_BUFFER_DESC& desc);
+
+		/** Calculates a hash of the provided descriptors, used for looking up free sets of transient textures. */
+		static size_t getHash(const Vector<TRANSIENT_RENDER_TEXTURE_DESC>& descs);
+
+		/** Checks are the two descriptors identical. */
+		static bool isEqual(const POOLED_RENDER_TEXTURE_DESC& a, const POOLED_RENDER_TEXTURE_DESC& b);
+
+		/** Returns an estimate of the amount of GPU memory used by a texture created from the descriptor, in bytes. */
+		static UINT64 getMemorySize(const POOLED_RENDER_TEXTURE_DESC& desc);
+
 		Map<PooledRenderTexture*, std::weak_ptr<PooledRenderTexture>> mTextures;
 		Map<PooledStorageBuffer*, std::weak_ptr<PooledStorageBuffer>> mBuffers;
+
+		UnorderedMap<size_t, SmallVector<PooledRenderTexture*, 4>> mFreeTextures;
+		UnorderedMap<size_t, SmallVector<PooledStorageBuffer*, 4>> mFreeBuffers;
+
+		Map<PooledTransientTextures*, std::weak_ptr<PooledTransientTextures>> mTransientTextures;
+		UnorderedMap<size_t, SmallVector<PooledTransientTextures*, 4>> mFreeTransientTextures;
 	};
 
 	/** Structure used for creating a new pooled render texture. */
@@ -223,5 +286,45 @@ namespace bs { namespace ct
 		UINT32 elementSize;
 	};
 
+	/** Describes a render texture that is only used during a limited range of passes. */
+	struct TRANSIENT_RENDER_TEXTURE_DESC
+	{
+		/** Describes the texture itself. */
+		POOLED_RENDER_TEXTURE_DESC desc;
+
+		/** Index of the first pass that uses the texture. */
+		UINT32 firstUse;
+
+		/** Index of the last pass that uses the texture. */
+		UINT32 lastUse;
+	};
+
+	/** 
+	 * Contains a set of render textures that are only used during a limited range of passes. Textures whose ranges don't
+	 * overlap share the same GPU memory where possible.
+	 */
+	struct PooledTransientTextures
+	{
+		PooledTransientTextures(GpuResourcePool* pool);
+		~PooledTransientTextures();
+
+		/** Textures in the set, in the same order as the descriptors the set was requested with. */
+		Vector<SPtr<PooledRenderTexture>> textures;
+
+		/** 
+		 * Estimated amount of GPU memory used by the set, in bytes. Textures sharing memory with another texture are not
+		 * counted.
+		 */
+		UINT64 memorySize = 0;
+
+	private:
+		friend class GpuResourcePool;
+
+		GpuResourcePool* mPool;
+		bool mIsFree;
+		size_t mDescHash;
+		Vector<TRANSIENT_RENDER_TEXTURE_DESC> mDescs;
+	};
+
 	/** @} */
 }}
\ No newline at end of file
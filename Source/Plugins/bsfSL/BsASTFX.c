@@ -398,6 +398,7 @@ ParseState* parseStateCreate()
 	parseState->errorFile = 0;
 
 	parseState->conditionalStack = 0;
+	parseState->includeCache = 0;
 	parseState->defineCapacity = 10;
 	parseState->numDefines = 0;
 	parseState->defines = mmalloc(parseState->memContext, parseState->defineCapacity * sizeof(DefineEntry));
@@ -219,6 +219,8 @@ struct tagParseState
 	int numDefines;
 	int defineCapacity;
 	ConditionalData* conditionalStack;
+
+	void* includeCache; // Optional BSLIncludeCache used for retrieving include contents
 };
 
 struct tagOptionInfo
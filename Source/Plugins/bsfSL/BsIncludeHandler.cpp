@@ -3,6 +3,7 @@
 #include "BsSLPrerequisites.h"
 #include "Material/BsShaderManager.h"
 #include "Material/BsShaderInclude.h"
+#include "BsSLFXCompiler.h"
 
 extern "C" {
 #include "BsIncludeHandler.h"
@@ -18,16 +19,29 @@ char* includePush(ParseState* state, const char* filename, int line, int column,
 	memcpy(filenameNoQuote, filename + 1, filenameQuotesLen - 2);
 	filenameNoQuote[filenameQuotesLen - 2] = '\0';
 
-	HShaderInclude include = ShaderManager::instance().findInclude(filenameNoQuote);
+	String includeSource;
+	bool found = false;
 
-	if (include != nullptr)
-		include.blockUntilLoaded();
+	BSLIncludeCache* includeCache = (BSLIncludeCache*)state->includeCache;
+	if (includeCache != nullptr)
+		found = includeCache->find(filenameNoQuote, includeSource);
+	else
+	{
+		HShaderInclude include = ShaderManager::instance().findInclude(filenameNoQuote);
+
+		if (include != nullptr)
+			include.blockUntilLoaded();
+
+		if (include.isLoaded())
+		{
+			includeSource = include->getString();
+			found = true;
+		}
+	}
 
 	int filenameLen = (int)strlen(filenameNoQuote);
-	if (include.isLoaded())
+	if (found)
 	{
-		String includeSource = include->getString();
-
 		*size = (int)includeSource.size() + 2;
 		char* output = (char*)mmalloc(state->memContext, *size);
 
@@ -18,6 +18,9 @@
 #include "Renderer/BsRendererManager.h"
 #include "FileSystem/BsFileSystem.h"
 #include "FileSystem/BsDataStream.h"
+#include "Managers/BsGpuProgramManager.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
 
 #define XSC_ENABLE_LANGUAGE_EXT 1
 #include "Xsc/Xsc.h"
@@ -538,7 +541,8 @@ namespace bs
 	};
 
 	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, bool optionalEntry, 
-		UINT32& startBindingSlot, SHADER_DESC* shaderDesc = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
+		UINT32& startBindingSlot, Xsc::Reflection::ReflectionData* outReflectionData = nullptr, 
+		Vector<GpuProgramType>* detectedTypes = nullptr)
 	{
 		SPtr<StringStream> input = bs_shared_ptr_new<StringStream>();
 
@@ -683,8 +687,8 @@ namespace bs
 			}
 		}
 
-		if (shaderDesc != nullptr)
-			parseParameters(reflectionData, *shaderDesc);
+		if (outReflectionData != nullptr)
+			*outReflectionData = reflectionData;
 
 		return output.str();
 	}
@@ -695,10 +699,11 @@ namespace bs
 		return crossCompile(hlsl, type, outputType, false, startBindingSlot);
 	}
 
-	void reflectHLSL(const String& hlsl, SHADER_DESC& shaderDesc, Vector<GpuProgramType>& entryPoints)
+	void reflectHLSL(const String& hlsl, Xsc::Reflection::ReflectionData& reflectionData, 
+		Vector<GpuProgramType>& entryPoints)
 	{
 		UINT32 dummy = 0;
-		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &shaderDesc, &entryPoints);
+		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &reflectionData, &entryPoints);
 	}
 
 	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source, 
@@ -1655,6 +1660,47 @@ namespace bs
 		return output;
 	}
 
+	struct BSLFXCompiler::VariationCompileData
+	{
+		String name;
+		ShaderVariation variation;
+
+		Vector<ShaderData> techniques;
+		Vector<Xsc::Reflection::ReflectionData> reflectionData;
+		UnorderedSet<String> includes;
+
+		BSLFXCompileResult output;
+		UINT64 time = 0;
+	};
+
+	bool BSLIncludeCache::find(const String& name, String& source)
+	{
+		// Note: Keeping the lock while loading, as includes are generally shared by all variations and there's no point
+		// in loading them on multiple threads simultaneously
+		Lock lock(mMutex);
+
+		auto iterFind = mEntries.find(name);
+		if (iterFind == mEntries.end())
+		{
+			Entry entry;
+
+			HShaderInclude include = ShaderManager::instance().findInclude(name);
+			if (include != nullptr)
+				include.blockUntilLoaded();
+
+			if (include.isLoaded())
+			{
+				entry.found = true;
+				entry.source = include->getString();
+			}
+
+			iterFind = mEntries.insert(std::make_pair(name, entry)).first;
+		}
+
+		source = iterFind->second.source;
+		return iterFind->second.found;
+	}
+
 	BSLFXCompileResult BSLFXCompiler::compileTechniques(
 		const Vector<std::pair<ASTFXNode*, ShaderMetaData>>& shaderMetaData, const String& source, 
 		const UnorderedMap<String, String>& defines, SHADER_DESC& shaderDesc, Vector<String>& includes)
@@ -1662,7 +1708,7 @@ namespace bs
 		BSLFXCompileResult output;
 
 		// Build a list of different variations and re-parse the source using the relevant defines
-		UnorderedSet<String> includeSet;
+		Vector<VariationCompileData> variationData;
 		for (auto& entry : shaderMetaData)
 		{
 			const ShaderMetaData& metaData = entry.second;
@@ -1745,46 +1791,108 @@ namespace bs
 				}
 			}
 
-			// For every variation, re-parse the file with relevant defines
 			for (auto& variation : variations)
 			{
-				UnorderedMap<String, String> globalDefines = defines;
-				UnorderedMap<String, String> variationDefines = variation.getDefines().getAll();
+				VariationCompileData data;
+				data.name = metaData.name;
+				data.variation = variation;
 
-				for (auto& define : variationDefines)
-					globalDefines[define.first] = define.second;
+				variationData.push_back(data);
+			}
+		}
 
-				ParseState* variationParseState = parseStateCreate();
-				output = parseFX(variationParseState, source.c_str(), globalDefines);
+		// Re-parse and cross-compile every variation in parallel. Include files are shared between all variations.
+		// If supported by the render backend, also compile the bytecode on the worker threads, so the programs don't need
+		// to be compiled serially on the core thread.
+		const RenderAPIInfo& apiInfo = ct::RenderAPI::instance().getAPIInfo();
+		bool compileBytecode = apiInfo.isFlagSet(RenderAPIFeatureFlag::ByteCodeCaching);
 
-				if (!output.errorMessage.empty())
-					parseStateDelete(variationParseState);
-				else
-				{
-					Vector<String> codeBlocks;
-					RawCode* rawCode = variationParseState->rawCodeBlock[RCT_CodeBlock];
-					while (rawCode != nullptr)
-					{
-						while ((INT32)codeBlocks.size() <= rawCode->index)
-							codeBlocks.push_back(String());
+		BSLIncludeCache includeCache;
+		Timer timer;
 
-						codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
-						rawCode = rawCode->next;
-					}
+		if (variationData.size() == 1)
+			compileVariation(source, defines, includeCache, compileBytecode, variationData[0]);
+		else
+		{
+			Vector<SPtr<Task>> tasks;
+			tasks.reserve(variationData.size());
 
-					output = compileTechniques(variationParseState, entry.second.name, codeBlocks, variation, includeSet, 
-						shaderDesc);
+			for (auto& entry : variationData)
+			{
+				VariationCompileData* data = &entry;
+				auto compileWorker = [&source, &defines, &includeCache, compileBytecode, data]()
+				{
+					compileVariation(source, defines, includeCache, compileBytecode, *data);
+				};
 
-					if (!output.errorMessage.empty())
-						return output;
-				}
+				SPtr<Task> task = Task::create("BSLVariationCompile", compileWorker);
+				TaskScheduler::instance().addTask(task);
+
+				tasks.push_back(task);
 			}
+
+			for (auto& task : tasks)
+				task->wait();
+		}
+
+		UINT64 totalTime = timer.getMicroseconds();
+
+		for (auto& entry : variationData)
+		{
+			if (!entry.output.errorMessage.empty())
+				return entry.output;
+		}
+
+		// Register techniques and parameters in the same order as the variations were generated, so the output is
+		// deterministic regardless of the order the variations finished compiling in
+		UnorderedSet<String> includeSet;
+		for (auto& entry : variationData)
+		{
+			for (auto& include : entry.includes)
+				includeSet.insert(include);
+
+			createTechniques(entry, shaderDesc);
 		}
 
-		// Generate a shader from the parsed techniques
 		for (auto& entry : includeSet)
 			includes.push_back(entry);
 
+		// Report per-variation compile times, so expensive variations can be identified and pruned
+		if (variationData.size() > 1)
+		{
+			Vector<const VariationCompileData*> sortedData;
+			for (auto& entry : variationData)
+				sortedData.push_back(&entry);
+
+			std::sort(sortedData.begin(), sortedData.end(), 
+				[](const VariationCompileData* lhs, const VariationCompileData* rhs)
+			{
+				return lhs->time > rhs->time;
+			});
+
+			StringStream report;
+			report << "Compiled " << variationData.size() << " shader variations in " << totalTime / 1000 << " ms:";
+
+			for (auto& entry : sortedData)
+			{
+				report << std::endl << "  " << entry->name << " [";
+
+				bool first = true;
+				for (auto& define : entry->variation.getDefines().getAll())
+				{
+					if (!first)
+						report << ", ";
+
+					report << define.first << "=" << define.second;
+					first = false;
+				}
+
+				report << "]: " << entry->time / 1000 << " ms";
+			}
+
+			LOGDBG(report.str());
+		}
+
 		// Verify techniques compile correctly
 		bool hasError = false;
 		StringStream gpuProgError;
@@ -1943,9 +2051,8 @@ namespace bs
 		return output;
 	}
 
-	BSLFXCompileResult BSLFXCompiler::compileTechniques(ParseState* parseState, const String& name, 
-		const Vector<String>& codeBlocks, const ShaderVariation& variation, UnorderedSet<String>& includes, 
-		SHADER_DESC& shaderDesc)
+	BSLFXCompileResult BSLFXCompiler::parseTechniques(ParseState* parseState, const Vector<String>& codeBlocks, 
+		VariationCompileData& data)
 	{
 		BSLFXCompileResult output;
 
@@ -1972,7 +2079,7 @@ namespace bs
 				ShaderMetaData metaData = parseShaderMetaData(option->value.nodePtr);
 
 				// Skip all techniques except the one we're parsing
-				if(metaData.name != name && !metaData.isMixin)
+				if(metaData.name != data.name && !metaData.isMixin)
 					continue;
 
 				shaderData.push_back(std::make_pair(option->value.nodePtr, ShaderData()));
@@ -2064,9 +2171,7 @@ namespace bs
 		{
 			String includeFilename = includeLink->data->filename;
 
-			auto iterFind = std::find(includes.begin(), includes.end(), includeFilename);
-			if (iterFind == includes.end())
-				includes.insert(includeFilename);
+			data.includes.insert(includeFilename);
 
 			includeLink = includeLink->next;
 		}
@@ -2123,7 +2228,8 @@ namespace bs
 				// type. If performance is ever important here it could be good to update XShaderCompiler so it can
 				// somehow save the AST and then re-use it for multiple actions.
 				Vector<GpuProgramType> types;
-				reflectHLSL(glslPassData.code, shaderDesc, types);
+				data.reflectionData.push_back(Xsc::Reflection::ReflectionData());
+				reflectHLSL(glslPassData.code, data.reflectionData.back(), types);
 
 				UINT32 glslBinding = 0;
 				UINT32 vkslBinding = 0;
@@ -2190,12 +2296,103 @@ namespace bs
 
 		for(auto& entry : shaderData)
 		{
-			const ShaderMetaData& metaData = entry.second.metaData;
-			if (metaData.isMixin)
-				continue;
+			if (!entry.second.metaData.isMixin)
+				data.techniques.push_back(entry.second);
+		}
+
+		return output;
+	}
+
+	void BSLFXCompiler::compileVariation(const String& source, const UnorderedMap<String, String>& defines, 
+		BSLIncludeCache& includeCache, bool compileBytecode, VariationCompileData& data)
+	{
+		Timer timer;
+
+		UnorderedMap<String, String> globalDefines = defines;
+		UnorderedMap<String, String> variationDefines = data.variation.getDefines().getAll();
+
+		for (auto& define : variationDefines)
+			globalDefines[define.first] = define.second;
+
+		ParseState* variationParseState = parseStateCreate();
+		variationParseState->includeCache = &includeCache;
+
+		data.output = parseFX(variationParseState, source.c_str(), globalDefines);
+
+		if (!data.output.errorMessage.empty())
+		{
+			parseStateDelete(variationParseState);
+
+			data.time = timer.getMicroseconds();
+			return;
+		}
+
+		Vector<String> codeBlocks;
+		RawCode* rawCode = variationParseState->rawCodeBlock[RCT_CodeBlock];
+		while (rawCode != nullptr)
+		{
+			while ((INT32)codeBlocks.size() <= rawCode->index)
+				codeBlocks.push_back(String());
+
+			codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
+			rawCode = rawCode->next;
+		}
+
+		data.output = parseTechniques(variationParseState, codeBlocks, data);
+
+		// Compile bytecode for all programs the active backend can use. Compilation results are checked later, when
+		// the programs are created.
+		if (compileBytecode && data.output.errorMessage.empty())
+		{
+			ct::GpuProgramManager& gpm = ct::GpuProgramManager::instance();
+			for (auto& technique : data.techniques)
+			{
+				const String& language = technique.metaData.language;
+				if (!gpm.isLanguageSupported(language))
+					continue;
+
+				bool isHLSL = language == "hlsl";
+				for (auto& passData : technique.passes)
+				{
+					auto compileProgram = [&](const String& code, const char* hlslEntry, GpuProgramType type, 
+						SPtr<GpuProgramBytecode>& bytecode)
+					{
+						if (code.empty())
+							return;
+
+						GPU_PROGRAM_DESC desc;
+						desc.language = language;
+						desc.entryPoint = isHLSL ? hlslEntry : "main";
+						desc.source = code;
+						desc.type = type;
+
+						bytecode = gpm.compileBytecode(desc);
+					};
+
+					compileProgram(passData.vertexCode, "vsmain", GPT_VERTEX_PROGRAM, passData.vertexBytecode);
+					compileProgram(passData.fragmentCode, "fsmain", GPT_FRAGMENT_PROGRAM, passData.fragmentBytecode);
+					compileProgram(passData.geometryCode, "gsmain", GPT_GEOMETRY_PROGRAM, passData.geometryBytecode);
+					compileProgram(passData.hullCode, "hsmain", GPT_HULL_PROGRAM, passData.hullBytecode);
+					compileProgram(passData.domainCode, "dsmain", GPT_DOMAIN_PROGRAM, passData.domainBytecode);
+					compileProgram(passData.computeCode, "csmain", GPT_COMPUTE_PROGRAM, passData.computeBytecode);
+				}
+			}
+		}
+
+		data.time = timer.getMicroseconds();
+	}
+
+	void BSLFXCompiler::createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc)
+	{
+		for (auto& reflectionData : data.reflectionData)
+			parseParameters(reflectionData, shaderDesc);
+
+		for(auto& technique : data.techniques)
+		{
+			const ShaderMetaData& metaData = technique.metaData;
 
 			Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
-			for (auto& passData : entry.second.passes)
+			for (auto& passData : technique.passes)
 			{
 				PASS_DESC passDesc;
 				passDesc.blendStateDesc = passData.blendDesc;
@@ -2203,13 +2400,15 @@ namespace bs
 				passDesc.depthStencilStateDesc = passData.depthStencilDesc;
 
 				auto createProgram =
-					[](const String& language, const String& entry, const String& code, GpuProgramType type) -> GPU_PROGRAM_DESC
+					[](const String& language, const String& entry, const String& code, GpuProgramType type,
+						const SPtr<GpuProgramBytecode>& bytecode) -> GPU_PROGRAM_DESC
 				{
 					GPU_PROGRAM_DESC desc;
 					desc.language = language;
 					desc.entryPoint = entry;
 					desc.source = code;
 					desc.type = type;
+					desc.bytecode = bytecode;
 
 					return desc;
 				};
@@ -2219,37 +2418,43 @@ namespace bs
 					metaData.language,
 					isHLSL ? "vsmain" : "main",
 					passData.vertexCode,
-					GPT_VERTEX_PROGRAM);
+					GPT_VERTEX_PROGRAM,
+					passData.vertexBytecode);
 
 				passDesc.fragmentProgramDesc = createProgram(
 					metaData.language,
 					isHLSL ? "fsmain" : "main",
 					passData.fragmentCode,
-					GPT_FRAGMENT_PROGRAM);
+					GPT_FRAGMENT_PROGRAM,
+					passData.fragmentBytecode);
 
 				passDesc.geometryProgramDesc = createProgram(
 					metaData.language,
 					isHLSL ? "gsmain" : "main",
 					passData.geometryCode,
-					GPT_GEOMETRY_PROGRAM);
+					GPT_GEOMETRY_PROGRAM,
+					passData.geometryBytecode);
 
 				passDesc.hullProgramDesc = createProgram(
 					metaData.language,
 					isHLSL ? "hsmain" : "main",
 					passData.hullCode,
-					GPT_HULL_PROGRAM);
+					GPT_HULL_PROGRAM,
+					passData.hullBytecode);
 
 				passDesc.domainProgramDesc = createProgram(
 					metaData.language,
 					isHLSL ? "dsmain" : "main",
 					passData.domainCode,
-					GPT_DOMAIN_PROGRAM);
+					GPT_DOMAIN_PROGRAM,
+					passData.domainBytecode);
 
 				passDesc.computeProgramDesc = createProgram(
 					metaData.language,
 					isHLSL ? "csmain" : "main",
 					passData.computeCode,
-					GPT_COMPUTE_PROGRAM);
+					GPT_COMPUTE_PROGRAM,
+					passData.computeBytecode);
 
 				passDesc.stencilRefValue = passData.stencilRefValue;
 
@@ -2264,12 +2469,11 @@ namespace bs
 
 			if (orderedPasses.size() > 0)
 			{
-				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, variation, orderedPasses);
-				shaderDesc.techniques.push_back(technique);
+				SPtr<Technique> newTechnique = Technique::create(metaData.language, metaData.tags, data.variation, 
+					orderedPasses);
+				shaderDesc.techniques.push_back(newTechnique);
 			}
 		}
-
-		return output;
 	}
 
 	String BSLFXCompiler::removeQuotes(const char* input)
@@ -29,6 +29,33 @@ namespace bs
 		String errorFile; /**< File in which the error occurred. Empty if root file. */
 	};
 
+	/**
+	 * Caches the contents of include files while compiling a single BSL shader, so each include is only looked up and
+	 * loaded once, instead of once for every variation.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BSLIncludeCache
+	{
+	public:
+		/** 
+		 * Retrieves the contents of the include file with the provided name. Returns false if the include file cannot be
+		 * found.
+		 */
+		bool find(const String& name, String& source);
+
+	private:
+		/** Contents of a single include file. */
+		struct Entry
+		{
+			bool found = false;
+			String source;
+		};
+
+		Mutex mMutex;
+		UnorderedMap<String, Entry> mEntries;
+	};
+
 	/**	Transforms a source file written in BSL FX syntax into a Shader object. */
 	class BSLFXCompiler
 	{
@@ -59,6 +86,14 @@ namespace bs
 			String hullCode;
 			String domainCode;
 			String computeCode;
+
+			// Optional bytecode compiled ahead of time, for programs supported by the active render backend
+			SPtr<GpuProgramBytecode> vertexBytecode;
+			SPtr<GpuProgramBytecode> fragmentBytecode;
+			SPtr<GpuProgramBytecode> geometryBytecode;
+			SPtr<GpuProgramBytecode> hullBytecode;
+			SPtr<GpuProgramBytecode> domainBytecode;
+			SPtr<GpuProgramBytecode> computeBytecode;
 		};
 
 		/** Information about different variations of a single shader. */
@@ -89,6 +124,9 @@ namespace bs
 			Vector<PassData> passes;
 		};
 
+		/** Intermediate results of parsing and cross-compiling a single shader variation. */
+		struct VariationCompileData;
+
 		/** Temporary data describing a sub-shader during parsing. */
 		struct SubShaderData
 		{
@@ -269,22 +307,40 @@ namespace bs
 			Vector<String>& includes);
 
 		/**
-		 * Generates a set of techniques for a single variation. Uses AST parse state as input, which must be created using
-		 * the defines of the relevant variation.
+		 * Parses and cross-compiles a single variation of a shader. Does not create any core objects and can therefore be
+		 * safely called from worker threads.
+		 *
+		 * @param[in]	source				Original BSL source the shader was parsed from.
+		 * @param[in]	defines				An optional set of defines to set before parsing the source, that is to be
+		 *									applied to all variations.
+		 * @param[in]	includeCache		Cache to use for retrieving include file contents.
+		 * @param[in]	compileBytecode		If true, bytecode will be generated for all programs supported by the active
+		 *									render backend.
+		 * @param[in, out]	data			Object containing the shader name and variation to compile. Output will be
+		 *									written to the same object.
+		 */
+		static void compileVariation(const String& source, const UnorderedMap<String, String>& defines, 
+			BSLIncludeCache& includeCache, bool compileBytecode, VariationCompileData& data);
+
+		/**
+		 * Generates a set of per-backend techniques for a single variation. Uses AST parse state as input, which must be
+		 * created using the defines of the relevant variation.
 		 *
 		 * @param[in, out]	parseState	Parser state object that has previously been initialized with the AST using 
-		 *								parseFX().
-		 * @param[in]	name			Name of the shader to generate the variation for.
+		 *								parseFX(). The state will be destroyed by this method.
 		 * @param[in]	codeBlocks		Blocks containing GPU program source code that are referenced by the AST.
-		 * @param[in]	variation		Shader variation the AST was parsed with.
-		 * @param[out]	includes		Set to append newly found includes to.
-		 * @param[out]	shaderDesc		Shader descriptor that resulting techniques, and non-internal parameters will be
-		 *								registered with.
+		 * @param[in, out]	data		Object containing the shader name and variation to generate the techniques for.
+		 *								Techniques, reflection data and includes will be written to the same object.
 		 * @return						A result object containing an error message if not successful.
 		 */
-		static BSLFXCompileResult compileTechniques(ParseState* parseState, const String& name, 
-			const Vector<String>& codeBlocks, const ShaderVariation& variation, UnorderedSet<String>& includes, 
-			SHADER_DESC& shaderDesc);
+		static BSLFXCompileResult parseTechniques(ParseState* parseState, const Vector<String>& codeBlocks, 
+			VariationCompileData& data);
+
+		/**
+		 * Creates techniques and passes from a previously compiled variation, and registers them and any variation
+		 * parameters with the provided shader descriptor. Must be called from the sim thread.
+		 */
+		static void createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc);
 
 		/**
 		 * Converts a null-terminated string into a standard string, and eliminates quotes that are assumed to be at the 
@@ -337,6 +337,29 @@ namespace bs { namespace ct
 		return memory;
 	}
 
+	bool VulkanDevice::bindAliasedMemory(VkImage image, VmaAllocation allocation)
+	{
+		VmaAllocationInfo allocInfo;
+		vmaGetAllocationInfo(mAllocator, allocation, &allocInfo);
+
+		VkMemoryRequirements memReqs;
+		vkGetImageMemoryRequirements(mLogicalDevice, image, &memReqs);
+
+		if (memReqs.size > allocInfo.size)
+			return false;
+
+		if ((memReqs.memoryTypeBits & (1 << allocInfo.memoryType)) == 0)
+			return false;
+
+		if ((allocInfo.offset % memReqs.alignment) != 0)
+			return false;
+
+		VkResult result = vkBindImageMemory(mLogicalDevice, image, allocInfo.deviceMemory, allocInfo.offset);
+		assert(result == VK_SUCCESS);
+
+		return true;
+	}
+
 	void VulkanDevice::freeMemory(VmaAllocation allocation)
 	{
 		vmaFreeMemory(mAllocator, allocation);
@@ -96,6 +96,13 @@ namespace bs { namespace ct
 		 */
 		VmaAllocation allocateMemory(VkBuffer buffer, VkMemoryPropertyFlags flags);
 
+		/**
+		 * Binds the memory of an existing allocation to the provided image, so the image shares the memory with the
+		 * resource it was allocated for. Returns false if the allocation is too small for the image or its memory type
+		 * is not compatible with the image, in which case nothing is bound.
+		 */
+		bool bindAliasedMemory(VkImage image, VmaAllocation allocation);
+
 		/** Frees a previously allocated block of memory. */
 		void freeMemory(VmaAllocation allocation);
 
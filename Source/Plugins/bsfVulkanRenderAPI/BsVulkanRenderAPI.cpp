@@ -684,6 +684,10 @@ namespace bs { namespace ct
 
 			caps.setCapability(RSC_COMPUTE_PROGRAM);
 
+			// Note: RSC_TEXTURE_MEMORY_ALIASING is not reported until command buffers handle aliased images. An alias
+			// must start in VK_IMAGE_LAYOUT_UNDEFINED on its first use each frame, and needs a barrier against the last
+			// use of the memory by its previous owner.
+
 			caps.setNumTextureUnits(GPT_FRAGMENT_PROGRAM, deviceLimits.maxPerStageDescriptorSampledImages);
 			caps.setNumTextureUnits(GPT_VERTEX_PROGRAM, deviceLimits.maxPerStageDescriptorSampledImages);
 			caps.setNumTextureUnits(GPT_COMPUTE_PROGRAM, deviceLimits.maxPerStageDescriptorSampledImages);
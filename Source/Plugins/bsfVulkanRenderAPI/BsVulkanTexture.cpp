@@ -117,8 +117,22 @@ namespace bs { namespace ct
 		if (mOwnsImage)
 		{
 			vkDestroyImage(vkDevice, mImage, gVulkanAllocator);
-			device.freeMemory(mAllocation);
+
+			if (mAllocation != VK_NULL_HANDLE)
+				device.freeMemory(mAllocation);
 		}
+
+		// Memory is no longer referenced by this image, allow the image owning it to be destroyed
+		if (mMemorySource != nullptr)
+			mMemorySource->notifyUnbound();
+	}
+
+	void VulkanImage::setMemorySource(VulkanImage* source)
+	{
+		assert(mMemorySource == nullptr && mAllocation == VK_NULL_HANDLE);
+
+		mMemorySource = source;
+		mMemorySource->notifyBound();
 	}
 
 	VkImageView VulkanImage::getView(bool framebuffer) const
@@ -721,6 +735,25 @@ namespace bs { namespace ct
 		VkResult result = vkCreateImage(vkDevice, &mImageCI, gVulkanAllocator, &image);
 		assert(result == VK_SUCCESS);
 
+		// Attempt to place the image into memory owned by the memory source, if any. Only done when aliasing is
+		// supported, see VulkanRenderAPI::initCapabilites.
+		const RenderAPICapabilities& caps = RenderAPI::instance().getCapabilities(device.getIndex());
+		if (mMemorySource != nullptr && !directlyMappable && caps.hasCapability(RSC_TEXTURE_MEMORY_ALIASING))
+		{
+			VulkanImage* sourceImage = mMemorySource->getResource(device.getIndex());
+			if (sourceImage != nullptr && sourceImage->getAllocation() != VK_NULL_HANDLE)
+			{
+				if (device.bindAliasedMemory(image, sourceImage->getAllocation()))
+				{
+					VulkanImage* newImage = device.getResourceManager().create<VulkanImage>(image, nullptr,
+						mImageCI.initialLayout, getProperties());
+					newImage->setMemorySource(sourceImage);
+
+					return newImage;
+				}
+			}
+		}
+
 		VmaAllocation allocation = device.allocateMemory(image, flags);
 		return device.getResourceManager().create<VulkanImage>(image, allocation, mImageCI.initialLayout, getProperties());
 	}
@@ -111,6 +111,15 @@ namespace bs { namespace ct
 		/** Unmaps a buffer previously mapped with map(). */
 		void unmap();
 
+		/** 
+		 * Notifies the image that it was bound to memory owned by another image, rather than having its own allocation.
+		 * The other image is kept alive for as long as this image exists.
+		 */
+		void setMemorySource(VulkanImage* source);
+
+		/** Returns the memory allocated for this image, or null if the image uses memory owned by another image. */
+		VmaAllocation getAllocation() const { return mAllocation; }
+
 		/** 
 		 * Queues a command on the provided command buffer. The command copies the contents of the current image
 		 * subresource to the destination buffer. 
@@ -149,6 +158,7 @@ namespace bs { namespace ct
 
 		VkImage mImage;
 		VmaAllocation mAllocation;
+		VulkanImage* mMemorySource = nullptr;
 		VkImageView mMainView;
 		VkImageView mFramebufferMainView;
 		INT32 mUsage;
@@ -246,6 +256,7 @@ namespace bs { namespace ct
 		VulkanImage* mImages[BS_MAX_DEVICES];
 		PixelFormat mInternalFormats[BS_MAX_DEVICES];
 		GpuDeviceFlags mDeviceMask;
+		SPtr<VulkanTexture> mMemorySource;
 
 		VulkanBuffer* mStagingBuffer;
 		UINT32 mMappedDeviceIdx;
@@ -743,4 +743,9 @@ cleanup:
 
 		return bytecode;
 	}
+
+	String VulkanGLSLProgramFactory::getCompilerVersion() const
+	{
+		return String("glslang_") + GetGlslVersionString() + "_" + toString(glslang::GetSpirvGeneratorVersion());
+	}
 }}
@@ -26,6 +26,9 @@ namespace bs { namespace ct
 
 		/** @copydoc GpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC&) */
 		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) override;
+
+		/** @copydoc GpuProgramFactory::getCompilerVersion */
+		String getCompilerVersion() const override;
 	protected:
 		static const String LANGUAGE_NAME;
 	};
@@ -143,6 +143,18 @@ namespace bs
 		return texPtr;
 	}
 
+	SPtr<Texture> VulkanTextureManager::createAliasedTextureInternal(const TEXTURE_DESC& desc,
+		const SPtr<Texture>& memorySource, GpuDeviceFlags deviceMask)
+	{
+		VulkanTexture* tex = new (bs_alloc<VulkanTexture>()) VulkanTexture(desc, nullptr, deviceMask);
+		tex->mMemorySource = std::static_pointer_cast<VulkanTexture>(memorySource);
+
+		SPtr<VulkanTexture> texPtr = bs_shared_ptr<VulkanTexture>(tex);
+		texPtr->_setThisPtr(texPtr);
+
+		return texPtr;
+	}
+
 	SPtr<RenderTexture> VulkanTextureManager::createRenderTextureInternal(const RENDER_TEXTURE_DESC& desc,
 																				  UINT32 deviceIdx)
 	{
@@ -40,6 +40,10 @@ namespace bs
 		SPtr<Texture> createTextureInternal(const TEXTURE_DESC& desc, 
 			const SPtr<PixelData>& initialData = nullptr, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
 
+		/** @copydoc TextureManager::createAliasedTextureInternal */
+		SPtr<Texture> createAliasedTextureInternal(const TEXTURE_DESC& desc, const SPtr<Texture>& memorySource,
+			GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
 		/** @copydoc TextureManager::createRenderTextureInternal */
 		SPtr<RenderTexture> createRenderTextureInternal(const RENDER_TEXTURE_DESC& desc, 
 			UINT32 deviceIdx = 0) override;